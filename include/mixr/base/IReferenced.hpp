@@ -4,9 +4,11 @@
 
 // framework configuration file
 #include "mixr/config.hpp"
-// lock/unlock, etc - reference system needs it
+// lock/unlock, etc
 #include "mixr/base/util/atomics.hpp"
 
+#include <atomic>
+
 namespace mixr {
 namespace base {
 
@@ -31,6 +33,12 @@ namespace base {
 //    Beware - Do not use 'delete' to destroy an object; only use unref()!
 //
 //    Using getRefCount() returns the current value of the Object's reference count
+//
+//    The reference count is a lock-free atomic counter.  Incrementing it needs no
+//    ordering (the caller already holds a reference), while decrementing it is
+//    a release operation, and the thread that drops the last reference acquires
+//    before deleting the object, so all prior uses of the object by the other
+//    threads happen before its deletion.
 //------------------------------------------------------------------------------
 
 class IReferenced
@@ -41,7 +49,7 @@ public:
    IReferenced& operator=(const IReferenced&) =delete;
    virtual ~IReferenced() =0;
 
-   int getRefCount() const       { return refCount; }
+   int getRefCount() const       { return refCount.load(std::memory_order_relaxed); }
 
    // ---
    // ref() --
@@ -87,31 +95,30 @@ public:
    };
 
 private:
-   mutable long semaphore{};  // ref(), unref() semaphore
-   mutable int refCount{1};   // reference count
+   mutable std::atomic<int> refCount{1};   // reference count
 };
 
 inline IReferenced::~IReferenced() {}
 
 inline void IReferenced::ref() const
 {
-   lock(semaphore);
-   if (++(refCount) <= 1) throw new ExpInvalidRefCount();
-   else unlock(semaphore);
+   const int n{refCount.fetch_add(1, std::memory_order_relaxed) + 1};
+   if (n <= 1) throw new ExpInvalidRefCount();
 
    #ifdef MAX_REF_COUNT_ERROR
    static int maxRefCount = MAX_REF_COUNT_ERROR;
-   if (which->refCount > maxRefCount) {
-      std::cout << "ref(" << this << "): refCount(" << which->refCount << ") exceeded max refCount(" << maxRefCount << ")." << std::endl;
+   if (n > maxRefCount) {
+      std::cout << "ref(" << this << "): refCount(" << n << ") exceeded max refCount(" << maxRefCount << ")." << std::endl;
    }
    #endif
 }
 
 inline void IReferenced::unref() const
 {
-   lock(semaphore);
-   if (--refCount == 0) delete this;
-   else unlock(semaphore);
+   if (refCount.fetch_sub(1, std::memory_order_release) == 1) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      delete this;
+   }
 }
 
 }
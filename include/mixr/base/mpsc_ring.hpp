@@ -0,0 +1,115 @@
+
+#ifndef __mixr_base_mpsc_ring_HPP__
+#define __mixr_base_mpsc_ring_HPP__
+
+#include <atomic>
+#include <cstddef>
+
+namespace mixr {
+namespace base {
+
+//------------------------------------------------------------------------------
+// Template: mpsc_ring<T>
+// Description: Lock-free, bounded, multiple producer, single consumer ring
+//              buffer of items of type T
+//------------------------------------------------------------------------------
+// Notes:
+//    1) Use the constructor's 'qsize' parameter to set the max size of the
+//       ring, which is rounded up to a power of two.
+//    2) Use put() to add items and get() to remove items.
+//    3) put() may be called by any number of threads at the same time; it
+//       never waits, it returns false when the ring is full.
+//    4) get() must only be called by one thread at a time (i.e., the consumer).
+//    5) Each slot has a sequence number that tells the producers and the
+//       consumer whose turn it is to use the slot (D. Vyukov's bounded queue).
+//
+// Examples:
+//    base::mpsc_ring<int>* q1 = new base::mpsc_ring<int>(100); // ring size 128 items
+//    q1->put(1);           // puts 1 on the ring
+//    q1->put(2);           // puts 2 on the ring
+//    int i{};
+//    q1->get(&i);          // i is equal to 1
+//    q1->get(&i);          // i is equal to 2
+//------------------------------------------------------------------------------
+template <class T> class mpsc_ring
+{
+public:
+   mpsc_ring(const unsigned int qsize) : SIZE(roundUp(qsize)), MASK(SIZE - 1)
+   {
+      ring = new Slot[SIZE];
+      for (std::size_t i = 0; i < SIZE; i++) {
+         ring[i].seq.store(i, std::memory_order_relaxed);
+      }
+   }
+   mpsc_ring(const mpsc_ring<T>& q1) : mpsc_ring(static_cast<unsigned int>(q1.SIZE))  {}
+   ~mpsc_ring()                                                                         { delete[] ring; }
+
+   bool isEmpty() const           { return (entries() == 0); }
+   bool isNotEmpty() const        { return (entries() != 0); }
+   unsigned int size() const      { return static_cast<unsigned int>(SIZE); }
+
+   // Number of items on the ring (approximate while the producers are busy)
+   unsigned int entries() const {
+      const std::size_t out{tail.load(std::memory_order_acquire)};
+      const std::size_t in{head.load(std::memory_order_acquire)};
+      return (in > out ? static_cast<unsigned int>(in - out) : 0);
+   }
+
+   // Puts an item at the back of the ring; returns false if the ring is full
+   bool put(T item) {
+      std::size_t pos{head.load(std::memory_order_relaxed)};
+      for (;;) {
+         Slot* const slot{&ring[pos & MASK]};
+         const std::size_t seq{slot->seq.load(std::memory_order_acquire)};
+         if (seq == pos) {
+            // the slot is free; claim it
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+               slot->item = item;
+               slot->seq.store(pos + 1, std::memory_order_release);
+               return true;
+            }
+         } else if (seq < pos) {
+            // the consumer hasn't emptied this slot yet; we're full
+            return false;
+         } else {
+            // another producer beat us to it
+            pos = head.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   // Gets an item from the front of the ring; returns false if the ring is empty
+   bool get(T* const item) {
+      const std::size_t pos{tail.load(std::memory_order_relaxed)};
+      Slot* const slot{&ring[pos & MASK]};
+      if (slot->seq.load(std::memory_order_acquire) != pos + 1) return false;
+      *item = slot->item;
+      slot->seq.store(pos + SIZE, std::memory_order_release);
+      tail.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+private:
+   struct Slot {
+      std::atomic<std::size_t> seq{};
+      T item{};
+   };
+
+   static std::size_t roundUp(const unsigned int n) {
+      std::size_t s{2};
+      while (s < n) s <<= 1;
+      return s;
+   }
+
+   mpsc_ring<T>& operator=(mpsc_ring<T>&) { return *this; }
+   Slot* ring{};                             // The ring
+   const std::size_t SIZE{};                 // Max size of the ring (a power of two)
+   const std::size_t MASK{};                 // Index mask
+   alignas(64) std::atomic<std::size_t> head{};   // In (put) position
+   alignas(64) std::atomic<std::size_t> tail{};   // Out (get) position
+};
+
+}
+}
+
+#endif
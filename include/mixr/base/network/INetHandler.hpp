@@ -57,6 +57,16 @@ public:
    // the actual number of bytes received.
    virtual unsigned int recvData(char* const packet, const int maxSize) =0;
 
+   // Sends 'n' packets, where packets[i] is sizes[i] bytes.  Returns the
+   // number of packets sent.  (default: sendData() for each packet)
+   virtual unsigned int sendBatch(const char* const* const packets, const int* const sizes, const unsigned int n);
+
+   // Receives a maximum of 'n' packets into 'buffer', where the i'th packet is
+   // at (buffer + i * maxSize) and is a maximum of 'maxSize' bytes.  The number
+   // of bytes received for each packet are returned in 'sizes'.  Returns the
+   // number of packets received.  (default: recvData() for each packet)
+   virtual unsigned int recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n);
+
    // Set our socket for blocked (wait) I/O
    virtual bool setBlocked() =0;
 
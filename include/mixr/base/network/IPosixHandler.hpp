@@ -71,6 +71,14 @@ class String;
 // typedefs, defines, and constants that will make each convention match for
 // use later in the code.  This will save a lot of pre-processor intervention
 // and make the code that much more enjoyable to read!
+//
+// On Linux, sendBatch() and recvBatch() use the sendmmsg() and recvmmsg()
+// system calls to send and receive up to 64 datagrams per call; elsewhere,
+// and for TCP (see ITcpHandler), they send and receive one packet at a time
+// (see INetHandler).  If sendmmsg() fails, the rest of the packets are sent
+// one at a time.  Packets that are larger than recvBatch()'s 'maxSize' are
+// dropped, rather than passed on cut short, and are counted (see
+// getNumTruncated()).
 //------------------------------------------------------------------------------
 class IPosixHandler : public INetHandler
 {
@@ -94,13 +102,18 @@ public:
    bool closeConnection() override;
    bool sendData(const char* const packet, const int size) override;
    unsigned int recvData(char* const packet, const int maxSize) override;
+   unsigned int sendBatch(const char* const* const packets, const int* const sizes, const unsigned int n) override;
+   unsigned int recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n) override;
    bool setBlocked() override;
    bool setNoWait() override;
 
-   // Last recvData() origin IP and port
+   // Last recvData() (or last packet of recvBatch()) origin IP and port
    uint32_t getLastFromAddr() const;     // IP address of last valid recvData()
    uint16_t getLastFromPort() const;     // Port address of last valid recvData()
 
+   // Number of packets that recvBatch() dropped because they were larger than 'maxSize'
+   unsigned int getNumTruncated() const;
+
 protected:
    bool init() override;
 
@@ -133,6 +146,8 @@ protected:
    LcSocket socketNum;                // uur Socket
 
 private:
+   static const unsigned int MAX_BATCH{64};  // Max packets per sendmmsg() or recvmmsg() call
+
    std::string localIpAddr;           // Local host name or IP address
    uint32_t localAddr{};              // Local host address
    uint32_t netAddr{};                // Network (remote) host address
@@ -141,6 +156,7 @@ private:
    uint16_t localPort{};              // Local (source) port
    uint16_t ignoreSourcePort{};       // Ignore message from this source port
    uint16_t fromPort1{};              // Last recvData() 'from' port number
+   unsigned int numTruncated{};       // Number of packets dropped by recvBatch() for being too large
    bool sharedFlg{};                  // Shared port flag
    bool initialized{};                // handler has been initialized
    unsigned int sendBuffSizeKb{32};   // Send buffer size in KBs
@@ -204,6 +220,11 @@ inline uint16_t IPosixHandler::getLastFromPort() const
    return fromPort1;
 }
 
+inline unsigned int IPosixHandler::getNumTruncated() const
+{
+   return numTruncated;
+}
+
 }
 }
 
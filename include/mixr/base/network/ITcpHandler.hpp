@@ -29,6 +29,11 @@ public:
 
    bool sendData(const char* const packet, const int size) final;
    unsigned int recvData(char* const packet, const int maxSize) final;
+
+   // One sendData() or recvData() per packet (see INetHandler); the batched
+   // datagram system calls of IPosixHandler don't apply to a stream socket
+   unsigned int sendBatch(const char* const* const packets, const int* const sizes, const unsigned int n) final;
+   unsigned int recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n) final;
    bool isConnected() const final;
    bool closeConnection() final;
 
@@ -27,6 +27,11 @@ public:
 
    virtual double f(const double iv1, IFStorage* const s = nullptr) const;
 
+   // Batch function: computes f() for 'n' points.  The table (if any) does the
+   // batch; otherwise f() is called for each point.  Derived classes that
+   // override f() should override this as well.
+   virtual void f(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s = nullptr) const;
+
 protected:
    // slot table helper methods
    bool setSlotLfiTable(const ITable* const) override;
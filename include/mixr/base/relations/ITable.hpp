@@ -9,6 +9,7 @@ namespace base {
 class Boolean;
 class IFStorage;
 class IList;
+class TableStorage;
 
 //------------------------------------------------------------------------------
 // Class: ITable
@@ -27,6 +28,8 @@ class IList;
 // Slots:
 //    data        <List>      ! Dependant variable data (default: 0)
 //    extrapolate <Boolean>   ! Extrapolate beyond the given data table limits (default: false)
+//    gridIndex   <Boolean>   ! Index the breakpoints with uniform grids for O(1)
+//                            ! breakpoint searches (default: false)
 //
 //------------------------------------------------------------------------------
 // Notes:
@@ -41,6 +44,13 @@ class IList;
 //    3) If a dependent variable exceeds a breakpoint table data then the lfi()
 //       result is clamped at the last known dependent value.  If the extrapolate
 //       flag is true, we'll extrapolate beyond the given data table.
+//
+//    4) The derived classes' batch lfi() functions interpolate arrays of 'n'
+//       points, and the breakpoints found for each point are the starting
+//       points of the searches for the next, so the searches are short when the
+//       points are sorted or clustered.  With the grid index enabled, the
+//       breakpoint tables are indexed with uniform grids (see LfiGrid), which
+//       gives the search's starting breakpoint for any point in O(1) time.
 //------------------------------------------------------------------------------
 class ITable : public IObject
 {
@@ -66,6 +76,12 @@ public:
    // Sets the extrapolation enabled flag.
    bool setExtrapolationEnabled(const bool);
 
+   // Returns true if the breakpoint grid indexes are enabled.
+   bool isGridIndexEnabled() const                               { return gridFlg; }
+
+   // Sets the breakpoint grid indexes enabled flag.
+   bool setGridIndexEnabled(const bool);
+
    // Data storage factory (pre-ref()'d)
    virtual IFStorage* storageFactory() const;
 
@@ -101,17 +117,25 @@ protected:
    virtual bool loadData(const IList& list, double* const table) = 0;
    static bool loadVector(const IList& list, double** table, unsigned int* n);
 
+   // (Re)builds the breakpoint grid indexes (derived classes index their breakpoints)
+   virtual void updateGridIndexes();
+
+   // Returns the TableStorage of 'f', or nullptr if 'f' is nullptr
+   static TableStorage* getTableStorage(IFStorage* const f);
+
    bool valid{};        // Table is valid
 
 private:
    double* dtable{};    // Data Table
    unsigned int nd{};   // Number of data points
    bool extFlg{};       // Extrapolation enabled flag
+   bool gridFlg{};      // Breakpoint grid indexes enabled flag
 
 private:
    // slot table helper methods
    bool setSlotDataTable(const IList* const x)               { return setDataTable(x); }
    bool setSlotExtrapolationEnabled(const Boolean* const);
+   bool setSlotGridIndexEnabled(const Boolean* const);
 };
 
 }
@@ -49,6 +49,7 @@ public:
    const double* getCoefficients() const  { return a; }
 
    double f(const double x, IFStorage* const s = nullptr) const override;
+   void f(const double* const x, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
 
 protected:
    bool setCoefficients(const double* const coeff, const int n);
@@ -3,6 +3,7 @@
 #define __mixr_base_Table1_HPP__
 
 #include "mixr/base/relations/ITable.hpp"
+#include "mixr/base/util/lfi.hpp"
 
 namespace mixr {
 namespace base {
@@ -41,6 +42,9 @@ public:
    // 1D Linear Function Interpolator: returns the result of f(x) using linear interpolation
    virtual double lfi(const double iv1, IFStorage* const s = nullptr) const;
 
+   // 1D batch Linear Function Interpolator: computes f(x) for 'n' points
+   virtual void lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s = nullptr) const;
+
    // Load the X (iv1) breakpoints
    virtual bool setXBreakpoints1(const IList* const bkpts);
 
@@ -50,10 +54,15 @@ public:
 
 protected:
    bool loadData(const IList& list, double* const table) override;
+   void updateGridIndexes() override;
+
+   // X breakpoint grid index
+   const LfiGrid& getXGrid() const     { return xGrid; }
 
 private:
    double* xtable{};    // X Breakpoint Table
    unsigned int nx{};   // Number of x breakpoints
+   LfiGrid xGrid;       // X breakpoint grid index
 };
 
 }
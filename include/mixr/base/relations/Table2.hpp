@@ -41,20 +41,32 @@ public:
    // 2D Linear Function Interpolator: returns the result of f(x,y) using linear interpolation
    virtual double lfi(const double iv1, const double iv2, IFStorage* const s = nullptr) const;
 
+   // 2D batch Linear Function Interpolator: computes f(x,y) for 'n' points
+   virtual void lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const s = nullptr) const;
+
    // Load the Y (iv2) breakpoints
    virtual bool setYBreakpoints2(const IList* const bkpts);
 
    double lfi(const double iv1, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
    unsigned int tableSize() const override;
 
    bool isValid() const override;
 
 protected:
    bool loadData(const IList& list, double* const table) override;
+   void updateGridIndexes() override;
+
+   // Y breakpoint grid index
+   const LfiGrid& getYGrid() const     { return yGrid; }
 
 private:
    double* ytable{};    // Y Breakpoint Table
    unsigned int ny{};   // Number of y breakpoints
+   LfiGrid yGrid;       // Y breakpoint grid index
+
+   // Interpolates 'n' points; missing (nullptr) independent variables are at their first breakpoints
+   void lfiBatch(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const f) const;
 };
 
 }
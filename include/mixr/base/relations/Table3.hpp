@@ -42,21 +42,34 @@ public:
    // 3D Linear Function Interpolator: returns the result of f(x,y,z) using linear interpolation
    virtual double lfi(const double iv1, const double iv2, const double iv3, IFStorage* const s = nullptr) const;
 
+   // 3D batch Linear Function Interpolator: computes f(x,y,z) for 'n' points
+   virtual void lfi(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const s = nullptr) const;
+
    // Loads the Z (iv3) breakpoints
    virtual bool setZBreakpoints3(const IList* const bkpts);
 
    double lfi(const double iv1, const double iv2, IFStorage* const s = nullptr) const override;
    double lfi(const double iv1, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
    unsigned int tableSize() const override;
 
    bool isValid() const override;
 
 protected:
    bool loadData(const IList& list, double* const table) override;
+   void updateGridIndexes() override;
+
+   // Z breakpoint grid index
+   const LfiGrid& getZGrid() const     { return zGrid; }
 
 private:
    double* ztable {};    // Z Breakpoint Table
    unsigned int nz {};   // Number of z breakpoints
+   LfiGrid zGrid;        // Z breakpoint grid index
+
+   // Interpolates 'n' points; missing (nullptr) independent variables are at their first breakpoints
+   void lfiBatch(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const f) const;
 };
 
 }
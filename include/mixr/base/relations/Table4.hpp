@@ -43,22 +43,36 @@ public:
    // 4D Linear Function Interpolator: returns the result of f(x,y,z,w) using linear interpolation
    virtual double lfi(const double iv1, const double iv2, const double iv3, const double iv4, IFStorage* const s = nullptr) const;
 
+   // 4D batch Linear Function Interpolator: computes f(x,y,z,w) for 'n' points
+   virtual void lfi(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const out, const unsigned int n, IFStorage* const s = nullptr) const;
+
    // Loads the W (iv4) breakpoints
    virtual bool setWBreakpoints4(const IList* const bkpts);
 
    double lfi(const double iv1, const double iv2, const double iv3, IFStorage* const s = nullptr) const override;
    double lfi(const double iv1, const double iv2, IFStorage* const s = nullptr) const override;
    double lfi(const double iv1, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
    unsigned int tableSize() const override;
 
    bool isValid() const override;
 
 protected:
    bool loadData(const IList& list, double* const table) override;
+   void updateGridIndexes() override;
+
+   // W breakpoint grid index
+   const LfiGrid& getWGrid() const     { return wGrid; }
 
 private:
    double* wtable {};    // W Breakpoint Table
    unsigned int nw {};   // Number of w breakpoints
+   LfiGrid wGrid;        // W breakpoint grid index
+
+   // Interpolates 'n' points; missing (nullptr) independent variables are at their first breakpoints
+   void lfiBatch(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const out, const unsigned int n, IFStorage* const f) const;
 };
 
 }
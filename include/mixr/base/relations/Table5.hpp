@@ -43,6 +43,9 @@ public:
 
    virtual double lfi(const double iv1, const double iv2, const double iv3, const double iv4, const double iv5, IFStorage* const s = nullptr) const;
 
+   // 5D batch Linear Function Interpolator: computes f(x,y,z,w,v) for 'n' points
+   virtual void lfi(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const out, const unsigned int n, IFStorage* const s = nullptr) const;
+
    // Loads the V (iv5) breakpoints
    virtual bool setVBreakpoints5(const IList* const bkpts);
 
@@ -50,16 +53,28 @@ public:
    double lfi(const double iv1, const double iv2, const double iv3, IFStorage* const s = nullptr) const override;
    double lfi(const double iv1, const double iv2, IFStorage* const s = nullptr) const override;
    double lfi(const double iv1, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
+   void lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s = nullptr) const override;
    unsigned int tableSize() const override;
 
    bool isValid() const override;
 
 protected:
    bool loadData(const IList& list, double* const table) override;
+   void updateGridIndexes() override;
+
+   // V breakpoint grid index
+   const LfiGrid& getVGrid() const     { return vGrid; }
 
 private:
    double* vtable {};     // V Breakpoint Table
    unsigned int nv {};    // Number of v breakpoints
+   LfiGrid vGrid;         // V breakpoint grid index
+
+   // Interpolates 'n' points; missing (nullptr) independent variables are at their first breakpoints
+   void lfiBatch(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const out, const unsigned int n, IFStorage* const f) const;
 };
 
 }
@@ -0,0 +1,40 @@
+
+#ifndef __mixr_base_util_compress_utils_HPP__
+#define __mixr_base_util_compress_utils_HPP__
+
+#include <cstddef>
+
+//------------------------------------------------------------------------------
+// Block compression functions
+//
+//    A fast, dependency free, LZ77 block compressor and decompressor that
+//    use the LZ4 block format, so the blocks can also be read by the
+//    standard LZ4 library (LZ4_decompress_safe()).  It's made for speed,
+//    not ratio: use it to compress large blocks of repetitive data (e.g.,
+//    recorded data records) on their way to the disk or the network.
+//------------------------------------------------------------------------------
+
+namespace mixr {
+namespace base {
+
+// Max size of the compressed block of 'n' bytes of data
+std::size_t lz4CompressBound(const std::size_t n);
+
+// Compresses the 'n' bytes of 'src' into 'dst', which has room for 'dstSize' bytes
+// (at least lz4CompressBound(n)); returns the compressed size, or zero if it didn't fit
+std::size_t lz4Compress(const char* const src, const std::size_t n, char* const dst, const std::size_t dstSize);
+
+// Returned by lz4Decompress() for an invalid block (zero is the size of a valid,
+// empty block)
+const std::size_t LZ4_ERROR{static_cast<std::size_t>(-1)};
+
+// Decompresses the compressed block of 'n' bytes into 'dst', which has room for
+// 'dstSize' bytes; returns the decompressed size, or LZ4_ERROR if the block is
+// invalid (e.g., truncated, or its offsets or lengths are past the data) or it
+// didn't fit
+std::size_t lz4Decompress(const char* const src, const std::size_t n, char* const dst, const std::size_t dstSize);
+
+}
+}
+
+#endif
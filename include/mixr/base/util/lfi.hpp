@@ -6,6 +6,8 @@
 // Linear Function Interpolators
 //------------------------------------------------------------------------------
 
+#include <vector>
+
 namespace mixr {
 namespace base {
 
@@ -110,8 +112,50 @@ double lfi_5D(const double x, const double y, const double z, const double w, co
          unsigned int* const vbp=nullptr
       );
 
+// ---
+// Breakpoint grid index
+//    Indexes a breakpoint table with a uniform grid of cells that span the
+//    breakpoints, and each cell holds the starting breakpoint for the
+//    interpolators' searches.  find() returns the breakpoint to use as the
+//    interpolators' previous breakpoint (e.g., 'xbp'), so the search is
+//    O(1) (a step or two from the start) for any 'x'.  The results are
+//    the same as the interpolators' searches.
+// ---
+
+class LfiGrid
+{
+public:
+   // Builds the index for the 'n' breakpoints in 'data'; empty if 'n' is less than two
+   void build(const double* const data, const unsigned int n);
+
+   void clear()                     { cells.clear(); }
+   bool isEmpty() const             { return cells.empty(); }
+
+   // Starting breakpoint for 'x'
+   unsigned int find(const double x) const
+   {
+      const double t{(x - x0) * scale};
+      if (!(t > 0.0)) return cells.front();
+      const auto maxCell = static_cast<double>(cells.size() - 1);
+      return cells[ (t < maxCell) ? static_cast<std::size_t>(t) : cells.size() - 1 ];
+   }
+
+   // Sets the previous breakpoint, 'bp', to the starting breakpoint for 'x', if indexed
+   void update(const double x, unsigned int* const bp) const
+   {
+      if (!cells.empty()) *bp = find(x);
+   }
+
+private:
+   static const unsigned int CELLS_PER_BREAKPOINT{4};
+   static const unsigned int MAX_CELLS{65536};
+
+   std::vector<unsigned int> cells;    // Starting breakpoint of each cell
+   double x0{};                        // Lower limit of the first cell
+   double scale{};                     // Number of cells per unit of 'x'
+};
+
 }
 }
 
 #endif
-
@@ -0,0 +1,82 @@
+
+#ifndef __mixr_base_util_simd_utils_HPP__
+#define __mixr_base_util_simd_utils_HPP__
+
+//------------------------------------------------------------------------------
+// Vectorized (SIMD) array functions
+//
+//    These are array kernels for the per-target loops (e.g., Tdb's boresight
+//    data and the antenna's gain pipeline).  Each function has a scalar
+//    version and, on x86 builds using GCC or Clang, an AVX2 version that
+//    processes four doubles at a time.
+//
+//    The kernels are selected at runtime: the AVX2 kernels are used by default
+//    when the CPU supports them, and setKernels() can be used to select the
+//    scalar kernels (e.g., to compare results or timing).  The scalar kernels
+//    give the same results as the standard library array functions (see
+//    math_utils.hpp and osg_utils.hpp).  The AVX2 matrix, square root and
+//    multiply kernels give identical results, while the AVX2 arc-tangent,
+//    arc-cosine and power of 10 kernels are polynomial approximations that
+//    are within 2 ULPs of the standard library.
+//
+//    Vector arrays must be contiguous arrays of base::Vec3d; the double
+//    arrays do not need to be aligned, but they're faster if they are.
+//------------------------------------------------------------------------------
+
+namespace mixr {
+namespace base {
+class Vec3d;
+class Matrixd;
+
+namespace simd {
+
+// Kernel sets
+enum class Kernels { SCALAR, AVX2 };
+
+// True if the AVX2 kernels are built in and supported by this CPU
+bool isAvx2Supported();
+
+// Current kernel set
+Kernels getKernels();
+
+// Selects the kernel set; returns false (and nothing changes) if not supported
+bool setKernels(const Kernels k);
+
+// Post-multiply an array of 3D vectors with a 4x4 matrix (see postMultVec3Array())
+void postMultVec3Array(const Vec3d orig[], const Matrixd& matrix, Vec3d result[], const unsigned int n);
+
+// Computes the antenna boresight data from 'n' line-of-sight unit vectors
+// in gimbal coordinates, 'losG'.
+//    xa, ya, za  -- x, y and -z components of the LOS vectors
+//    ra2, ra     -- x-y plane range squared and range
+//    aar         -- angle off boresight (radians), acos(xa)
+//    aazr        -- azimuth off boresight (radians), atan2(ya, xa)
+//    aelr        -- elevation off boresight (radians), atan2(za, ra)
+void boresightArrays(
+      const Vec3d losG[],
+      double xa[], double ya[], double za[],
+      double ra2[], double ra[],
+      double aar[], double aazr[], double aelr[],
+      const unsigned int n
+   );
+
+// Computes the arc-cosines of 'n' values
+void acosArray(const double* const src, double* const dst, const unsigned int n);
+
+// Computes the arc-tangents of 'n' (y, x) pairs
+void atan2Array(const double* const yValues, const double* const xValues, double* const dst, const unsigned int n);
+
+// Computes the square roots of 'n' values
+void sqrtArray(const double* const src, double* const dst, const unsigned int n);
+
+// Raises 10 to the power of 'n' src values
+void pow10Array(const double* const src, double* const dst, const unsigned int n);
+
+// Multiply an array of 'n' reals with a constant
+void multArrayConst(const double* const src, const double c, double* const dst, const unsigned int n);
+
+}
+}
+}
+
+#endif
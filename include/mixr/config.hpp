@@ -18,7 +18,9 @@
 // Max number of interval timers (see Timers.hpp)
 constexpr int MIXR_CONFIG_MAX_INTERVAL_TIMERS{500};
 
-// Max number of "player's of interest" (see Gimbal.hpp)
+// Deprecated: the "players of interest" are no longer limited (see Gimbal.hpp
+// and the gimbal's 'maxPlayersOfInterest' slot)
+[[deprecated("players of interest are no longer limited; use the gimbal's maxPlayersOfInterest slot")]]
 constexpr int MIXR_CONFIG_MAX_PLAYERS_OF_INTEREST{4000};
 
 // Max size of the RF emission queues (see RfSystem.hpp)
@@ -0,0 +1,87 @@
+
+#ifndef __mixr_interop_common_DeadReckoningBatch_HPP__
+#define __mixr_interop_common_DeadReckoningBatch_HPP__
+
+#include "mixr/base/osg/Vec3d"
+
+#include <vector>
+
+namespace mixr {
+namespace interop {
+class INib;
+
+//------------------------------------------------------------------------------
+// Class: DeadReckoningBatch
+// Description: Computes the dead reckoned (DR) positions and Euler angles of
+//              a batch of NIBs.
+//
+//    compute() gathers the DR state of the NIBs that use the world coordinate
+//    algorithms (FPW, RPW, RVW and FVW) into arrays (structure of arrays), and
+//    then dead reckons all of them together: one pass for the positions, and
+//    one pass for the rotations of the RPW and RVW NIBs, which uses the
+//    base::simd array kernels for the square roots and arc-tangents.  The
+//    NIBs using the other algorithms are computed by their own DR function.
+//
+//    Using the scalar simd kernels (see base::simd::setKernels()), the results
+//    are the same as INib's own DR function, within round-off.
+//
+// Example:
+//
+//    DeadReckoningBatch batch;
+//    for each NIB ...
+//       batch.add(nib, drTime);
+//    batch.compute();
+//    for (unsigned int i = 0; i < batch.size(); i++) {
+//       ... batch.getNib(i), batch.getPosition(i), batch.getAngles(i) ...
+//    }
+//
+//------------------------------------------------------------------------------
+class DeadReckoningBatch
+{
+public:
+   DeadReckoningBatch() = default;
+
+   unsigned int size() const                          { return static_cast<unsigned int>(nibs.size()); }
+   INib* getNib(const unsigned int i) const           { return nibs[i]; }
+   const base::Vec3d& getPosition(const unsigned int i) const   { return pos[i]; }  // DR position (meters) (ECEF)
+   const base::Vec3d& getAngles(const unsigned int i) const     { return angles[i]; }  // DR Euler angles (rad) [ phi theta psi ]
+   double getTime(const unsigned int i) const         { return t[i]; }     // DR time (seconds)
+
+   // Adds a NIB, which will be dead reckoned to DR time 'dT' (seconds)
+   void add(INib* const nib, const double dT);
+
+   // Computes the DR positions and Euler angles of the NIBs
+   void compute();
+
+   // Removes all NIBs
+   void clear();
+
+private:
+   std::vector<INib*> nibs;         // NIBs
+   std::vector<double> t;           // DR time (seconds)
+   std::vector<base::Vec3d> pos;    // DR positions (results)
+   std::vector<base::Vec3d> angles; // DR Euler angles (results)
+
+   // World coordinate DR state (positions)
+   std::vector<unsigned int> lin;               // Index of each NIB
+   std::vector<double> p0x, p0y, p0z;           // Position @ t0
+   std::vector<double> v0x, v0y, v0z;           // Velocity @ t0
+   std::vector<double> a0x, a0y, a0z;           // Acceleration @ t0 (zero for 1st order)
+                                                // (the positions are computed in place)
+   std::vector<double> lt;                      // DR time
+
+   // World coordinate DR state (rotations)
+   std::vector<unsigned int> rot;               // Index of each NIB
+   std::vector<double> wx, wy, wz;              // Angular rates @ t0
+   std::vector<double> r0[9];                   // R0 matrix (row major)
+   std::vector<double> rt;                      // DR time
+   std::vector<double> w2, w1;                  // |w|^2 and |w|
+   std::vector<double> rwb[9];                  // Rwb matrix (row major)
+   std::vector<double> sphi, cphi, stht, ctht, spsi, cpsi;   // Sin/cos of the DR Euler angles
+   std::vector<double> phi, tht, psi;           // DR Euler angles
+};
+
+}
+}
+
+#endif
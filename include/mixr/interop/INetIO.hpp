@@ -3,9 +3,14 @@
 #define __mixr_interop_common_INetIO_HPP__
 
 #include "mixr/simulation/INetIO.hpp"
+#include "mixr/interop/NibTable.hpp"
+#include "mixr/interop/DeadReckoningBatch.hpp"
 
 #include <array>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace mixr {
 namespace base { class IAngle; class Boolean; class Identifier; class Integer; class ILength; class PairStream; class ITime; }
@@ -14,6 +19,7 @@ namespace simulation { class ISimulation; class IStation; }
 namespace interop {
 class INib;
 class INtm;
+class InterestManager;
 class INtmInputNode;
 class INtmOutputNode;
 
@@ -50,6 +56,9 @@ class INtmOutputNode;
 //    maxEntityRange       <base::ILength>     ! Max entity range of networked players,
 //                                             !  or zero for no max range (default: 0 -- no range filtering)
 //
+//    inputInterest        <InterestManager>   ! Interest filter for the incoming entities (default: none)
+//    outputInterest       <InterestManager>   ! Interest filter for the outgoing players (default: none)
+//
 //
 // INetIO interface:
 //
@@ -94,6 +103,15 @@ class INtmOutputNode;
 //    slot, which defaults to zero or no range filtering.  Currently, this
 //    applies only to new entities; proxy players are not filtered.
 //
+//    Incoming entities can also be filtered by the 'inputInterest' interest
+//    manager (see InterestManager.hpp); proxy players are not created for the
+//    entities that are not of interest.  The network specific classes also
+//    drop these entities' updates before their Nibs are created, and remove
+//    the Nibs of the entities that leave the areas of interest.  See the
+//    getNumInputFiltered() and getNumProxiesFiltered() counters; a filtered
+//    entity is forgotten when it's deleted from the network or hasn't been
+//    updated for 'maxAge' seconds, and is counted again if it comes back.
+//
 // Outgoing entities:
 //
 //    Use the 'enableOutput' slot to enable or disable the sending of our
@@ -107,10 +125,33 @@ class INtmOutputNode;
 //    (Note: without the outgoing Ntm list, no local players will be written
 //    to the network)
 //
+//    The entity state updates of the outgoing players that are not of interest
+//    to the 'outputInterest' interest manager (i.e., the areas and entity types
+//    that the other federates subscribe to) are suppressed.  Mode changes
+//    are always sent, and so are heartbeats (an update after 'maxTimeDR'
+//    seconds without one), so that the other federates don't time out the
+//    suppressed entities.  See the getNumOutputFiltered() counter.
+//
 //    A network specific Nib is created, using the nibFactory() function, to
 //    manage the flow of data from the mixr player to the network entity.
 //    The outgoing Nib objects are managed using the "output Nib" list.
 //
+//    The input and output Nib lists are NibTables, which find the Nibs by their
+//    player ID and federate name in constant time.  The lists are not in any
+//    particular order, and a Nib's position in its list can change as other
+//    Nibs are removed.
+//
+//    Before the output Nibs are checked for player state updates, the dead
+//    reckoned positions and angles of the local players' Nibs are computed
+//    together using a DeadReckoningBatch.  Nibs that will send an update
+//    without checking their DR errors (e.g., a heartbeat) are left out (see
+//    INib::isDeadReckoningCheckRequired()).
+//
+//    Likewise, before the Input-list is processed, the dead reckoning of the
+//    proxy players' Nibs is computed together for their next DR step, which
+//    their players use during their next dynamics phase (see INib::setDrResult()
+//    and INib::getNextDrStep()).
+//
 //    The mixr player objects do not contain any state data related to the
 //    interoperability networks that their being sent to.  As a result, an
 //    mixr player can be sent to more than one interoperability network,
@@ -210,6 +251,19 @@ public:
    // Dead-Reckoning: Returns max age before a networked player is removed (seconds)
    virtual double getMaxAge(const INib* const nib = nullptr) const;
 
+   // Interest management: interest filters for the incoming entities and outgoing players (or nullptr)
+   const InterestManager* getInputInterest() const;
+   const InterestManager* getOutputInterest() const;
+
+   // Interest management: true if the entity at 'geocPos' (meters) (ECEF), which is managed
+   // by 'nib', is of interest to 'im' (always true without an interest manager)
+   virtual bool isEntityOfInterest(const InterestManager* const im, const INib* const nib, const base::Vec3d& geocPos) const;
+
+   // Interest management counters
+   unsigned long getNumInputFiltered() const              { return numInputFiltered; }     // Incoming entity updates that were dropped
+   unsigned long getNumProxiesFiltered() const            { return numProxiesFiltered; }   // Incoming entities without proxy players
+   unsigned long getNumOutputFiltered() const             { return numOutputFiltered; }    // Outgoing player frames whose entity state updates were suppressed
+
    // Network initialization
    bool isNetworkInitialized() const                      { return netInit; }
    bool didInitializationFail() const                     { return netInitFail; }
@@ -251,6 +305,20 @@ protected:
    virtual bool setFederateName(const std::string&);          // Sets our federate name
    virtual bool setFederationName(const std::string&);        // Sets our federation name
 
+   // Interest management: true if an entity of type 'kind' and 'domain' at 'geocPos' (ECEF)
+   // is of interest to 'im', using our ownship's position
+   bool isEntityOfInterest(const InterestManager* const im, const base::Vec3d& geocPos, const unsigned char kind, const unsigned char domain) const;
+
+   // Interest management: counts a dropped update from an incoming entity, which is identified
+   // by a network specific key, and counts the entity once as a proxy that was filtered.
+   void inputEntityFiltered(const std::uint64_t entityKey);
+
+   // Interest management: the incoming entity, 'entityKey', is of interest (again)
+   void inputEntityAccepted(const std::uint64_t entityKey);
+
+   // Interest management: the incoming entity, 'entityKey', has been deleted from the network
+   void inputEntityRemoved(const std::uint64_t entityKey);
+
    bool shutdownNotification() override;
 
 //------------------------------------------------------------------------------
@@ -278,9 +346,6 @@ public:
    virtual bool addNib2InputList(INib* const);
 
 protected:
-   // Maximum number of active objects
-   static const int MAX_OBJECTS{MIXR_CONFIG_MAX_NETIO_ENTITIES};
-
    // Create NIB unique to protocol (pure functions!)
    virtual INib* nibFactory(const INetIO::IoType ioType) =0;
 
@@ -290,17 +355,17 @@ protected:
 
    // Number of NIBs on the input list
    unsigned int getInputListSize() const {
-      return nInNibs;
+      return inputList.size();
    }
 
    // Returns the idx'th NIB from the input list
    INib* getInputNib(const int idx) {
-      return (idx < nInNibs) ? inputList[idx] : 0;
+      return (idx >= 0) ? inputList.get(idx) : 0;
    }
 
    // Returns the idx'th NIB from the input list (const version)
    const INib* getInputNib(const int idx) const  {
-      return (idx < nInNibs) ? inputList[idx] : 0;
+      return (idx >= 0) ? inputList.get(idx) : 0;
    }
 
    // Returns the input list
@@ -310,7 +375,7 @@ protected:
 
    // Number of NIBs on the output list
    unsigned int getOutputListSize() const {
-      return nOutNibs;
+      return outputList.size();
    }
 
    // Returns the input list
@@ -320,12 +385,12 @@ protected:
 
    // Returns the idx'th NIB from the output list
    INib* getOutputNib(const int idx) {
-      return (idx < nOutNibs) ? outputList[idx] : 0;
+      return (idx >= 0) ? outputList.get(idx) : 0;
    }
 
    // Returns the idx'th NIB from the output list (const version)
    const INib* getOutputNib(const int idx) const {
-      return (idx < nOutNibs) ? outputList[idx] : 0;
+      return (idx >= 0) ? outputList.get(idx) : 0;
    }
 
 
@@ -374,6 +439,7 @@ protected:
 private:
    void updateOutputList();                             // Update the Output-List from the simulation player list (Background thread)
    void cleanupInputList();                             // Clean-up the Input-List (remove out of date items)
+   void deadReckonInputList();                          // Dead reckon the Input-List's next DR step (batched)
 
    // Network Model IDs
    unsigned short netID{1};                             // Network ID
@@ -403,26 +469,20 @@ private:
    double maxOrientationErr{};  // Maximum orientation error        (radians)
    double maxAge{};             // Maximum age of networked players (seconds)
 
+   // Interest management
+   base::safe_ptr<const InterestManager> inputInterest;    // Interest filter for incoming entities
+   base::safe_ptr<const InterestManager> outputInterest;   // Interest filter for outgoing players
+   std::unordered_map<std::uint64_t, double> filteredEntities; // Exec times (sec) of the last dropped updates of the incoming entities that are being filtered, by key
+   unsigned long numInputFiltered{};                       // Incoming entity updates that were dropped
+   unsigned long numProxiesFiltered{};                     // Incoming entities without proxy players
+   unsigned long numOutputFiltered{};                      // Outgoing player frames whose entity state updates were suppressed
+
 private: // Nib related private
-   // input tables
-   std::array<INib*, MAX_OBJECTS> inputList{};  // Table of input objects in name order
-   int nInNibs{};                               // Number of input objects in both tables
-
-   // output tables
-   std::array<INib*, MAX_OBJECTS> outputList{}; // Table of output objects in name order
-   int nOutNibs{};                              // Number of output objects in both tables
-
-   // NIB quick lookup key
-   struct NibKey {
-      NibKey(const unsigned short playerId, const std::string& federateName): id(playerId), fName(federateName) {}
-      // NIB IDs  -- Comparisons in this order --
-      unsigned short id{};     // Player id
-      std::string fName;       // Federate name
-   };
-
-   // Search callbacks: object name compare function --
-   //   True types are (const NibKey* key, const Nib** nib)
-   static int compareKey2Nib(const void* key, const void* nib);
+   NibTable inputList;     // Table of input objects (indexed by player ID and federate name)
+   NibTable outputList;    // Table of output objects (indexed by player ID and federate name)
+   DeadReckoningBatch drBatch;   // Dead reckoning of the output objects
+   DeadReckoningBatch inputDrBatch;  // Dead reckoning of the input objects
+   std::vector<unsigned int> inputDrSteps;  // DR step numbers of the input objects' results
 
 private:  // Ntm related private
    static const int MAX_ENTITY_TYPES{MIXR_CONFIG_MAX_NETIO_ENTITY_TYPES};
@@ -455,6 +515,8 @@ private:
    bool setSlotTimeline(const base::Identifier* const);                // Sets the source of the time ( UTC or EXEC )
    bool setSlotInputEntityTypes(base::PairStream* const);              // Sets the table of input entity to player mapper objects
    bool setSlotOutputEntityTypes(base::PairStream* const);             // Sets the table of output entity to player mapper objects
+   bool setSlotInputInterest(const InterestManager* const);            // Sets the interest filter for incoming entities
+   bool setSlotOutputInterest(const InterestManager* const);           // Sets the interest filter for outgoing players
 };
 
 }
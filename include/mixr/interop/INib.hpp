@@ -43,6 +43,7 @@ namespace interop {
 class INib : public simulation::INib
 {
    DECLARE_SUBCLASS(INib, simulation::INib)
+   friend class DeadReckoningBatch;
 
 public:
    // Standard (mil-std-1278.1) Dead_Reckoning Model codes [ 0 .. 9 ]
@@ -130,6 +131,25 @@ public:
          const double time = 0         // Initial time (seconds) (default: zero)
       );
 
+   // Sets the DR position and angles @ DR time 'dT', which were computed outside
+   // of the NIB (e.g., by a DeadReckoningBatch).  The results are used once: by
+   // the next check for a player state update, isPlayerStateUpdateRequired(), of
+   // a local player's (output) NIB, or by the next updateDeadReckoning() of a
+   // proxy player's (input) NIB, if they're for its next DR step, 'step' (see
+   // getNextDrStep()) and the step's delta time hasn't changed.
+   void setDrResult(const double dT, const base::Vec3d& pos, const base::Vec3d& angles, const unsigned int step = 0);
+
+   // The (input) NIB's next DR step: returns its DR time, which is the current DR
+   // time plus the last delta time of updateDeadReckoning() (sec), and sets 'step'
+   // to its step number
+   double getNextDrStep(unsigned int* const step) const;
+
+   // True if the next isPlayerStateUpdateRequired() of this (local player's) NIB
+   // will check its dead reckoning errors; false if it won't dead reckon at all,
+   // e.g., because a mode change, a DR timeout (heartbeat) or an appearance change
+   // requires an update first, or the NIB is frozen.
+   bool isDeadReckoningCheckRequired() const;
+
    // Checked flags
    bool isChecked() const                             { return checked; }
    void setCheckedFlag(const bool flg)                { checked = flg; }
@@ -232,6 +252,10 @@ protected:
    bool shutdownNotification() override;
 
 private:
+   // Checks 3-a to 3-c of isPlayerStateUpdateRequired(): true if the local player
+   // requires an update before (and without) checking the dead reckoning errors
+   bool isLocalStateUpdateRequired(const models::IPlayer* const player, const double drTime) const;
+
    // compute the rotational matrix R0
    static bool drComputeMatrixR0(
          const base::Vec3d& RPY,      // [radians]
@@ -317,9 +341,19 @@ private:
 
    // Current DR values (incoming only)
    double drTime {};                   // DR time (sec)
+   double drStep {};                   // Last delta time of updateDeadReckoning() (sec)
+   unsigned int drStepNum {};          // Number of updateDeadReckoning() steps
    base::Vec3d drPos;                  // Current DR position vector (meters) (ECEF)
    base::Vec3d drAngles;               // Current DR angles (rad) [ roll pitch yaw ] (Body/ECEF)
 
+   // DR results from setDrResult(); used once
+   bool drResultValid {};              // Results are valid
+   double drResultTime {};             // DR time of the results (sec)
+   unsigned int drResultStep {};       // DR step number of the results (incoming only)
+   base::Vec3d drResultPos;            // DR position vector (meters) (ECEF)
+   base::Vec3d drResultAngles;         // DR angles (rad) [ roll pitch yaw ] (Body/ECEF)
+   mutable long drResultLock {};       // Semaphore to protect the DR results (set by the network thread)
+
    // DR smoothing data
    base::Vec3d smoothVel;              // Smoothing Velocity (meters/second) (ECEF)
    double smoothTime {};               // Smoothing Time
@@ -0,0 +1,117 @@
+
+#ifndef __mixr_interop_common_InterestManager_HPP__
+#define __mixr_interop_common_InterestManager_HPP__
+
+#include "mixr/base/IObject.hpp"
+#include "mixr/base/osg/Vec3d"
+
+#include <array>
+#include <vector>
+
+namespace mixr {
+namespace base { class IList; class ILength; class PairStream; }
+namespace interop {
+
+//------------------------------------------------------------------------------
+// Class: InterestManager
+// Description: Interest management (relevance filter) for the entities of an
+//              interoperability network.
+//
+//    An entity is of interest when its entity kind and domain are accepted by
+//    the 'entityKinds' and 'entityDomains' filters, and when it's either within
+//    'range' of the ownship or inside one of the 'areas' polygons.  Without a
+//    range or any areas, all entities of the accepted kinds and domains are of
+//    interest.
+//
+//    INetIO uses these filters for its incoming entities ('inputInterest' slot),
+//    which drops updates from the entities that are not of interest before
+//    their NIBs and proxy players are created, and its outgoing players
+//    ('outputInterest' slot), which suppresses their entity state updates.
+//
+// Factory name: InterestManager
+// Slots:
+//    range          <base::ILength>     ! Radius of interest around the ownship, or zero for none (default: 0)
+//    areas          <base::PairStream>  ! Areas of interest; polygons of base::IList [ lat1 lon1 lat2 lon2 ... ]
+//                                       !   (degrees) with at least three points (default: none)
+//    entityKinds    <base::IList>       ! Entity kinds of interest [ 0 .. 254 ] (default: all)
+//    entityDomains  <base::IList>       ! Entity domains of interest [ 0 .. 254 ] (default: all)
+//
+// Example:
+//
+//    inputInterest: ( InterestManager
+//       range: ( NauticalMiles 100 )
+//       areas: { [ 34.0 -118.5  35.5 -118.5  35.5 -116.0  34.0 -116.0 ] }
+//       entityKinds: [ 1 2 ]          // platforms and munitions
+//    )
+//
+// Notes:
+//    1) The entity kind and domain are the DIS (or RPR-FOM) entity type codes;
+//       ANY (255) is used when they're not known, and is always accepted.
+//    2) The areas are tested in latitude and longitude, so they should not
+//       cross the 180 degree meridian or include a pole.
+//    3) Without an ownship, the 'range' test is ignored.
+//------------------------------------------------------------------------------
+class InterestManager : public base::IObject
+{
+   DECLARE_SUBCLASS(InterestManager, base::IObject)
+
+public:
+   static const unsigned char ANY{255};   // Unknown entity kind or domain
+
+public:
+   InterestManager();
+
+   double getRange() const                   { return range; }         // Radius of interest (meters)
+   unsigned int getNumAreas() const          { return static_cast<unsigned int>(areas.size()); }
+
+   // True if the entity type, 'kind' and 'domain', is of interest
+   bool isEntityTypeOfInterest(const unsigned char kind, const unsigned char domain) const;
+
+   // True if the geocentric (ECEF) position, 'pos', is of interest, given the
+   // ownship's position, 'ownPos' (or nullptr)
+   bool isPositionOfInterest(const base::Vec3d& pos, const base::Vec3d* const ownPos) const;
+
+   // True if the entity of this type at this position is of interest
+   virtual bool isOfInterest(
+         const base::Vec3d& pos,          // Entity's position (meters) (ECEF)
+         const unsigned char kind,        // Entity kind (or ANY)
+         const unsigned char domain,      // Entity domain (or ANY)
+         const base::Vec3d* const ownPos  // Ownship's position (meters) (ECEF), or nullptr
+      ) const;
+
+   // True if the point is inside one of the areas
+   bool isInsideArea(const double lat, const double lon) const;
+
+   virtual bool setRange(const double meters);
+
+protected:
+   // slot table helper methods
+   bool setSlotRange(const base::ILength* const);
+   bool setSlotAreas(const base::PairStream* const);
+   bool setSlotEntityKinds(const base::IList* const);
+   bool setSlotEntityDomains(const base::IList* const);
+
+private:
+   struct Area {
+      std::vector<double> lat, lon;          // Polygon (degrees)
+      double minLat{}, maxLat{};             // Bounding box (degrees)
+      double minLon{}, maxLon{};
+   };
+
+   static bool isInside(const Area& area, const double lat, const double lon);
+   static bool setTypeFilter(const base::IList* const, std::array<bool, 256>* const, bool* const, const char* const);
+
+   double range{};                  // Radius of interest (meters)
+   double range2{};                 // Radius of interest squared (meters^2)
+   std::vector<Area> areas;         // Areas of interest
+
+   std::array<bool, 256> kinds{};   // Entity kinds of interest
+   bool anyKind{true};              // All kinds are of interest
+   std::array<bool, 256> domains{}; // Entity domains of interest
+   bool anyDomain{true};            // All domains are of interest
+};
+
+}
+}
+
+#endif
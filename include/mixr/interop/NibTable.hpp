@@ -0,0 +1,82 @@
+
+#ifndef __mixr_interop_common_NibTable_HPP__
+#define __mixr_interop_common_NibTable_HPP__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace interop {
+class INib;
+
+//------------------------------------------------------------------------------
+// Class: NibTable
+// Description: Table of Network Interface Blocks (NIBs) that are indexed by
+//              their player ID and federate name.
+//
+//    The NIBs are kept in a dense array, which can be accessed by index, and
+//    are found using an open-addressing hash table that's keyed by the player
+//    ID and an interned ID of the federate name.  Finding, adding and removing
+//    a NIB are all O(1); a removed NIB is replaced by the last NIB in the array,
+//    so the array is not in any particular order.
+//
+//    The table does not ref() or unref() the NIBs.
+//
+//    The NIB's player ID and federate name must not change while it's in the table.
+//------------------------------------------------------------------------------
+class NibTable
+{
+public:
+   NibTable() = default;
+   NibTable(const NibTable&) = delete;
+   NibTable& operator=(const NibTable&) = delete;
+
+   unsigned int size() const                   { return static_cast<unsigned int>(nibs.size()); }
+   INib* get(const unsigned int idx) const     { return (idx < nibs.size()) ? nibs[idx] : nullptr; }
+   INib** data()                               { return nibs.data(); }
+
+   // Finds the NIB by player ID and federate name
+   INib* find(const unsigned short playerID, const std::string& federateName) const;
+
+   // Adds a NIB; returns false if a NIB with the same IDs is already in the table
+   bool add(INib* const nib);
+
+   // Removes a NIB (found by its IDs); returns false if it's not in the table
+   bool remove(const INib* const nib);
+
+   // Removes the idx'th NIB; the last NIB is moved to 'idx'
+   void removeAt(const unsigned int idx);
+
+   // Removes all NIBs
+   void clear();
+
+   // Hash of a key: the federate name ID (upper bits) and the player ID (lower 16 bits)
+   static std::uint32_t hash(const std::uint64_t key);
+
+private:
+   static const std::uint32_t EMPTY{0xffffffff};   // Empty hash slot
+
+   struct Slot {
+      std::uint64_t key{};          // Player ID and federate name ID
+      std::uint32_t idx{EMPTY};     // Index of the NIB in 'nibs'
+   };
+
+   std::uint64_t makeKey(const INib* const nib);
+   bool findKey(const unsigned short playerID, const std::string& federateName, std::uint64_t* const key) const;
+   std::uint32_t findSlot(const std::uint64_t key) const;
+   void insertSlot(const std::uint64_t key, const std::uint32_t idx);
+   void eraseSlot(std::uint32_t slot);
+   void grow();
+
+   std::vector<INib*> nibs;                                  // NIBs
+   std::vector<std::uint64_t> keys;                          // Key of each NIB
+   std::vector<Slot> slots;                                  // Hash table (power of two size)
+   std::unordered_map<std::string, std::uint32_t> fedIDs;    // Interned federate name IDs
+};
+
+}
+}
+
+#endif
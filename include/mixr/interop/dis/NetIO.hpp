@@ -7,7 +7,7 @@
 #include <array>
 
 namespace mixr {
-namespace base { class IAngle; class Integer; class ILength; class PairStream; class INetHandler; class Identifier; }
+namespace base { class IAngle; class Boolean; class Integer; class ILength; class PairStream; class INetHandler; class Identifier; }
 namespace models { class Iff; class IRfSensor; class IPlayer; }
 namespace interop { class INib; }
 namespace dis {
@@ -26,6 +26,7 @@ struct TrackJamTargets;
 struct DetonationPDU;
 struct ElectromagneticEmissionPDU;
 struct EntityStatePDU;
+struct EntityStatePduView;
 struct FirePDU;
 struct SignalPDU;
 struct TransmitterPDU;
@@ -61,6 +62,9 @@ struct ActionResponsePDU_R;
 //    applicationID  <base::Integer>         ! Application Identification (default: 1)
 //    exerciseID     <base::Integer>         ! Exercise Identification (default: 1)
 //
+//    bundleOutput   <base::Boolean>         ! Bundle the output PDUs into datagrams (default: false) (see note #8)
+//    maxDatagramSize <base::Integer>        ! Max size of the bundled datagrams (bytes) [ 1 .. 1536 ] (default: 1400)
+//
 //    maxTimeDR   <base::ITime>              ! Max DR time (default: 5 seconds)
 //                <base::PairStream>         ! List of max DR times by kinds and domains (see note #4)
 //
@@ -87,9 +91,9 @@ struct ActionResponsePDU_R;
 //       using makeFederationName().  (e.g., exercise = 13 gives the federation name "E13")
 //
 //    3) findDisNib() searches the same input and output lists that are maintained by
-//       NetIO, which are in order of player ID and the federate name.  Since our DIS
+//       NetIO, which are indexed by player ID and the federate name.  Since our DIS
 //       federate names are generated by site and app IDs, the lists are seen by DIS as
-//       being order by player ID, site ID and app ID.
+//       being indexed by player ID, site ID and app ID.
 //
 //    4) For the slots maxTimeDR, maxPositionError, maxOrientationError, maxAge and
 //       maxEntityRange, if the slot type is base::Time, base::Angle or base::Length then that
@@ -111,6 +115,36 @@ struct ActionResponsePDU_R;
 //       type id.  For incoming emission PDUs, the "emitter name" from the PDU
 //       is matched with the EmissionPduHandler's "emitterName" value.
 //
+//    7) Incoming PDUs are received in batches (see base::INetHandler::recvBatch()),
+//       into buffers that hold the largest UDP datagram (MAX_DATAGRAM_SIZE); the
+//       network handler drops any datagram that doesn't fit (it would be cut short,
+//       see base::IPosixHandler::getNumTruncated()).  The PDUs that are sent while processing the output list (see
+//       processOutputList()) are queued and then sent in batches at the end of
+//       the output frame (see base::INetHandler::sendBatch()).  Datagrams that
+//       still aren't sent after a second try are dropped and counted (see
+//       getNumOutputDropped()).
+//
+//    8) When 'bundleOutput' is true, the PDUs that are queued while processing the
+//       output list (see note #7) are packed into datagrams of up to 'maxDatagramSize'
+//       bytes, with each PDU starting on a 64-bit boundary (zero padded).  Incoming
+//       datagrams are always split into their PDUs using the PDU header's length,
+//       so we're able to receive the bundled datagrams of other federates.
+//
+//    9) Incoming entity state PDUs for the entities that are already on the input
+//       list are passed, still in network byte order, to processEntityStateView(),
+//       which reads their fields using an EntityStatePduView and updates the Nib
+//       (see Nib::entityStateView2Nib()).  The PDUs of new entities, or with new
+//       articulation parameters, are byte swapped and then processed by
+//       processEntityStatePDU().  Derived classes that need every PDU passed to
+//       processEntityStatePDU() can override processEntityStateView() to return false.
+//
+//    10) With an 'inputInterest' filter (see interop::InterestManager), the entity
+//       state PDUs of new entities that are not of interest are dropped before their
+//       Nibs are created, and the Nibs of known entities that leave the areas of
+//       interest are removed (a deactivated entity is forgotten at once).  The
+//       entity's DIS kind and domain are used for the entity type filters of both
+//       the input and output interest managers.
+//
 //------------------------------------------------------------------------------
 class NetIO : public interop::INetIO
 {
@@ -120,6 +154,9 @@ public:
    // Max PDU buffer size
    enum { MAX_PDU_SIZE = 1536 };
 
+   // Max input datagram size: the largest UDP datagram (65507 bytes), rounded up
+   enum { MAX_DATAGRAM_SIZE = 65536 };
+
    // Standard (IST-CF-03-01, May 5, 2003) entity type "kind" codes [ 0 .. 9 ]
    enum EntityTypeKindEnum {
       KIND_OTHER, KIND_PLATFORM, KIND_MUNITION, KIND_LIFEFORM,
@@ -225,12 +262,23 @@ public:
    unsigned short getApplicationID() const                 { return appID;      }
    unsigned char getExerciseID() const                     { return exerciseID; }
 
-   // Sends a packet (PDU) to the network
+   // Output PDU bundling (see note #8)
+   bool isOutputBundlingEnabled() const                    { return bundleOutput; }
+   unsigned int getMaxDatagramSize() const                 { return maxDatagramSize; }
+
+   // Number of queued output datagrams that couldn't be sent (see note #7)
+   unsigned int getNumOutputDropped() const                { return numOutputDropped; }
+
+   // Sends a packet (PDU) to the network (queued while processing the output list)
    bool sendData(const char* const packet, const int size);
 
    // Receives a packet (PDU) from the network
    int recvData(char* const packet, const int maxSize);
 
+   // Receives up to 'n' packets (PDUs) from the network into 'buffer', where
+   // the i'th packet is at (buffer + i * maxSize); returns the number received
+   unsigned int recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n);
+
    unsigned int timeStamp();                                                  // Gets the current timestamp
    unsigned int makeTimeStamp(const double ctime, const bool absolute);       // Make a PDU time stamp
 
@@ -262,6 +310,7 @@ public:
    double getMaxPositionErr(const interop::INib* const nib) const final;
    double getMaxOrientationErr(const interop::INib* const nib) const final;
    double getMaxAge(const interop::INib* const nib) const final;
+   bool isEntityOfInterest(const interop::InterestManager* const im, const interop::INib* const nib, const base::Vec3d& geocPos) const final;
    interop::INib* createNewOutputNib(models::IPlayer* const player) final;
 
    // DIS v7 additions
@@ -278,6 +327,7 @@ public:
 
 protected:
    virtual void processEntityStatePDU(const EntityStatePDU* const);
+   virtual bool processEntityStateView(const EntityStatePduView&);   // (see note #9)
    virtual void processFirePDU(const FirePDU* const);
    virtual void processDetonationPDU(const DetonationPDU* const);
    virtual void processElectromagneticEmissionPDU(const ElectromagneticEmissionPDU* const);
@@ -305,6 +355,8 @@ protected:
    virtual bool setSiteID(const unsigned short);          // Sets the network's site ID
    virtual bool setApplicationID(const unsigned short);   // Sets the network's application ID
    virtual bool setExerciseID(const unsigned char);       // Sets the network's exercise ID
+   virtual bool setOutputBundling(const bool);            // Enables/disables output PDU bundling
+   virtual bool setMaxDatagramSize(const unsigned int);   // Sets the max size of the bundled datagrams (bytes)
 
    virtual bool slot2KD(const char* const slotname, unsigned char* const k, unsigned char* const d);
    virtual bool setMaxTimeDR(const double v, const unsigned char kind, const unsigned char domain);
@@ -322,6 +374,7 @@ protected:
    bool initNetwork() override;                                                   // Initialize the network
    void netInputHander() override;                                                // Network input handler
    void processInputList() override;                                              // Update players/systems from the Input-list
+   void processOutputList() override;                                             // Process the Output-list and send the queued PDUs
    interop::INib* nibFactory(const interop::INetIO::IoType ioType) override;      // Create a new Nib
    interop::INtmInputNode* rootNtmInputNodeFactory() const override;
    void testOutputEntityTypes(const int) final;                                   // Test quick lookup of outgoing entity types
@@ -329,6 +382,9 @@ protected:
 
 private:
     void initData();
+    void flushOutput();                            // Sends the queued output PDUs
+    void queueOutputPdu(const char* const packet, const int size);   // Queues (or bundles) an output PDU
+    PDUHeader* nextInputPdu(unsigned int* const idx, unsigned int* const offset, const unsigned int n);  // Next PDU in the input buffer
 
     base::safe_ptr<base::INetHandler> netInput;    // Input network handler
     base::safe_ptr<base::INetHandler> netOutput;   // Output network handler
@@ -339,8 +395,19 @@ private:
    unsigned short appID{1};                       // Application ID
    unsigned char exerciseID{1};                   // Exercise ID
 
-   static const unsigned int MAX_PDUs{500};               // Max PDUs in input buffer
-   unsigned int inputBuffer[MAX_PDUs][MAX_PDU_SIZE/4]{};  // Input buffer
+   static const unsigned int MAX_PDUs{500};               // Max PDUs in output buffer
+   static const unsigned int MAX_INPUT_DATAGRAMS{64};     // Max datagrams in input buffer (per batch)
+   unsigned int inputBuffer[MAX_INPUT_DATAGRAMS][MAX_DATAGRAM_SIZE/4]{};  // Input buffer
+   unsigned int inputSizes[MAX_INPUT_DATAGRAMS]{};        // Size of each input buffer datagram (bytes)
+   unsigned int inputPdu[MAX_DATAGRAM_SIZE/4]{};          // Aligned copy of a bundled input PDU
+
+   unsigned int outputBuffer[MAX_PDUs][MAX_PDU_SIZE/4]{}; // Output buffer (queued datagrams)
+   int outputSizes[MAX_PDUs]{};                           // Size of each queued datagram (bytes)
+   unsigned int numOutputDatagrams{};                     // Number of queued datagrams
+   unsigned int numOutputDropped{};                       // Number of queued datagrams that couldn't be sent
+   bool queueOutput{};                                    // Queue output PDUs (while processing the output list)
+   bool bundleOutput{};                                   // Bundle the queued output PDUs
+   unsigned int maxDatagramSize{1400};                    // Max size of the bundled datagrams (bytes)
 
    // Distance filter by entity kind/domain
    double  maxEntityRange[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS]{};     // Max range from ownship           (meters)
@@ -382,6 +449,8 @@ private:
    bool setSlotSiteID(const base::Integer* const);                    // Sets Site ID
    bool setSlotApplicationID(const base::Integer* const);             // Sets Application ID
    bool setSlotExerciseID(const base::Integer* const);                // Sets Exercise ID
+   bool setSlotBundleOutput(const base::Boolean* const);              // Sets output PDU bundling
+   bool setSlotMaxDatagramSize(const base::Integer* const);           // Sets the max bundled datagram size
 };
 
 }
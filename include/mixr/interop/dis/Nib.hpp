@@ -5,6 +5,7 @@
 #include "mixr/interop/INib.hpp"
 #include "mixr/interop/dis/NetIO.hpp"
 #include <array>
+#include <vector>
 
 namespace mixr {
 namespace dis {
@@ -37,6 +38,7 @@ public:
    // Input support functions
    virtual void updateProxyPlayer();
    virtual void entityStatePdu2Nib(const EntityStatePDU* const);
+   virtual bool entityStateView2Nib(const EntityStatePduView&);   // PDU in network byte order (see NetIO note #9)
 
    // Update check functions
    virtual bool isIffUpdateRequired(const double curExecTime, const models::Iff* const iffSystem);
@@ -74,6 +76,16 @@ public:
 protected:
    unsigned char manageArticulationParameters(EntityStatePDU* const);
    void processArticulationParameters(const EntityStatePDU* const);
+   void appearance2Nib(const unsigned int appearance);
+   void pdu2DeadReckoning(
+      const unsigned int disTimeStamp,    // PDU time stamp
+      const unsigned char drAlgorithm,    // DR algorithm
+      const base::Vec3d& geocPos,         // Geocentric position
+      const base::Vec3d& geocVel,         // Geocentric velocity
+      const base::Vec3d& geocAcc,         // Geocentric acceleration
+      const base::Vec3d& geocAngles,      // Geocentric Euler angles
+      const base::Vec3d& arates           // Angular rates
+   );
 
    bool shutdownNotification() override;
 
@@ -110,6 +122,12 @@ private:
    // 2) If time is not synchronized across the network, then it becomes the time difference + latency
    //    This allows applications to run time relative
    double timeOffset{};
+
+   // Last entity state PDU's appearance and articulation parameters (input only;
+   // see entityStateView2Nib())
+   unsigned int lastAppearance{};                 // Appearance bits
+   bool haveAppearance{};                         // Appearance has been decoded (with a proxy player)
+   std::vector<unsigned char> articulationData;   // Articulation parameters (network byte order)
 };
 
 }
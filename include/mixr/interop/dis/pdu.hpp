@@ -4,6 +4,7 @@
 //
 // PDU List
 //    7.2.2    EntityStatePDU
+//             EntityStatePduView
 //    7.2.3    CollisionPDU
 //    7.3.2    FirePDU
 //    7.3.3    DetonationPDU
@@ -168,6 +169,55 @@ struct EntityStatePDU
    };
 };
 
+//-----------------------------------------------
+// EntityStatePduView -- read-only view of an EntityStatePDU
+// that's still in network byte order; the fields are
+// byte swapped (if 'swap' is true) as they're read.
+//-----------------------------------------------
+struct EntityStatePduView
+{
+   EntityStatePduView(const EntityStatePDU* const p, const bool swapBytes) : pdu(p), swap(swapBytes) {}
+
+   const EntityStatePDU* getPdu() const            { return pdu; }
+
+   uint32_t getTimeStamp() const                   { return u32(pdu->header.timeStamp); }
+   uint16_t getEntityID() const                    { return u16(pdu->entityID.ID); }
+   uint16_t getSiteID() const                      { return u16(pdu->entityID.simulationID.siteIdentification); }
+   uint16_t getApplicationID() const               { return u16(pdu->entityID.simulationID.applicationIdentification); }
+   uint8_t getDeadReckoningAlgorithm() const       { return pdu->deadReckoningAlgorithm; }
+   uint32_t getAppearance() const                  { return u32(pdu->appearance); }
+
+   // Geocentric position, velocity and acceleration; i: [ 0 .. 2 ]
+   double getLocation(const unsigned int i) const
+   {
+      const double v{(i == 0 ? pdu->entityLocation.X_coord : (i == 1 ? pdu->entityLocation.Y_coord : pdu->entityLocation.Z_coord))};
+      return (swap ? convertDouble(v) : v);
+   }
+   float getLinearVelocity(const unsigned int i) const      { return f32(pdu->entityLinearVelocity.component[i]); }
+   float getLinearAcceleration(const unsigned int i) const  { return f32(pdu->DRentityLinearAcceleration.component[i]); }
+
+   // Orientation and angular velocity
+   float getPhi() const                            { return f32(pdu->entityOrientation.phi); }
+   float getTheta() const                          { return f32(pdu->entityOrientation.theta); }
+   float getPsi() const                            { return f32(pdu->entityOrientation.psi); }
+   float getAngularVelocityX() const               { return f32(pdu->DRentityAngularVelocity.x_axis); }
+   float getAngularVelocityY() const               { return f32(pdu->DRentityAngularVelocity.y_axis); }
+   float getAngularVelocityZ() const               { return f32(pdu->DRentityAngularVelocity.z_axis); }
+
+   // Articulation parameters (still in network byte order)
+   uint8_t getNumberOfArticulationParameters() const { return pdu->numberOfArticulationParameters; }
+   const uint8_t* getArticulationData() const      { return reinterpret_cast<const uint8_t*>(pdu) + sizeof(EntityStatePDU); }
+   unsigned int getArticulationDataSize() const    { return pdu->numberOfArticulationParameters * sizeof(VpArticulatedPart); }
+
+private:
+   uint16_t u16(const uint16_t v) const            { return (swap ? convertUInt16(v) : v); }
+   uint32_t u32(const uint32_t v) const            { return (swap ? convertUInt32(v) : v); }
+   float f32(const float v) const                  { return (swap ? convertFloat(v) : v); }
+
+   const EntityStatePDU* pdu{};     // PDU (network byte order)
+   bool swap{};                     // Swap the bytes as they're read
+};
+
 
 //-----------------------------------------------
 // CollisionPDU (480 bits)
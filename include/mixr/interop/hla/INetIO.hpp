@@ -7,6 +7,7 @@
 #include "mixr/base/safe_ptr.hpp"
 
 #include <array>
+#include <vector>
 
 #include <RTI.hh>
 #include <fedtime.hh>
@@ -224,13 +225,13 @@ private:
    // Quick lookup tables
    // ---
    // input tables
-   std::array<INib*, MAX_OBJECTS> inNameTbl{};    // Table of input objects in name order
-   std::array<INib*, MAX_OBJECTS> inHandleTbl{};  // Table of input objects in handle order
+   std::vector<INib*> inNameTbl;                 // Table of input objects in name order
+   std::vector<INib*> inHandleTbl;               // Table of input objects in handle order
    unsigned int nInObjects{};                    // Number of input objects in both tables
 
    // output tables
-   std::array<INib*, MAX_OBJECTS> outNameTbl{};    // Table of output objects in name order
-   std::array<INib*, MAX_OBJECTS> outHandleTbl{};  // Table of output objects in handle order
+   std::vector<INib*> outNameTbl;                 // Table of output objects in name order
+   std::vector<INib*> outHandleTbl;               // Table of output objects in handle order
    unsigned int nOutObjects{};                    // Number of output objects in both tables
 
    // Support functions
@@ -4,11 +4,15 @@
 
 #include "mixr/simulation/ISimulation.hpp"
 
+#include <vector>
+
 namespace mixr {
-namespace base { class Boolean; class Identifier; class Latitude; class ILength; class Longitude; class INumber; }
+namespace base { class Boolean; class Identifier; class Latitude; class ILength; class Longitude; class INumber; class Vec3d; }
 namespace terrain { class ITerrain; }
 namespace models {
 class IAtmosphere;
+class IPlayer;
+class SpatialIndex;
 
 //------------------------------------------------------------------------------
 // Class: IWorldModel
@@ -42,6 +46,9 @@ class IAtmosphere;
 //    terrain        <terrain:ITerrain>       ! Terrain elevation database (default: nullptr)
 //    atmosphere     <IAtmosphere>            ! Atmosphere
 //
+//    spatialIndexCellSize <base::ILength>    ! Cell size of the players-of-interest spatial index,
+//                                            ! or zero to disable the index (default: 10 km)
+//
 
 // Gaming area reference point:
 //
@@ -67,11 +74,37 @@ class IAtmosphere;
 //                   Vecef = Vned * M;
 //
 //
+// Players of interest:
+//
+//    Once per time-critical frame, after the players have been updated, the player
+//    list is bucketed into a geocentric grid (see SpatialIndex), so that sensors,
+//    weapons and other systems can find their "players of interest" without walking
+//    the complete player list.  The new index replaces the old one (an immutable
+//    snapshot) under the safe_ptr's lock, so readers are never blocked.  After the
+//    player list membership changes, and until the next time-critical frame, the
+//    queries for the new list scan the player array.
+//
+//       SpatialIndex* getSpatialIndex()
+//          Returns the current spatial index (pre-ref()'d), or zero if disabled.
+//
+//       unsigned int getPlayersOfInterest(players, pos, range, list)
+//          Appends to 'list', in player list order, the players on 'players' that
+//          could be within 'range' meters of the geocentric position 'pos' (all
+//          players when 'range' is zero).  This uses the spatial index when it was
+//          built from 'players'; otherwise, the player list is scanned.
+//
 // Environments:
 //
 //    Current simulation environments include terrain elevation posts, getTerrain(),
 //    and atmosphere model, getAtmosphere().
 //
+//    Each background frame, before the players are updated, the terrain
+//    elevations of all of the active players that use the terrain database
+//    (i.e., their terrain elevation isn't from the IG system) are found with
+//    one ITerrain::getElevationsBatch() call (one for each interpolation mode),
+//    see updateBgBatch().  The players pick them up in their (virtual)
+//    IPlayer::updateElevation().
+//
 // Shutdown:
 //
 //    At shutdown, the parent object must send a SHUTDOWN_EVENT event to
@@ -103,6 +136,15 @@ public:
 
     bool isGamingAreaUsingEarthModel() const;      // Gaming area using the earth model?
 
+    // players of interest
+    SpatialIndex* getSpatialIndex();                       // Returns the players-of-interest spatial index; pre-ref()'d
+    const SpatialIndex* getSpatialIndex() const;           // Returns the players-of-interest spatial index; pre-ref()'d (const version)
+    double getSpatialIndexCellSize() const;                // Spatial index cell size (meters), or zero if disabled
+    unsigned int getPlayersOfInterest(                     // Finds the players that could be within range of a geocentric position
+       base::PairStream* const players,
+       const base::Vec3d& pos,
+       const double range,
+       std::vector<IPlayer*>& list) const;
 
 
     // environmental interface
@@ -110,9 +152,15 @@ public:
     IAtmosphere* getAtmosphere();                          // returns the atmosphere model
     const IAtmosphere* getAtmosphere() const;              // returns the atmosphere model (const version)
 
+    void updateTC(const double dt = 0.0) override;
+    void updateData(const double dt = 0.0) override;
     void reset() override;
 
 protected:
+    virtual bool setSpatialIndexCellSize(const double); // Sets the spatial index cell size (meters), or zero to disable
+    virtual void updateSpatialIndex();                   // Rebuilds the players-of-interest spatial index
+    void updateBgBatch(simulation::PlayerArray* const players, const double dt) override;
+
     virtual bool setEarthModel(const base::EarthModel* const msg); // Sets our earth model
     virtual bool setGamingAreaUseEarthModel(const bool flg);
 
@@ -145,6 +193,19 @@ private:
    IAtmosphere* atmosphere {};
    terrain::ITerrain* terrain {};
 
+   // players of interest
+   static constexpr double DEFAULT_SPATIAL_INDEX_CELL_SIZE{10000.0};
+   base::safe_ptr<SpatialIndex> spatialIndex;                     // Current spatial index
+   double spatialIndexCellSize {DEFAULT_SPATIAL_INDEX_CELL_SIZE}; // Spatial index cell size (meters); zero if disabled
+   double tcFrameTime {};                                         // Last time-critical frame time (seconds)
+
+   // terrain elevation batch (see updateBgBatch())
+   // (one list for each interpolation mode)
+   std::vector<IPlayer*> elevPlayers[2];       // Players
+   std::vector<double> elevLats[2];            // Player latitudes (degs)
+   std::vector<double> elevLons[2];            // Player longitudes (degs)
+   std::vector<double> elevations;             // Terrain elevations (meters)
+
 private:
    // slot table helper methods
    bool setSlotRefLatitude(const base::Latitude* const);
@@ -160,6 +221,8 @@ private:
    // environmental interface
    bool setSlotTerrain(terrain::ITerrain* const);
    bool setSlotAtmosphere(IAtmosphere* const);
+
+   bool setSlotSpatialIndexCellSize(const base::ILength* const);
 };
 
 }
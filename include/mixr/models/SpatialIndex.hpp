@@ -0,0 +1,111 @@
+
+#ifndef __mixr_models_common_SpatialIndex_HPP__
+#define __mixr_models_common_SpatialIndex_HPP__
+
+#include "mixr/base/IObject.hpp"
+#include "mixr/base/safe_ptr.hpp"
+#include "mixr/base/osg/Vec3d"
+
+#include <cstdint>
+#include <vector>
+
+namespace mixr {
+namespace base { class PairStream; }
+namespace models {
+class IPlayer;
+
+//------------------------------------------------------------------------------
+// Class: SpatialIndex
+// Description: Concrete class, an immutable snapshot of the player list that is
+//              bucketed into a uniform grid of geocentric (ECEF) cells, which is
+//              used to find the "players of interest" near a position without
+//              walking the complete player list.
+//
+// Factory name: SpatialIndex
+//
+// Usage:
+//
+//    The index is built by the world model (see IWorldModel) once per time-critical
+//    frame, from the current player list.  The index holds a reference to that player list, so all of the
+//    player pointers that it returns remain valid for as long as the index is
+//    ref()'d.
+//
+//    Queries return candidate players, in player list order (i.e., local players
+//    first, sorted by player ID, then the proxy players), and the candidate lists
+//    are 'loose' -- they include all players that could be within the query volume,
+//    allowing for player motion since the index was built and for the differences
+//    between ECEF and gaming area ranges, plus some players that are not.  Callers
+//    are expected to apply their own exact range, angle and type checks.
+//
+//    findPlayersInRange() -- players within 'range' meters of a geocentric
+//       position; a range of zero (or less) returns all players.
+//
+//    findPlayersInCone() -- players within 'range' meters of a geocentric
+//       position and within 'angle' radians of the (unit) direction vector;
+//       an angle of zero (or pi or more) is the same as findPlayersInRange().
+//
+//    Both queries are thread-safe; the index is never changed after it's built.
+//
+//------------------------------------------------------------------------------
+class SpatialIndex final : public base::IObject
+{
+   DECLARE_SUBCLASS(SpatialIndex, base::IObject)
+
+public:
+   SpatialIndex() = delete;
+   SpatialIndex(
+      base::PairStream* const players,    // Player list (base::PairStream of IPlayer)
+      const double cellSize,              // Grid cell size (meters)
+      const double maxAge                 // Max time (seconds) that the index is used before it's rebuilt
+   );
+
+   // The player list that this index was built from
+   const base::PairStream* getPlayers() const    { return players; }
+
+   // Number of players in the index
+   unsigned int getNumberOfPlayers() const       { return static_cast<unsigned int>(plist.size()); }
+
+   // Grid cell size (meters)
+   double getCellSize() const                    { return cellSize; }
+
+   // Max distance (meters) that any player could move before the index is rebuilt
+   double getMargin() const                      { return margin; }
+
+   // Finds the candidate players within 'range' meters of the geocentric position 'pos'
+   // and appends them, in player list order, to 'list'.  Returns the number of players found.
+   unsigned int findPlayersInRange(const base::Vec3d& pos, const double range, std::vector<IPlayer*>& list) const;
+
+   // Finds the candidate players within 'range' meters of the geocentric position 'pos' that are also
+   // within 'angle' radians of the unit vector 'dir', and appends them, in player list order, to 'list'.
+   // Returns the number of players found.
+   unsigned int findPlayersInCone(const base::Vec3d& pos, const base::Vec3d& dir, const double range,
+                                  const double angle, std::vector<IPlayer*>& list) const;
+
+private:
+   // Loose range factor; covers the differences between ECEF and gaming area (NED) ranges
+   static constexpr double RANGE_FACTOR{1.1};
+
+   // Max number of cells that we'll visit before we just scan all players
+   static constexpr unsigned int MAX_CELLS_PER_QUERY{4096};
+
+   std::uint64_t cellKey(const int ix, const int iy, const int iz) const;
+   int cellIndex(const double v) const;
+   unsigned int findCandidates(const base::Vec3d& pos, const double range, std::vector<unsigned int>& idx) const;
+   unsigned int copyPlayers(std::vector<unsigned int>& idx, std::vector<IPlayer*>& list) const;
+
+   base::safe_ptr<base::PairStream> players;    // Player list that we were built from
+   double cellSize{};                           // Grid cell size (meters)
+   double margin{};                             // Motion margin (meters)
+
+   std::vector<IPlayer*> plist;                 // Players, in player list order
+   std::vector<base::Vec3d> ppos;               // Player geocentric positions at build time (meters)
+
+   std::vector<std::uint64_t> cells;            // Occupied cell keys (sorted)
+   std::vector<unsigned int> cellStart;         // Index into 'cellPlayers' of each cell's first player (plus end marker)
+   std::vector<unsigned int> cellPlayers;       // Player indices, grouped by cell
+};
+
+}
+}
+
+#endif
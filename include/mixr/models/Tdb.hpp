@@ -4,6 +4,8 @@
 
 #include "mixr/base/IObject.hpp"
 
+#include <cstddef>
+
 namespace mixr {
 namespace base { class PairStream; class Vec3d; }
 namespace models {
@@ -48,6 +50,19 @@ class IPlayer;
 //       must be completed before the LOS vectors, ranges, angles, etc. are
 //       computed and used).
 //
+//       The gimbal rotation and boresight errors are computed using the
+//       vectorized array kernels (see base/util/simd_utils.hpp).
+//
+// Target data arrays:
+//
+//       The target data is a structure-of-arrays (one array per item; e.g.,
+//       ranges, LOS vectors, boresight errors and gains) that is allocated as a
+//       single 64-byte aligned block, with each array starting on a 64-byte
+//       boundary.  The block is grown as needed, so the only limit on the number
+//       of targets is the gimbal's max players of interest, and it's kept when
+//       the TDB is reused (see setMaxTargets() and IGimbal), so the steady state
+//       is one allocation per gimbal.
+//
 // Gimbal coordinates:
 //       X+ is along the gimbal/sensor boresight
 //       Y+ is to the right of the gimbal boresight
@@ -62,6 +77,16 @@ public:
    Tdb() = delete;
    Tdb(const unsigned int maxTargets, const IGimbal* const gimbal);
 
+   // Clears the targets and sets the max number of targets; the target data
+   // arrays are kept for reuse
+   bool setMaxTargets(const unsigned int n)           { return resizeArrays(n); }
+
+   // Max number of targets
+   unsigned int getMaxTargets() const                 { return maxTargets; }
+
+   // Number of targets that the target data arrays can currently hold
+   unsigned int getCapacity() const                   { return capacity; }
+
    //------------------------------------------------------------------------------
    // Process players-of-interest --- Scan the provided player list generates a
    // filtered list of target players.
@@ -123,6 +148,11 @@ public:
    // Compute elevation off boresight (radians)
    const double* getBoresightElevationErrors() const        { return aelr; }
 
+   // The array of antenna gains toward the targets (no qty); work space
+   // that's filled in by the gimbal's system (e.g., Antenna::rfTransmit())
+   double* getTargetGains()                                 { return gains; }
+   const double* getTargetGains() const                     { return gains; }
+
 protected:
    // Sets our Gimbal
    virtual void setGimbal(const IGimbal* const gimbal);
@@ -130,10 +160,15 @@ protected:
    // Clear the target data arrays
    virtual void clearArrays();
 
-   // Resize the target data arrays
+   // Clears the targets and sets the max number of targets; the
+   // target data arrays are freed only when the new size is zero
    // -- old data is lost
    virtual bool resizeArrays(const unsigned int newSize);
 
+   // Grows the target data arrays to hold at least 'n' targets
+   // -- the current targets' data is kept
+   bool reserveArrays(const unsigned int n);
+
    const IPlayer* ownship {};    // Our ownship player (set using setGimbal())
    const IGimbal* gimbal {};     // Our gimbal (set in setGimbal())
 
@@ -142,7 +177,7 @@ protected:
                                  //   local gaming area position is not valid
 
    IPlayer**    targets {};      // Target pointer
-   unsigned int maxTargets {};   // Max number of targets (i.e., size of the arrays)
+   unsigned int maxTargets {};   // Max number of targets
    unsigned int numTgts {};      // Number of targets
 
    base::Vec3d* losG {};         // Normalized LOS vector (gimbal to target) in Gimbal coord
@@ -154,6 +189,7 @@ protected:
    double* aar {};           // Compute angle off antenna boresight (radians)
    double* aazr {};          // Compute azimuth off boresight (radians)
    double* aelr {};          // Compute elevation off boresight (radians)
+   double* gains {};         // Antenna gains toward the targets (no qty)
 
    // computeBoresightData() arrays
    double* xa {};
@@ -161,6 +197,16 @@ protected:
    double* za {};
    double* ra2 {};
    double* ra {};
+
+private:
+   static const std::size_t ALIGNMENT{64};        // Alignment of the target data arrays (bytes)
+   static const std::size_t NUM_VEC_ARRAYS{3};    // Number of base::Vec3d arrays
+   static const std::size_t NUM_DBL_ARRAYS{11};   // Number of double arrays
+
+   void freeArrays();
+
+   void* block {};               // Target data arrays (single 64-byte aligned block)
+   unsigned int capacity {};     // Size of the target data arrays
 };
 
 }
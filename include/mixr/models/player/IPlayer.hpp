@@ -687,6 +687,7 @@ public:
    virtual bool setCommandedAltitudeFt(const double);                  // Sets commanded (HAE) altitude (feet)
 
    virtual void setTerrainElevation(const double);                     // Sets the elevation of the terrain at this player's location (meters)
+   virtual void setBatchTerrainElevation(const double);                // Sets the terrain elevation (meters) found by our world model's batch, for updateElevation()
    virtual bool setTerrainOffset(const double);                        // Sets the ground clamping offset (meters)
    virtual bool setInterpolateTerrain(const bool);                     // sets the DTED terrain interpolation flag
    virtual bool setTerrainElevationRequired(const bool);               // Sets IG terrain elevation request flag
@@ -993,6 +994,8 @@ private:
 
    double tElev{};          // Terrain Elevation  (meters -- up+)
    bool   tElevValid{};     // Terrain elevation is valid
+   double batchElev{};      // Terrain elevation from our world model's batch (meters -- up+)
+   bool   batchElevValid{}; // Batch terrain elevation is valid (until the next updateElevation())
    bool   tElevReq{};       // Height-Of-Terrain is required from the IG system (default: terrain height isn't required)
    bool   interpTrrn{};     // interpolate between terrain elevation posts (local terrain database only)
    double tOffset{};        // Offset from the terrain to the player's CG for ground clamping
@@ -4,10 +4,10 @@
 
 #include "mixr/models/system/IScanGimbal.hpp"
 
-#include "mixr/base/safe_queue.hpp"
-#include "mixr/base/safe_stack.hpp"
 #include "mixr/base/util/constants.hpp"
 
+#include <vector>
+
 namespace mixr {
 namespace base { class IAngle; class Boolean; class IFunction; class Identifier; class INumber; class IPower; }
 namespace models {
@@ -50,6 +50,16 @@ class IRfSystem;
 //       system will try to reuse Emission objects, which removes the overhead
 //       of creating and deleting them.
 //
+//       The antenna keeps a pool of up to getMaxEmissions() emissions, which is
+//       only used by our ownship's thread, so it's not locked.  An emission is
+//       free when the pool holds its only reference (i.e., all receivers have
+//       unref()'d it); the free test is a single atomic read of its reference
+//       count.  Each pool entry has a generation counter, which is incremented
+//       each time the emission is sent, and process() clears (i.e., releases the
+//       player and gimbal pointers of) the free emissions whose generation has
+//       not yet been cleared.  Use getEmissionPoolHits(), getEmissionPoolMisses()
+//       and getEmissionPoolHitRate() for the pool statistics.
+//
 //------------------------------------------------------------------------------
 class Antenna final: public IScanGimbal
 {
@@ -70,6 +80,12 @@ public:
    // System limits
    int getMaxEmissions() const                            { return MAX_EMISSIONS; }
 
+   // Emission pool statistics
+   unsigned int getEmissionPoolSize() const               { return static_cast<unsigned int>(emPool.size()); }
+   unsigned long getEmissionPoolHits() const              { return emPoolHits; }     // Emissions reused from the pool
+   unsigned long getEmissionPoolMisses() const            { return emPoolMisses; }   // Emissions that were cloned
+   double getEmissionPoolHitRate() const;                                             // Hits / (hits + misses)
+
    // Antenna polarization matching gain
    double getPolarizationGain(const Polarization) const;
    Polarization getPolarization() const                   { return polar; }
@@ -129,14 +145,22 @@ protected:
 
    bool shutdownNotification() override;
 
-   base::safe_stack<RfEmission*> freeEmStack{MAX_EMISSIONS};   // free emission stack
-   mutable long freeEmLock{};                                  // semaphore to protect 'freeEmStack'
+private:
+   static const int MAX_EMISSIONS{10000};       // max size of the emission pool
+   static const int MAX_POOL_PROBES{8};         // max pool entries checked for a free emission
 
-   base::safe_queue<RfEmission*> inUseEmQueue{MAX_EMISSIONS};  // in use emission queue
-   mutable long inUseEmLock{};                                 // semaphore to protect 'inUseEmQueue'
+   struct PoolEntry {
+      RfEmission* em{};                         // pooled emission (we hold a reference)
+      unsigned int generation{};                // number of times this emission has been sent
+      unsigned int cleared{};                   // generation that has been cleared
+   };
 
-private:
-   static const int MAX_EMISSIONS{10000};       // max size of emission queues and arrays
+   RfEmission* getFreeEmission(const RfEmission* const xmit);
+
+   std::vector<PoolEntry> emPool;               // emission pool
+   unsigned int emPoolNext{};                   // next pool entry to check
+   unsigned long emPoolHits{};                  // emissions reused from the pool
+   unsigned long emPoolMisses{};                // emissions that were cloned
 
    IRfSystem* sys{};                            // assigned R/F system (e.g., sensor, radio)
 
@@ -144,6 +168,7 @@ private:
    Polarization polar{Polarization::NONE};      // polarization  (enum)
    double gain{1.0};                            // gain          (no qty)
    base::IFunction* gainPattern{};              // gain pattern  (Function)
+   std::vector<double> gainIv1, gainIv2;        // gain pattern lookup angles (degrees)
 
    double threshold{};                          // antenna threshold; don't send emission if
                                                 // power is below this threshold (watts)
@@ -9,6 +9,7 @@
 
 namespace mixr {
 namespace base { class IAngle; class Boolean; class Identifier; class Integer; class ILength; class IList; class PairStream; }
+namespace terrain { class OccultingCache; }
 namespace models {
 class RfEmission;
 class SensorMsg;
@@ -91,6 +92,8 @@ class Tdb;
 //
 //    terrainOcculting     <Boolean>      ! Enable terrain occulting of the players of interest (default: false)
 //    checkHorizon         <Boolean>      ! Enable horizon masking check (default: true)
+//    terrainOccultingTolerance <ILength> ! Terrain occulting results are reused until the ownship or target
+//                                        ! moves more than this distance, or zero to always compute them (default: 0)
 //
 //    playerOfInterestTypes        <PairStream> ! List of player of interest types (default: all types )
 //                                              ! Valid identifiers: { air, ground, weapon, ship, building, lifeform, space }
@@ -140,8 +143,9 @@ public:
       ROLL_IDX   // Roll index
    };
 
-   // Max number of players of interest
-   enum { MAX_PLAYERS = MIXR_CONFIG_MAX_PLAYERS_OF_INTEREST };
+   // Deprecated: the players of interest are no longer limited (see the
+   // 'maxPlayersOfInterest' slot); this was MIXR_CONFIG_MAX_PLAYERS_OF_INTEREST
+   enum { MAX_PLAYERS [[deprecated("players of interest are no longer limited; see maxPlayersOfInterest")]] = 4000 };
 
 public:  // Public section
    IGimbal();
@@ -215,6 +219,8 @@ public:  // Public section
    unsigned int getMaxPlayersOfInterest() const  { return maxPlayers; }     // Max number of players of interest (i.e., size of the arrays)
    bool isLocalPlayersOfInterestOnly() const { return localOnly; }          // Local only players of interest flag
    bool isTerrainOccultingEnabled() const  { return terrainOcculting; }     // Terrain occulting enabled flag
+   double getTerrainOccultingTolerance() const;                             // Terrain occulting cache tolerance, or zero if not caching (meters)
+   terrain::OccultingCache* getTerrainOccultingCache() const { return occultingCache; } // Terrain occulting cache, or zero if not caching
    bool isHorizonCheckEnabled() const      { return checkHorizon; }         // Horizon masking enable flag
    bool isUsingWorldCoordinates() const    { return useWorld; }             // Returns true if using player of interest's world coordinates
    bool isUsingHeadingOnly() const         { return ownHeadingOnly; }       // Returns true if using players heading only
@@ -227,6 +233,7 @@ public:  // Public section
    virtual bool setMaxPlayersOfInterest(const unsigned int);                // Max number of players of interest (i.e., size of the arrays)
    virtual bool setLocalPlayersOfInterestOnly(const bool);                  // Sets the local only players of interest flag
    virtual bool setTerrainOccultingEnabled(const bool);                     // Sets the terrain occulting enabled flag
+   virtual bool setTerrainOccultingTolerance(const double meters);          // Sets the terrain occulting cache tolerance, or zero for no caching (meters)
    virtual bool setHorizonCheckEnabled(const bool);                         // Sets the horizon check enabled flag
    virtual bool setUseWorld(const bool);                                    // Sets the using world coordinates flag
    virtual bool setOwnHeadingOnly(const bool);                              // Use only the ownship player's heading to when transforming between body and local NED
@@ -318,7 +325,7 @@ private:
    double    maxRngPlayers{};         // Max range for players of interest or zero for all (meters)
    double    maxAnglePlayers{};       // Max angle of gimbal boresight for players of interest (or zero for all) (rad)
    unsigned int playerTypes{0xFFFF};  // Player of interest type mask (default: all players)
-   unsigned int maxPlayers{200};      // Max number of players of interest (i.e., size of the arrays)
+   unsigned int maxPlayers{200};      // Max number of players of interest
    bool     localOnly{};              // Local players of interest only
    bool     terrainOcculting{};       // Target terrain occulting enabled flag
    bool     checkHorizon{true};       // Horizon masking check enabled flag
@@ -326,6 +333,9 @@ private:
    bool     ownHeadingOnly{true};     // Whether only the ownship heading is used by the target data block
 
    base::safe_ptr<Tdb> tdb;           // Target Data Block
+   base::safe_ptr<Tdb> spareTdb;      // Previous Target Data Block; reused when it's no longer referenced
+
+   terrain::OccultingCache* occultingCache{};   // Terrain occulting results (see Tdb), or zero if not caching
 
 private:
    // slot table helper methods
@@ -366,6 +376,7 @@ private:
 
    bool setSlotTerrainOcculting(const base::Boolean* const);
    bool setSlotCheckHorizon(const base::Boolean* const);
+   bool setSlotTerrainOccultingTolerance(const base::ILength* const);
 
    bool setSlotPlayerTypes(const base::PairStream* const);
    bool setSlotMaxPlayers(const base::Integer* const);
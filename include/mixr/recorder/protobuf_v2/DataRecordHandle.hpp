@@ -9,6 +9,7 @@ namespace recorder {
 namespace protobuf_v2 {
 // Main (protocol buffer) data record
 namespace proto { class DataRecord; }
+class RecordArena;
 
 //------------------------------------------------------------------------------
 // Class: DataRecordHandle
@@ -23,6 +24,10 @@ namespace proto { class DataRecord; }
 //    3) Using the assignment operator ( e.g., handle1 = handle2; ), the contents
 //       of handle2's DataRecord will be copied into handle1's DataRecord.
 //
+//    4) A DataRecord that was allocated on a RecordArena is owned by the arena,
+//       so the handle refs the arena instead, and the DataRecord is released
+//       with the arena's other records after the last handle to them is destroyed.
+//
 //------------------------------------------------------------------------------
 class DataRecordHandle : public base::IObject
 {
@@ -30,6 +35,7 @@ class DataRecordHandle : public base::IObject
 
 public:
    DataRecordHandle(proto::DataRecord* const record);
+   DataRecordHandle(proto::DataRecord* const record, RecordArena* const arena);
 
    const proto::DataRecord* getRecord() const;
 
@@ -38,6 +44,7 @@ protected:
 
 private:
    proto::DataRecord* record {};
+   RecordArena* arena {};           // Arena that owns the record (or zero)
 };
 
 inline const proto::DataRecord* DataRecordHandle::getRecord() const { return record; }
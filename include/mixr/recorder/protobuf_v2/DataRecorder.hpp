@@ -3,10 +3,13 @@
 #define __mixr_recorder_DataRecorder_HPP__
 
 #include "mixr/simulation/IDataRecorder.hpp"
+#include "mixr/base/safe_ptr.hpp"
+#include <cstddef>
 #include <string>
+#include <unordered_map>
 
 namespace mixr {
-namespace base { class Identifier; class Integer; }
+namespace base { class Identifier; class Integer; class INumber; }
 namespace models { class IPlayer; class ITrack; class RfEmission; }
 namespace recorder {
 namespace protobuf_v2 {
@@ -14,6 +17,8 @@ namespace proto { class DataRecord; class PlayerId; class PlayerState;
                   class TrackData; class EmissionData; }
 class DataRecordHandle;
 class IOutputHandler;
+class RecordArena;
+class RecorderWriterPeriodicThread;
 
 //------------------------------------------------------------------------------
 // Class: DataRecorder
@@ -22,10 +27,30 @@ class IOutputHandler;
 // Factory name: DataRecorder
 // Slots:
 //    outputHandler     <OutputHandler>     ! Output handler (default: none)
+//    writerRate        <base::INumber>     ! Writer thread rate (Hz), or zero for no writer thread (default: 0)
+//    writerPriority    <base::INumber>     ! Writer thread priority; zero(0) is lowest, one(1) is highest (default: 0.0)
 //
 // Notes:
 //    1) negative time values are used when time is unknown.
 //
+//    2) The data records are queued on the output handler by the threads that
+//    record the data (e.g., time-critical), and they're processed, serialized
+//    and written, by the station's background thread (see processRecords()).
+//    With a 'writerRate', a dedicated writer thread is created, at reset,
+//    that processes the queue instead, so writing to the disk or network
+//    doesn't take the background thread's time either.
+//
+//    3) The data records are allocated from a RecordArena (see createRecord()),
+//    which is shared by all of the records of the same frame, and
+//    which is released, with its records, after the output handler has
+//    processed the last of them.
+//
+//    4) The records' player IDs are interned: a player's PlayerId (see
+//    genPlayerId()) is created once, and it's shared by the records of the
+//    player (see internPlayerId()) until the player's ID or names change,
+//    instead of copying the player's names into each record.  The IDs'
+//    arena is recycled, with a new frame's arena, when it gets too large.
+//
 //------------------------------------------------------------------------------
 // Recorder events handled ---
 //
@@ -69,6 +94,12 @@ public:
    unsigned int getMonth() const        { return month; }
    unsigned int getYear() const         { return year; }
 
+   double getWriterRate() const         { return writerRate; }
+   double getWriterPriority() const     { return writerPriority; }
+
+   // Processes the output handler's queue; called by the writer thread
+   void writeRecords();
+
    void processRecords() override;
    void reset() override;
 
@@ -81,17 +112,28 @@ protected:
 
    // Set functions
    bool setOutputHandler(IOutputHandler* const);
+   virtual bool setWriterRate(const double hz);
+   virtual bool setWriterPriority(const double pri);
 
    // data filler functions
    virtual void genPlayerId(proto::PlayerId* const id, const models::IPlayer* const player );
    virtual void genPlayerState(proto::PlayerState* const state, const models::IPlayer* const player );
    virtual void genTrackData(proto::TrackData* const trkMsg, const models::ITrack* const track );
-   virtual void genEmissionData(proto::EmissionData* const emMsg, const models::RfEmission* const emData);
-   virtual void sendDataRecord(proto::DataRecord* const msg);       // Send the DataRecord to our output handler
+   virtual void genEmissionData(proto::EmissionData* const emMsg, const models::RfEmission* const emData, RecordArena* const arena = nullptr);
+   virtual void sendDataRecord(proto::DataRecord* const msg, RecordArena* const arena = nullptr); // Send the DataRecord to our output handler
    virtual void timeStamp(proto::DataRecord* const msg);            // Time stamp the DataRecord
    virtual std::string genTrackId(const models::ITrack* const track);
    void setFirstPass(const bool f);
 
+   // Creates a new DataRecord on the current frame's arena, which is returned,
+   // ref()'d, by 'arena' (pass both to sendDataRecord())
+   proto::DataRecord* createRecord(RecordArena** const arena);
+
+   // Returns the player's interned PlayerId, which is shared by the player's records
+   // on 'arena' (see createRecord()); returns zero if there's no player
+   proto::PlayerId* internPlayerId(const models::IPlayer* const player, RecordArena* const arena);
+   void removePlayerId(const models::IPlayer* const player);
+
    // Recorder data event handlers
    virtual bool recordMarker(const base::IObject* objs[4], const double values[4]);
    virtual bool recordAI(const base::IObject* objs[4], const double values[4]);
@@ -125,10 +167,25 @@ protected:
 
 private:
    void initData();
+   void createWriterThread();
 
    IOutputHandler* outputHandler {};          // Our output handler
    bool firstPass {true};
 
+   double writerRate {};                      // Writer thread rate (Hz), or zero for no thread
+   double writerPriority {};                  // Writer thread priority
+   base::safe_ptr<RecorderWriterPeriodicThread> writerThread;
+
+   static const std::size_t MAX_ARENA_SIZE{1024 * 1024};   // Start a new arena after this many bytes
+
+   RecordArena* frameArena {};                // Current frame's record arena
+   unsigned int arenaFrame {};                // Current arena's frame
+   long arenaLock {};                         // Current arena's lock
+
+   RecordArena* idArena {};                   // Interned player IDs' arena
+   std::unordered_map<const models::IPlayer*, proto::PlayerId*> playerIds;  // Interned player IDs
+   long idLock {};                            // Interned player IDs' lock
+
    std::string eventName;
    std::string application;
    unsigned int caseNum {};
@@ -151,6 +208,8 @@ private:
    bool setSlotDay(base::Integer* const);
    bool setSlotMonth(base::Integer* const);
    bool setSlotYear(base::Integer* const);
+   bool setSlotWriterRate(const base::INumber* const);
+   bool setSlotWriterPriority(const base::INumber* const);
 };
 
 #include "mixr/recorder/protobuf_v2/DataRecorder.inl"
@@ -3,11 +3,17 @@
 #define __mixr_recorder_FileReader_HPP__
 
 #include "mixr/recorder/protobuf_v2/IInputHandler.hpp"
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace mixr {
-namespace base { class String; }
+namespace base { class Integer; class ITime; class String; }
 namespace recorder {
 namespace protobuf_v2 {
+namespace proto { class DataRecord; }
 
 //------------------------------------------------------------------------------
 // Class: FileReader
@@ -18,12 +24,39 @@ namespace protobuf_v2 {
 // Slots:
 //     filename       <String>     ! Data file name (required)
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     startTime      <ITime>      ! Start reading at this sim time (indexed files only) (optional)
+//     player         <Integer>    ! Only read the records of this player ID (optional)
 //
 // Notes
-//    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    1) Both data file formats that FileWriter writes are read; the format is
+//    found when the file is opened.
+//
+//    Indexed format (see RecordFileFormat): when the file is opened, only a
+//    summary of each index block is kept (its records, their max sim time
+//    and their players); a block's entries are read when they're needed, one
+//    block at a time.  So the reader can seek to a sim time, seekTime(), or
+//    skip to the records of one player, setPlayerFilter(), without holding
+//    the whole index.  The records after the last index block of a file that
+//    wasn't closed (no trailer) are read, and filtered by the player and the
+//    start time, one after the other.
+//
+//    Legacy format: the data file consists of a sequence of serialized data
+//    records that are preceded by 4 bytes that provided the size of each data
+//    record in bytes.  The 4 bytes are stored as an ascii string with leading
+//    spaces (e.g., " 123").  They can only be read from the start to the end.
+//
+//    2) A record's player is the player, the weapon, the shooter of a gun or
+//    the ownship of a track (see RecordFileFormat::getPlayerId()).  With a
+//    player filter, the records without a player are skipped.
+//
+//    3) The sim times of the records are not always increasing (e.g., after
+//    a reset), so seekTime() seeks to the first record where the sim time
+//    has reached the given time.
+//
+//    4) Compressed (indexed) files: the current block is decompressed once
+//    and kept, so the records are read straight from it.  To read a delta
+//    encoded record after a seek, the player data of the block's records
+//    before it are decoded first.
 //------------------------------------------------------------------------------
 class FileReader final: public IInputHandler
 {
@@ -41,6 +74,42 @@ public:
    virtual bool openFile();         // Open the data file
    virtual void closeFile();        // Close the data file
 
+   // Summary of an index block of the open indexed file
+   struct IndexBlock {
+      std::uint64_t offset{};             // Index chunk's offset
+      std::size_t firstRec{};             // First record
+      std::size_t numRecs{};              // Number of records
+      double maxTime{};                   // Max sim time of the records up to the end of the block (seconds)
+      std::uint64_t firstOffset{};        // First record (or block) chunk's offset
+      std::uint64_t lastOffset{};         // Last record (or block) chunk's offset
+      std::uint32_t firstInner{};         // First record chunk's offset in its block (compressed files)
+      std::uint32_t lastInner{};          // Last record chunk's offset in its block (compressed files)
+      std::vector<unsigned int> players;  // IDs of the players of the block's records (sorted)
+   };
+
+   bool isIndexed() const                       { return indexed; }             // Is the open file an indexed file?
+   bool isCompressed() const                    { return blocks; }              // Does the open file have compressed blocks?
+   std::size_t getNumIndexedRecords() const     { return numIndexedRecs; }      // Number of indexed records
+   bool isPlayerFilterEnabled() const           { return playerFilterFlg; }
+   unsigned int getPlayerFilter() const         { return playerFilter; }
+
+   // The open indexed file's index (e.g., to read the file's index blocks in parallel)
+   std::size_t getNumIndexBlocks() const                            { return indexBlocks.size(); }
+   const IndexBlock& getIndexBlock(const std::size_t b) const       { return indexBlocks[b]; }
+   std::uint64_t getTailOffset() const                              { return tailOffset; }                // Offset of the unindexed records
+   std::uint64_t getDataEnd() const                                 { return dataEnd; }                   // End of the chunks
+
+   // Does the index block 'b' have any records of the player 'id'?
+   bool hasPlayerRecords(const unsigned int id, const std::size_t b) const;
+
+   // Seeks to the first record at which the sim time has reached 'simTime' (seconds);
+   // returns false if the file isn't open and indexed
+   virtual bool seekTime(const double simTime);
+
+   // Only read the records of the player 'id'
+   virtual bool setPlayerFilter(const unsigned int id);
+   virtual bool clearPlayerFilter();
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const base::String* const);
    virtual bool setPathName(const base::String* const);
@@ -50,8 +119,21 @@ protected:
 
 private:
    void initData();
-
-   char* ibuf {};                    // Input data buffer
+   bool readIndex();
+   bool summarizeIndexBlock(const std::vector<char>& payload, IndexBlock* const blk, std::uint64_t* const prev);
+   std::size_t findIndexBlock(const std::size_t rec) const;
+   const RecordFileFormat::IndexEntry* indexEntry(const std::size_t rec);
+   std::size_t nextPlayerRecord();
+   bool isSkipped(const proto::DataRecord& record);
+   bool readChunkHeader(unsigned char* const type, std::uint64_t* const size, std::size_t* const hdrSize);
+   bool readChunk(const std::uint64_t offset, unsigned char* const type, std::vector<char>& payload);
+   const DataRecordHandle* readIndexedRecord();
+   const DataRecordHandle* readLegacyRecord();
+   const DataRecordHandle* readBlockRecord();
+   bool loadBlock(const std::uint64_t offset);
+   proto::DataRecord* nextBlockRecord(bool* const ok);
+
+   std::vector<char> ibuf;           // Input data buffer
 
    std::ifstream* sin {};            // Input stream
    const base::String* filename {};  // File name
@@ -60,10 +142,41 @@ private:
    bool fileFailed {};               // Open or read failed
    bool firstPassFlg {true};         // First pass flag
 
+   // indexed files
+   bool indexed {};                                  // Open file is an indexed file
+   std::vector<IndexBlock> indexBlocks;              // Index block summaries
+   std::size_t numIndexedRecs {};                    // Number of indexed records
+   std::vector<RecordFileFormat::IndexEntry> indexEntries;   // Entries of the current index block
+   std::vector<char> indexChunk;                     // Index chunk buffer
+   std::size_t indexBlock {};                        // Current index block
+   bool indexLoaded {};                              // Current index block's entries are loaded
+   std::size_t nextRec {};                           // Next indexed record
+   std::uint64_t filePos {};                         // Current file offset
+   std::uint64_t tailOffset {};                      // Offset of the unindexed records
+   std::uint64_t dataEnd {};                         // End of the chunks
+
+   // compressed (indexed) files
+   bool blocks {};                                   // Open file has compressed blocks
+   std::vector<char> blockChunk;                     // Compressed block
+   std::vector<char> blockData;                      // Current (uncompressed) block
+   std::uint64_t blockOffset {};                     // Current block's file offset
+   std::size_t blockPos {};                          // Next record chunk in the current block
+   bool blockLoaded {};                              // Current block is loaded
+   RecordFileFormat::DeltaState deltaState;          // Previous player data samples in the block
+
+   double startTime {};              // Start time (seconds)
+   bool startTimeFlg {};             // Start time is set
+   double tailTime {};               // Skip the unindexed records until the sim time reaches this time (seconds)
+   bool tailTimeFlg {};              // Tail time is set (see seekTime())
+   unsigned int playerFilter {};     // Player filter ID
+   bool playerFilterFlg {};          // Player filter is set
+
 private:
    // slot table helper methods
    bool setSlotFilename(const base::String* const x)                 { return setFilename(x); }
    bool setSlotPathName(const base::String* const x)                 { return setPathName(x); }
+   bool setSlotStartTime(const base::ITime* const);
+   bool setSlotPlayer(const base::Integer* const);
 };
 
 }
@@ -3,9 +3,14 @@
 #define __mixr_recorder_FileWriter_HPP__
 
 #include "mixr/recorder/protobuf_v2/IOutputHandler.hpp"
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace mixr {
-namespace base { class String; }
+namespace base { class Boolean; class Identifier; class Integer; class String; }
 namespace recorder {
 namespace protobuf_v2 {
 
@@ -19,12 +24,22 @@ namespace protobuf_v2 {
 // Slots:
 //     filename       <String>     ! Data file name
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     format         <Identifier> ! File format: indexed or legacy (default: indexed)
+//     compress       <Boolean>    ! Compress the records in blocks (indexed format only) (default: false)
+//     blockSize      <Integer>    ! Uncompressed block size (bytes) [MIN_BLOCK_SIZE .. MAX_BLOCK_SIZE]
+//                                 !   (default: DEFAULT_BLOCK_SIZE)
+//     deltaEncoding  <Boolean>    ! Delta encode the player data in the compressed blocks (default: false)
 //
 // Note:
-//    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    1) Indexed format: the data file is a versioned container of serialized
+//    data records, with varint sizes, and periodic index blocks of the records'
+//    sim times and player IDs (see RecordFileFormat), so FileReader can seek
+//    to a time or filter by player.
+//
+//    Legacy format: the data file consists of a sequence of serialized data
+//    records that are preceded by 4 bytes that provided the size of each data
+//    record in bytes.  The 4 bytes are stored as an ascii string with leading
+//    spaces (e.g., " 123"), so the records are limited to 9999 bytes.
 //
 //    2) During open(), if the file already exists then a version number is appended
 //    to the end of the file name.  (e.g., filename_v01 to filename_v99)
@@ -35,14 +50,46 @@ namespace protobuf_v2 {
 //    4) File will be closed with an end of data (REID_END_OF_DATA) message.
 //    Calling openFile() or sending any additional data messages will open
 //    a new file with a new version number.
+//
+//    5) The data records are serialized straight into a large, reusable
+//    buffer, and the buffer is written to the file, in one big write, when
+//    it's full and when the file is closed.
+//
+//    6) Use convert() to convert a data file (e.g., a legacy file) to an
+//    indexed data file (or the tools/recorderConvert program).
+//
+//    7) Compressed (indexed) files: the records are collected into blocks of
+//    'blockSize' bytes, and each block is compressed (base::lz4Compress()) when
+//    it's full, which is done by the thread that's processing the records (i.e.,
+//    the recorder's writer thread, if it has one).  The index entries have the
+//    block's offset and the record's offset in the block.
+//
+//    With 'deltaEncoding', the player data (position, angles, velocity, alpha,
+//    beta and cas) of a REID_PLAYER_DATA record is encoded as the difference
+//    from the player's previous sample in the block, which turns the slowly
+//    changing values into mostly zero bytes that compress well.  Each block starts over, so a block
+//    can be decoded on its own.
 //------------------------------------------------------------------------------
 class FileWriter final: public IOutputHandler
 {
     DECLARE_SUBCLASS(FileWriter, IOutputHandler)
 
+public:
+   enum class Format { LEGACY, INDEXED };
+
+   static const std::size_t BUFFER_SIZE{1024 * 1024};    // Output buffer size (bytes)
+
+   static const std::size_t MIN_BLOCK_SIZE{64 * 1024};       // Compressed blocks' uncompressed size (bytes)
+   static const std::size_t MAX_BLOCK_SIZE{1024 * 1024};
+   static const std::size_t DEFAULT_BLOCK_SIZE{256 * 1024};
+
 public:
    FileWriter();
 
+   // Converts a (legacy or indexed) data file to an indexed (and optionally
+   // compressed) data file; returns true if successful
+   static bool convert(const char* const inFilename, const char* const outFilename, const bool compress = false);
+
    bool isOpen() const;                   // Is the data file open?
    bool isFailed() const;                 // Did we have an open or write error?
 
@@ -51,6 +98,10 @@ public:
 
    const char* getFilename() const;       // File name as entered
    const char* getPathname() const;       // Path to file
+   Format getFormat() const               { return format; }
+   bool isCompressed() const              { return compress; }
+   std::size_t getBlockSize() const       { return blockSize; }
+   bool isDeltaEncoding() const           { return deltaEncoding; }
 
    const char* getFullFilename() const;   // File name with path and possible version number
                                           // (valid only while file is open)
@@ -58,6 +109,10 @@ public:
    // File and path names; set before calling openFile()
    virtual bool setFilename(const base::String* const);
    virtual bool setPathName(const base::String* const);
+   virtual bool setFormat(const Format);
+   virtual bool setCompress(const bool);
+   virtual bool setBlockSize(const std::size_t);
+   virtual bool setDeltaEncoding(const bool);
 
 protected:
    void setFullFilename(const char* const);
@@ -67,7 +122,30 @@ protected:
    bool shutdownNotification() override;
 
 private:
+   char* reserveBuffer(const std::size_t n);
+   void flushBuffer();
+   void writeIndex();
+   void writeBlock();
+
    std::ofstream* sout {};            // Output stream
+   std::vector<char> buffer;          // Output buffer of serialized data records
+   std::size_t bufferUsed {};         // Bytes used in the output buffer
+   std::uint64_t fileOffset {};       // Bytes written to the file
+
+   Format format {Format::INDEXED};                   // File format
+   std::vector<RecordFileFormat::IndexEntry> index;   // Index entries since the last index block
+   std::vector<unsigned char> indexData;              // Encoded index block
+   std::uint64_t lastIndexOffset {};                  // Offset of the last index block
+
+   bool compress {};                                  // Compress the records in blocks
+   std::size_t blockSize {DEFAULT_BLOCK_SIZE};        // Uncompressed block size (bytes)
+   bool deltaEncoding {};                             // Delta encode the player data
+   bool blocks {};                                    // The open file has compressed blocks
+   std::vector<char> block;                           // Uncompressed block of record chunks
+   std::size_t blockUsed {};                          // Bytes used in the block
+   std::vector<char> compressed;                      // Compressed block
+   std::vector<RecordFileFormat::IndexEntry> blockIndex;  // Index entries of the block's records
+   RecordFileFormat::DeltaState deltaState;           // Previous player data samples in the block
 
    char* fullFilename {};             // Full file name of the output file
    const base::String* filename {};   // Output file name
@@ -81,6 +159,10 @@ private:
    // slot table helper methods
    bool setSlotFilename(const base::String* const x)                { return setFilename(x); }
    bool setSlotPathName(const base::String* const x)                { return setPathName(x); }
+   bool setSlotFormat(const base::Identifier* const);
+   bool setSlotCompress(const base::Boolean* const);
+   bool setSlotBlockSize(const base::Integer* const);
+   bool setSlotDeltaEncoding(const base::Boolean* const);
 };
 
 }
@@ -3,10 +3,12 @@
 #define __mixr_recorder_IOutputHandler_HPP__
 
 #include "mixr/simulation/IRecorder.hpp"
-#include "mixr/base/IList.hpp"
+#include "mixr/base/mpsc_ring.hpp"
+
+#include <atomic>
 
 namespace mixr {
-namespace base { class IList; class PairStream; }
+namespace base { class Integer; class PairStream; }
 namespace recorder {
 namespace protobuf_v2 {
 class DataRecordHandle;
@@ -22,12 +24,28 @@ class DataRecordHandle;
 //    2) the addToQueue() function will save the record for later processing
 //    by the processQueue() function.  This allows a time critical thread to
 //    create a data record and queue it for later processing by a background
-//    thread, which would call the processQueue() function.
+//    (or writer) thread, which would call the processQueue() function.
+//
+//    The queue is a lock-free ring (see base::mpsc_ring) of 'queueSize'
+//    records, so addToQueue() never waits on the thread that's processing
+//    the queue (e.g., the one writing to the disk).  When the queue is full,
+//    the record is dropped and counted (see getNumDropped()).  The number of
+//    dropped records and the queue's high-water mark, which is the most
+//    records found on the queue by processQueue(), are reported at shutdown.
 //
 //    3) Using the 'components' slot, this OutputHandler can manage as list
 //    of subcomponent OutputHandlers.  The prcessRecord() function for each
 //    subcomponent OutputHandler is called from our processRecord() function.
 //
+//    4) The flush() function, which is called by processQueue() after it has
+//    processed a set of records, calls flushImp() and the subcomponents' flush()
+//    functions.  Derived classes that batch the records (e.g., NetOutput) use
+//    flushImp() to send out their partial batches.
+//
+// Slots:
+//    queueSize      <base::Integer>   ! Size of the data record queue; rounded up to a
+//                                     !   power of two (default: DEFAULT_QUEUE_SIZE)
+//
 // Overriding the Component class slot:
 //    components     ! Must contain only 'OutputHandler' type objects
 //
@@ -36,6 +54,9 @@ class IOutputHandler : public simulation::IRecorder
 {
    DECLARE_SUBCLASS(IOutputHandler, simulation::IRecorder)
 
+public:
+   static const unsigned int DEFAULT_QUEUE_SIZE{8192};
+
 public:
    IOutputHandler();
 
@@ -48,10 +69,25 @@ public:
    // Process all data records from the queue
    void processQueue();
 
+   // Flush any batched data records
+   void flush();
+
+   // Queue statistics
+   unsigned int getQueueSize() const;                 // Max number of records on the queue
+   unsigned int getQueueEntries() const;              // Number of records on the queue
+   unsigned int getQueueHighWaterMark() const         { return highWaterMark; }
+   unsigned int getNumDropped() const                 { return numDropped.load(std::memory_order_relaxed); }
+
+   // Sets the size of the queue; set before any records are queued
+   virtual bool setQueueSize(const unsigned int n);
+
 protected:
    // Process record implementations by derived classes
    virtual void processRecordImp(const DataRecordHandle* const);
 
+   // Flush implementations by derived classes
+   virtual void flushImp();
+
    // Checks the data enabled list and returns true if the record should be processed.
    bool isDataTypeEnabled(const DataRecordHandle* const handle) const;
 
@@ -65,8 +101,17 @@ protected:
    bool shutdownNotification() override;
 
 private:
-   base::IList queue;            // Data Record Queue
-   mutable long semaphore {};
+   void clearQueue();
+
+   base::mpsc_ring<const DataRecordHandle*>* queue {};     // Data Record Queue
+   mutable long semaphore {};                              // Queue consumer semaphore
+
+   std::atomic<unsigned int> numDropped {};               // Records dropped because the queue was full
+   unsigned int highWaterMark {};                          // Most records found on the queue
+
+private:
+   // slot table helper methods
+   bool setSlotQueueSize(const base::Integer* const);
 };
 
 }
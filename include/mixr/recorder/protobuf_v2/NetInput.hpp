@@ -3,6 +3,10 @@
 #define __mixr_recorder_NetInput_HPP__
 
 #include "mixr/recorder/protobuf_v2/IInputHandler.hpp"
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+
+#include <cstddef>
+#include <vector>
 
 namespace mixr {
 namespace base { class Boolean; class INetHandler; }
@@ -17,13 +21,18 @@ namespace protobuf_v2 {
 // Slots:
 //      netHandler  <INetHandler>   Network input handler
 //      noWait      <Boolean>       No wait (unblocked) I/O flag (default: false -- blocked I/O)
+//
+// Note:
+//    A packet is either a single record or a compressed batch of records
+//    from a NetOutput (see RecordFileFormat); the records of a batch are
+//    returned one at a time before the next packet is read.
 //------------------------------------------------------------------------------
 class NetInput final: public IInputHandler
 {
     DECLARE_SUBCLASS(NetInput, IInputHandler)
 
 public:
-   static const unsigned int MAX_INPUT_BUFFER_SIZE = 2000;
+   static const unsigned int MAX_INPUT_BUFFER_SIZE = 65536;
 
 public:
    NetInput();
@@ -48,6 +57,10 @@ private:
 
    char* ibuf {};    // Input buffer
 
+   std::vector<char> batch;                      // Uncompressed batch of record chunks
+   std::size_t batchPos {};                      // Next record chunk in the batch
+   RecordFileFormat::DeltaState deltaState;      // Previous player data samples in the batch
+
 private:
    // slot table helper methods
    bool setSlotNetwork(base::INetHandler* const);
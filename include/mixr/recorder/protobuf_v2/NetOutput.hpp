@@ -3,9 +3,13 @@
 #define __mixr_recorder_NetOutput_HPP__
 
 #include "mixr/recorder/protobuf_v2/IOutputHandler.hpp"
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+
+#include <cstddef>
+#include <vector>
 
 namespace mixr {
-namespace base { class Boolean; class INetHandler; }
+namespace base { class Boolean; class INetHandler; class Integer; }
 namespace recorder {
 namespace protobuf_v2 {
 
@@ -17,11 +21,28 @@ namespace protobuf_v2 {
 // Slots:
 //      netHandler  <INetHandler>  ! Network output handler
 //      noWait      <Boolean>      ! No wait (unblocked) I/O flag (default: false -- blocked I/O)
+//      compress    <Boolean>      ! Send compressed batches of records (default: false)
+//      batchSize   <Integer>      ! Uncompressed batch size (bytes) [MIN_BATCH_SIZE .. MAX_BATCH_SIZE]
+//                                 !   (default: RecordFileFormat::MAX_BATCH_SIZE)
+//      deltaEncoding <Boolean>    ! Delta encode the player data in the batches (default: false)
+//
+// Notes:
+//    1) Without 'compress', each record is sent in its own packet.
+//
+//    2) With 'compress', the records are collected into a batch, which is
+//    compressed and sent as one packet (see RecordFileFormat) when it's full,
+//    when the records on the recorder's queue have been processed (flush())
+//    and at the end of data.  A batch fits in one datagram, so it's much
+//    smaller than a file's block.  With 'deltaEncoding', the player data is
+//    delta encoded as it is in the compressed files (see FileWriter).
 //------------------------------------------------------------------------------
 class NetOutput final: public IOutputHandler
 {
     DECLARE_SUBCLASS(NetOutput, IOutputHandler)
 
+public:
+   static const std::size_t MIN_BATCH_SIZE{1024};    // Uncompressed batch size (bytes)
+
 public:
    NetOutput();
 
@@ -31,17 +52,32 @@ public:
 
 protected:
    void processRecordImp(const DataRecordHandle* const handle) override;
+   void flushImp() override;
 
 private:
+   void sendBatch();
+
     base::safe_ptr<base::INetHandler> netHandler; // Network handler (input/output, or just output if netInput is defined)
     bool networkInitialized {};    // Network has been initialized
     bool networkInitFailed {};     // Network initialization has failed
     bool noWaitFlag {};            // No wait (unblocked) I/O flag
 
+    bool compress {};                                          // Send compressed batches
+    std::size_t batchSize {RecordFileFormat::MAX_BATCH_SIZE};  // Uncompressed batch size (bytes)
+    bool deltaEncoding {};                                     // Delta encode the player data
+    std::vector<char> batch;                                   // Batch of record chunks
+    std::size_t batchUsed {};                                  // Bytes used in the batch
+    std::vector<char> compressed;                              // Compressed batch
+    std::vector<char> packet;                                  // Packet (magic and compressed batch)
+    RecordFileFormat::DeltaState deltaState;                   // Previous player data samples in the batch
+
 private:
    // slot table helper methods
    bool setSlotNetwork(base::INetHandler* const);
    bool setSlotNoWait(base::Boolean* const);
+   bool setSlotCompress(base::Boolean* const);
+   bool setSlotBatchSize(base::Integer* const);
+   bool setSlotDeltaEncoding(base::Boolean* const);
 };
 
 }
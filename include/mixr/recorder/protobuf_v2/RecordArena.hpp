@@ -0,0 +1,71 @@
+
+#ifndef __mixr_recorder_RecordArena_HPP__
+#define __mixr_recorder_RecordArena_HPP__
+
+#include "mixr/base/IObject.hpp"
+
+#include <cstddef>
+
+namespace google { namespace protobuf { class Arena; } }
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+namespace proto { class DataRecord; class PlayerId; }
+
+//------------------------------------------------------------------------------
+// Class: RecordArena
+// Description: Ref counted protocol buffer arena for the DataRecords of one
+//              recorder frame.
+//
+// Notes:
+//
+//    1) The DataRecords, with their submessages and strings, are allocated
+//       from the arena's large blocks (createRecord() is thread-safe), instead
+//       of one malloc for each message.
+//
+//    2) Each DataRecordHandle of an arena record refs the arena, so the arena,
+//       and all of its records, are released together when the last handle
+//       is released.
+//
+//    3) Records can share long lived submessages (e.g., the DataRecorder's
+//       interned PlayerIds) that are allocated from another arena, which is
+//       kept, using setSharedArena(), for as long as this arena.
+//
+//------------------------------------------------------------------------------
+class RecordArena : public base::IObject
+{
+   DECLARE_SUBCLASS(RecordArena, base::IObject)
+
+public:
+   static const std::size_t START_BLOCK_SIZE{16 * 1024};    // Arena's first block (bytes)
+   static const std::size_t MAX_BLOCK_SIZE{256 * 1024};     // Arena's largest blocks (bytes)
+
+public:
+   RecordArena();
+
+   // Creates a new (empty) DataRecord on the arena
+   proto::DataRecord* createRecord();
+
+   // Creates a new (empty) PlayerId on the arena
+   proto::PlayerId* createPlayerId();
+
+   // Keeps (refs) the arena of the submessages shared by this arena's records
+   void setSharedArena(RecordArena* const);
+   RecordArena* getSharedArena() const;
+
+   // Bytes allocated by the arena
+   std::size_t getSpaceAllocated() const;
+
+private:
+   void initData();
+
+   google::protobuf::Arena* arena {};
+   RecordArena* sharedArena {};     // Arena of the shared submessages (or zero)
+};
+
+}
+}
+}
+
+#endif
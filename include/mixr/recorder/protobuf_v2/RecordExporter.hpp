@@ -0,0 +1,227 @@
+
+#ifndef __mixr_recorder_RecordExporter_HPP__
+#define __mixr_recorder_RecordExporter_HPP__
+
+#include "mixr/base/IComponent.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mixr {
+namespace base { class Boolean; class Identifier; class Integer; class String; }
+namespace recorder {
+namespace protobuf_v2 {
+namespace proto { class DataRecord; class PlayerId; class PlayerState; class PlayerDataMsg;
+                  class TrackData; class WeaponDetonationEventMsg; }
+class RecordExporterThread;
+
+//------------------------------------------------------------------------------
+// Class: RecordExporter
+// Description: Replay and analysis exporter; reads an (indexed) data recorder
+//              file, using several decoder threads, and writes the player
+//              state, track and weapon detonation records as columnar tables.
+//
+// Factory name: RecordExporter
+//
+// Slots:
+//    filename       <String>        ! Data file name (required)
+//    pathname       <String>        ! Path to the data file's directory (optional)
+//    output         <String>        ! Output file name prefix (required)
+//    format         <Identifier>    ! Output format { csv, columns } (default: csv)
+//    numThreads     <Integer>       ! Number of decoder threads, or zero for one per processor (default: 0)
+//    players        <Boolean>       ! Export the player state table (default: true)
+//    tracks         <Boolean>       ! Export the track table (default: true)
+//    detonations    <Boolean>       ! Export the weapon detonation table (default: true)
+//    player         <Integer>       ! Only export the records of this player ID (optional)
+//
+// Notes:
+//    1) Call exportFile() to export the data file; it returns after the
+//    tables have been written.  The recorderExport tool (see the tools
+//    directory) exports a data file from the command line.
+//
+//    2) The work is split by the file's index blocks (see RecordFileFormat):
+//    each decoder thread reads, decompresses, parses and formats the records
+//    of one index block at a time, and the tables are written, in the file's
+//    order, by the calling thread.  With a player filter, the index blocks
+//    without any of the player's records are skipped.  Legacy (unindexed)
+//    files need to be converted first (see FileWriter::convert()).
+//
+//    3) Tables and their records:
+//       players        REID_NEW_PLAYER, REID_PLAYER_REMOVED and REID_PLAYER_DATA
+//       tracks         REID_NEW_TRACK, REID_TRACK_REMOVED and REID_TRACK_DATA
+//       detonations    REID_WEAPON_DETONATION
+//    The 'event' column is the record's recorder event ID, and the missing
+//    (optional) values are NaN, zero or empty.
+//
+//    4) Output formats:
+//
+//       csv: one file for each table, <output>_<table>.csv, with a header
+//       line of the column names.
+//
+//       columns: one binary file for each column of each table,
+//       <output>_<table>.<column>, which is an array of little-endian
+//       'float64' or 'uint32' values, or, for the 'utf8' (string) columns,
+//       the strings' bytes, one after the other, and their end offsets, in
+//       <output>_<table>.<column>.offsets ('uint64' values).  The columns and
+//       the number of rows are listed in <output>_<table>.schema.
+//------------------------------------------------------------------------------
+class RecordExporter final: public base::IComponent
+{
+   DECLARE_SUBCLASS(RecordExporter, base::IComponent)
+
+public:
+   enum class Format { CSV, COLUMNS };
+   enum class ColumnType { FLOAT64, UINT32, UTF8 };
+
+   static const unsigned int PLAYERS_TABLE{0};         // Player state table
+   static const unsigned int TRACKS_TABLE{1};          // Track table
+   static const unsigned int DETONATIONS_TABLE{2};     // Weapon detonation table
+   static const unsigned int NUM_TABLES{3};
+   static const std::size_t MAX_UNITS_AHEAD{4};        // Max decoded units ahead of the writer (per thread)
+
+   // Table column
+   struct Column {
+      const char* name;
+      ColumnType type;
+   };
+
+   // Table columns
+   struct Table {
+      const char* name;
+      const Column* columns;
+      std::size_t numColumns;
+   };
+
+public:
+   RecordExporter();
+
+   // Table 't' and its columns
+   static const Table& getTable(const unsigned int t);
+
+   // Exports the data file; returns false if the file couldn't be read or
+   // the tables couldn't be written
+   bool exportFile();
+
+   Format getFormat() const                        { return format; }
+   unsigned int getNumThreads() const              { return numThreads; }
+   bool isTableEnabled(const unsigned int t) const { return (t < NUM_TABLES && tableEnabled[t]); }
+   bool isPlayerFilterEnabled() const              { return playerFilterFlg; }
+   unsigned int getPlayerFilter() const            { return playerFilter; }
+
+   std::size_t getNumRows(const unsigned int t) const;     // Rows exported to table 't' by the last export
+   std::size_t getNumErrors() const                { return numErrors; }  // Bad chunks or records found by the last export
+
+   virtual bool setFilename(const base::String* const);
+   virtual bool setPathName(const base::String* const);
+   virtual bool setOutput(const base::String* const);
+   virtual bool setFormat(const Format);
+   virtual bool setNumThreads(const unsigned int);
+   virtual bool setTableEnabled(const unsigned int t, const bool);
+   virtual bool setPlayerFilter(const unsigned int id);
+   virtual bool clearPlayerFilter();
+
+   // Decodes units until they're all done; called by the decoder threads
+   void decodeUnits();
+
+private:
+   // A table's rows of one unit, formatted by a decoder thread
+   struct TableBuffer {
+      std::size_t rows{};
+      std::string csv;                                    // CSV rows
+      std::vector<std::vector<char>> data;                // Column data
+      std::vector<std::vector<std::uint64_t>> offsets;    // String column (end) offsets
+      std::size_t col{};                                  // Next column of the current row
+   };
+
+   // Unit of work: the records of one index block (or the unindexed records)
+   struct Unit {
+      std::uint64_t begin{};         // First chunk's offset
+      std::uint64_t last{};          // Last (record or block) chunk's offset
+      std::uint32_t innerFirst{};    // First record's offset in the first block
+      std::uint32_t innerLast{};     // Last record's offset in the last block
+      bool tail{};                   // Unindexed records (to the end of the data)
+      bool done{};                   // Decoded
+      std::size_t errors{};          // Bad chunks or records
+      TableBuffer tables[NUM_TABLES];
+   };
+
+   // Decoder thread's data
+   struct Decoder {
+      std::ifstream sin;
+      std::vector<char> chunk;
+      std::vector<char> block;
+      proto::DataRecord* record{};
+   };
+
+   bool openOutput();
+   void closeOutput();
+   bool writeUnit(Unit& unit);
+   bool writeSchemas();
+   void clearThreads();
+
+   void decodeUnit(Decoder& dec, Unit& unit);
+   bool readChunk(Decoder& dec, std::uint64_t* const pos, unsigned char* const type);
+   void exportRecord(const proto::DataRecord& record, Unit& unit);
+
+   // Table rows
+   void putPlayerRow(TableBuffer& t, const proto::DataRecord& record, const proto::PlayerId& id,
+                     const proto::PlayerState* const state, const proto::PlayerDataMsg* const data);
+   void putTrackRow(TableBuffer& t, const proto::DataRecord& record, const proto::PlayerId& id,
+                    const std::string& trackId, const proto::PlayerId* const trkId, const proto::TrackData* const data);
+   void putDetonationRow(TableBuffer& t, const proto::DataRecord& record, const proto::WeaponDetonationEventMsg& msg);
+
+   // Row values
+   void beginRow(TableBuffer& t, const unsigned int table);
+   void putDouble(TableBuffer& t, const double v);
+   void putUint(TableBuffer& t, const std::uint32_t v);
+   void putString(TableBuffer& t, const std::string& v);
+   void endRow(TableBuffer& t);
+   void putTime(TableBuffer& t, const proto::DataRecord& record);
+   void putPlayerId(TableBuffer& t, const proto::PlayerId* const id);
+   void putVector(TableBuffer& t, const bool valid, const double x, const double y, const double z);
+
+   std::string filename;                      // Data file name
+   std::string pathname;                      // Data file's directory
+   std::string output;                        // Output file name prefix
+   Format format {Format::CSV};
+   unsigned int numThreads {};                // Decoder threads (zero: one per processor)
+   bool tableEnabled[NUM_TABLES] {true, true, true};
+   unsigned int playerFilter {};              // Player filter ID
+   bool playerFilterFlg {};                   // Player filter is set
+
+   // export state
+   std::string fullname;                      // Data file's full name
+   std::uint64_t dataEnd {};                  // End of the data file's chunks
+   std::vector<Unit> units;                   // Units of work
+   std::size_t nextUnit {};                   // Next unit to decode
+   std::size_t unitsWritten {};               // Units written
+   std::size_t maxAhead {};                   // Max units decoded ahead of the writer
+   std::size_t numRunning {};                 // Decoder threads still in decodeUnits()
+   long unitLock {};                          // Units' lock
+   std::size_t numErrors {};                  // Bad chunks or records
+   std::size_t numRows[NUM_TABLES] {};        // Rows written to each table
+   std::vector<std::ofstream*> files[NUM_TABLES];       // Output files of each table (CSV: one; columns: data and offsets of each column)
+   std::vector<std::uint64_t> stringBytes[NUM_TABLES];  // Bytes written to each (string) column
+   std::vector<RecordExporterThread*> threads;         // Decoder threads (ref()'d)
+
+private:
+   // slot table helper methods
+   bool setSlotFilename(const base::String* const x)        { return setFilename(x); }
+   bool setSlotPathName(const base::String* const x)        { return setPathName(x); }
+   bool setSlotOutput(const base::String* const x)          { return setOutput(x); }
+   bool setSlotFormat(const base::Identifier* const);
+   bool setSlotNumThreads(const base::Integer* const);
+   bool setSlotPlayers(const base::Boolean* const);
+   bool setSlotTracks(const base::Boolean* const);
+   bool setSlotDetonations(const base::Boolean* const);
+   bool setSlotPlayer(const base::Integer* const);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,211 @@
+
+#ifndef __mixr_recorder_RecordFileFormat_HPP__
+#define __mixr_recorder_RecordFileFormat_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+namespace proto { class DataRecord; }
+
+//------------------------------------------------------------------------------
+// Class: RecordFileFormat
+// Description: Constants and encoding functions of the indexed data recorder
+//              file format, which is written by FileWriter and read by FileReader,
+//              and of the compressed record batches of NetOutput and NetInput.
+//
+// File format (all fixed size values are little-endian):
+//
+//    Header (HEADER_SIZE bytes)
+//       char[8]   MAGIC ("MIXRREC" and a null)
+//       uint32    VERSION
+//       uint32    flags (BLOCKS_FLAG: the records are in compressed blocks)
+//
+//    Chunks, one after the other
+//       uint8     chunk type (RECORD_CHUNK, INDEX_CHUNK or BLOCK_CHUNK)
+//       varint    payload size (bytes)
+//       payload
+//
+//       RECORD_CHUNK payload: a serialized DataRecord
+//
+//       DELTA_CHUNK payload: a serialized DataRecord whose player data
+//       (PlayerState and alpha, beta and cas) has been delta encoded against
+//       the previous sample of the same player in the same block (see
+//       deltaEncode()).  Only found in blocks.
+//
+//       BLOCK_CHUNK payload: a compressed block of record chunks (RECORD_CHUNK
+//       and DELTA_CHUNK), of up to the writer's block size
+//          varint    size of the uncompressed chunks (bytes)
+//          the chunks, compressed with base::lz4Compress()
+//
+//       INDEX_CHUNK payload: an index block of the records since the
+//       previous index block (every INDEX_INTERVAL records and at close)
+//          uint64    offset of the previous index chunk (zero if none)
+//          varint    number of entries
+//          entries, one for each record:
+//             varint    record (or block) chunk offset; from the previous entry's
+//                       offset (the first entry's is from the file's start)
+//             varint    offset of the record's chunk in the uncompressed block
+//                       (only with the BLOCKS_FLAG)
+//             float64   sim time (seconds)
+//             varint    player ID plus one, or zero if the record has no player
+//
+//    Trailer (TRAILER_SIZE bytes, written at close)
+//       uint64    offset of the last index chunk
+//       char[8]   TRAILER_MAGIC ("MIXRIDX" and a null)
+//
+// Varints are unsigned, base 128, least significant group first (as in
+// protocol buffers), so there's no limit on the size of a data record.
+//
+// A reader finds the index blocks by following the chain of offsets back
+// from the trailer, or, if the file wasn't closed (no trailer), by scanning
+// the chunks.
+//
+// Network batch (one datagram)
+//       char[4]   BATCH_MAGIC ("MXRB")
+//       varint    size of the uncompressed chunks (bytes)
+//       record chunks (RECORD_CHUNK and DELTA_CHUNK), compressed with
+//       base::lz4Compress(); the delta encoding starts over with each batch
+//------------------------------------------------------------------------------
+class RecordFileFormat
+{
+public:
+   static const char MAGIC[8];
+   static const char TRAILER_MAGIC[8];
+   static const std::uint32_t VERSION{1};
+   static const std::size_t HEADER_SIZE{16};        // File header (bytes)
+   static const std::size_t TRAILER_SIZE{16};       // File trailer (bytes)
+   static const std::size_t MAX_CHUNK_HEADER{11};   // Max chunk header: type and varint size (bytes)
+
+   static const std::uint32_t BLOCKS_FLAG{0x01};    // Header flag: records are in compressed blocks
+
+   static const unsigned char RECORD_CHUNK{1};      // Data record chunk type
+   static const unsigned char INDEX_CHUNK{2};       // Index block chunk type
+   static const unsigned char BLOCK_CHUNK{3};       // Compressed block chunk type
+   static const unsigned char DELTA_CHUNK{4};       // Delta encoded data record chunk type
+
+   static const unsigned int INDEX_INTERVAL{4096};  // Records between index blocks
+
+   static const char BATCH_MAGIC[4];
+   static const std::size_t MAX_BATCH_SIZE{60000};  // Max uncompressed network batch (bytes)
+
+   // Index entry of one record
+   struct IndexEntry {
+      std::uint64_t offset{};       // Record (or block) chunk's file offset
+      std::uint32_t inner{};        // Record chunk's offset in the uncompressed block
+      double simTime{};             // Sim time (seconds)
+      unsigned int playerId{};      // Player ID
+      bool hasPlayer{};             // Record has a player ID
+   };
+
+   // Previous player data samples of each player ID (delta encoding)
+   static const std::size_t NUM_DELTA_FIELDS{12};
+   using DeltaState = std::unordered_map<unsigned int, std::array<double, NUM_DELTA_FIELDS>>;
+
+public:
+   // Encodes the file header; 'p' must have HEADER_SIZE bytes
+   static void encodeHeader(unsigned char* const p, const std::uint32_t flags = 0);
+
+   // Returns true if 'p' (HEADER_SIZE bytes) is a valid file header
+   static bool decodeHeader(const unsigned char* const p, std::uint32_t* const flags = nullptr);
+
+   // Encodes the file trailer; 'p' must have TRAILER_SIZE bytes
+   static void encodeTrailer(unsigned char* const p, const std::uint64_t lastIndexOffset);
+
+   // Decodes the file trailer (TRAILER_SIZE bytes); returns false if it's not a valid trailer
+   static bool decodeTrailer(const unsigned char* const p, std::uint64_t* const lastIndexOffset);
+
+   // Encodes a chunk header; 'p' must have MAX_CHUNK_HEADER bytes; returns the number of bytes
+   static std::size_t encodeChunkHeader(unsigned char* const p, const unsigned char type, const std::uint64_t size);
+
+   // Encodes an index block, which is appended to 'out'
+   static void encodeIndex(
+      std::vector<unsigned char>& out,
+      const std::uint64_t prevIndexOffset,
+      const std::vector<IndexEntry>& entries,
+      const bool blocks = false                 // Entries have block offsets (BLOCKS_FLAG)
+   );
+
+   // Decodes an index block, whose entries are appended to 'entries'; returns false if it's invalid
+   static bool decodeIndex(
+      const unsigned char* const data,
+      const std::size_t size,
+      std::uint64_t* const prevIndexOffset,
+      std::vector<IndexEntry>& entries,
+      const bool blocks = false                 // Entries have block offsets (BLOCKS_FLAG)
+   );
+
+   // Appends the record's chunk to the 'used' bytes of the 'block' of chunks;
+   // with a 'delta' state, player data records are delta encoded (DELTA_CHUNK)
+   static bool appendRecord(
+      std::vector<char>& block,
+      std::size_t* const used,
+      const proto::DataRecord& record,
+      DeltaState* const delta = nullptr
+   );
+
+   // Gets the chunk at 'pos' of a block of 'size' bytes, and moves 'pos' to the next chunk;
+   // returns false if there isn't a valid chunk at 'pos'
+   static bool getChunk(
+      const char* const block,
+      const std::size_t size,
+      std::size_t* const pos,
+      unsigned char* const type,
+      const char** const payload,
+      std::size_t* const n
+   );
+
+   // Parses a record chunk's payload; a DELTA_CHUNK is decoded using (and updates)
+   // the 'delta' state; returns zero if it's not a valid record
+   static proto::DataRecord* parseRecord(
+      const unsigned char type,
+      const char* const payload,
+      const std::size_t n,
+      DeltaState& delta
+   );
+
+   // Parses a record chunk's payload into an existing 'record' (e.g., reused for
+   // each record); returns false if it's not a valid record
+   static bool parseRecord(
+      const unsigned char type,
+      const char* const payload,
+      const std::size_t n,
+      DeltaState& delta,
+      proto::DataRecord* const record
+   );
+
+   // Compresses the 'n' bytes of the 'block' into 'out' (its varint size and the
+   // compressed data); returns the number of bytes
+   static std::size_t compressBlock(const char* const block, const std::size_t n, std::vector<char>& out);
+
+   // Decompresses a compressed block into 'block'; returns false if it's invalid
+   static bool decompressBlock(const char* const data, const std::size_t n, std::vector<char>& block);
+
+   // Delta encoding (the integer difference of the bits) of the player data of a
+   // REID_PLAYER_DATA record against the previous sample of the same player;
+   // returns false if it's not a player data record
+   static bool deltaEncode(proto::DataRecord* const record, DeltaState& delta);
+   static bool deltaDecode(proto::DataRecord* const record, DeltaState& delta);
+
+   // Gets the ID of the record's (main) player; returns false if it doesn't have one
+   static bool getPlayerId(const proto::DataRecord& record, unsigned int* const id);
+
+   // Varint, uint64 and float64 encoding; the put functions return the number of bytes
+   static std::size_t putVarint(unsigned char* const p, std::uint64_t v);
+   static bool getVarint(const unsigned char** const p, const unsigned char* const end, std::uint64_t* const v);
+   static void putUint64(unsigned char* const p, const std::uint64_t v);
+   static std::uint64_t getUint64(const unsigned char* const p);
+   static void putDouble(unsigned char* const p, const double v);
+   static double getDouble(const unsigned char* const p);
+};
+
+}
+}
+}
+
+#endif
@@ -46,12 +46,12 @@ public:
    };
 
    // player id
-   void setID(const int x)                  { id = x;         }        // sets the player's ID
+   void setID(const int x);                                            // sets the player's ID
    bool isID(const int x) const             { return x == id; }        // true if player's ID matches
    int getID() const                        { return id;      }        // returns ID
 
    // player name
-   void setName(const std::string& x)       { name = x;         }      // set players name
+   void setName(const std::string& x);                                 // set players name
    bool isName(const std::string& x) const  { return x == name; }      // true if the players name matches
    const std::string& getName() const       { return name;      }      // return players name
 
@@ -95,6 +95,7 @@ protected:
 
 private:
    void initData();
+   bool isIndexed() const;
 
    // player identity
    int id{};
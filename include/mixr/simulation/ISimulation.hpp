@@ -6,6 +6,7 @@
 #include "mixr/base/safe_queue.hpp"
 #include "mixr/base/osg/Matrixd"
 #include <array>
+#include <vector>
 
 namespace mixr {
 namespace base { class EarthModel; class Integer; class LatLon; class Pair; class ITime; }
@@ -13,6 +14,8 @@ namespace simulation {
 class IDataRecorder;
 class SimulationBgSyncThread;
 class SimulationTcSyncThread;
+class SimulationTaskScheduler;
+class PlayerArray;
 class IStation;
 class Statistic;
 class IPlayer;
@@ -83,6 +86,11 @@ class IPlayer;
 //    g) You can find players on the list by Player ID [plus Net ID], findPlayer(),
 //       or by name using findPlayerByName().
 //
+//    h) Each time the player list is swapped, a contiguous array of its players,
+//       with the local players followed by the proxy players, is also built,
+//       see getPlayerArray() and PlayerArray.  Frame loops should iterate this
+//       array rather than walk the player list.
+//
 //
 // Cycles, frames and phases:
 //
@@ -107,6 +115,13 @@ class IPlayer;
 //    threads to traverse the player list.  These threads will each process a subset
 //    of players.  The T/C threads rejoin at the end of each phase (see phases above).
 //
+//    The players are distributed to the threads by a work-stealing scheduler
+//    (see SimulationTaskScheduler), which splits the player array (see below)
+//    into chunks that are sized using each player's execution time history
+//    (per phase), and deals them out to a deque for each thread.  A thread that
+//    finishes its own chunks steals the remaining chunks from the other threads,
+//    so a single heavy player doesn't stall the phase while other threads are idle.
+//
 //    There is overhead with managing threads, so this is effective only with
 //    a larger number of players.  The trade off point is dependent on the
 //    complexity of the players and the speed of your computer system, so you
@@ -181,6 +196,10 @@ public:
     base::PairStream* getPlayers();                // Returns the player list; pre-ref()'d
     const base::PairStream* getPlayers() const;    // Returns the player list; pre-ref()'d (const version)
 
+    PlayerArray* getPlayerArray();                 // Returns the contiguous player array of the player list; pre-ref()'d
+    const PlayerArray* getPlayerArray() const;     // Returns the contiguous player array of the player list; pre-ref()'d (const version)
+    void rebuildPlayerArray();                     // Rebuilds the player array (e.g., after a listed player's ID, name or NIB changed)
+
     unsigned int cycle() const;                    // Cycle counter; each cycle represents 16 frames.
     unsigned int frame() const;                    // Frame counter [0 .. 15]; each frame represents a call to our updateTC()
     unsigned int phase() const;                    // Phase counter [0 .. 3]; frames are divide into 4 phases to help
@@ -228,14 +247,14 @@ public:
 
 public:
     void updateTcPlayerList(
-       base::PairStream* const playerList,
+       PlayerArray* const players,
        const double dt,
        const unsigned int idx,
        const unsigned int n
     );
 
     void updateBgPlayerList(
-       base::PairStream* const playerList,
+       PlayerArray* const players,
        const double dt,
        const unsigned int idx,
        const unsigned int n
@@ -243,6 +262,8 @@ public:
 
 protected:
     virtual void updatePlayerList();                  // Updates the current player list
+    virtual void updateBgBatch(PlayerArray* const players, const double dt); // Background processing done for all players
+                                                      // at once, before their updateData() (default: none)
 
     virtual void incCycle();                          // Increments the cycle counter
     virtual void setCycle(const unsigned int c);      // Sets the cycle counter
@@ -262,12 +283,16 @@ protected:
 private:
    IStation* getStationImp();
 
-   bool insertPlayerSort(base::Pair* const newPlayer, base::PairStream* const newList);
+   void insertPlayersSorted(std::vector<base::Pair*>& newPlayers, base::PairStream* const newList);
+   static bool isPlayerBefore(const IPlayer* const p1, const IPlayer* const p2);
+   void swapPlayers(base::PairStream* const newList);
    IPlayer* findPlayerPrivate(const short id, const int netID) const;
    IPlayer* findPlayerByNamePrivate(const char* const playerName) const;
 
    base::safe_ptr<base::PairStream> players;     // Main player list (sorted by network and player IDs)
    base::safe_ptr<base::PairStream> origPlayers; // Original player list
+   base::safe_ptr<PlayerArray> playerArray;      // Contiguous array of the main player list
+   long playersLock{};                           // Player list and array swap lock
 
    unsigned int cycleCnt{};      // Real-Time Cycle Counter (Cycles consist of Frames)
    unsigned int frameCnt{};      // Real-Time Frame Counter (Frames consist of Phases)
@@ -303,6 +328,7 @@ private:
    int reqTcThreads{1};                                               // Requested number of threads
    int numTcThreads{};                                                // Number of threads in pool; should be (reqTcThreads - 1)
    bool tcThreadsFailed{};                                            // Failed to create threads.
+   SimulationTaskScheduler* tcScheduler{};                            // T/C thread pool's work-stealing scheduler
 
    // Background thread pool
    static const int MAX_BG_THREADS{32};
@@ -310,6 +336,7 @@ private:
    int reqBgThreads{1};                                               // Requested number of threads
    int numBgThreads{};                                                // Number of threads in pool; should be (reqBgThreads - 1)
    bool bgThreadsFailed{};                                            // Failed to create threads.
+   SimulationTaskScheduler* bgScheduler{};                            // Background thread pool's work-stealing scheduler
 
    base::Statistic* frameTimingStats{};                               // Frame timing statistics
    double tcLastFrameTime{0.0};                                       // Previous frame time
@@ -0,0 +1,99 @@
+
+#ifndef __mixr_simulation_PlayerArray_HPP__
+#define __mixr_simulation_PlayerArray_HPP__
+
+#include "mixr/base/IObject.hpp"
+#include "mixr/base/safe_ptr.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace base { class PairStream; }
+namespace simulation {
+class IPlayer;
+
+//------------------------------------------------------------------------------
+// Class: PlayerArray
+// Description: Concrete class, an immutable, contiguous array snapshot of the
+//              simulation's player list.
+//
+//    The simulation (see ISimulation) builds a new player array whenever the
+//    player list membership changes, and publishes it using getPlayerArray().
+//    The array is never changed after it's built, so it can be traversed by any
+//    number of threads without locks, and it holds a reference to the player
+//    list that it was built from, so its player pointers remain valid for as
+//    long as the array is ref()'d.
+//
+//    The players are in player list order, which is partitioned into the local
+//    players, indices [ 0 .. getNumLocalPlayers()-1 ], followed by the proxy
+//    (networked) players, indices [ getFirstProxyIndex() .. getNumPlayers()-1 ].
+//
+//    The array is also hash indexed by player ID, by player and network IDs,
+//    and by player name, so findPlayer() and findPlayerByName() don't need to
+//    search the list.  Both return the first matching player in list order,
+//    or zero if there's no match.  The indexes are keyed by the IDs and names
+//    at the time the array was built, so the simulation rebuilds its array
+//    when a listed player's ID, name or NIB changes (see IPlayer::setID(),
+//    setName() and setNib()).
+//
+// Example:
+//
+//    base::safe_ptr<PlayerArray> pa( sim->getPlayerArray(), false );
+//    for (unsigned int i = 0; i < pa->getNumLocalPlayers(); i++) {
+//       IPlayer* const ip{pa->getPlayer(i)};
+//       ...
+//    }
+//
+//------------------------------------------------------------------------------
+class PlayerArray final : public base::IObject
+{
+   DECLARE_SUBCLASS(PlayerArray, base::IObject)
+
+public:
+   PlayerArray() = delete;
+   PlayerArray(base::PairStream* const players);
+
+   // The player list that this array was built from
+   const base::PairStream* getPlayerList() const    { return playerList; }
+
+   // Number of players (local and proxy)
+   unsigned int getNumPlayers() const               { return static_cast<unsigned int>(players.size()); }
+
+   // Number of local players; they're at indices [ 0 .. getNumLocalPlayers()-1 ]
+   unsigned int getNumLocalPlayers() const          { return numLocal; }
+
+   // Number of proxy players; they're at indices [ getFirstProxyIndex() .. getNumPlayers()-1 ]
+   unsigned int getNumProxyPlayers() const          { return getNumPlayers() - numLocal; }
+   unsigned int getFirstProxyIndex() const          { return numLocal; }
+
+   // Returns the i'th player
+   IPlayer* getPlayer(const unsigned int i) const   { return players[i]; }
+
+   // The contiguous array of all players
+   IPlayer* const* getPlayers() const               { return players.data(); }
+
+   // Finds a player by player ID and, if 'netID' is greater than zero, network ID
+   IPlayer* findPlayer(const short id, const int netID = 0) const;
+
+   // Finds a player by name
+   IPlayer* findPlayerByName(const std::string& name) const;
+
+private:
+   static std::uint64_t netKey(const int id, const int netID);
+
+   base::safe_ptr<base::PairStream> playerList;    // Player list that we were built from
+   std::vector<IPlayer*> players;                  // Players (local, then proxy)
+   unsigned int numLocal{};                        // Number of local players
+
+   std::unordered_map<int, unsigned int> idIndex;              // Player ID -> index of first player
+   std::unordered_map<std::uint64_t, unsigned int> netIndex;   // Network and player IDs -> index of first player
+   std::unordered_map<std::string, unsigned int> nameIndex;    // Player name -> index of first player
+};
+
+}
+}
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "mixr/terrain/ITerrain.hpp"
 
+#include <vector>
+
 namespace mixr {
 namespace terrain {
 
@@ -16,6 +18,20 @@ namespace terrain {
 //    1) the first elevation point [0] of all arrays is at the reference point
 //    2) the final elevation point [n-1] is at the maximum range
 //    3) The size of all arrays, n, must contain at least 2 points (ref point & max range)
+//
+//    4) A max elevation pyramid (i.e., mip-mapped maximums) of the elevation
+//    posts is built when the data is loaded (see reset()).  Level 'k' of the
+//    pyramid holds the maximum elevation of each 2^(k+1) by 2^(k+1) block of
+//    posts.  targetOcculting() uses it to skip runs of elevation points that
+//    are all below the line of sight, so it only looks up the elevation posts
+//    near the line of sight, and it returns the same result as the default,
+//    sampled ITerrain::targetOcculting().
+//
+//    5) getElevationsBatch() returns the same elevations as getElevation(), but
+//    it does the points in blocks of BATCH_SIZE: the post indices and weights,
+//    and then the interpolated elevations, are computed for the whole block in
+//    branch free loops that the compiler can vectorize, and only the elevation
+//    posts are looked up one point at a time.
 //------------------------------------------------------------------------------
 class DataFile : public ITerrain
 {
@@ -29,6 +45,7 @@ public:
 
    double getLatSpacing() const;             // Spacing between latitude points (degs), or zero if the data isn't loaded
    double getLonSpacing() const;             // Spacing between longitude points (degs), or zero if the data isn't loaded
+   short getVoidValue() const                { return voidValue; }    // Value representing a void (missing) data point
 
    // Computes the nearest row index for the latitude (degs).
    // Returns true if the index is valid
@@ -52,6 +69,12 @@ public:
    //  Elevations are in meters
    const short* getColumn(const unsigned int idx) const;
 
+   // Returns the k'th level of the max elevation pyramid (see note #4), or nullptr.
+   //  Level 'k' is column major, with ((getNumLonPoints()-1) >> (k+1)) + 1 columns
+   //  of ((getNumLatPoints()-1) >> (k+1)) + 1 elevations.
+   unsigned int getNumMaxPyramidLevels() const;
+   const short* getMaxPyramidLevel(const unsigned int k) const;
+
    // ---
    // simulation::Terrain interface
    // ---
@@ -80,7 +103,32 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const override;
 
+   // Locates the elevations (meters) of an array of reference points, and sets
+   // their valid flags (if provided); returns the number of points found
+   unsigned int getElevationsBatch(
+         const double* const lats,     // Reference latitude array (degs)
+         const double* const lons,     // Reference longitude array (degs)
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found), or nullptr
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Returns true if a target point is occulted by the terrain as seen from the ref point
+   bool targetOcculting(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const double refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const double tgtAlt           // Target altitude (meters)
+      ) const override;
+
+   void reset() override;
+
 protected:
+   static const unsigned int BATCH_SIZE{64};  // Points per block (see getElevationsBatch())
+
    short**  columns {};           // Array of data columns (values in meters)
    double   latSpacing {};        // Spacing between latitude points (degs)
    double   lonSpacing {};        // Spacing between longitude points (degs)
@@ -88,7 +136,26 @@ protected:
    unsigned int nptlong {};       // Number of points in longitude (i.e., number of columns)
    short    voidValue {-32767};   // Value representing a void (missing) data point
 
+   // Builds the max elevation pyramid from the columns of elevation data
+   void buildMaxPyramid();
+
+   // Sets the max elevation pyramid (e.g., from a file); the levels are swapped
+   // with the pyramid's
+   void setMaxPyramid(std::vector< std::vector<short> >& levels);
+
    void clearData() override;
+
+private:
+   // Max elevation of the posts in rows [ irow0 .. irow1 ] and columns [ icol0 .. icol1 ]
+   // (the returned value may be from a slightly larger block of posts)
+   short getMaxElevation(
+         const unsigned int irow0, const unsigned int irow1,
+         const unsigned int icol0, const unsigned int icol1
+      ) const;
+
+   // Max elevation pyramid; level 'k' is column major, with ((nptlat-1) >> (k+1)) + 1
+   // elevations per column, and holds the max of each 2^(k+1) x 2^(k+1) block of posts
+   std::vector< std::vector<short> > maxPyramid;
 };
 
 }
@@ -0,0 +1,144 @@
+
+#ifndef __mixr_terrain_GlobalTerrain_HPP__
+#define __mixr_terrain_GlobalTerrain_HPP__
+
+#include "mixr/terrain/PagedTerrain.hpp"
+
+#include "mixr/base/safe_ptr.hpp"
+
+#include <chrono>
+
+namespace mixr {
+namespace base { class Identifier; class ITime; }
+namespace terrain {
+class TerrainPrefetchPeriodicThread;
+
+//------------------------------------------------------------------------------
+// Class: GlobalTerrain
+// Description: Tiled, global terrain elevation database of any number of DTED
+//              or SRTM cells (see PagedTerrain).
+//
+//    The cells are indexed in a one degree latitude/longitude grid directory,
+//    so the cell that contains a point is found without searching the cells.
+//    With a 'cellFormat', the cell files are found using the standard file
+//    names in the 'path' directory tree, and they're only mapped when they're
+//    first used, so the database can cover the whole globe:
+//
+//       dted0, dted1 and dted2:    <path>/w118/n34.dt1  (i.e., <lon>/<lat>.dt<level>)
+//       srtm:                      <path>/N34W118.hgt
+//
+//    The cells on the 'files' list (see PagedTerrain) are indexed in the grid
+//    directory as well; they're used before the cells from the directory tree.
+//
+//    With a 'prefetchTime', a low priority background thread pages in the
+//    tiles along the predicted paths of the ownships (see setOwnshipPath()),
+//    out to the distance they'll travel in that time, so the tiles are in the
+//    tile cache before they're needed.
+//
+// Factory name: GlobalTerrain
+// Slots:
+//    cellFormat     <base::Identifier>   ! Cell files in the 'path' directory tree: dted0, dted1,
+//                                        !   dted2 or srtm (default: none; only the 'files' are used)
+//    prefetchTime   <base::ITime>        ! Look ahead time along the ownship paths, or zero to
+//                                        !   disable the prefetch thread (default: 0)
+//
+// Example:
+//
+//    terrain: ( GlobalTerrain
+//       path: "/data/dted/level1"
+//       cellFormat: dted1
+//       maxTiles: 512
+//       prefetchTime: ( Seconds 120 )
+//    )
+//
+// Notes:
+//    1) Each one degree square of the grid directory indexes only one cell, so
+//       the cells should be one degree cells (e.g., DTED or SRTM).
+//    2) Longitudes are wrapped at the 180 degree meridian.
+//    3) Ownship paths that aren't updated for STALE_TIME seconds are dropped.
+//    4) IWorldModel sets the path of its station's ownship each background frame.
+//------------------------------------------------------------------------------
+class GlobalTerrain : public PagedTerrain
+{
+   DECLARE_SUBCLASS(GlobalTerrain, PagedTerrain)
+
+public:
+   enum class CellFormat { NONE, DTED0, DTED1, DTED2, SRTM };
+
+   static constexpr double PREFETCH_RATE{1.0};        // Prefetch thread rate (hz)
+   static constexpr double PREFETCH_STEP{1000.0};     // Distance between prefetched points (meters)
+   static constexpr double STALE_TIME{10.0};          // Ownship paths are dropped after (seconds)
+
+public:
+   GlobalTerrain();
+
+   CellFormat getCellFormat() const            { return cellFormat; }
+   double getPrefetchTime() const              { return prefetchTime; }    // Look ahead time (seconds)
+
+   virtual bool setCellFormat(const CellFormat fmt);
+   virtual bool setPrefetchTime(const double seconds);
+
+   // Pages in the tiles along the ownship paths; called by the prefetch thread
+   void prefetchPaths();
+
+   bool isDataLoaded() const override;
+
+   void setOwnshipPath(
+      const void* const id,            // Ownship (e.g., its player pointer)
+      const double lat,                // Latitude (degs)
+      const double lon,                // Longitude (degs)
+      const double direction,          // True direction (ground track) angle (degs)
+      const double speed               // Ground speed (meters/second)
+   ) override;
+
+   void reset() override;
+
+protected:
+   int findCell(const double lat, const double lon) const override;
+
+   void clearData() override;
+   bool loadData() override;
+
+   bool shutdownNotification() override;
+
+private:
+   static const int NUM_LAT{180};        // Grid rows (one degree)
+   static const int NUM_LON{360};        // Grid columns (one degree)
+   static const int NO_CELL{-1};         // Grid entry: no cell
+   static const int UNKNOWN_CELL{-2};    // Grid entry: cell file not looked for yet
+
+   // Ownship's predicted path
+   struct Path {
+      const void* id{};
+      double lat{}, lon{};                            // Position (degs)
+      double direction{};                             // Ground track (degs)
+      double speed{};                                 // Ground speed (m/s)
+      std::chrono::steady_clock::time_point time;     // Time of the update
+   };
+
+   // Cell index of the grid square; the tile cache is unlocked while a cell file is mapped
+   int gridCell(const int ilat, const int ilon) const;
+   std::string cellFilename(const int ilat, const int ilon) const;
+   void createPrefetchThread();
+
+   CellFormat cellFormat{CellFormat::NONE};     // Format of the cells in the 'path' directory tree
+   double prefetchTime{};                       // Look ahead time (seconds)
+
+   mutable std::vector<int> grid;               // Grid directory; cell index of each one degree square
+   std::string dir;                             // Cell directory (with trailing separator)
+
+   std::vector<Path> paths;                     // Ownship paths
+   mutable long pathSemaphore{};                // Ownship paths semaphore
+
+   base::safe_ptr<TerrainPrefetchPeriodicThread> prefetchThread;
+
+private:
+   // slot table helper methods
+   bool setSlotCellFormat(const base::Identifier* const);
+   bool setSlotPrefetchTime(const base::ITime* const);
+};
+
+}
+}
+
+#endif
@@ -7,6 +7,8 @@
 #include "mixr/base/osg/Vec2d"
 #include "mixr/base/osg/Vec3d"
 
+#include <atomic>
+
 namespace mixr {
 namespace base { class Hsva; class String; }
 namespace terrain {
@@ -50,6 +52,10 @@ public:
    // Has the data been loaded
    virtual bool isDataLoaded() const = 0;
 
+   // Data version: changes each time the data is cleared or (re)loaded, so
+   // results computed from the old data (e.g., OccultingCache) can be dropped
+   virtual unsigned int getDataVersion() const   { return dataVersion; }
+
    // Locates an array of (at least two) elevation points (and sets valid flags if found)
    // returns the number of points found within this DataFile
    virtual unsigned int getElevations(
@@ -72,6 +78,20 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const = 0;
 
+   // Locates the elevations (meters) of an array of reference points, and sets
+   // their valid flags (if provided); returns the number of points found.  The
+   // elevations of the points that aren't found are unchanged.  The default is
+   // a call to getElevation() for each point; the databases override this to
+   // look up their cells and posts only once for points that are close together.
+   virtual unsigned int getElevationsBatch(
+         const double* const lats,     // Reference latitude array (degs)
+         const double* const lons,     // Reference longitude array (degs)
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found), or nullptr
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const;
+
    // Returns true if a target point is occulted by the terrain as seen from the ref point
    virtual bool targetOcculting(
          const double refLat,          // Ref latitude (degs)
@@ -93,6 +113,17 @@ public:
       const double tanLookAng          // Tangent of the look angle
    ) const;
 
+   // Sets the predicted path of an ownship, 'id', from its position, ground
+   // track and ground speed; databases that page in their data use it to load
+   // the data along the path before it's needed (default: ignored)
+   virtual void setOwnshipPath(
+      const void* const id,            // Ownship (e.g., its player pointer)
+      const double lat,                // Latitude (degs)
+      const double lon,                // Longitude (degs)
+      const double direction,          // True direction (ground track) angle (degs)
+      const double speed               // Ground speed (meters/second)
+   );
+
    // Returns true if the target at the altitude 'tgtAlt' and range 'range' is
    // occulted by the elevation points as seen from the reference altitude, 'refAlt'.
    static bool occultCheck(
@@ -194,6 +225,7 @@ private:
    double swLat {}, swLon {};       // Southwest lat/lon (degs)
    double minElev {};               // Minimum elevation (m)
    double maxElev {};               // Maximum elevation (m)
+   std::atomic<unsigned int> dataVersion {};   // Data version (see getDataVersion())
 
 private:
    // slot table helper methods
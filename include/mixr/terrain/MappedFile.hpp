@@ -0,0 +1,58 @@
+
+#ifndef __mixr_terrain_MappedFile_HPP__
+#define __mixr_terrain_MappedFile_HPP__
+
+#include <cstddef>
+
+namespace mixr {
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Class: MappedFile
+// Description: Read-only memory mapped file.
+//
+//    The file's pages are only read from the disk when they're first accessed,
+//    so opening (mapping) even a very large file is quick, and the operating
+//    system can drop the pages that haven't been used recently.
+//
+// Example:
+//
+//    MappedFile mf;
+//    if (mf.open("n34.dt1")) {
+//       const unsigned char* p = mf.getData();
+//       ... p[0] ... p[mf.getSize()-1] ...
+//    }
+//
+//------------------------------------------------------------------------------
+class MappedFile
+{
+public:
+   MappedFile() = default;
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+   ~MappedFile();
+
+   bool isOpen() const                       { return (data != nullptr); }
+   const unsigned char* getData() const      { return data; }     // Mapped file data, or nullptr if not open
+   std::size_t getSize() const               { return size; }     // Size of the file (bytes)
+
+   // Maps the file; returns true if successful
+   bool open(const char* const filename);
+
+   // Unmaps the file
+   void close();
+
+private:
+   const unsigned char* data{};  // Mapped file data
+   std::size_t size{};           // Size of the file (bytes)
+
+#if defined(WIN32)
+   void* hFile{};                // File handle
+   void* hMapping{};             // File mapping handle
+#endif
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,100 @@
+
+#ifndef __mixr_terrain_OccultingCache_HPP__
+#define __mixr_terrain_OccultingCache_HPP__
+
+#include <unordered_map>
+
+namespace mixr {
+namespace base { class IReferenced; }
+namespace terrain {
+class ITerrain;
+
+//------------------------------------------------------------------------------
+// Class: OccultingCache
+// Description: Cache of target occulting results, ITerrain::targetOcculting(),
+//              for one ref point (e.g., an ownship's gimbal) and its targets.
+//
+//    Each target is identified by a key (e.g., its player), and its result
+//    is reused until the ref point or the target has moved more than the
+//    tolerance distance from where they were when the result was computed,
+//    or until the terrain or its data (see ITerrain::getDataVersion())
+//    changes.  A tolerance of zero disables the cache.
+//
+//    Each entry holds a reference to its key, so a removed target (e.g., a
+//    deleted player) can't be replaced by a new one at the same address
+//    while its entry still exists.
+//
+//    update() is called once per pass through the targets, and removes the
+//    entries of the targets that weren't checked since the previous update().
+//
+// Example:
+//
+//    OccultingCache cache(100.0);
+//    ...
+//    for each target ...
+//       bool occulted = cache.targetOcculting(terrain, target, osLat, osLon, osAlt, tgtLat, tgtLon, tgtAlt);
+//    cache.update();
+//
+//------------------------------------------------------------------------------
+class OccultingCache
+{
+public:
+   OccultingCache() = default;
+   explicit OccultingCache(const double tolerance);
+   OccultingCache(const OccultingCache&) = delete;
+   OccultingCache& operator=(const OccultingCache&) = delete;
+   ~OccultingCache();
+
+   double getTolerance() const         { return tolerance; }      // Tolerance distance (meters)
+   void setTolerance(const double meters);                        // Sets the tolerance distance (meters), and clears the cache
+
+   unsigned int getNumEntries() const  { return static_cast<unsigned int>(entries.size()); }
+   unsigned long getNumHits() const    { return numHits; }        // Number of results that were reused
+   unsigned long getNumMisses() const  { return numMisses; }      // Number of results that were computed
+
+   // Returns true if the target, 'key', at [ tgtLat tgtLon tgtAlt ] is occulted by
+   // the terrain as seen from the ref point [ refLat refLon refAlt ]
+   bool targetOcculting(
+         const ITerrain* const terrain, // Terrain
+         const base::IReferenced* const key, // Target key
+         const double refLat,           // Ref latitude (degs)
+         const double refLon,           // Ref longitude (degs)
+         const double refAlt,           // Ref altitude (meters)
+         const double tgtLat,           // Target latitude (degs)
+         const double tgtLon,           // Target longitude (degs)
+         const double tgtAlt            // Target altitude (meters)
+      );
+
+   // Removes the entries that weren't used since the previous update()
+   void update();
+
+   // Removes all entries
+   void clear();
+
+private:
+   struct Entry {
+      const ITerrain* terrain{};
+      unsigned int dataVersion{};            // Terrain data version when the result was computed
+      double refLat{}, refLon{}, refAlt{};   // Ref point when the result was computed
+      double tgtLat{}, tgtLon{}, tgtAlt{};   // Target point when the result was computed
+      bool occulted{};                       // Result
+      bool used{};                           // Used since the previous update()
+   };
+
+   // True if point #2 is within the tolerance distance of point #1
+   bool isWithinTolerance(
+         const double lat1, const double lon1, const double alt1,
+         const double lat2, const double lon2, const double alt2
+      ) const;
+
+   std::unordered_map<const base::IReferenced*, Entry> entries;  // Results by target key (ref()'d)
+
+   double tolerance{};              // Tolerance distance (meters)
+   unsigned long numHits{};         // Number of results that were reused
+   unsigned long numMisses{};       // Number of results that were computed
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,237 @@
+
+#ifndef __mixr_terrain_PagedTerrain_HPP__
+#define __mixr_terrain_PagedTerrain_HPP__
+
+#include "mixr/terrain/ITerrain.hpp"
+#include "mixr/terrain/MappedFile.hpp"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mixr {
+namespace base { class Integer; class PairStream; }
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Class: PagedTerrain
+// Description: Memory mapped, lazily paged terrain elevation database of any
+//              number of DTED, SRTM (.hgt), DED and terrain cache cell files.
+//
+//    The cell files are memory mapped when the data is loaded (see reset()),
+//    and only their headers are read, so loading even a very large theater is
+//    quick and uses very little memory.  The elevation posts are paged in,
+//    on demand, as tiles of TILE_SIZE by TILE_SIZE posts, which are decoded
+//    from the mapped files and kept in a bounded, least recently used (LRU)
+//    tile cache.
+//
+//    The elevations are the same as the ones from the DtedFile, SrtmHgtFile,
+//    DedFile and TerrainCacheFile loaders; the cell format is selected by the
+//    file extension: ".dt0", ".dt1" or ".dt2" for DTED, ".hgt" for SRTM, ".ded"
+//    for DED and ".mtc" for terrain cache files.
+//
+// Factory name: PagedTerrain
+// Slots:
+//    files       <base::PairStream>  ! Cell file names, base::String, relative to 'path' (default: none)
+//    maxTiles    <base::Integer>     ! Max number of tiles in the tile cache; each tile is
+//                                    !   128KB (default: 1024)
+//
+// Example:
+//
+//    terrain: ( PagedTerrain
+//       path: "/data/dted/level1"
+//       files: { "w118/n34.dt1" "w118/n35.dt1" "w117/n34.dt1" "w117/n35.dt1" }
+//       maxTiles: 256
+//    )
+//
+// Notes:
+//    1) The ITerrain 'file' slot may also be used for a single cell file.
+//    2) Where cells overlap, the elevations are from the first cell in the list
+//       that contains the point.
+//    3) The min and max elevations are not known until all of the posts have
+//       been read, so they are zero, except for DED and terrain cache cells,
+//       which have them in their headers.
+//    4) DTED checksums are not verified.
+//    5) The query functions are thread safe; the tile cache is locked while
+//       they're running, except while a tile is paged in from its file, so the
+//       other threads aren't held up by the file's page faults.
+//------------------------------------------------------------------------------
+class PagedTerrain : public ITerrain
+{
+   DECLARE_SUBCLASS(PagedTerrain, ITerrain)
+
+public:
+   static const unsigned int TILE_SIZE{256};          // Tile size (posts)
+
+public:
+   PagedTerrain();
+
+   unsigned int getNumCells() const                   { return static_cast<unsigned int>(cells.size()); }
+   unsigned int getMaxTiles() const                   { return maxTiles; }    // Max number of tiles in the cache
+   unsigned int getNumTiles() const;                                          // Number of tiles in the cache
+   unsigned long getNumTileHits() const               { return numHits; }     // Tiles found in the cache
+   unsigned long getNumTileMisses() const             { return numMisses; }   // Tiles paged in
+
+   // Sets the max number of tiles in the cache (at least four)
+   virtual bool setMaxTiles(const unsigned int n);
+
+   // Maps a DTED, SRTM, DED or terrain cache cell file; returns true if successful
+   bool addFile(const char* const filename);
+
+   // ---
+   // simulation::Terrain interface
+   // ---
+
+   bool isDataLoaded() const override;
+
+   // Locates an array of (at least two) elevation points (and sets valid flags if found)
+   // returns the number of points found within this database
+   unsigned int getElevations(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of elevation and valdFlags arrays
+         const double lat,             // Starting latitude (degs)
+         const double lon,             // Starting longitude (degs)
+         const double direction,       // True direction (heading) angle of the data (degs)
+         const double maxRng,          // Range to last elevation point (meters)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates an elevation value (meters) for a given reference point and returns
+   // it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+   bool getElevation(
+         double* const elev,           // The elevation value (meters)
+         const double lat,             // Reference latitude (degs)
+         const double lon,             // Reference longitude (degs)
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates the elevations (meters) of an array of reference points, and sets
+   // their valid flags (if provided); returns the number of points found.
+   // The points are sorted by their cell and tile, so each tile is looked up
+   // once for all of the points that are on it.
+   unsigned int getElevationsBatch(
+         const double* const lats,     // Reference latitude array (degs)
+         const double* const lons,     // Reference longitude array (degs)
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found), or nullptr
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+protected:
+   enum class Format { DTED, SRTM, DED, CACHE };
+
+   // Mapped cell file
+   struct Cell {
+      MappedFile file;              // Mapped file
+      Format format{Format::DTED};  // File format
+      double swLat{}, swLon{};      // Southwest corner (degs)
+      double neLat{}, neLon{};      // Northeast corner (degs)
+      double latSpacing{};          // Spacing between latitude points (degs)
+      double lonSpacing{};          // Spacing between longitude points (degs)
+      unsigned int nptlat{};        // Number of points in latitude (rows)
+      unsigned int nptlong{};       // Number of points in longitude (columns)
+      std::size_t offset{};         // Offset to the first post (bytes)
+      std::size_t stride{};         // Offset between columns, or rows for SRTM (bytes)
+      bool hasElevations{};         // Min and max elevations are known (DED and CACHE)
+      double minElev{}, maxElev{};  // Min and max elevations (meters)
+   };
+
+   // Longitude (degs) of the point on the cell's side of the 180 degree meridian
+   static double cellLongitude(const Cell& cell, const double lon)
+   {
+      if (lon - cell.swLon >= 180.0) return lon - 360.0;
+      if (cell.swLon - lon > 180.0) return lon + 360.0;
+      return lon;
+   }
+
+   // True if the cell contains the point
+   static bool isInCell(const Cell& cell, const double lat, const double lon)
+   {
+      const double x{cellLongitude(cell, lon)};
+      return (lat >= cell.swLat && lat <= cell.neLat && x >= cell.swLon && x <= cell.neLon);
+   }
+
+   const Cell* getCell(const unsigned int i) const    { return (i < cells.size() ? cells[i].get() : nullptr); }
+
+   // Locks and unlocks the tile cache
+   void lockTiles() const;
+   void unlockTiles() const;
+
+   // Unlocks the tile cache while a file is read or mapped, and then locks it
+   // again; the cells are not unmapped (see lockTilesNoIo()) in between
+   void suspendTilesLock() const;
+   void resumeTilesLock() const;
+
+   // Locks the tile cache once no files are being read or mapped (see suspendTilesLock())
+   void lockTilesNoIo() const;
+
+   // Returns the index of the first cell that contains the point, or -1 if none;
+   // called with the tile cache locked
+   virtual int findCell(const double lat, const double lon) const;
+
+   // Maps a cell file; returns the new cell, or nullptr if the file couldn't
+   // be mapped or isn't a valid DTED, SRTM, DED or terrain cache cell
+   Cell* mapCell(const std::string& filename) const;
+
+   // Adds a mapped cell, and returns its index; called with the tile cache locked
+   int insertCell(Cell* const cell) const;
+
+   // Pages in the tile containing the point, if it isn't already in the cache
+   void prefetch(const double lat, const double lon) const;
+
+   // Elevation (meters) of the point in cell 'icell', which contains the point;
+   // called with the tile cache locked
+   double cellElevation(const unsigned int icell, const double lat, const double lon, const bool interp) const;
+
+   // Returns the post at [ icol ][ irow ] of cell 'icell', paging in its tile, if needed;
+   // called with the tile cache locked
+   short getPost(const unsigned int icell, const unsigned int icol, const unsigned int irow) const;
+
+   void clearData() override;
+   bool loadData() override;
+
+private:
+   // Cached tile of posts; column major, TILE_SIZE posts per column
+   struct Tile {
+      std::uint64_t key{};
+      std::vector<short> posts;
+   };
+
+   static std::uint64_t tileKey(const unsigned int icell, const unsigned int tcol, const unsigned int trow);
+
+   bool mapDted(Cell* const cell) const;
+   bool mapSrtm(Cell* const cell, const std::string& name) const;
+   bool mapDed(Cell* const cell) const;
+   bool mapCache(Cell* const cell) const;
+   const Tile* findTile(const unsigned int icell, const unsigned int tcol, const unsigned int trow) const;
+   void readTile(Tile* const tile, const Cell& cell, const unsigned int tcol, const unsigned int trow) const;
+
+   std::vector<std::string> fileNames;          // Cell file names (from the 'files' slot)
+   mutable std::vector<std::unique_ptr<Cell>> cells;   // Mapped cells (see insertCell())
+   unsigned int maxTiles{1024};                 // Max number of tiles in the cache
+
+   mutable std::list<Tile> tiles;               // Tile cache; most recently used first
+   mutable std::list<Tile> spares;              // Evicted tiles, which are reused when tiles are paged in
+   mutable std::unordered_map<std::uint64_t, std::list<Tile>::iterator> tileMap;   // Tiles by key
+   mutable const Tile* lastTile{};              // Most recently used tile
+   mutable int lastCell{-1};                    // Most recently found cell
+   mutable unsigned long numHits{};             // Tiles found in the cache
+   mutable unsigned long numMisses{};           // Tiles paged in
+   mutable long semaphore{};                    // Tile cache semaphore
+   mutable unsigned int numIo{};                // Number of files being read or mapped without the lock
+
+private:
+   // slot table helper methods
+   bool setSlotFiles(const base::PairStream* const);
+   bool setSlotMaxTiles(const base::Integer* const);
+};
+
+}
+}
+
+#endif
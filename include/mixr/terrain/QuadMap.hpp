@@ -13,6 +13,12 @@ class DataFile;
 // Class: QuadMap
 // Description: Manage up to 4 elevation files in a 2x2 pattern
 // Factory name: QuadMap
+//
+// Notes:
+//    1) targetOcculting() is passed to the first data file that contains the
+//    entire line of sight, if none of the files before it overlap the line of
+//    sight (so that the data file can use its max elevation pyramid; see
+//    DataFile), otherwise the default ITerrain::targetOcculting() is used.
 //------------------------------------------------------------------------------
 class QuadMap : public ITerrain
 {
@@ -31,6 +37,9 @@ public:
 
    bool isDataLoaded() const override;
 
+   // Changes when any of our data files changes
+   unsigned int getDataVersion() const override;
+
    // Locates an array of (at least two) elevation points (and sets valid flags if found)
    // returns the number of points found within this QuadMap
    unsigned int getElevations(
@@ -53,6 +62,16 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const override;
 
+   // Returns true if a target point is occulted by the terrain as seen from the ref point
+   bool targetOcculting(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const double refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const double tgtAlt           // Target altitude (meters)
+      ) const override;
+
    void reset() override;
 
 protected:
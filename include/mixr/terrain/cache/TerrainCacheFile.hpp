@@ -0,0 +1,122 @@
+
+#ifndef __mixr_terrain_TerrainCacheFile_HPP__
+#define __mixr_terrain_TerrainCacheFile_HPP__
+
+#include "mixr/terrain/DataFile.hpp"
+#include "mixr/terrain/MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mixr {
+namespace terrain {
+
+//------------------------------------------------------------------------------
+// Class: TerrainCacheFile
+//
+// Description: Terrain cache file loader and converter.
+//
+// A terrain cache file holds one cell of elevation posts, already in the form
+// that DataFile uses, so loading it is just memory mapping the file: there's
+// no parsing, byte assembly, checksums or max elevation pyramid to build.
+// Use convert() to create a cache file from a DTED, SRTM (.hgt) or DED cell
+// file, or write() to create one from any loaded DataFile.
+//
+// File format (all values are little-endian):
+//
+//    Header (HEADER_SIZE bytes)
+//       [  0]  char[8]   MAGIC ("MIXRTRC" and a null)
+//       [  8]  uint32    VERSION
+//       [ 12]  uint32    nptlat          Number of latitude points (rows)
+//       [ 16]  uint32    nptlong         Number of longitude points (columns)
+//       [ 20]  uint32    numLevels       Number of max elevation pyramid levels
+//       [ 24]  float64   swLat, swLon    Southwest corner (degs)
+//       [ 40]  float64   neLat, neLon    Northeast corner (degs)
+//       [ 56]  float64   latSpacing      Spacing between latitude points (degs)
+//       [ 64]  float64   lonSpacing      Spacing between longitude points (degs)
+//       [ 72]  float64   minElev         Min elevation (meters)
+//       [ 80]  float64   maxElev         Max elevation (meters)
+//       [ 88]  int16     voidValue       Value of void (missing) posts
+//       [ 96]  uint64    postsOffset     Offset to the elevation posts
+//       [104]  uint64    pyramidOffset   Offset to the max elevation pyramid
+//
+//    Elevation posts (at postsOffset, which is aligned to ALIGNMENT bytes)
+//       int16[nptlong][nptlat]  -- column major, south to north (meters)
+//
+//    Max elevation pyramid (at pyramidOffset, which is aligned as well)
+//       numLevels levels, one after the other, as DataFile's max elevation
+//       pyramid (see DataFile::getMaxPyramidLevel())
+//
+// The columns of posts are used directly from the mapped file, on little-
+// endian hosts, so the posts are only read from the disk when they're used.
+// On big-endian hosts, they're copied (and swapped) when the file is loaded.
+//
+// Factory name: TerrainCacheFile
+// Slots:
+//   N/A
+//
+// Example:
+//
+//    // Convert once (or use the tools/terrainCacheConvert program) ...
+//    TerrainCacheFile::convert("/data/dted/w118/n34.dt1", "/data/cache/n34w118.mtc");
+//
+//    // ... and then load the cache file
+//    terrain: ( TerrainCacheFile path: "/data/cache" file: "n34w118.mtc" )
+//
+// Notes:
+//    1) The cache files may also be used by PagedTerrain and GlobalTerrain
+//       (".mtc" file extension).
+//------------------------------------------------------------------------------
+class TerrainCacheFile : public DataFile
+{
+   DECLARE_SUBCLASS(TerrainCacheFile, DataFile)
+
+public:
+   static const char MAGIC[8];
+   static const std::uint32_t VERSION{1};
+   static const std::size_t HEADER_SIZE{128};      // Header (bytes)
+   static const std::size_t ALIGNMENT{64};         // Alignment of the posts and pyramid (bytes)
+
+   // Header of a terrain cache file
+   struct Header {
+      std::uint32_t nptlat{};
+      std::uint32_t nptlong{};
+      std::uint32_t numLevels{};
+      double swLat{}, swLon{};
+      double neLat{}, neLon{};
+      double latSpacing{};
+      double lonSpacing{};
+      double minElev{}, maxElev{};
+      short voidValue{-32767};
+      std::uint64_t postsOffset{};
+      std::uint64_t pyramidOffset{};
+   };
+
+public:
+   TerrainCacheFile();
+
+   // Decodes and checks the header of a terrain cache file of 'size' bytes;
+   // returns true if it's a valid terrain cache file
+   static bool readHeader(Header* const hdr, const unsigned char* const data, const std::size_t size);
+
+   // Writes the loaded data file to a terrain cache file; returns true if successful
+   static bool write(const DataFile* const src, const char* const filename);
+
+   // Converts a DTED (.dt0, .dt1 or .dt2), SRTM (.hgt) or DED (.ded) cell file
+   // to a terrain cache file; returns true if successful
+   static bool convert(const char* const inFilename, const char* const outFilename);
+
+protected:
+   void clearData() override;
+
+private:
+   bool loadData() override;
+
+   MappedFile file;           // Mapped terrain cache file
+   bool mappedColumns{};      // Columns are in the mapped file
+};
+
+}
+}
+
+#endif
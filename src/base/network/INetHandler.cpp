@@ -24,6 +24,7 @@
 
 #include "mixr/base/network/INetHandler.hpp"
 
+#include <cstddef>
 #include <iostream>
 
 namespace mixr {
@@ -56,6 +57,40 @@ bool INetHandler::initNetwork(const bool noWaitFlag)
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// sendBatch() -- send 'n' packets, one at a time
+//------------------------------------------------------------------------------
+unsigned int INetHandler::sendBatch(const char* const* const packets, const int* const sizes, const unsigned int n)
+{
+    unsigned int num{};
+    if (packets != nullptr && sizes != nullptr) {
+        while (num < n && sendData(packets[num], sizes[num])) {
+            num++;
+        }
+    }
+    return num;
+}
+
+//------------------------------------------------------------------------------
+// recvBatch() -- receive up to 'n' packets, one at a time
+//------------------------------------------------------------------------------
+unsigned int INetHandler::recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n)
+{
+    unsigned int num{};
+    if (buffer != nullptr && sizes != nullptr && maxSize > 0) {
+        bool more{true};
+        while (num < n && more) {
+            const unsigned int size{recvData(buffer + static_cast<std::size_t>(num) * maxSize, maxSize)};
+            if (size > 0) {
+                sizes[num++] = size;
+            } else {
+                more = false;
+            }
+        }
+    }
+    return num;
+}
+
 //------------------------------------------------------------------------------
 // init() -- initialize the network
 //------------------------------------------------------------------------------
@@ -25,6 +25,8 @@
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/util/str_utils.hpp"
 
+#include <cerrno>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <cstdint>
@@ -343,6 +345,125 @@ unsigned int IPosixHandler::recvData(char* const packet, const int maxSize)
    return n;
 }
 
+// -------------------------------------------------------------
+// sendBatch() -- Send 'n' packets using as few system calls
+//                as we can.
+// -------------------------------------------------------------
+unsigned int IPosixHandler::sendBatch(const char* const* const packets, const int* const sizes, const unsigned int n)
+{
+#if defined(__linux__)
+    if (socketNum == INVALID_SOCKET || packets == nullptr || sizes == nullptr) return 0;
+
+    // Destination address
+    struct sockaddr_in addr;        // Working address structure
+    bzero(&addr, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = netAddr;
+    addr.sin_port = htons(port);
+
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovecs[MAX_BATCH];
+
+    unsigned int num{};
+    bool ok{true};
+    while (num < n && ok) {
+        const unsigned int count{(n - num) < MAX_BATCH ? (n - num) : MAX_BATCH};
+        bzero(msgs, sizeof(msgs[0]) * count);
+        for (unsigned int i = 0; i < count; i++) {
+            iovecs[i].iov_base = const_cast<char*>(packets[num + i]);
+            iovecs[i].iov_len = sizes[num + i];
+            msgs[i].msg_hdr.msg_name = &addr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int result{::sendmmsg(socketNum, msgs, count, 0)};
+        if (result > 0) {
+            num += result;
+        } else if (result < 0 && errno == EINTR) {
+            // Interrupted before anything was sent; try again
+        } else {
+            // Send the rest one at a time; sendData() reports its errors
+            while (num < n && sendData(packets[num], sizes[num])) {
+                num++;
+            }
+            ok = false;
+        }
+    }
+    return num;
+#else
+    return BaseClass::sendBatch(packets, sizes, n);
+#endif
+}
+
+// -------------------------------------------------------------
+// recvBatch() -- Receive up to 'n' packets using as few system
+//                calls as we can, and possible ignore our own
+//                local port messages.  Packets larger than
+//                'maxSize' are dropped and counted.
+// -------------------------------------------------------------
+unsigned int IPosixHandler::recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n)
+{
+#if defined(__linux__)
+   if (socketNum == INVALID_SOCKET || buffer == nullptr || sizes == nullptr || maxSize <= 0) return 0;
+
+   fromAddr1 = INADDR_NONE;
+   fromPort1 = 0;
+
+   struct mmsghdr msgs[MAX_BATCH];
+   struct iovec iovecs[MAX_BATCH];
+   struct sockaddr_in raddrs[MAX_BATCH];
+
+   unsigned int num{};
+   int flags{MSG_WAITFORONE};
+   bool more{true};
+   while (num < n && more) {
+
+      // Receive directly into the next free packets of the buffer
+      const unsigned int first{num};
+      const unsigned int count{(n - num) < MAX_BATCH ? (n - num) : MAX_BATCH};
+      bzero(msgs, sizeof(msgs[0]) * count);
+      for (unsigned int i = 0; i < count; i++) {
+         iovecs[i].iov_base = buffer + static_cast<std::size_t>(first + i) * maxSize;
+         iovecs[i].iov_len = maxSize;
+         msgs[i].msg_hdr.msg_name = &raddrs[i];
+         msgs[i].msg_hdr.msg_namelen = sizeof(raddrs[i]);
+         msgs[i].msg_hdr.msg_iov = &iovecs[i];
+         msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      const int result{::recvmmsg(socketNum, msgs, count, flags, nullptr)};
+      if (result > 0) {
+         // Keep the packets that we're not ignoring (moving them down over any that we are)
+         for (unsigned int i = 0; i < static_cast<unsigned int>(result); i++) {
+            const std::uint16_t rport{ntohs(raddrs[i].sin_port)};
+            if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+               // Too large for the buffer: we only have part of it
+               numTruncated++;
+            } else if (msgs[i].msg_len > 0 && (ignoreSourcePort == 0 || rport != ignoreSourcePort)) {
+               char* const packet{buffer + static_cast<std::size_t>(num) * maxSize};
+               if (packet != iovecs[i].iov_base) {
+                  std::memmove(packet, iovecs[i].iov_base, msgs[i].msg_len);
+               }
+               sizes[num++] = msgs[i].msg_len;
+               fromAddr1 = raddrs[i].sin_addr.s_addr;
+               fromPort1 = rport;
+            }
+         }
+         // More to read if we filled this batch; but don't wait for them
+         more = (static_cast<unsigned int>(result) == count);
+         flags = MSG_DONTWAIT;
+      } else {
+         more = false;
+      }
+   }
+   return num;
+#else
+   return BaseClass::recvBatch(buffer, maxSize, sizes, n);
+#endif
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
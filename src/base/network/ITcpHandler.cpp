@@ -142,6 +142,22 @@ bool ITcpHandler::sendData(const char* const packet, const int size)
     return true;
 }
 
+// -------------------------------------------------------------
+// sendBatch() -- Send 'n' packets, one sendData() at a time
+// -------------------------------------------------------------
+unsigned int ITcpHandler::sendBatch(const char* const* const packets, const int* const sizes, const unsigned int n)
+{
+    return INetHandler::sendBatch(packets, sizes, n);
+}
+
+// -------------------------------------------------------------
+// recvBatch() -- Receive up to 'n' packets, one recvData() at a time
+// -------------------------------------------------------------
+unsigned int ITcpHandler::recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n)
+{
+    return INetHandler::recvBatch(buffer, maxSize, sizes, n);
+}
+
 // -------------------------------------------------------------
 // recvData() -- Receive data from our connected TCP socket
 // -------------------------------------------------------------
@@ -29,6 +29,18 @@ double Func1::f(const double iv1, IFStorage* const s) const
    return value;
 }
 
+void Func1::f(const double* const iv1, double* const out, const unsigned int n, IFStorage* const s) const
+{
+   const auto p = static_cast<const Table1*>(getTable());
+   if (p != nullptr) {
+      p->lfi(iv1, out, n, s);
+   } else {
+      for (unsigned int i = 0; i < n; i++) {
+         out[i] = f(iv1[i], s);
+      }
+   }
+}
+
 bool Func1::setSlotLfiTable(const ITable* const msg)
 {
    bool ok {};
@@ -29,6 +29,18 @@ double Func2::f(const double iv1, const double iv2, IFStorage* const s) const
    return value;
 }
 
+void Func2::f(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const s) const
+{
+   const auto p = static_cast<const Table2*>(getTable());
+   if (p != nullptr) {
+      p->lfi(iv1, iv2, out, n, s);
+   } else {
+      for (unsigned int i = 0; i < n; i++) {
+         out[i] = f(iv1[i], iv2[i], s);
+      }
+   }
+}
+
 bool Func2::setSlotLfiTable(const ITable* const msg)
 {
    bool ok {};
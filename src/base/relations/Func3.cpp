@@ -29,6 +29,18 @@ double Func3::f(const double iv1, const double iv2, const double iv3, IFStorage*
    return value;
 }
 
+void Func3::f(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const s) const
+{
+   const auto p = static_cast<const Table3*>(getTable());
+   if (p != nullptr) {
+      p->lfi(iv1, iv2, iv3, out, n, s);
+   } else {
+      for (unsigned int i = 0; i < n; i++) {
+         out[i] = f(iv1[i], iv2[i], iv3[i], s);
+      }
+   }
+}
+
 bool Func3::setSlotLfiTable(const ITable* const msg)
 {
    bool ok {};
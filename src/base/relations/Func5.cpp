@@ -30,6 +30,18 @@ double Func5::f(const double iv1, const double iv2, const double iv3, const doub
    return value;
 }
 
+void Func5::f(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const out, const unsigned int n, IFStorage* const s) const
+{
+   const auto p = static_cast<const Table5*>(getTable());
+   if (p != nullptr) {
+      p->lfi(iv1, iv2, iv3, iv4, iv5, out, n, s);
+   } else {
+      for (unsigned int i = 0; i < n; i++) {
+         out[i] = f(iv1[i], iv2[i], iv3[i], iv4[i], iv5[i], s);
+      }
+   }
+}
+
 bool Func5::setSlotLfiTable(const ITable* const msg)
 {
    bool ok {};
@@ -17,11 +17,13 @@ IMPLEMENT_PARTIAL_SUBCLASS(ITable, "ITable")
 BEGIN_SLOTTABLE(ITable)
     "data",          // Data table
     "extrapolate",   // Extrapolate beyond data
+    "gridIndex",     // Breakpoint grid indexes
 END_SLOTTABLE(ITable)
 
 BEGIN_SLOT_MAP(ITable)
     ON_SLOT(1, setSlotDataTable, IList)
     ON_SLOT(2, setSlotExtrapolationEnabled, Boolean)
+    ON_SLOT(3, setSlotGridIndexEnabled, Boolean)
 END_SLOT_MAP()
 
 ITable::ITable()
@@ -43,7 +45,7 @@ ITable::ITable(const double* dtbl, const unsigned int dsize)
     }
 }
 
-ITable::ITable(const ITable& org) : valid(false), extFlg(false)
+ITable::ITable(const ITable& org) : valid(false), extFlg(false), gridFlg(false)
 {
     STANDARD_CONSTRUCTOR()
     dtable = nullptr;
@@ -89,6 +91,7 @@ void ITable::copyData(const ITable& org, const bool cc)
     }
     valid = org.valid;
     extFlg = org.extFlg;
+    gridFlg = org.gridFlg;
 }
 
 void ITable::deleteData()
@@ -132,6 +135,46 @@ bool ITable::setSlotExtrapolationEnabled(const Boolean* const msg)
    return ok;
 }
 
+//------------------------------------------------------------------------------
+// setGridIndexEnabled() -- set the breakpoint grid indexes enabled flag
+//------------------------------------------------------------------------------
+bool ITable::setGridIndexEnabled(const bool flg)
+{
+   gridFlg = flg;
+   updateGridIndexes();
+   return true;
+}
+
+bool ITable::setSlotGridIndexEnabled(const Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setGridIndexEnabled( msg->asBool() );
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// updateGridIndexes() -- (re)builds the breakpoint grid indexes
+//------------------------------------------------------------------------------
+void ITable::updateGridIndexes()
+{
+}
+
+//------------------------------------------------------------------------------
+// getTableStorage() -- returns the TableStorage of 'f', or nullptr if 'f' is
+// nullptr; throws an ExpInvalidFStorage exception if it's the wrong type
+//------------------------------------------------------------------------------
+TableStorage* ITable::getTableStorage(IFStorage* const f)
+{
+   TableStorage* s{};
+   if (f != nullptr) {
+      s = dynamic_cast<TableStorage*>(f);
+      if (s == nullptr) throw new ExpInvalidFStorage();
+   }
+   return s;
+}
+
 //------------------------------------------------------------------------------
 // findMinMax() -- find the minimum and maximum values of the table
 //------------------------------------------------------------------------------
@@ -51,6 +51,13 @@ double Polynomial::f(const double x, IFStorage* const) const
    return result;
 }
 
+void Polynomial::f(const double* const x, double* const out, const unsigned int n, IFStorage* const s) const
+{
+   for (unsigned int i = 0; i < n; i++) {
+      out[i] = f(x[i], s);
+   }
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -53,6 +53,7 @@ void Table1::copyData(const Table1& org, const bool cc)
         for (unsigned int i = 0; i < nx; i++) xtable[i] = org.xtable[i];
     }
     else xtable = nullptr;
+    xGrid = org.xGrid;
     valid = isValid();
 }
 
@@ -127,17 +128,40 @@ double Table1::getMaxX() const
 //  1D LFI
 //------------------------------------------------------------------------------
 double Table1::lfi(const double iv1, IFStorage* const f) const
+{
+   double value{};
+   lfi(&iv1, &value, 1, f);
+   return value;
+}
+
+//------------------------------------------------------------------------------
+//  1D batch LFI -- interpolates 'n' points
+//------------------------------------------------------------------------------
+void Table1::lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
+   TableStorage* const s{getTableStorage(f)};
+
+   // The breakpoint found for each point is where the next search starts
+   unsigned int xbp{(s != nullptr) ? s->xbp : 0};
 
-      return lfi_1D(iv1, getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled(), &s->xbp);
-   } else {
-      return lfi_1D(iv1, getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled());
+   for (unsigned int i = 0; i < n; i++) {
+      xGrid.update(iv1[i], &xbp);
+      out[i] = lfi_1D(iv1[i], getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled(), &xbp);
    }
+
+   if (s != nullptr) s->xbp = xbp;
+}
+
+//------------------------------------------------------------------------------
+// updateGridIndexes() -- (re)builds the breakpoint grid indexes
+//------------------------------------------------------------------------------
+void Table1::updateGridIndexes()
+{
+   BaseClass::updateGridIndexes();
+   if (isGridIndexEnabled()) xGrid.build(xtable, nx);
+   else xGrid.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -148,6 +172,7 @@ bool Table1::setXBreakpoints1(const IList* const sxb1obj)
     if (sxb1obj != nullptr) {
         loadVector(*sxb1obj, &xtable, &nx);
         valid = isValid();
+        updateGridIndexes();
     }
     return true;
 }
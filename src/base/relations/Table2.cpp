@@ -54,6 +54,7 @@ void Table2::copyData(const Table2& org, const bool cc)
         for (unsigned int i = 0; i < ny; i++) ytable[i] = org.ytable[i];
     }
     else ytable = nullptr;
+    yGrid = org.yGrid;
     valid = isValid();
 }
 
@@ -135,40 +136,76 @@ double Table2::getMaxY() const
 //------------------------------------------------------------------------------
 double Table2::lfi(const double iv1, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_2D( iv1, ytable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp );
-   } else {
-      return lfi_2D( iv1, ytable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table2::lfi(const double iv1, const double iv2, IFStorage* const f) const
+{
+   double value{};
+   lfiBatch(&iv1, &iv2, &value, 1, f);
+   return value;
+}
+
+//------------------------------------------------------------------------------
+//  2D batch LFIs -- interpolate 'n' points
+//------------------------------------------------------------------------------
+void Table2::lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, nullptr, out, n, f);
+}
+
+void Table2::lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, out, n, f);
+}
+
+//------------------------------------------------------------------------------
+// lfiBatch() -- interpolates 'n' points; the missing (nullptr) independent
+// variables are at their first breakpoints
+//------------------------------------------------------------------------------
+void Table2::lfiBatch(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_2D( iv1, iv2, getXData(), getNumXPoints(), getYData(),
-                         getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp );
-   } else {
-      return lfi_2D( iv1, iv2, getXData(), getNumXPoints(), getYData(),
-                         getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled() );
+   TableStorage* const s{getTableStorage(f)};
+
+   // The breakpoints found for each point are where the next searches start
+   unsigned int xbp{}, ybp{};
+   if (s != nullptr) {
+      xbp = s->xbp;
+      ybp = s->ybp;
+   }
+
+   for (unsigned int i = 0; i < n; i++) {
+      const double x{iv1[i]};
+      const double y{(iv2 != nullptr) ? iv2[i] : getYData()[0]};
+
+      getXGrid().update(x, &xbp);
+      yGrid.update(y, &ybp);
+
+      out[i] = lfi_2D( x, y,
+                     getXData(), getNumXPoints(),
+                     getYData(), getNumYPoints(),
+                     getDataTable(), isExtrapolationEnabled(),
+                     &xbp, &ybp );
    }
+
+   if (s != nullptr) {
+      s->xbp = xbp;
+      s->ybp = ybp;
+   }
+}
+
+//------------------------------------------------------------------------------
+// updateGridIndexes() -- (re)builds the breakpoint grid indexes
+//------------------------------------------------------------------------------
+void Table2::updateGridIndexes()
+{
+   BaseClass::updateGridIndexes();
+   if (isGridIndexEnabled()) yGrid.build(ytable, ny);
+   else yGrid.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -179,6 +216,7 @@ bool Table2::setYBreakpoints2(const IList* const syb2obj)
     if (syb2obj != nullptr) {
         loadVector(*syb2obj, &ytable, &ny);
         valid = isValid();
+        updateGridIndexes();
     }
     return true;
 }
@@ -55,6 +55,7 @@ void Table3::copyData(const Table3& org, const bool cc)
         for (unsigned int i = 0; i < nz; i++) ztable[i] = org.ztable[i];
     }
     else ztable = nullptr;
+    zGrid = org.zGrid;
     valid = isValid();
 }
 
@@ -138,62 +139,95 @@ double Table3::getMaxZ() const
 //------------------------------------------------------------------------------
 double Table3::lfi(const double iv1, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   const double* y_data = getYData();
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_3D( iv1, y_data[0], ztable[0], getXData(), getNumXPoints(),
-                         y_data, getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp );
-   } else {
-      return lfi_3D( iv1, y_data[0], ztable[0], getXData(), getNumXPoints(),
-                         y_data, getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, nullptr, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table3::lfi(const double iv1, const double iv2, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_3D( iv1, iv2, ztable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp );
-   } else {
-      return lfi_3D( iv1, iv2, ztable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getDataTable(), isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, &iv2, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table3::lfi(const double iv1, const double iv2, const double iv3, IFStorage* const f) const
+{
+   double value{};
+   lfiBatch(&iv1, &iv2, &iv3, &value, 1, f);
+   return value;
+}
+
+//------------------------------------------------------------------------------
+//  3D batch LFIs -- interpolate 'n' points
+//------------------------------------------------------------------------------
+void Table3::lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, nullptr, nullptr, out, n, f);
+}
+
+void Table3::lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, nullptr, out, n, f);
+}
+
+void Table3::lfi(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, iv3, out, n, f);
+}
+
+//------------------------------------------------------------------------------
+// lfiBatch() -- interpolates 'n' points; the missing (nullptr) independent
+// variables are at their first breakpoints
+//------------------------------------------------------------------------------
+void Table3::lfiBatch(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_3D( iv1, iv2, iv3, getXData(), getNumXPoints(), getYData(),
-                         getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp );
-   } else {
-      return lfi_3D( iv1, iv2, iv3, getXData(), getNumXPoints(), getYData(),
-                         getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
+   TableStorage* const s{getTableStorage(f)};
+
+   // The breakpoints found for each point are where the next searches start
+   unsigned int xbp{}, ybp{}, zbp{};
+   if (s != nullptr) {
+      xbp = s->xbp;
+      ybp = s->ybp;
+      zbp = s->zbp;
+   }
+
+   for (unsigned int i = 0; i < n; i++) {
+      const double x{iv1[i]};
+      const double y{(iv2 != nullptr) ? iv2[i] : getYData()[0]};
+      const double z{(iv3 != nullptr) ? iv3[i] : getZData()[0]};
+
+      getXGrid().update(x, &xbp);
+      getYGrid().update(y, &ybp);
+      zGrid.update(z, &zbp);
+
+      out[i] = lfi_3D( x, y, z,
+                     getXData(), getNumXPoints(),
+                     getYData(), getNumYPoints(),
+                     getZData(), getNumZPoints(),
+                     getDataTable(), isExtrapolationEnabled(),
+                     &xbp, &ybp, &zbp );
+   }
+
+   if (s != nullptr) {
+      s->xbp = xbp;
+      s->ybp = ybp;
+      s->zbp = zbp;
    }
 }
 
+//------------------------------------------------------------------------------
+// updateGridIndexes() -- (re)builds the breakpoint grid indexes
+//------------------------------------------------------------------------------
+void Table3::updateGridIndexes()
+{
+   BaseClass::updateGridIndexes();
+   if (isGridIndexEnabled()) zGrid.build(ztable, nz);
+   else zGrid.clear();
+}
+
 //------------------------------------------------------------------------------
 // setZBreakpoints3() -- for Table3
 //------------------------------------------------------------------------------
@@ -202,6 +236,7 @@ bool Table3::setZBreakpoints3(const IList* const szb3obj)
     if (szb3obj != nullptr) {
         loadVector(*szb3obj, &ztable, &nz);
         valid = isValid();
+        updateGridIndexes();
     }
     return true;
 }
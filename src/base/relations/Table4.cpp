@@ -56,6 +56,7 @@ void Table4::copyData(const Table4& org, const bool cc)
         for (unsigned int i = 0; i < nw; i++) wtable[i] = org.wtable[i];
     }
     else wtable = nullptr;
+    wGrid = org.wGrid;
     valid = isValid();
 }
 
@@ -152,90 +153,110 @@ double Table4::getMaxW() const
 //------------------------------------------------------------------------------
 double Table4::lfi(const double iv1, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   const double* y_data{getYData()};
-   const double* z_data{getZData()};
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_4D( iv1, y_data[0], z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   }
-   else {
-      return lfi_4D( iv1, y_data[0], z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, nullptr, nullptr, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table4::lfi(const double iv1, const double iv2, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   const double* z_data{getZData()};
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_4D( iv1, iv2, z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   } else {
-      return lfi_4D( iv1, iv2, z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, &iv2, nullptr, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table4::lfi(const double iv1, const double iv2, const double iv3, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_4D( iv1, iv2, iv3, wtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   } else {
-      return lfi_4D( iv1, iv2, iv3, wtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, &iv2, &iv3, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table4::lfi(const double iv1, const double iv2, const double iv3, const double iv4, IFStorage* const f) const
+{
+   double value{};
+   lfiBatch(&iv1, &iv2, &iv3, &iv4, &value, 1, f);
+   return value;
+}
+
+//------------------------------------------------------------------------------
+//  4D batch LFIs -- interpolate 'n' points
+//------------------------------------------------------------------------------
+void Table4::lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, nullptr, nullptr, nullptr, out, n, f);
+}
+
+void Table4::lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, nullptr, nullptr, out, n, f);
+}
+
+void Table4::lfi(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, iv3, nullptr, out, n, f);
+}
+
+void Table4::lfi(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, iv3, iv4, out, n, f);
+}
+
+//------------------------------------------------------------------------------
+// lfiBatch() -- interpolates 'n' points; the missing (nullptr) independent
+// variables are at their first breakpoints
+//------------------------------------------------------------------------------
+void Table4::lfiBatch(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const out, const unsigned int n, IFStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-       const auto s = dynamic_cast<TableStorage*>(f);
-       if (s == nullptr) throw new ExpInvalidFStorage();
-
-       return lfi_4D( iv1, iv2, iv3, iv4, getXData(), getNumXPoints(),
-                           getYData(), getNumYPoints(), getZData(),
-                           getNumZPoints(), getWData(), getNumWPoints(),
-                           getDataTable(), isExtrapolationEnabled(),
-                           &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   } else {
-       return lfi_4D( iv1, iv2, iv3, iv4, getXData(), getNumXPoints(),
-                           getYData(), getNumYPoints(), getZData(),
-                           getNumZPoints(), getWData(), getNumWPoints(),
-                           getDataTable(), isExtrapolationEnabled() );
+   TableStorage* const s{getTableStorage(f)};
+
+   // The breakpoints found for each point are where the next searches start
+   unsigned int xbp{}, ybp{}, zbp{}, wbp{};
+   if (s != nullptr) {
+      xbp = s->xbp;
+      ybp = s->ybp;
+      zbp = s->zbp;
+      wbp = s->wbp;
    }
+
+   for (unsigned int i = 0; i < n; i++) {
+      const double x{iv1[i]};
+      const double y{(iv2 != nullptr) ? iv2[i] : getYData()[0]};
+      const double z{(iv3 != nullptr) ? iv3[i] : getZData()[0]};
+      const double w{(iv4 != nullptr) ? iv4[i] : getWData()[0]};
+
+      getXGrid().update(x, &xbp);
+      getYGrid().update(y, &ybp);
+      getZGrid().update(z, &zbp);
+      wGrid.update(w, &wbp);
+
+      out[i] = lfi_4D( x, y, z, w,
+                     getXData(), getNumXPoints(),
+                     getYData(), getNumYPoints(),
+                     getZData(), getNumZPoints(),
+                     getWData(), getNumWPoints(),
+                     getDataTable(), isExtrapolationEnabled(),
+                     &xbp, &ybp, &zbp, &wbp );
+   }
+
+   if (s != nullptr) {
+      s->xbp = xbp;
+      s->ybp = ybp;
+      s->zbp = zbp;
+      s->wbp = wbp;
+   }
+}
+
+//------------------------------------------------------------------------------
+// updateGridIndexes() -- (re)builds the breakpoint grid indexes
+//------------------------------------------------------------------------------
+void Table4::updateGridIndexes()
+{
+   BaseClass::updateGridIndexes();
+   if (isGridIndexEnabled()) wGrid.build(wtable, nw);
+   else wGrid.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -246,6 +267,7 @@ bool Table4::setWBreakpoints4(const IList* const swb4obj)
     if (swb4obj != nullptr) {
         loadVector(*swb4obj, &wtable, &nw);
         valid = isValid();
+        updateGridIndexes();
     }
     return true;
 }
@@ -60,6 +60,7 @@ void Table5::copyData(const Table5& org, const bool cc)
         for (unsigned int i = 0; i < nv; i++) vtable[i] = org.vtable[i];
     }
     else vtable = nullptr;
+    vGrid = org.vGrid;
     valid = isValid();
 }
 
@@ -140,125 +141,129 @@ double Table5::getMaxV() const
 //------------------------------------------------------------------------------
 double Table5::lfi(const double iv1, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   const double* y_data{getYData()};
-   const double* z_data{getZData()};
-   const double* w_data{getWData()};
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_5D( iv1, y_data[0], z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   } else {
-      return lfi_5D( iv1, y_data[0], z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled());
-   }
+   double value{};
+   lfiBatch(&iv1, nullptr, nullptr, nullptr, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table5::lfi(const double iv1, const double iv2, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   const double* z_data{getZData()};
-   const double* w_data{getWData()};
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_5D( iv1, iv2, z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   } else {
-      return lfi_5D( iv1, iv2, z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled());
-   }
+   double value{};
+   lfiBatch(&iv1, &iv2, nullptr, nullptr, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table5::lfi(const double iv1, const double iv2, const double iv3, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   const double* w_data{getWData()};
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_5D( iv1, iv2, iv3, w_data[0], vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   } else {
-      return lfi_5D( iv1, iv2, iv3, w_data[0], vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled());
-   }
+   double value{};
+   lfiBatch(&iv1, &iv2, &iv3, nullptr, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table5::lfi(const double iv1, const double iv2, const double iv3, const double iv4, IFStorage* const f) const
 {
-   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
-
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_5D( iv1, iv2, iv3, iv4, vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   } else {
-      return lfi_5D( iv1, iv2, iv3, iv4, vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   double value{};
+   lfiBatch(&iv1, &iv2, &iv3, &iv4, nullptr, &value, 1, f);
+   return value;
 }
 
 double Table5::lfi(const double iv1, const double iv2, const double iv3, const double iv4, const double iv5, IFStorage* const f) const
+{
+   double value{};
+   lfiBatch(&iv1, &iv2, &iv3, &iv4, &iv5, &value, 1, f);
+   return value;
+}
+
+//------------------------------------------------------------------------------
+//  5D batch LFIs -- interpolate 'n' points
+//------------------------------------------------------------------------------
+void Table5::lfi(const double* const iv1, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, nullptr, nullptr, nullptr, nullptr, out, n, f);
+}
+
+void Table5::lfi(const double* const iv1, const double* const iv2, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, nullptr, nullptr, nullptr, out, n, f);
+}
+
+void Table5::lfi(const double* const iv1, const double* const iv2, const double* const iv3, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, iv3, nullptr, nullptr, out, n, f);
+}
+
+void Table5::lfi(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, iv3, iv4, nullptr, out, n, f);
+}
+
+void Table5::lfi(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const out, const unsigned int n, IFStorage* const f) const
+{
+   lfiBatch(iv1, iv2, iv3, iv4, iv5, out, n, f);
+}
+
+//------------------------------------------------------------------------------
+// lfiBatch() -- interpolates 'n' points; the missing (nullptr) independent
+// variables are at their first breakpoints
+//------------------------------------------------------------------------------
+void Table5::lfiBatch(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const out, const unsigned int n, IFStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      const auto s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi_5D( iv1, iv2, iv3, iv4, iv5, getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   } else {
-      return lfi_5D( iv1, iv2, iv3, iv4, iv5, getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
+   TableStorage* const s{getTableStorage(f)};
+
+   // The breakpoints found for each point are where the next searches start
+   unsigned int xbp{}, ybp{}, zbp{}, wbp{}, vbp{};
+   if (s != nullptr) {
+      xbp = s->xbp;
+      ybp = s->ybp;
+      zbp = s->zbp;
+      wbp = s->wbp;
+      vbp = s->vbp;
+   }
+
+   for (unsigned int i = 0; i < n; i++) {
+      const double x{iv1[i]};
+      const double y{(iv2 != nullptr) ? iv2[i] : getYData()[0]};
+      const double z{(iv3 != nullptr) ? iv3[i] : getZData()[0]};
+      const double w{(iv4 != nullptr) ? iv4[i] : getWData()[0]};
+      const double v{(iv5 != nullptr) ? iv5[i] : getVData()[0]};
+
+      getXGrid().update(x, &xbp);
+      getYGrid().update(y, &ybp);
+      getZGrid().update(z, &zbp);
+      getWGrid().update(w, &wbp);
+      vGrid.update(v, &vbp);
+
+      out[i] = lfi_5D( x, y, z, w, v,
+                     getXData(), getNumXPoints(),
+                     getYData(), getNumYPoints(),
+                     getZData(), getNumZPoints(),
+                     getWData(), getNumWPoints(),
+                     getVData(), getNumVPoints(),
+                     getDataTable(), isExtrapolationEnabled(),
+                     &xbp, &ybp, &zbp, &wbp, &vbp );
+   }
+
+   if (s != nullptr) {
+      s->xbp = xbp;
+      s->ybp = ybp;
+      s->zbp = zbp;
+      s->wbp = wbp;
+      s->vbp = vbp;
    }
 }
 
+//------------------------------------------------------------------------------
+// updateGridIndexes() -- (re)builds the breakpoint grid indexes
+//------------------------------------------------------------------------------
+void Table5::updateGridIndexes()
+{
+   BaseClass::updateGridIndexes();
+   if (isGridIndexEnabled()) vGrid.build(vtable, nv);
+   else vGrid.clear();
+}
+
 //------------------------------------------------------------------------------
 // setVBreakpoints5() -- For Table5
 //------------------------------------------------------------------------------
@@ -267,6 +272,7 @@ bool Table5::setVBreakpoints5(const IList* const swb5obj)
     if (swb5obj != nullptr) {
         loadVector(*swb5obj, &vtable, &nv);
         valid = isValid();
+        updateGridIndexes();
     }
     return true;
 }
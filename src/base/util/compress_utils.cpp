@@ -0,0 +1,181 @@
+
+#include "mixr/base/util/compress_utils.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace mixr {
+namespace base {
+
+namespace {
+
+// LZ4 block format limits
+const std::size_t MIN_MATCH{4};         // Min match length
+const std::size_t LAST_LITERALS{5};     // The last bytes are always literals
+const std::size_t MF_LIMIT{12};         // The last match must start before the last bytes
+const std::size_t MAX_OFFSET{65535};    // Max match offset
+
+const int HASH_BITS{12};                // Match finder's hash table (4096 entries)
+
+inline std::uint32_t read32(const unsigned char* const p)
+{
+   std::uint32_t v{};
+   std::memcpy(&v, p, sizeof(v));
+   return v;
+}
+
+inline std::uint32_t hash(const std::uint32_t v)
+{
+   return (v * 2654435761U) >> (32 - HASH_BITS);
+}
+
+// Writes the extra bytes of a literal or match length
+inline unsigned char* putLength(unsigned char* op, std::size_t len)
+{
+   while (len >= 255) {
+      *op++ = 255;
+      len -= 255;
+   }
+   *op++ = static_cast<unsigned char>(len);
+   return op;
+}
+
+// Reads the extra bytes of a literal or match length; returns false if we ran out of input
+inline bool getLength(const unsigned char** const ip, const unsigned char* const iend, std::size_t* const len)
+{
+   unsigned char b{};
+   do {
+      if (*ip >= iend) return false;
+      b = *(*ip)++;
+      *len += b;
+   } while (b == 255);
+   return true;
+}
+
+}
+
+//------------------------------------------------------------------------------
+// Max size of the compressed block of 'n' bytes of data
+//------------------------------------------------------------------------------
+std::size_t lz4CompressBound(const std::size_t n)
+{
+   return n + (n / 255) + 16;
+}
+
+//------------------------------------------------------------------------------
+// Compresses a block of data (greedy, single probe hash match finder)
+//------------------------------------------------------------------------------
+std::size_t lz4Compress(const char* const src, const std::size_t n, char* const dst, const std::size_t dstSize)
+{
+   if (dstSize < lz4CompressBound(n)) return 0;
+
+   const unsigned char* const base{reinterpret_cast<const unsigned char*>(src)};
+   const unsigned char* const end{base + n};
+   const unsigned char* ip{base};
+   const unsigned char* anchor{base};
+   unsigned char* op{reinterpret_cast<unsigned char*>(dst)};
+
+   if (n > MF_LIMIT) {
+      std::uint32_t table[1 << HASH_BITS]{};
+      const unsigned char* const matchLimit{end - LAST_LITERALS};
+      const unsigned char* const mfLimit{end - MF_LIMIT};
+
+      while (ip < mfLimit) {
+         const std::uint32_t seq{read32(ip)};
+         const std::uint32_t h{hash(seq)};
+         const unsigned char* ref{base + table[h]};
+         table[h] = static_cast<std::uint32_t>(ip - base);
+
+         if (ref >= ip || static_cast<std::size_t>(ip - ref) > MAX_OFFSET || read32(ref) != seq) {
+            // no match; skip faster through data that doesn't compress
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+         }
+
+         // extend the match backwards, over the literals, and forwards
+         while (ip > anchor && ref > base && ip[-1] == ref[-1]) { ip--; ref--; }
+         const unsigned char* mp{ip + MIN_MATCH};
+         const unsigned char* rp{ref + MIN_MATCH};
+         while (mp < matchLimit && *mp == *rp) { mp++; rp++; }
+
+         // the sequence: token, literals, offset and match length
+         const std::size_t litLen{static_cast<std::size_t>(ip - anchor)};
+         const std::size_t matchLen{static_cast<std::size_t>(mp - ip) - MIN_MATCH};
+         unsigned char* const token{op++};
+         *token = static_cast<unsigned char>(((litLen < 15 ? litLen : 15) << 4) | (matchLen < 15 ? matchLen : 15));
+         if (litLen >= 15) op = putLength(op, litLen - 15);
+         std::memcpy(op, anchor, litLen);
+         op += litLen;
+         const std::size_t offset{static_cast<std::size_t>(ip - ref)};
+         *op++ = static_cast<unsigned char>(offset & 0xff);
+         *op++ = static_cast<unsigned char>(offset >> 8);
+         if (matchLen >= 15) op = putLength(op, matchLen - 15);
+
+         ip = mp;
+         anchor = ip;
+         if (ip < mfLimit) table[hash(read32(ip - 2))] = static_cast<std::uint32_t>(ip - 2 - base);
+      }
+   }
+
+   // the last literals
+   const std::size_t litLen{static_cast<std::size_t>(end - anchor)};
+   *op++ = static_cast<unsigned char>((litLen < 15 ? litLen : 15) << 4);
+   if (litLen >= 15) op = putLength(op, litLen - 15);
+   std::memcpy(op, anchor, litLen);
+   op += litLen;
+
+   return static_cast<std::size_t>(op - reinterpret_cast<unsigned char*>(dst));
+}
+
+//------------------------------------------------------------------------------
+// Decompresses a block of data
+//------------------------------------------------------------------------------
+std::size_t lz4Decompress(const char* const src, const std::size_t n, char* const dst, const std::size_t dstSize)
+{
+   const unsigned char* ip{reinterpret_cast<const unsigned char*>(src)};
+   const unsigned char* const iend{ip + n};
+   unsigned char* const obase{reinterpret_cast<unsigned char*>(dst)};
+   unsigned char* op{obase};
+   unsigned char* const oend{obase + dstSize};
+
+   while (ip < iend) {
+      const unsigned char token{*ip++};
+
+      // literals
+      std::size_t litLen{static_cast<std::size_t>(token >> 4)};
+      if (litLen == 15 && !getLength(&ip, iend, &litLen)) return LZ4_ERROR;
+      if (litLen > static_cast<std::size_t>(iend - ip) || litLen > static_cast<std::size_t>(oend - op)) return LZ4_ERROR;
+      std::memcpy(op, ip, litLen);
+      op += litLen;
+      ip += litLen;
+
+      // the last sequence is just literals
+      if (ip >= iend) return static_cast<std::size_t>(op - obase);
+
+      // match
+      if ((iend - ip) < 2) return LZ4_ERROR;
+      const std::size_t offset{static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8)};
+      ip += 2;
+      if (offset == 0 || offset > static_cast<std::size_t>(op - obase)) return LZ4_ERROR;
+
+      std::size_t matchLen{static_cast<std::size_t>(token & 15)};
+      if (matchLen == 15 && !getLength(&ip, iend, &matchLen)) return LZ4_ERROR;
+      matchLen += MIN_MATCH;
+      if (matchLen > static_cast<std::size_t>(oend - op)) return LZ4_ERROR;
+
+      const unsigned char* mp{op - offset};
+      if (offset >= matchLen) {
+         std::memcpy(op, mp, matchLen);
+         op += matchLen;
+      } else {
+         // overlapped (repeating) match
+         for (std::size_t i = 0; i < matchLen; i++) *op++ = *mp++;
+      }
+   }
+
+   // no input, or the block didn't end with a literals only sequence
+   return LZ4_ERROR;
+}
+
+}
+}
@@ -67,7 +67,7 @@ double lfi_1D(
          x2 = *xbp;
          if (x2 >= nx) x2 = 0;                         // safety check
          while (x > x_data[x2]) { x2 += delta; }       // search up
-         while (x < x_data[x2-delta]) { x2 -= delta; } // search down
+         while (x <= x_data[x2-delta]) { x2 -= delta; } // search down
          *xbp = x2;
       }
    }
@@ -152,7 +152,7 @@ double lfi_2D(
          y2 = *ybp;
          if (y2 >= ny) y2 = 0;                         // safety check
          while (y > y_data[y2]) { y2 += delta; }       // search up
-         while (y < y_data[y2-delta]) { y2 -= delta; } // search down
+         while (y <= y_data[y2-delta]) { y2 -= delta; } // search down
          *ybp = y2;
       }
    }
@@ -249,7 +249,7 @@ double lfi_3D(
          z2 = *zbp;
          if (z2 >= nz) z2 = 0;                         // safety check
          while (z > z_data[z2]) { z2 += delta; }       // search up
-         while (z < z_data[z2-delta]) { z2 -= delta; } // search down
+         while (z <= z_data[z2-delta]) { z2 -= delta; } // search down
          *zbp = z2;
       }
    }
@@ -353,7 +353,7 @@ double lfi_4D(
          w2 = *wbp;
          if (w2 >= nw) w2 = 0;                         // safety check
          while (w > w_data[w2]) { w2 += delta; }       // search up
-         while (w < w_data[w2-delta]) { w2 -= delta; } // search down
+         while (w <= w_data[w2-delta]) { w2 -= delta; } // search down
          *wbp = w2;
       }
    }
@@ -460,7 +460,7 @@ double lfi_5D(
          v2 = *vbp;
          if (v2 >= nv) v2 = 0;                         // safety check
          while (v > v_data[v2]) { v2 += delta; }       // search up
-         while (v < v_data[v2-delta]) { v2 -= delta; } // search down
+         while (v <= v_data[v2-delta]) { v2 -= delta; } // search down
          *vbp = v2;
       }
    }
@@ -482,5 +482,39 @@ double lfi_5D(
    return m * (a2 - a1) + a1;
 }
 
+
+//------------------------------------------------------------------------------
+// LfiGrid::build() -- builds the breakpoint grid index
+//------------------------------------------------------------------------------
+void LfiGrid::build(const double* const data, const unsigned int n)
+{
+   cells.clear();
+   if (data == nullptr || n < 2) return;
+
+   const bool increasing{data[1] >= data[0]};
+   const double lo{increasing ? data[0] : data[n - 1]};
+   const double hi{increasing ? data[n - 1] : data[0]};
+   if (!(hi > lo)) return;
+
+   unsigned int nc{(n - 1) * CELLS_PER_BREAKPOINT};
+   if (nc > MAX_CELLS) nc = MAX_CELLS;
+   x0 = lo;
+   scale = nc / (hi - lo);
+
+   // Each cell starts at the breakpoint that the interpolators' linear
+   // search would find for the cell's lower limit
+   cells.resize(nc);
+   unsigned int bp{increasing ? 1u : n - 2};
+   for (unsigned int c = 0; c < nc; c++) {
+      const double x{lo + (hi - lo) * c / nc};
+      if (increasing) {
+         while (bp < (n - 1) && x > data[bp]) bp++;
+      } else {
+         while (bp > 0 && x > data[bp]) bp--;
+      }
+      cells[c] = bp;
+   }
+}
+
 }
 }
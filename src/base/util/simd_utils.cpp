@@ -0,0 +1,437 @@
+
+#include "mixr/base/util/simd_utils.hpp"
+
+#include "mixr/base/osg/Vec3d"
+#include "mixr/base/osg/Matrixd"
+
+#include "mixr/base/util/math_utils.hpp"
+#include "mixr/base/util/osg_utils.hpp"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIXR_SIMD_AVX2
+#include <immintrin.h>
+#define MIXR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace mixr {
+namespace base {
+namespace simd {
+
+static_assert(sizeof(Vec3d) == 3 * sizeof(double), "simd: Vec3d arrays must be contiguous doubles");
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Kernel selection
+//------------------------------------------------------------------------------
+
+bool checkAvx2()
+{
+#ifdef MIXR_SIMD_AVX2
+   __builtin_cpu_init();
+   return (__builtin_cpu_supports("avx2") != 0);
+#else
+   return false;
+#endif
+}
+
+const bool avx2Supported{checkAvx2()};
+std::atomic<Kernels> kernels{avx2Supported ? Kernels::AVX2 : Kernels::SCALAR};
+
+inline bool useAvx2()
+{
+   return (kernels.load(std::memory_order_relaxed) == Kernels::AVX2);
+}
+
+//------------------------------------------------------------------------------
+// Scalar kernels
+//------------------------------------------------------------------------------
+
+void boresightScalar(
+      const Vec3d losG[],
+      double xa[], double ya[], double za[],
+      double ra2[], double ra[],
+      double aar[], double aazr[], double aelr[],
+      const unsigned int i0, const unsigned int n
+   )
+{
+   for (unsigned int i = i0; i < n; i++) {
+      xa[i] = losG[i].x();
+      ya[i] = losG[i].y();
+      za[i] = -losG[i].z();
+      ra2[i] = xa[i]*xa[i] + ya[i]*ya[i];
+      ra[i] = std::sqrt(ra2[i]);
+      aar[i] = std::acos(xa[i]);
+      aazr[i] = std::atan2(ya[i], xa[i]);
+      aelr[i] = std::atan2(za[i], ra[i]);
+   }
+}
+
+#ifdef MIXR_SIMD_AVX2
+
+//------------------------------------------------------------------------------
+// AVX2 kernels
+//
+//    The arc-tangent and power of 10 approximations are the Cephes library's
+//    double precision atan() and exp10() rational approximations (Stephen L.
+//    Moshier), evaluated four at a time.
+//------------------------------------------------------------------------------
+
+// Loads four Vec3d and transposes them into x, y and z vectors
+MIXR_TARGET_AVX2
+inline void loadVec3x4(const Vec3d* const v, __m256d* const x, __m256d* const y, __m256d* const z)
+{
+   const double* const p{v[0].ptr()};
+   const __m256d r0{_mm256_loadu_pd(p)};       // x0 y0 z0 x1
+   const __m256d r1{_mm256_loadu_pd(p + 4)};   // y1 z1 x2 y2
+   const __m256d r2{_mm256_loadu_pd(p + 8)};   // z2 x3 y3 z3
+   const __m256d m1{_mm256_permute2f128_pd(r0, r1, 0x30)};   // x0 y0 x2 y2
+   const __m256d m2{_mm256_permute2f128_pd(r0, r2, 0x21)};   // z0 x1 z2 x3
+   const __m256d m3{_mm256_permute2f128_pd(r1, r2, 0x30)};   // y1 z1 y3 z3
+   *x = _mm256_shuffle_pd(m1, m2, 0xA);
+   *y = _mm256_shuffle_pd(m1, m3, 0x5);
+   *z = _mm256_shuffle_pd(m2, m3, 0xA);
+}
+
+// Transposes x, y and z vectors and stores them as four Vec3d
+MIXR_TARGET_AVX2
+inline void storeVec3x4(Vec3d* const v, const __m256d x, const __m256d y, const __m256d z)
+{
+   double* const p{v[0].ptr()};
+   const __m256d m1{_mm256_unpacklo_pd(x, y)};          // x0 y0 x2 y2
+   const __m256d m2{_mm256_shuffle_pd(z, x, 0xA)};      // z0 x1 z2 x3
+   const __m256d m3{_mm256_unpackhi_pd(y, z)};          // y1 z1 y3 z3
+   _mm256_storeu_pd(p,     _mm256_permute2f128_pd(m1, m2, 0x20));
+   _mm256_storeu_pd(p + 4, _mm256_permute2f128_pd(m3, m1, 0x30));
+   _mm256_storeu_pd(p + 8, _mm256_permute2f128_pd(m2, m3, 0x31));
+}
+
+// Arc-tangent of 'x', where 0 <= x <= 1
+MIXR_TARGET_AVX2
+inline __m256d atan01(const __m256d x)
+{
+   const __m256d one{_mm256_set1_pd(1.0)};
+   const __m256d big{_mm256_cmp_pd(x, _mm256_set1_pd(0.66), _CMP_GT_OQ)};
+
+   // Reduce the range: atan(x) = pi/4 + atan((x-1)/(x+1))
+   const __m256d xr{_mm256_blendv_pd(x, _mm256_div_pd(_mm256_sub_pd(x, one), _mm256_add_pd(x, one)), big)};
+   const __m256d y0{_mm256_and_pd(big, _mm256_set1_pd(0.78539816339744830962))};
+
+   const __m256d z{_mm256_mul_pd(xr, xr)};
+   __m256d p{_mm256_set1_pd(-8.750608600031904122785E-1)};
+   p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(-1.615753718733365076637E1));
+   p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(-7.500855792314704667340E1));
+   p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(-1.228866684490136173410E2));
+   p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(-6.485021904942025371773E1));
+   __m256d q{_mm256_add_pd(z, _mm256_set1_pd(2.485846490142306297962E1))};
+   q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(1.650270098316988542046E2));
+   q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(4.328810604912902668951E2));
+   q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(4.853903996359136964868E2));
+   q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(1.945506571482613964425E2));
+
+   __m256d r{_mm256_div_pd(_mm256_mul_pd(z, p), q)};
+   r = _mm256_add_pd(_mm256_mul_pd(xr, r), xr);
+   r = _mm256_add_pd(r, _mm256_and_pd(big, _mm256_set1_pd(0.5 * 6.123233995736765886130E-17)));
+   return _mm256_add_pd(y0, r);
+}
+
+// Arc-tangent of y/x using the signs of both to determine the quadrant
+MIXR_TARGET_AVX2
+inline __m256d atan2x4(const __m256d y, const __m256d x)
+{
+   const __m256d signMask{_mm256_set1_pd(-0.0)};
+   const __m256d zero{_mm256_setzero_pd()};
+   const __m256d ax{_mm256_andnot_pd(signMask, x)};
+   const __m256d ay{_mm256_andnot_pd(signMask, y)};
+
+   // atan(min/max) is in [ 0 .. pi/4 ]; 'ay' is the second operand so NaNs propagate
+   const __m256d mx{_mm256_max_pd(ax, ay)};
+   const __m256d mn{_mm256_min_pd(ax, ay)};
+   const __m256d a{_mm256_blendv_pd(_mm256_div_pd(mn, mx), zero, _mm256_cmp_pd(mx, zero, _CMP_EQ_OQ))};
+   __m256d r{atan01(a)};
+
+   // |y| > |x| : r = pi/2 - r
+   const __m256d pio2{_mm256_set1_pd(1.57079632679489661923)};
+   const __m256d morebits{_mm256_set1_pd(6.123233995736765886130E-17)};
+   r = _mm256_blendv_pd(r, _mm256_add_pd(_mm256_sub_pd(pio2, r), morebits), _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+
+   // x < 0 (or -0) : r = pi - r; blendv() selects using the sign bit of 'x'
+   const __m256d pi{_mm256_set1_pd(3.14159265358979323846)};
+   r = _mm256_blendv_pd(r, _mm256_add_pd(_mm256_sub_pd(pi, r), _mm256_add_pd(morebits, morebits)), x);
+
+   // Sign of y
+   return _mm256_xor_pd(r, _mm256_and_pd(signMask, y));
+}
+
+// Arc-cosine of x: acos(x) = atan2(sqrt((1-x)*(1+x)), x)
+MIXR_TARGET_AVX2
+inline __m256d acosx4(const __m256d x)
+{
+   const __m256d one{_mm256_set1_pd(1.0)};
+   const __m256d s{_mm256_sqrt_pd(_mm256_mul_pd(_mm256_sub_pd(one, x), _mm256_add_pd(one, x)))};
+   return atan2x4(s, x);
+}
+
+// 10 raised to the power 'x'; returns false if any 'x' is out of range (or NaN)
+MIXR_TARGET_AVX2
+inline bool pow10x4(const __m256d x, __m256d* const result)
+{
+   const __m256d inRange{_mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), x), _mm256_set1_pd(300.0), _CMP_LE_OQ)};
+   if (_mm256_movemask_pd(inRange) != 0xF) return false;
+
+   // 10^x = 2^n * 10^f, where n = floor(x * log2(10) + 0.5)
+   const __m256d n{_mm256_floor_pd(_mm256_add_pd(_mm256_mul_pd(x, _mm256_set1_pd(3.32192809488736234787e0)), _mm256_set1_pd(0.5)))};
+   __m256d f{_mm256_sub_pd(x, _mm256_mul_pd(n, _mm256_set1_pd(3.01025390625e-1)))};
+   f = _mm256_sub_pd(f, _mm256_mul_pd(n, _mm256_set1_pd(4.6050389811952137388947e-6)));
+
+   // Rational approximation: 10^f = 1 + 2P(f^2)/(Q(f^2) - P(f^2))
+   const __m256d ff{_mm256_mul_pd(f, f)};
+   __m256d p{_mm256_set1_pd(4.09962519798587023075E-2)};
+   p = _mm256_add_pd(_mm256_mul_pd(p, ff), _mm256_set1_pd(1.17452732554344059015E1));
+   p = _mm256_add_pd(_mm256_mul_pd(p, ff), _mm256_set1_pd(4.06717289936872725516E2));
+   p = _mm256_add_pd(_mm256_mul_pd(p, ff), _mm256_set1_pd(2.39423741207388267439E3));
+   p = _mm256_mul_pd(p, f);
+   __m256d q{_mm256_add_pd(ff, _mm256_set1_pd(8.50936160849306532625E1))};
+   q = _mm256_add_pd(_mm256_mul_pd(q, ff), _mm256_set1_pd(1.27209271178345121210E3));
+   q = _mm256_add_pd(_mm256_mul_pd(q, ff), _mm256_set1_pd(2.07960819286001865907E3));
+   const __m256d r{_mm256_div_pd(p, _mm256_sub_pd(q, p))};
+   const __m256d one{_mm256_set1_pd(1.0)};
+   const __m256d e{_mm256_add_pd(one, _mm256_add_pd(r, r))};
+
+   // Scale by 2^n, built from its exponent bits
+   const __m256i ni{_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n))};
+   const __m256i bits{_mm256_slli_epi64(_mm256_add_epi64(ni, _mm256_set1_epi64x(1023)), 52)};
+   *result = _mm256_mul_pd(e, _mm256_castsi256_pd(bits));
+   return true;
+}
+
+MIXR_TARGET_AVX2
+void postMultVec3ArrayAvx2(const Vec3d orig[], const Matrixd& matrix, Vec3d result[], const unsigned int n)
+{
+   __m256d m[4][4];
+   for (int r = 0; r < 4; r++) {
+      for (int c = 0; c < 4; c++) {
+         m[r][c] = _mm256_set1_pd(matrix(r, c));
+      }
+   }
+   const __m256d one{_mm256_set1_pd(1.0)};
+
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      __m256d x, y, z;
+      loadVec3x4(&orig[i], &x, &y, &z);
+
+      // Same operation order as Matrixd::postMult()
+      const __m256d d{_mm256_div_pd(one,
+         _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m[3][0], x), _mm256_mul_pd(m[3][1], y)), _mm256_mul_pd(m[3][2], z)), m[3][3]))};
+      __m256d v[3];
+      for (int r = 0; r < 3; r++) {
+         v[r] = _mm256_mul_pd(
+            _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m[r][0], x), _mm256_mul_pd(m[r][1], y)), _mm256_mul_pd(m[r][2], z)), m[r][3]),
+            d);
+      }
+      storeVec3x4(&result[i], v[0], v[1], v[2]);
+   }
+   for (; i < n; i++) {
+      result[i] = matrix.postMult(orig[i]);
+   }
+}
+
+MIXR_TARGET_AVX2
+void boresightArraysAvx2(
+      const Vec3d losG[],
+      double xa[], double ya[], double za[],
+      double ra2[], double ra[],
+      double aar[], double aazr[], double aelr[],
+      const unsigned int n
+   )
+{
+   const __m256d signMask{_mm256_set1_pd(-0.0)};
+
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      __m256d x, y, z;
+      loadVec3x4(&losG[i], &x, &y, &z);
+      z = _mm256_xor_pd(z, signMask);
+
+      const __m256d r2{_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y))};
+      const __m256d r{_mm256_sqrt_pd(r2)};
+
+      _mm256_storeu_pd(&xa[i], x);
+      _mm256_storeu_pd(&ya[i], y);
+      _mm256_storeu_pd(&za[i], z);
+      _mm256_storeu_pd(&ra2[i], r2);
+      _mm256_storeu_pd(&ra[i], r);
+      _mm256_storeu_pd(&aar[i], acosx4(x));
+      _mm256_storeu_pd(&aazr[i], atan2x4(y, x));
+      _mm256_storeu_pd(&aelr[i], atan2x4(z, r));
+   }
+   boresightScalar(losG, xa, ya, za, ra2, ra, aar, aazr, aelr, i, n);
+}
+
+MIXR_TARGET_AVX2
+void acosArrayAvx2(const double* const src, double* const dst, const unsigned int n)
+{
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      _mm256_storeu_pd(&dst[i], acosx4(_mm256_loadu_pd(&src[i])));
+   }
+   for (; i < n; i++) {
+      dst[i] = std::acos(src[i]);
+   }
+}
+
+MIXR_TARGET_AVX2
+void atan2ArrayAvx2(const double* const yValues, const double* const xValues, double* const dst, const unsigned int n)
+{
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      _mm256_storeu_pd(&dst[i], atan2x4(_mm256_loadu_pd(&yValues[i]), _mm256_loadu_pd(&xValues[i])));
+   }
+   for (; i < n; i++) {
+      dst[i] = std::atan2(yValues[i], xValues[i]);
+   }
+}
+
+MIXR_TARGET_AVX2
+void sqrtArrayAvx2(const double* const src, double* const dst, const unsigned int n)
+{
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      _mm256_storeu_pd(&dst[i], _mm256_sqrt_pd(_mm256_loadu_pd(&src[i])));
+   }
+   for (; i < n; i++) {
+      dst[i] = std::sqrt(src[i]);
+   }
+}
+
+MIXR_TARGET_AVX2
+void pow10ArrayAvx2(const double* const src, double* const dst, const unsigned int n)
+{
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      __m256d r;
+      if (pow10x4(_mm256_loadu_pd(&src[i]), &r)) {
+         _mm256_storeu_pd(&dst[i], r);
+      } else {
+         // Out of range (overflow, underflow or NaN) -- let the library handle it
+         for (unsigned int j = i; j < i + 4; j++) {
+            dst[j] = std::pow(10.0, src[j]);
+         }
+      }
+   }
+   for (; i < n; i++) {
+      dst[i] = std::pow(10.0, src[i]);
+   }
+}
+
+MIXR_TARGET_AVX2
+void multArrayConstAvx2(const double* const src, const double c, double* const dst, const unsigned int n)
+{
+   const __m256d cc{_mm256_set1_pd(c)};
+   unsigned int i{};
+   for (; i + 4 <= n; i += 4) {
+      _mm256_storeu_pd(&dst[i], _mm256_mul_pd(_mm256_loadu_pd(&src[i]), cc));
+   }
+   for (; i < n; i++) {
+      dst[i] = src[i] * c;
+   }
+}
+
+#endif
+
+}
+
+//------------------------------------------------------------------------------
+// Kernel selection
+//------------------------------------------------------------------------------
+
+bool isAvx2Supported()
+{
+   return avx2Supported;
+}
+
+Kernels getKernels()
+{
+   return kernels.load(std::memory_order_relaxed);
+}
+
+bool setKernels(const Kernels k)
+{
+   if (k == Kernels::AVX2 && !avx2Supported) return false;
+   kernels.store(k, std::memory_order_relaxed);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Array functions
+//------------------------------------------------------------------------------
+
+void postMultVec3Array(const Vec3d orig[], const Matrixd& matrix, Vec3d result[], const unsigned int n)
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { postMultVec3ArrayAvx2(orig, matrix, result, n); return; }
+#endif
+   base::postMultVec3Array(orig, matrix, result, n);
+}
+
+void boresightArrays(
+      const Vec3d losG[],
+      double xa[], double ya[], double za[],
+      double ra2[], double ra[],
+      double aar[], double aazr[], double aelr[],
+      const unsigned int n
+   )
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { boresightArraysAvx2(losG, xa, ya, za, ra2, ra, aar, aazr, aelr, n); return; }
+#endif
+   boresightScalar(losG, xa, ya, za, ra2, ra, aar, aazr, aelr, 0, n);
+}
+
+void acosArray(const double* const src, double* const dst, const unsigned int n)
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { acosArrayAvx2(src, dst, n); return; }
+#endif
+   base::acosArray(src, dst, n);
+}
+
+void atan2Array(const double* const yValues, const double* const xValues, double* const dst, const unsigned int n)
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { atan2ArrayAvx2(yValues, xValues, dst, n); return; }
+#endif
+   base::atan2Array(yValues, xValues, dst, n);
+}
+
+void sqrtArray(const double* const src, double* const dst, const unsigned int n)
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { sqrtArrayAvx2(src, dst, n); return; }
+#endif
+   base::sqrtArray(src, dst, n);
+}
+
+void pow10Array(const double* const src, double* const dst, const unsigned int n)
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { pow10ArrayAvx2(src, dst, n); return; }
+#endif
+   base::pow10Array(src, dst, n);
+}
+
+void multArrayConst(const double* const src, const double c, double* const dst, const unsigned int n)
+{
+#ifdef MIXR_SIMD_AVX2
+   if (useAvx2()) { multArrayConstAvx2(src, c, dst, n); return; }
+#endif
+   base::multArrayConst(src, c, dst, n);
+}
+
+}
+}
+}
@@ -0,0 +1,214 @@
+
+#include "mixr/interop/DeadReckoningBatch.hpp"
+
+#include "mixr/interop/INib.hpp"
+
+#include "mixr/base/util/simd_utils.hpp"
+
+#include <cmath>
+
+namespace mixr {
+namespace interop {
+
+//------------------------------------------------------------------------------
+// add() -- adds a NIB, which will be dead reckoned to DR time 'dT' (seconds)
+//------------------------------------------------------------------------------
+void DeadReckoningBatch::add(INib* const nib, const double dT)
+{
+   if (nib != nullptr) {
+      nibs.push_back(nib);
+      t.push_back(dT);
+   }
+}
+
+//------------------------------------------------------------------------------
+// compute() -- computes the DR positions and Euler angles
+//------------------------------------------------------------------------------
+void DeadReckoningBatch::compute()
+{
+   const auto n = static_cast<unsigned int>(nibs.size());
+   pos.resize(n);
+   angles.resize(n);
+   for (std::vector<double>* v : {&p0x, &p0y, &p0z, &v0x, &v0y, &v0z, &a0x, &a0y, &a0z, &lt, &wx, &wy, &wz, &rt}) {
+      v->resize(n);
+   }
+   for (unsigned int k = 0; k < 9; k++) {
+      r0[k].resize(n);
+   }
+   lin.resize(n);
+   rot.resize(n);
+
+   // ---
+   // Gather the DR state of the world coordinate algorithms; the other
+   // algorithms are computed by the NIB itself
+   // ---
+   unsigned int nl{};
+   unsigned int nr{};
+   for (unsigned int i = 0; i < n; i++) {
+      const INib* const nib{nibs[i]};
+      const double dT{t[i]};
+      const unsigned char dr{nib->drNum};
+      if (dr != INib::FPW_DRM && dr != INib::RPW_DRM && dr != INib::RVW_DRM && dr != INib::FVW_DRM) {
+         nib->mainDeadReckoning(dT, &pos[i], &angles[i]);
+         continue;
+      }
+
+      // Positions (1st order has no acceleration term)
+      const bool secondOrder{dr == INib::RVW_DRM || dr == INib::FVW_DRM};
+      lin[nl] = i;
+      p0x[nl] = nib->drP0[0];
+      p0y[nl] = nib->drP0[1];
+      p0z[nl] = nib->drP0[2];
+      v0x[nl] = nib->drV0[0];
+      v0y[nl] = nib->drV0[1];
+      v0z[nl] = nib->drV0[2];
+      a0x[nl] = (secondOrder ? nib->drA0[0] : 0.0);
+      a0y[nl] = (secondOrder ? nib->drA0[1] : 0.0);
+      a0z[nl] = (secondOrder ? nib->drA0[2] : 0.0);
+      lt[nl] = dT;
+      nl++;
+
+      if (dr == INib::RPW_DRM || dr == INib::RVW_DRM) {
+         // Rotations
+         rot[nr] = i;
+         wx[nr] = nib->drAV0[0];
+         wy[nr] = nib->drAV0[1];
+         wz[nr] = nib->drAV0[2];
+         for (unsigned int r = 0; r < 3; r++) {
+            for (unsigned int c = 0; c < 3; c++) {
+               r0[r*3 + c][nr] = nib->drR0(r,c);
+            }
+         }
+         rt[nr] = dT;
+         nr++;
+      } else {
+         // No rotation
+         angles[i] = nib->drRPY0;
+      }
+   }
+
+   // ---
+   // Positions: p = p0 + v0*t + a0*(t*t/2)
+   // ---
+   {
+      double* const x{p0x.data()};
+      double* const y{p0y.data()};
+      double* const z{p0z.data()};
+      const double* const tt{lt.data()};
+      for (unsigned int i = 0; i < nl; i++) {
+         const double dT{tt[i]};
+         const double k{0.5*dT*dT};
+         x[i] = x[i] + v0x[i]*dT + a0x[i]*k;
+         y[i] = y[i] + v0y[i]*dT + a0y[i]*k;
+         z[i] = z[i] + v0z[i]*dT + a0z[i]*k;
+      }
+      for (unsigned int i = 0; i < nl; i++) {
+         pos[lin[i]].set(x[i], y[i], z[i]);
+      }
+   }
+
+   // ---
+   // Rotations: Rwb = DR * R0, where DR = wwT*k1 + I*k2 - omega*k3
+   // ---
+   if (nr > 0) {
+      w2.resize(nr);
+      w1.resize(nr);
+      for (unsigned int i = 0; i < 9; i++) {
+         rwb[i].resize(nr);
+      }
+      sphi.resize(nr);
+      cphi.resize(nr);
+      stht.resize(nr);
+      ctht.resize(nr);
+      spsi.resize(nr);
+      cpsi.resize(nr);
+      phi.resize(nr);
+      tht.resize(nr);
+      psi.resize(nr);
+
+      // |w|
+      for (unsigned int i = 0; i < nr; i++) {
+         w2[i] = wx[i]*wx[i] + wy[i]*wy[i] + wz[i]*wz[i];
+      }
+      base::simd::sqrtArray(w2.data(), w1.data(), nr);
+
+      for (unsigned int i = 0; i < nr; i++) {
+         // DR matrix (identity when there's no rotation)
+         double dr[9] {1.0, 0.0, 0.0,  0.0, 1.0, 0.0,  0.0, 0.0, 1.0};
+         if (w2[i] > 0.0) {
+            const double cosWT{std::cos(w1[i] * rt[i])};
+            const double sinWT{std::sin(w1[i] * rt[i])};
+            const double k1{(1.0 - cosWT) / w2[i]};
+            const double k2{cosWT};
+            const double k3{sinWT / w1[i]};
+            const double x{wx[i]}, y{wy[i]}, z{wz[i]};
+            dr[0] = x*x*k1 + k2;    dr[1] = x*y*k1 + z*k3;  dr[2] = x*z*k1 - y*k3;
+            dr[3] = y*x*k1 - z*k3;  dr[4] = y*y*k1 + k2;    dr[5] = y*z*k1 + x*k3;
+            dr[6] = z*x*k1 + y*k3;  dr[7] = z*y*k1 - x*k3;  dr[8] = z*z*k1 + k2;
+         }
+
+         // Rwb = DR * R0
+         for (unsigned int r = 0; r < 3; r++) {
+            for (unsigned int c = 0; c < 3; c++) {
+               rwb[r*3 + c][i] = dr[r*3]*r0[c][i] + dr[r*3 + 1]*r0[3 + c][i] + dr[r*3 + 2]*r0[6 + c][i];
+            }
+         }
+
+         // sin(theta) and cos(theta)^2
+         double st{-rwb[2][i]};
+         if (-1.0 > st) st = -1.0;
+         if ( 1.0 < st) st =  1.0;
+         stht[i] = st;
+         w2[i] = 1.0 - st*st;
+      }
+      base::simd::sqrtArray(w2.data(), ctht.data(), nr);
+
+      // Sin/cos of phi and psi (same as base::nav::computeEulerAngles())
+      for (unsigned int i = 0; i < nr; i++) {
+         double sp{};
+         double cp{1.0};
+         if (ctht[i] > 0) {
+            sp = rwb[5][i]/ctht[i];
+            if ( 1.0 < sp) sp =  1.0;
+            if (-1.0 > sp) sp = -1.0;
+
+            cp = rwb[8][i]/ctht[i];
+            if ( 1.0 < cp) cp =  1.0;
+            if (-1.0 > cp) cp = -1.0;
+         }
+
+         double ss{rwb[6][i]*sp - rwb[3][i]*cp};
+         if ( 1.0 < ss) ss =  1.0;
+         if (-1.0 > ss) ss = -1.0;
+
+         double cs{rwb[4][i]*cp - rwb[7][i]*sp};
+         if ( 1.0 < cs) cs =  1.0;
+         if (-1.0 > cs) cs = -1.0;
+
+         sphi[i] = sp;
+         cphi[i] = cp;
+         spsi[i] = ss;
+         cpsi[i] = cs;
+      }
+
+      // Euler angles
+      base::simd::atan2Array(sphi.data(), cphi.data(), phi.data(), nr);
+      base::simd::atan2Array(stht.data(), ctht.data(), tht.data(), nr);
+      base::simd::atan2Array(spsi.data(), cpsi.data(), psi.data(), nr);
+      for (unsigned int i = 0; i < nr; i++) {
+         angles[rot[i]].set(phi[i], tht[i], psi[i]);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// clear() -- removes all NIBs
+//------------------------------------------------------------------------------
+void DeadReckoningBatch::clear()
+{
+   nibs.clear();
+   t.clear();
+}
+
+}
+}
@@ -4,6 +4,7 @@
 #include "mixr/interop/INtm.hpp"
 #include "mixr/interop/INtmInputNode.hpp"
 #include "mixr/interop/INtmOutputNode.hpp"
+#include "mixr/interop/InterestManager.hpp"
 #include "NtmOutputNodeStd.hpp"
 
 #include "mixr/models/system/Gun.hpp"
@@ -11,6 +12,7 @@
 #include "mixr/models/player/IPlayer.hpp"
 
 #include "mixr/simulation/ISimulation.hpp"
+#include "mixr/simulation/PlayerArray.hpp"
 #include "mixr/simulation/IStation.hpp"
 
 #include "mixr/base/numeric/Boolean.hpp"
@@ -66,6 +68,9 @@ BEGIN_SLOTTABLE(INetIO)
    "maxOrientationError",  // 12: Max DR angular error
    "maxAge",               // 13: Max age (without update) of networked players
    "maxEntityRange",       // 14: Max entity range of networked players
+
+   "inputInterest",        // 15: Interest filter for the incoming entities
+   "outputInterest",       // 16: Interest filter for the outgoing players
 END_SLOTTABLE(INetIO)
 
 BEGIN_SLOT_MAP(INetIO)
@@ -86,6 +91,9 @@ BEGIN_SLOT_MAP(INetIO)
    ON_SLOT(12, setSlotMaxOrientationErr,  base::IAngle)
    ON_SLOT(13, setSlotMaxAge,             base::ITime)
    ON_SLOT(14, setSlotMaxEntityRange,     base::ILength)
+
+   ON_SLOT(15, setSlotInputInterest,      InterestManager)
+   ON_SLOT(16, setSlotOutputInterest,     InterestManager)
 END_SLOT_MAP()
 
 INetIO::INetIO()
@@ -127,8 +135,15 @@ void INetIO::copyData(const INetIO& org, const bool)
    setMaxOrientationErr(org.maxOrientationErr);
    setMaxAge(org.maxAge);
 
-   nInNibs = 0;
-   nOutNibs = 0;
+   inputInterest = org.inputInterest;
+   outputInterest = org.outputInterest;
+   filteredEntities.clear();
+   numInputFiltered = 0;
+   numProxiesFiltered = 0;
+   numOutputFiltered = 0;
+
+   inputList.clear();
+   outputList.clear();
 
    clearInputEntityTypes();
    for (int i{}; i < org.nInputEntityTypes; i++) {
@@ -147,21 +162,22 @@ void INetIO::copyData(const INetIO& org, const bool)
 
 void INetIO::deleteData()
 {
-   for (int i{}; i < nInNibs; i++) {
-      inputList[i]->unref();
-      inputList[i] = nullptr;
+   for (unsigned int i{}; i < inputList.size(); i++) {
+      inputList.get(i)->unref();
    }
-   nInNibs = 0;
+   inputList.clear();
 
-   for (int i{}; i < nOutNibs; i++) {
-      outputList[i]->unref();
-      outputList[i] = nullptr;
+   for (unsigned int i{}; i < outputList.size(); i++) {
+      outputList.get(i)->unref();
    }
-   nOutNibs = 0;
+   outputList.clear();
 
    clearInputEntityTypes();
    clearOutputEntityTypes();
 
+   inputInterest = nullptr;
+   outputInterest = nullptr;
+
    station = nullptr;
    simulation = nullptr;
 
@@ -185,12 +201,12 @@ void INetIO::reset()
 //------------------------------------------------------------------------------
 bool INetIO::shutdownNotification()
 {
-    for (int i{}; i < nInNibs; i++) {
-        inputList[i]->event(SHUTDOWN_EVENT);
+    for (unsigned int i{}; i < inputList.size(); i++) {
+        inputList.get(i)->event(SHUTDOWN_EVENT);
     }
 
-    for (int i{}; i < nOutNibs; i++) {
-        outputList[i]->event(SHUTDOWN_EVENT);
+    for (unsigned int i{}; i < outputList.size(); i++) {
+        outputList.get(i)->event(SHUTDOWN_EVENT);
     }
     return BaseClass::shutdownNotification();
 }
@@ -242,6 +258,69 @@ double INetIO::getMaxAge(const INib* const) const
    return maxAge;
 }
 
+// Interest filter for the incoming entities (or nullptr)
+const InterestManager* INetIO::getInputInterest() const
+{
+   return inputInterest;
+}
+
+// Interest filter for the outgoing players (or nullptr)
+const InterestManager* INetIO::getOutputInterest() const
+{
+   return outputInterest;
+}
+
+// True if the entity at 'geocPos', which is managed by 'nib', is of interest to 'im'
+bool INetIO::isEntityOfInterest(const InterestManager* const im, const INib* const, const base::Vec3d& geocPos) const
+{
+   return isEntityOfInterest(im, geocPos, InterestManager::ANY, InterestManager::ANY);
+}
+
+// True if an entity of type 'kind' and 'domain' at 'geocPos' is of interest to 'im'
+bool INetIO::isEntityOfInterest(
+      const InterestManager* const im,
+      const base::Vec3d& geocPos,
+      const unsigned char kind,
+      const unsigned char domain
+   ) const
+{
+   if (im == nullptr) return true;
+
+   const base::Vec3d* ownPos{};
+   base::Vec3d pos;
+   const simulation::IStation* sta{getStation()};
+   if (sta != nullptr) {
+      const auto own = dynamic_cast<const models::IPlayer*>(sta->getOwnship());
+      if (own != nullptr) {
+         pos = own->getGeocPosition();
+         ownPos = &pos;
+      }
+   }
+   return im->isOfInterest(geocPos, kind, domain, ownPos);
+}
+
+// Counts a dropped update from the incoming entity 'entityKey'
+void INetIO::inputEntityFiltered(const std::uint64_t entityKey)
+{
+   numInputFiltered++;
+   const double curExecTime{getSimulation()->getExecTimeSec()};
+   const auto result = filteredEntities.try_emplace(entityKey, curExecTime);
+   if (result.second) numProxiesFiltered++;
+   else result.first->second = curExecTime;
+}
+
+// The incoming entity 'entityKey' is of interest (again)
+void INetIO::inputEntityAccepted(const std::uint64_t entityKey)
+{
+   if (!filteredEntities.empty()) filteredEntities.erase(entityKey);
+}
+
+// The incoming entity 'entityKey' has been deleted from the network
+void INetIO::inputEntityRemoved(const std::uint64_t entityKey)
+{
+   if (!filteredEntities.empty()) filteredEntities.erase(entityKey);
+}
+
 // Federate name
 const std::string& INetIO::getFederateName() const
 {
@@ -333,6 +412,7 @@ void INetIO::inputFrame(const double)
 {
    if (isNetworkInitialized()) {
       netInputHander();     // Input handler
+      deadReckonInputList(); // Dead reckon the proxy players' next DR step
       processInputList();   // Update players/systems from the Input-list
       cleanupInputList();   // Cleanup the Input-List (remove old NABs)
    }
@@ -388,18 +468,15 @@ void INetIO::cleanupInputList()
    // Current exec time
    const double curExecTime{getSimulation()->getExecTimeSec()};
 
-   for (int idx{}; idx < nInNibs; idx++) {
-      INib* nib{inputList[idx]};
+   unsigned int idx{};
+   while (idx < inputList.size()) {
+      INib* nib{inputList.get(idx)};
       if ( (nib->isTimeoutEnabled() && ((curExecTime - nib->getTimeExec()) > getMaxAge(nib)) )) {
             // We have one that's timed-out --
             //std::cout << "REMOVED(TO): cur=" << curExecTime << ", NIB=" << nib->getTimeExec() << std::endl;
 
-            // 1) Shift the rest of the list down one
-            nInNibs--;
-            for (int i{idx}; i < nInNibs; i++) {
-               inputList[i] = inputList[i+1];
-            }
-            inputList[nInNibs] = nullptr;
+            // 1) Remove it from the list (the last NIB is moved to 'idx')
+            inputList.removeAt(idx);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
@@ -407,17 +484,22 @@ void INetIO::cleanupInputList()
             // We have one that has a DELETE_REQUEST
             //std::cout << "REMOVED(DR): cur=" << curExecTime << ", NIB=" << nib->getTimeExec() << std::endl;
 
-            // 1) Shift the rest of the list down one
-            nInNibs--;
-            for (int i{idx}; i < nInNibs; i++) {
-               inputList[i] = inputList[i+1];
-            }
-            inputList[nInNibs] = nullptr;
+            // 1) Remove it from the list (the last NIB is moved to 'idx')
+            inputList.removeAt(idx);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
+      } else {
+            idx++;
       }
    }
+
+   // Forget the filtered entities that haven't been updated for 'maxAge' seconds
+   auto it = filteredEntities.begin();
+   while (it != filteredEntities.end()) {
+      if ((curExecTime - it->second) > maxAge) it = filteredEntities.erase(it);
+      else ++it;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -433,25 +515,23 @@ void INetIO::updateOutputList()
       // Remove all DELETE_REQUEST mode NIBs
       //   -- The DELETE_REQUEST were issued last pass, so the network
       //       specific software should have handled them by now.
-      //   -- As NIBs are removed, the table above the NIB is shifted down.
+      //   -- As NIBs are removed, the last NIB in the table is moved to their position.
       //   -- We're also clearing the NIB's 'checked' flag
       // ---
       {
-         int i{};  // src index
-         int j{};  // dest index
-         while (i < nOutNibs) {
-            if (outputList[i]->isMode(models::IPlayer::Mode::DELETE_REQUEST)) {
+         unsigned int i{};
+         while (i < outputList.size()) {
+            INib* nib{outputList.get(i)};
+            if (nib->isMode(models::IPlayer::Mode::DELETE_REQUEST)) {
                // Deleting this NIB
-               //std::cout << "NetIO::updateOutputList() cleanup: nib = " << outputList[i] << std::endl;
-               destroyOutputNib(outputList[i++]);
+               //std::cout << "NetIO::updateOutputList() cleanup: nib = " << nib << std::endl;
+               outputList.removeAt(i);
+               destroyOutputNib(nib);
             } else {
-               if (i != j) outputList[j] = outputList[i];
-               outputList[j]->setCheckedFlag(false);
+               nib->setCheckedFlag(false);
                i++;
-               j++;
             }
          }
-         nOutNibs = j;
       }
 
       // --- ---
@@ -459,20 +539,19 @@ void INetIO::updateOutputList()
       // --- ---
       if ( isOutputEnabled() ) {
 
-         // Get the player list pointer (pre-ref()'d)
-         base::PairStream* players{getSimulation()->getPlayers()};
+         // Get the player array (pre-ref()'d)
+         base::safe_ptr<simulation::PlayerArray> players( getSimulation()->getPlayerArray(), false );
+
+         // The local players, and the networked players when we're relaying
+         const unsigned int np{ (players == nullptr) ? 0 :
+               (isRelayEnabled() ? players->getNumPlayers() : players->getNumLocalPlayers()) };
 
-         // For all players
-         bool finished{};
          unsigned int newCount{};
-         base::IList::Item* playerItem{players->getFirstItem()};
-         while (playerItem != nullptr && !finished) {
+         for (unsigned int i = 0; i < np; i++) {
 
-            // Get player list items
-            base::Pair* playerPair{static_cast<base::Pair*>(playerItem->getValue())};
-            models::IPlayer* player{static_cast<models::IPlayer*>(playerPair->object())};
+            models::IPlayer* player{static_cast<models::IPlayer*>(players->getPlayer(i))};
 
-            if (player->isLocalPlayer() || (isRelayEnabled() && player->getNetworkID() != getNetworkID()) )  {
+            if (player->isLocalPlayer() || player->getNetworkID() != getNetworkID())  {
                if ( player->isActive() && player->isNetOutputEnabled()) {
 
                   // We have (1) an active local player to output or
@@ -491,27 +570,19 @@ void INetIO::updateOutputList()
                      nib->setCheckedFlag(true);
                   }
                }
-            } else {
-               // Finished with local players and we're not relaying
-               finished = !isRelayEnabled();
             }
-
-            // get the next player
-            playerItem = playerItem->getNext();
          }
-
-         players->unref();
       }
 
       // ---
       // Any NIB that was not checked needs to be removed
       // ---
-      for (int i{}; i < nOutNibs; i++) {
-         if ( !outputList[i]->isChecked() ) {
+      for (unsigned int i{}; i < outputList.size(); i++) {
+         if ( !outputList.get(i)->isChecked() ) {
             // Request removal;
             // (note: the network specific code now has one frame to cleanup its own code
             //  before the NIB is dropped from the output list next frame -- see above)
-            outputList[i]->setMode(models::IPlayer::Mode::DELETE_REQUEST);
+            outputList.get(i)->setMode(models::IPlayer::Mode::DELETE_REQUEST);
          }
       }
 
@@ -519,11 +590,52 @@ void INetIO::updateOutputList()
 
 }
 
+//------------------------------------------------------------------------------
+// deadReckonInputList() -- Dead reckons the input-list entities that have
+// proxy players to their next DR step; the players use the results during
+// their next dynamics phase
+//------------------------------------------------------------------------------
+void INetIO::deadReckonInputList()
+{
+   inputDrBatch.clear();
+   inputDrSteps.clear();
+   for (unsigned int idx{}; idx < getInputListSize(); idx++) {
+      INib* nib{getInputNib(idx)};
+      if (nib->getPlayer() != nullptr) {
+         unsigned int step{};
+         inputDrBatch.add(nib, nib->getNextDrStep(&step));
+         inputDrSteps.push_back(step);
+      }
+   }
+   inputDrBatch.compute();
+   for (unsigned int i{}; i < inputDrBatch.size(); i++) {
+      inputDrBatch.getNib(i)->setDrResult(inputDrBatch.getTime(i), inputDrBatch.getPosition(i), inputDrBatch.getAngles(i), inputDrSteps[i]);
+   }
+}
+
 //------------------------------------------------------------------------------
 // processOutputList() -- Process the output-list entities
 //------------------------------------------------------------------------------
 void INetIO::processOutputList()
 {
+   // ---
+   // Dead reckon the local players' NIBs that will check their dead reckoning
+   // errors for player state updates (not those that will send an update anyway)
+   // ---
+   drBatch.clear();
+   for (unsigned int idx{}; idx < getOutputListSize(); idx++) {
+      INib* nib{getOutputNib(idx)};
+      if (nib->isDeadReckoningCheckRequired()) {
+         const models::IPlayer* player{nib->getPlayer()};
+         const double drTime{static_cast<double>(player->getSynchronizedState().getTimeExec()) - nib->getTimeExec()};
+         drBatch.add(nib, drTime);
+      }
+   }
+   drBatch.compute();
+   for (unsigned int i{}; i < drBatch.size(); i++) {
+      drBatch.getNib(i)->setDrResult(drBatch.getTime(i), drBatch.getPosition(i), drBatch.getAngles(i));
+   }
+
    // ---
    // Send player states
    // ---
@@ -549,8 +661,20 @@ void INetIO::processOutputList()
             nib->munitionDetonationMsgFactory(static_cast<double>(curExecTime));
          }
 
-         // Manager entity state updates (do this after detonation check because it updates the NIB's mode)
-         nib->entityStateManager(static_cast<double>(curExecTime));
+         // Manager entity state updates (do this after detonation check because it updates the NIB's mode);
+         // updates of players that are not of interest are suppressed, unless their mode has changed
+         // or they're due a heartbeat (max DR time), so the other federates don't time them out.
+         const models::IPlayer* player{nib->getPlayer()};
+         const double drTime{static_cast<double>(player->getSynchronizedState().getTimeExec()) - nib->getTimeExec()};
+         const bool suppressed{
+            outputInterest != nullptr && !fired && !nib->isMode(models::IPlayer::Mode::DELETE_REQUEST) &&
+            nib->isMode(player->getMode()) && drTime < getMaxTimeDR(nib) &&
+            !isEntityOfInterest(outputInterest, nib, player->getGeocPosition())};
+         if (suppressed) {
+            numOutputFiltered++;
+         } else {
+            nib->entityStateManager(static_cast<double>(curExecTime));
+         }
 
          // Send a fire message; if a fire event was needed, we delayed sending
          // until after the weapon's entity state has been sent at least once.
@@ -647,6 +771,11 @@ models::IPlayer* INetIO::createProxyPlayer(INib* const nib)
       }
    }
 
+   // Interest filter
+   if (inRange && nib != nullptr) {
+      inRange = isEntityOfInterest(getInputInterest(), nib, nib->getDrPosition());
+   }
+
    // ---
    // In range and we haven't done a type check yet.
    // ---
@@ -743,19 +872,9 @@ bool INetIO::addNib2InputList(INib* const nib)
 //------------------------------------------------------------------------------
 INib* INetIO::findNib(const unsigned short playerID, const std::string& federateName, const IoType ioType)
 {
-   // Define the key
-   NibKey key(playerID, federateName);
-
-   // Binary search the table for the NIB
-   INib* found{};
-   if (ioType == INPUT_NIB) {
-      INib** k{static_cast<INib**>(bsearch(&key, inputList.data(), nInNibs, sizeof(INib*), compareKey2Nib))};
-      if (k != nullptr) found = *k;
-   } else {
-      INib** k{static_cast<INib**>(bsearch(&key, outputList.data(), nOutNibs, sizeof(INib*), compareKey2Nib))};
-      if (k != nullptr) found = *k;
-   }
-   return found;
+   // Hash table lookup
+   if (ioType == INPUT_NIB) return inputList.find(playerID, federateName);
+   else return outputList.find(playerID, federateName);
 }
 
 INib* INetIO::findNib(const models::IPlayer* const player, const IoType ioType)
@@ -763,14 +882,14 @@ INib* INetIO::findNib(const models::IPlayer* const player, const IoType ioType)
    INib* found{};
    if (player != nullptr) {
       // Get the player's IDs
-      std::string fName{getFederateName()};
+      const std::string* fName{&getFederateName()};
       if (player->isProxyPlayer()) {
          // If networked, used original IDs
          const auto pNib = dynamic_cast<const INib*>(player->getNib());
-         fName = pNib->getFederateName();
+         fName = &pNib->getFederateName();
       }
       // Now find the NIB using the player's IDs
-      found = findNib(player->getID(), fName, ioType);
+      found = findNib(player->getID(), *fName, ioType);
    }
    return found;
 }
@@ -782,40 +901,11 @@ bool INetIO::addNibToList(INib* const nib, const IoType ioType)
 {
    bool ok{};
    if (nib != nullptr) {
-      INib** tbl{inputList.data()};
-      int n{nInNibs};
-      if (ioType == OUTPUT_NIB) {
-         tbl = outputList.data();
-         n = nOutNibs;
-      }
-
-      if (n < MAX_OBJECTS) {
-
-         // Put the NIB on the top of the table
-         nib->ref();
-         tbl[n] = nib;
-
-         // Create a key for this new NIB
-         NibKey key(nib->getPlayerID(), nib->getFederateName());
-
-         if (n > 0) {
-            // Now, 'bubble down' to its correct position
-            int idx{n-1};
-            while (idx >= 0 && compareKey2Nib(&key, &tbl[idx]) <= 0) {
-               // Swap the table entries
-               INib* tmp{tbl[idx]};
-               tbl[idx] = tbl[idx+1];
-               tbl[idx+1] = tmp;
-               idx--;
-            }
-         }
-
-         // Increment the count
-         if (ioType == OUTPUT_NIB) nOutNibs++;
-         else nInNibs++;
+      if (ioType == OUTPUT_NIB) ok = outputList.add(nib);
+      else ok = inputList.add(nib);
 
-         ok = true;
-      }
+      // The table has it
+      if (ok) nib->ref();
    }
    return ok;
 }
@@ -825,60 +915,11 @@ bool INetIO::addNibToList(INib* const nib, const IoType ioType)
 //------------------------------------------------------------------------------
 void INetIO::removeNibFromList(INib* const nib, const IoType ioType)
 {
-   INib** tbl{inputList.data()};
-   int n{nInNibs};
-   if (ioType == OUTPUT_NIB) {
-      tbl = outputList.data();
-      n = nOutNibs;
-   }
+   bool found{};
+   if (ioType == OUTPUT_NIB) found = outputList.remove(nib);
+   else found = inputList.remove(nib);
 
-   int found{-1};
-   // Find the NIB
-   for (int i{}; i < n && found < 0; i++) {
-      if (nib == tbl[i]) found = i;
-   }
-
-   // Shift down all items above this NIB one position
-   if (found >= 0) {
-      tbl[found]->unref();
-      int n1{n - 1};
-      for (int i{found}; i < n1; i++) {
-         tbl[i] = tbl[i+1];
-      }
-      tbl[n-1] = nullptr;
-
-      // Decrement the count
-      if (ioType == OUTPUT_NIB) --nOutNibs;
-      else --nInNibs;
-   }
-}
-
-//------------------------------------------------------------------------------
-// bsearch callbacks: object name compare function --
-//   True types are (const NibKey* key, const Nib** nib)
-//------------------------------------------------------------------------------
-int INetIO::compareKey2Nib(const void* key, const void* nib)
-{
-   // the key
-   const NibKey* pKey{static_cast<const NibKey*>(key)};
-
-   // the NIB
-   const INib* const* pp{static_cast<const INib* const*>(nib)};
-   const INib* pNib{*pp};
-
-   // default to equal
-   int result{};
-
-   // first, compare the player IDs
-   if (pKey->id > pNib->getPlayerID()) result = +1;
-   else if (pKey->id < pNib->getPlayerID()) result = -1;
-
-   if (result == 0) {
-      // if they're the same, compare the federate names
-      result = std::strcmp(pKey->fName.c_str(), pNib->getFederateName().c_str());
-   }
-
-   return result;
+   if (found) nib->unref();
 }
 
 //------------------------------------------------------------------------------
@@ -1158,6 +1199,21 @@ bool INetIO::setSlotOutputEntityTypes(base::PairStream* const msg)
     return ok;
 }
 
+// Sets the interest filter for incoming entities
+bool INetIO::setSlotInputInterest(const InterestManager* const x)
+{
+   inputInterest = x;
+   filteredEntities.clear();
+   return true;
+}
+
+// Sets the interest filter for outgoing players
+bool INetIO::setSlotOutputInterest(const InterestManager* const x)
+{
+   outputInterest = x;
+   return true;
+}
+
 // Sets the mac DR time(s)
 bool INetIO::setSlotMaxTimeDR(const base::ITime* const x)
 {
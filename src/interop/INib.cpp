@@ -15,6 +15,7 @@
 #include "mixr/base/PairStream.hpp"
 
 #include "mixr/base/util/nav_utils.hpp"
+#include "mixr/base/util/platform_api.hpp"
 #include "mixr/base/util/str_utils.hpp"
 
 #include <cmath>
@@ -50,6 +51,8 @@ void INib::initData()
    drPos.set(0,0,0);
    drAngles.set(0,0,0);
 
+   drResultValid = false;
+
    smoothVel.set(0,0,0);
 }
 
@@ -98,8 +101,11 @@ void INib::copyData(const INib& org, const bool cc)
    drOmega = org.drOmega;
 
    drTime = org.drTime;
+   drStep = org.drStep;
+   drStepNum = org.drStepNum;
    drPos = org.drPos;
    drAngles = org.drAngles;
+   drResultValid = false;
 
    smoothVel = org.smoothVel;
    smoothTime = org.smoothTime;
@@ -386,36 +392,25 @@ bool INib::isPlayerStateUpdateRequired(const double curExecTime)
       models::SynchronizedState playerState{player->getSynchronizedState()};
       const double drTime{static_cast<double>(playerState.getTimeExec()) - getTimeExec()};
 
-      // 3-a) Freeze flag has changed
-      if ( (player->isFrozen() && isNotFrozen()) || (!player->isFrozen() && isFrozen()) ) {
+      // 3-a) to 3-c) Freeze flag, max DR timeout and appearance changes
+      if (isLocalStateUpdateRequired(player, drTime)) {
          result = YES;
       }
 
-      // 3-b) Max DR timeout
-      if (result == UNSURE) {
-         if ( drTime >= getNetIO()->getMaxTimeDR(this) ) {
-            result = YES;
-         }
-      }
-
-      // 3-c) Appearance has changed
-      if (result == UNSURE &&
-         (player->getDamage() != getDamage() ||
-         player->getSmoke()  != getSmoke()   ||
-         player->getFlames() != getFlames() ||
-         player->getCamouflageType() != getCamouflageType() )
-         ) {
-            result = YES;
-      }
-
       // 3-d) Check dead reckoning errors
       if (result == UNSURE && isNotFrozen()) {
 
          // Compute our dead reckoned position and angles, which are
          // based on our last packet sent.
+         // (use the results from setDrResult(), which are cleared below)
          base::Vec3d drPos;
          base::Vec3d drAngles;
-         mainDeadReckoning(drTime, &drPos, &drAngles);
+         if (drResultValid) {
+            drPos = drResultPos;
+            drAngles = drResultAngles;
+         } else {
+            mainDeadReckoning(drTime, &drPos, &drAngles);
+         }
 
          // 3-d-1) Position error
          if (!player->isPositionFrozen() && !player->isAltitudeFrozen()) {
@@ -599,9 +594,51 @@ bool INib::isPlayerStateUpdateRequired(const double curExecTime)
       }
    }
 
+   // The DR results are only used once
+   drResultValid = false;
+
    return (result == YES);
 }
 
+//------------------------------------------------------------------------------
+// isLocalStateUpdateRequired() -- checks 3-a to 3-c of isPlayerStateUpdateRequired()
+//------------------------------------------------------------------------------
+bool INib::isLocalStateUpdateRequired(const models::IPlayer* const player, const double drTime) const
+{
+   // 3-a) Freeze flag has changed
+   if ( (player->isFrozen() && isNotFrozen()) || (!player->isFrozen() && isFrozen()) ) {
+      return true;
+   }
+
+   // 3-b) Max DR timeout
+   if ( drTime >= getNetIO()->getMaxTimeDR(this) ) {
+      return true;
+   }
+
+   // 3-c) Appearance has changed
+   return (player->getDamage() != getDamage() ||
+           player->getSmoke()  != getSmoke()   ||
+           player->getFlames() != getFlames() ||
+           player->getCamouflageType() != getCamouflageType() );
+}
+
+//------------------------------------------------------------------------------
+// isDeadReckoningCheckRequired() -- true if the next isPlayerStateUpdateRequired()
+// will check the dead reckoning errors (steps 1 to 3-c don't require an update)
+//------------------------------------------------------------------------------
+bool INib::isDeadReckoningCheckRequired() const
+{
+   const models::IPlayer* player{pPlayer};
+   if (player == nullptr || isEntityTypeInvalid() || !player->isLocalPlayer() || isFrozen()) return false;
+
+   // 2) and 2-a) Mode changes
+   if (isNotMode(player->getMode()) || isMode(models::IPlayer::Mode::DELETE_REQUEST)) return false;
+
+   // 3-a) to 3-c)
+   const double drTime{static_cast<double>(player->getSynchronizedState().getTimeExec()) - getTimeExec()};
+   return !isLocalStateUpdateRequired(player, drTime);
+}
+
 //------------------------------------------------------------------------------
 // playerState2Nib() -- Sets this NIB's player data
 //------------------------------------------------------------------------------
@@ -700,10 +737,23 @@ bool INib::updateDeadReckoning(
 {
    bool ok{ioType == INetIO::INPUT_NIB};
    if (ok) {
-      double time{updateDrTime(dt)};
+      base::lock(drResultLock);
+      drStepNum++;
+      const bool useResult{drResultValid && drResultStep == drStepNum && dt == drStep};
+      if (useResult) {
+         // Use the results from setDrResult(), which are for this DR step
+         drTime = drResultTime;
+         drPos = drResultPos;
+         drAngles = drResultAngles;
+      } else {
+         updateDrTime(dt);
+      }
+      drResultValid = false;
+      drStep = dt;
+      base::unlock(drResultLock);
 
       // Main Dead Reckoning Function
-      mainDeadReckoning( time, &drPos, &drAngles );
+      if (!useResult) mainDeadReckoning( drTime, &drPos, &drAngles );
       //std::cout << "updateDeadReckoning(): geoc pos(";
       //std::cout << drPos[0] << ", ";
       //std::cout << drPos[1] << ", ";
@@ -779,6 +829,7 @@ bool INib::resetDeadReckoning(
    //double drTimeN1 = drTime;
    drNum = dr;
    drTime = time;
+   drResultValid = false;
 
    //if (ioType == NetIO::INPUT_NIB) {
       //std::cout << "resetDeadReckoning(): drTime = " << drTimeN1 << std::endl;
@@ -807,6 +858,32 @@ bool INib::resetDeadReckoning(
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Returns the DR time of the (input) NIB's next DR step, and its step number
+//------------------------------------------------------------------------------
+double INib::getNextDrStep(unsigned int* const step) const
+{
+   base::lock(drResultLock);
+   const double time{drTime + drStep};
+   *step = drStepNum + 1;
+   base::unlock(drResultLock);
+   return time;
+}
+
+//------------------------------------------------------------------------------
+// Sets the DR results @ DR time 'dT' for their next use (see INib.hpp)
+//------------------------------------------------------------------------------
+void INib::setDrResult(const double dT, const base::Vec3d& pos, const base::Vec3d& angles, const unsigned int step)
+{
+   base::lock(drResultLock);
+   drResultTime = dT;
+   drResultStep = step;
+   drResultPos = pos;
+   drResultAngles = angles;
+   drResultValid = true;
+   base::unlock(drResultLock);
+}
+
 //------------------------------------------------------------------------------
 // Main Dead Reckoning Function
 //------------------------------------------------------------------------------
@@ -0,0 +1,239 @@
+
+#include "mixr/interop/InterestManager.hpp"
+
+#include "mixr/base/IList.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/qty/lengths.hpp"
+#include "mixr/base/util/nav_utils.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace mixr {
+namespace interop {
+
+IMPLEMENT_SUBCLASS(InterestManager, "InterestManager")
+EMPTY_DELETEDATA(InterestManager)
+
+BEGIN_SLOTTABLE(InterestManager)
+   "range",          // 1) Radius of interest around the ownship
+   "areas",          // 2) Areas of interest (polygons)
+   "entityKinds",    // 3) Entity kinds of interest
+   "entityDomains",  // 4) Entity domains of interest
+END_SLOTTABLE(InterestManager)
+
+BEGIN_SLOT_MAP(InterestManager)
+   ON_SLOT(1, setSlotRange,         base::ILength)
+   ON_SLOT(2, setSlotAreas,         base::PairStream)
+   ON_SLOT(3, setSlotEntityKinds,   base::IList)
+   ON_SLOT(4, setSlotEntityDomains, base::IList)
+END_SLOT_MAP()
+
+InterestManager::InterestManager()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void InterestManager::copyData(const InterestManager& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   range = org.range;
+   range2 = org.range2;
+   areas = org.areas;
+   kinds = org.kinds;
+   anyKind = org.anyKind;
+   domains = org.domains;
+   anyDomain = org.anyDomain;
+}
+
+//------------------------------------------------------------------------------
+// True if the entity type, 'kind' and 'domain', is of interest
+//------------------------------------------------------------------------------
+bool InterestManager::isEntityTypeOfInterest(const unsigned char kind, const unsigned char domain) const
+{
+   const bool kindOk{anyKind || kind == ANY || kinds[kind]};
+   const bool domainOk{anyDomain || domain == ANY || domains[domain]};
+   return (kindOk && domainOk);
+}
+
+//------------------------------------------------------------------------------
+// True if the geocentric (ECEF) position, 'pos', is of interest
+//------------------------------------------------------------------------------
+bool InterestManager::isPositionOfInterest(const base::Vec3d& pos, const base::Vec3d* const ownPos) const
+{
+   const bool useRange{range > 0.0 && ownPos != nullptr};
+
+   // No range and no areas -- everywhere is of interest
+   if (!useRange && areas.empty()) return true;
+
+   // Within range of the ownship
+   if (useRange && (pos - *ownPos).length2() <= range2) return true;
+
+   // Inside one of the areas
+   if (!areas.empty()) {
+      double lat{};
+      double lon{};
+      double alt{};
+      base::nav::convertEcef2Geod(pos[0], pos[1], pos[2], &lat, &lon, &alt);
+      return isInsideArea(lat, lon);
+   }
+
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// True if the entity of this type at this position is of interest
+//------------------------------------------------------------------------------
+bool InterestManager::isOfInterest(
+      const base::Vec3d& pos,
+      const unsigned char kind,
+      const unsigned char domain,
+      const base::Vec3d* const ownPos
+   ) const
+{
+   return isEntityTypeOfInterest(kind, domain) && isPositionOfInterest(pos, ownPos);
+}
+
+//------------------------------------------------------------------------------
+// True if the point is inside one of the areas
+//------------------------------------------------------------------------------
+bool InterestManager::isInsideArea(const double lat, const double lon) const
+{
+   for (const Area& area : areas) {
+      if (isInside(area, lat, lon)) return true;
+   }
+   return false;
+}
+
+// True if the point is inside the polygon (even-odd rule)
+bool InterestManager::isInside(const Area& area, const double lat, const double lon)
+{
+   if (lat < area.minLat || lat > area.maxLat || lon < area.minLon || lon > area.maxLon) return false;
+
+   bool inside{};
+   const std::size_t n{area.lat.size()};
+   for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+      const double lat1{area.lat[i]}, lon1{area.lon[i]};
+      const double lat2{area.lat[j]}, lon2{area.lon[j]};
+      if ((lat1 > lat) != (lat2 > lat)) {
+         const double lonX{lon1 + (lat - lat1) * (lon2 - lon1) / (lat2 - lat1)};
+         if (lon < lonX) inside = !inside;
+      }
+   }
+   return inside;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+// Sets the radius of interest around the ownship (meters)
+bool InterestManager::setRange(const double meters)
+{
+   bool ok{meters >= 0.0};
+   if (ok) {
+      range = meters;
+      range2 = meters * meters;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool InterestManager::setSlotRange(const base::ILength* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setRange(msg->getValueInMeters());
+      if (!ok) {
+         std::cerr << "InterestManager::setSlotRange(): invalid range; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool InterestManager::setSlotAreas(const base::PairStream* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = true;
+      std::vector<Area> newAreas;
+      const base::IList::Item* item{msg->getFirstItem()};
+      while (item != nullptr) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto list = dynamic_cast<const base::IList*>(pair->object());
+         std::vector<double> values;
+         if (list != nullptr) {
+            values.resize(list->entries());
+            values.resize(list->getNumberList(values.data(), values.size()));
+         }
+         if (values.size() >= 6 && (values.size() % 2) == 0) {
+            Area area;
+            for (std::size_t i = 0; i < values.size(); i += 2) {
+               area.lat.push_back(values[i]);
+               area.lon.push_back(values[i + 1]);
+            }
+            area.minLat = *std::min_element(area.lat.begin(), area.lat.end());
+            area.maxLat = *std::max_element(area.lat.begin(), area.lat.end());
+            area.minLon = *std::min_element(area.lon.begin(), area.lon.end());
+            area.maxLon = *std::max_element(area.lon.begin(), area.lon.end());
+            newAreas.push_back(area);
+         } else {
+            std::cerr << "InterestManager::setSlotAreas(): area " << pair->slot() << " is not a list of three or more [ lat lon ] points" << std::endl;
+            ok = false;
+         }
+         item = item->getNext();
+      }
+      if (ok) areas = newAreas;
+   }
+   return ok;
+}
+
+bool InterestManager::setSlotEntityKinds(const base::IList* const msg)
+{
+   return setTypeFilter(msg, &kinds, &anyKind, "setSlotEntityKinds");
+}
+
+bool InterestManager::setSlotEntityDomains(const base::IList* const msg)
+{
+   return setTypeFilter(msg, &domains, &anyDomain, "setSlotEntityDomains");
+}
+
+// Sets a kind or domain filter from a list of type codes
+bool InterestManager::setTypeFilter(
+      const base::IList* const msg,
+      std::array<bool, 256>* const filter,
+      bool* const any,
+      const char* const name
+   )
+{
+   bool ok{};
+   if (msg != nullptr) {
+      std::vector<int> values(msg->entries());
+      values.resize(msg->getNumberList(values.data(), values.size()));
+
+      ok = true;
+      for (const int v : values) {
+         if (v < 0 || v >= ANY) {
+            std::cerr << "InterestManager::" << name << "(): invalid type code: " << v << "; must be [ 0 .. 254 ]" << std::endl;
+            ok = false;
+         }
+      }
+
+      if (ok) {
+         filter->fill(false);
+         for (const int v : values) {
+            (*filter)[v] = true;
+         }
+         *any = values.empty();
+      }
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,188 @@
+
+#include "mixr/interop/NibTable.hpp"
+
+#include "mixr/interop/INib.hpp"
+
+#include <algorithm>
+
+namespace mixr {
+namespace interop {
+
+//------------------------------------------------------------------------------
+// find() -- finds the NIB by player ID and federate name
+//------------------------------------------------------------------------------
+INib* NibTable::find(const unsigned short playerID, const std::string& federateName) const
+{
+   INib* found{};
+   std::uint64_t key{};
+   if (findKey(playerID, federateName, &key)) {
+      const std::uint32_t slot{findSlot(key)};
+      if (slot != EMPTY) found = nibs[slots[slot].idx];
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// add() -- adds a NIB; returns false if a NIB with the same IDs is already in the table
+//------------------------------------------------------------------------------
+bool NibTable::add(INib* const nib)
+{
+   if (nib == nullptr) return false;
+
+   const std::uint64_t key{makeKey(nib)};
+   if (findSlot(key) != EMPTY) return false;
+
+   // Keep the hash table no more than half full
+   if ((nibs.size() + 1) * 2 > slots.size()) grow();
+
+   const auto idx = static_cast<std::uint32_t>(nibs.size());
+   nibs.push_back(nib);
+   keys.push_back(key);
+   insertSlot(key, idx);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// remove() -- removes a NIB, which is found by its IDs; returns false if it's
+// not in the table
+//------------------------------------------------------------------------------
+bool NibTable::remove(const INib* const nib)
+{
+   if (nib == nullptr) return false;
+
+   std::uint64_t key{};
+   if (findKey(nib->getPlayerID(), nib->getFederateName(), &key)) {
+      const std::uint32_t slot{findSlot(key)};
+      if (slot != EMPTY && nibs[slots[slot].idx] == nib) {
+         removeAt(slots[slot].idx);
+         return true;
+      }
+   }
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// removeAt() -- removes the idx'th NIB; the last NIB is moved to 'idx'
+//------------------------------------------------------------------------------
+void NibTable::removeAt(const unsigned int idx)
+{
+   if (idx >= nibs.size()) return;
+
+   eraseSlot(findSlot(keys[idx]));
+
+   const auto last = static_cast<std::uint32_t>(nibs.size() - 1);
+   if (idx != last) {
+      nibs[idx] = nibs[last];
+      keys[idx] = keys[last];
+      slots[findSlot(keys[idx])].idx = idx;
+   }
+   nibs.pop_back();
+   keys.pop_back();
+}
+
+//------------------------------------------------------------------------------
+// clear() -- removes all NIBs
+//------------------------------------------------------------------------------
+void NibTable::clear()
+{
+   nibs.clear();
+   keys.clear();
+   std::fill(slots.begin(), slots.end(), Slot());
+}
+
+//------------------------------------------------------------------------------
+// Keys are the federate name ID (upper bits) and the player ID (lower 16 bits)
+//------------------------------------------------------------------------------
+
+// Makes the NIB's key, interning its federate name as needed
+std::uint64_t NibTable::makeKey(const INib* const nib)
+{
+   const auto fedID = static_cast<std::uint32_t>(fedIDs.size());
+   const auto it = fedIDs.emplace(nib->getFederateName(), fedID).first;
+   return ((static_cast<std::uint64_t>(it->second) << 16) | nib->getPlayerID());
+}
+
+// Finds the key for these IDs; returns false if the federate name has never been seen
+bool NibTable::findKey(const unsigned short playerID, const std::string& federateName, std::uint64_t* const key) const
+{
+   const auto it = fedIDs.find(federateName);
+   if (it == fedIDs.end()) return false;
+   *key = ((static_cast<std::uint64_t>(it->second) << 16) | playerID);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Hash table (linear probing)
+//------------------------------------------------------------------------------
+
+// Returns the slot holding 'key', or EMPTY
+std::uint32_t NibTable::findSlot(const std::uint64_t key) const
+{
+   if (slots.empty()) return EMPTY;
+
+   const auto mask = static_cast<std::uint32_t>(slots.size() - 1);
+   std::uint32_t i{hash(key) & mask};
+   while (slots[i].idx != EMPTY) {
+      if (slots[i].key == key) return i;
+      i = (i + 1) & mask;
+   }
+   return EMPTY;
+}
+
+// Inserts 'key' (which isn't in the table)
+void NibTable::insertSlot(const std::uint64_t key, const std::uint32_t idx)
+{
+   const auto mask = static_cast<std::uint32_t>(slots.size() - 1);
+   std::uint32_t i{hash(key) & mask};
+   while (slots[i].idx != EMPTY) {
+      i = (i + 1) & mask;
+   }
+   slots[i].key = key;
+   slots[i].idx = idx;
+}
+
+// Empties 'slot', and shifts back the following entries of its probe sequence
+void NibTable::eraseSlot(std::uint32_t slot)
+{
+   if (slot == EMPTY) return;
+
+   const auto mask = static_cast<std::uint32_t>(slots.size() - 1);
+   std::uint32_t j{slot};
+   for (;;) {
+      slots[slot].idx = EMPTY;
+      for (;;) {
+         j = (j + 1) & mask;
+         if (slots[j].idx == EMPTY) return;
+
+         // Leave it if its home slot is cyclically within (slot, j]
+         const std::uint32_t k{hash(slots[j].key) & mask};
+         const bool stays{ (slot <= j) ? (slot < k && k <= j) : (slot < k || k <= j) };
+         if (!stays) break;
+      }
+      slots[slot] = slots[j];
+      slot = j;
+   }
+}
+
+// Doubles the size of the hash table (min 64 slots), and rehashes the NIBs
+void NibTable::grow()
+{
+   const std::size_t n{std::max<std::size_t>(64, slots.size() * 2)};
+   slots.assign(n, Slot());
+   for (std::uint32_t i = 0; i < keys.size(); i++) {
+      insertSlot(keys[i], i);
+   }
+}
+
+//------------------------------------------------------------------------------
+// hash() -- hash of a key
+//------------------------------------------------------------------------------
+std::uint32_t NibTable::hash(const std::uint64_t key)
+{
+   std::uint64_t h{key * 0x9e3779b97f4a7c15ULL};
+   h ^= (h >> 32);
+   return static_cast<std::uint32_t>(h);
+}
+
+}
+}
@@ -11,6 +11,7 @@
 
 #include "mixr/models/IWorldModel.hpp"
 
+#include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/IList.hpp"
 #include "mixr/base/network/INetHandler.hpp"
@@ -27,6 +28,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <iostream>
 
 namespace mixr {
 namespace dis {
@@ -72,6 +74,8 @@ BEGIN_SLOTTABLE(NetIO)
    "siteID",               // 10: Site Identification
    "applicationID",        // 11: Application Identification
    "exerciseID",           // 12: Exercise Identification
+   "bundleOutput",         // 13: Bundle the output PDUs into datagrams
+   "maxDatagramSize",      // 14: Max size of the bundled datagrams (bytes)
 END_SLOTTABLE(NetIO)
 
 BEGIN_SLOT_MAP(NetIO)
@@ -99,6 +103,9 @@ BEGIN_SLOT_MAP(NetIO)
    ON_SLOT(10, setSlotSiteID,             base::Integer)
    ON_SLOT(11, setSlotApplicationID,      base::Integer)
    ON_SLOT(12, setSlotExerciseID,         base::Integer)
+
+   ON_SLOT(13, setSlotBundleOutput,       base::Boolean)
+   ON_SLOT(14, setSlotMaxDatagramSize,    base::Integer)
 END_SLOT_MAP()
 
 NetIO::NetIO() : netInput(nullptr), netOutput(nullptr)
@@ -128,6 +135,9 @@ void NetIO::copyData(const NetIO& org, const bool cc)
    appID = org.appID;
    exerciseID = org.exerciseID;
 
+   bundleOutput = org.bundleOutput;
+   maxDatagramSize = org.maxDatagramSize;
+
    clearEmissionPduHandlers();
    for (unsigned int i = 0; i < org.nEmissionHandlers; i++) {
       const EmissionPduHandler* const tmp = org.emissionHandlers[i]->clone();
@@ -196,17 +206,15 @@ bool NetIO::initNetwork()
 void NetIO::netInputHander()
 {
    // Read PDUs
-   unsigned int j0{};
-   while ( (j0 < MAX_PDUs) && (recvData(reinterpret_cast<char*>(&inputBuffer[j0]), MAX_PDU_SIZE) > 0) ) {
-      j0++;
-   }
+   unsigned int j0{recvBatch(reinterpret_cast<char*>(&inputBuffer[0]), MAX_DATAGRAM_SIZE, inputSizes, MAX_INPUT_DATAGRAMS)};
 
    while (j0 > 0) {
 
-      // Process incoming PDUs
+      // Process incoming PDUs (bundled datagrams are split into their PDUs)
       unsigned int j1{};
-      while (j1 < j0) {
-         PDUHeader* header{reinterpret_cast<PDUHeader*>(&inputBuffer[j1++][0])};
+      unsigned int offset{};
+      PDUHeader* header{};
+      while ((header = nextInputPdu(&j1, &offset, j0)) != nullptr) {
 
          if (isInputEnabled()) {
 
@@ -221,10 +229,13 @@ void NetIO::netInputHander()
                   case PDU_ENTITY_STATE: {
                      //std::cout << "Entity State PDU." << std::endl;
                      EntityStatePDU* pPdu{reinterpret_cast<EntityStatePDU*>(header)};
-                     if (base::INetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->entityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->entityID.simulationID.applicationIdentification) {
-                           processEntityStatePDU(pPdu);
+                     // Known entities are updated without swapping the PDU (see note #9)
+                     if (!processEntityStateView(EntityStatePduView(pPdu, base::INetHandler::isNotNetworkByteOrder()))) {
+                        if (base::INetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+                        if (getSiteID() != pPdu->entityID.simulationID.siteIdentification ||
+                           getApplicationID() != pPdu->entityID.simulationID.applicationIdentification) {
+                              processEntityStatePDU(pPdu);
+                        }
                      }
                   }
                   break;
@@ -383,14 +394,70 @@ void NetIO::netInputHander()
       }  // processing PDUs
 
       // Read more PDUs
-      j0 = 0;
-      while ( (j0 < MAX_PDUs) && (recvData(reinterpret_cast<char*>(&inputBuffer[j0]), MAX_PDU_SIZE) > 0) ) {
-         j0++;
-      }
+      j0 = recvBatch(reinterpret_cast<char*>(&inputBuffer[0]), MAX_DATAGRAM_SIZE, inputSizes, MAX_INPUT_DATAGRAMS);
    }
 
 }
 
+//------------------------------------------------------------------------------
+// nextInputPdu() -- returns the next PDU from the first 'n' input buffer
+// datagrams, starting at byte 'offset' of datagram 'idx', and advances both;
+// returns zero when there are no more PDUs.
+//
+// The first PDU of each datagram is always returned.  Following PDUs, which
+// may start on the next 64-bit boundary, are returned if their length (from
+// the PDU header) fits within the datagram.
+//------------------------------------------------------------------------------
+PDUHeader* NetIO::nextInputPdu(unsigned int* const idx, unsigned int* const offset, const unsigned int n)
+{
+   PDUHeader* header{};
+   while (header == nullptr && *idx < n) {
+      char* const datagram{reinterpret_cast<char*>(&inputBuffer[*idx][0])};
+      const unsigned int size{inputSizes[*idx]};
+      unsigned int pos{*offset};
+
+      // Skip any zero padding up to the next 64-bit boundary
+      const unsigned int aligned{(pos + 7) & ~7u};
+      if (aligned > pos && aligned < size) {
+         bool padding{true};
+         for (unsigned int i = pos; i < aligned && padding; i++) {
+            padding = (datagram[i] == 0);
+         }
+         if (padding) pos = aligned;
+      }
+
+      // PDU length (bytes); the header is still in network order
+      unsigned int length{};
+      if (pos + sizeof(PDUHeader) <= size) {
+         const PDUHeader* const p{reinterpret_cast<const PDUHeader*>(&datagram[pos])};
+         length = p->length;
+         if (base::INetHandler::isNotNetworkByteOrder()) length = convertUInt16(p->length);
+      }
+      const bool valid{length >= sizeof(PDUHeader) && (pos + length) <= size};
+
+      if (pos == 0) {
+         header = reinterpret_cast<PDUHeader*>(datagram);
+      } else if (valid) {
+         if ((pos % 8) == 0) {
+            header = reinterpret_cast<PDUHeader*>(&datagram[pos]);
+         } else {
+            // Make an aligned copy
+            std::memcpy(inputPdu, &datagram[pos], length);
+            header = reinterpret_cast<PDUHeader*>(&inputPdu[0]);
+         }
+      }
+
+      // Next PDU in this datagram, or the next datagram
+      if (valid && (pos + length) < size) {
+         *offset = pos + length;
+      } else {
+         (*idx)++;
+         *offset = 0;
+      }
+   }
+   return header;
+}
+
 //------------------------------------------------------------------------------
 // processInputList() -- Update players/systems from the Input-list
 //------------------------------------------------------------------------------
@@ -410,6 +477,69 @@ void NetIO::processInputList()
 //   std::cout << std::endl;
 }
 
+//------------------------------------------------------------------------------
+// processOutputList() -- Process the Output-list; the PDUs that are sent while
+// processing the list are queued and sent together at the end.
+//------------------------------------------------------------------------------
+void NetIO::processOutputList()
+{
+   queueOutput = true;
+   BaseClass::processOutputList();
+   queueOutput = false;
+
+   flushOutput();
+}
+
+//------------------------------------------------------------------------------
+// flushOutput() -- send the queued output PDUs; the datagrams that aren't
+// sent are tried once more, and then dropped
+//------------------------------------------------------------------------------
+void NetIO::flushOutput()
+{
+   if (numOutputDatagrams > 0 && netOutput != nullptr) {
+      const char* packets[MAX_PDUs]{};
+      for (unsigned int i = 0; i < numOutputDatagrams; i++) {
+         packets[i] = reinterpret_cast<const char*>(&outputBuffer[i]);
+      }
+      const unsigned int n{numOutputDatagrams};
+      unsigned int sent{netOutput->sendBatch(packets, outputSizes, n)};
+      if (sent < n) {
+         sent += netOutput->sendBatch(&packets[sent], &outputSizes[sent], n - sent);
+      }
+      if (sent < n) {
+         numOutputDropped += (n - sent);
+         if (isMessageEnabled(MSG_WARNING)) {
+            std::cerr << "NetIO::flushOutput(): " << (n - sent) << " of " << n << " datagrams not sent" << std::endl;
+         }
+      }
+   }
+   numOutputDatagrams = 0;
+}
+
+//------------------------------------------------------------------------------
+// queueOutputPdu() -- queue an output PDU; when bundling, the PDU is added to
+// the last queued datagram, on its next 64-bit boundary, if it fits within
+// the max datagram size; otherwise it starts a new datagram.
+//------------------------------------------------------------------------------
+void NetIO::queueOutputPdu(const char* const packet, const int size)
+{
+   if (bundleOutput && numOutputDatagrams > 0) {
+      const unsigned int last{numOutputDatagrams - 1};
+      const unsigned int pos{(static_cast<unsigned int>(outputSizes[last]) + 7) & ~7u};
+      if ((pos + size) <= maxDatagramSize) {
+         char* const datagram{reinterpret_cast<char*>(&outputBuffer[last])};
+         std::memset(&datagram[outputSizes[last]], 0, pos - outputSizes[last]);
+         std::memcpy(&datagram[pos], packet, size);
+         outputSizes[last] = static_cast<int>(pos + size);
+         return;
+      }
+   }
+
+   if (numOutputDatagrams >= MAX_PDUs) flushOutput();
+   std::memcpy(&outputBuffer[numOutputDatagrams], packet, size);
+   outputSizes[numOutputDatagrams++] = size;
+}
+
 //------------------------------------------------------------------------------
 // processSignalPDU() callback --
 //------------------------------------------------------------------------------
@@ -617,13 +747,31 @@ int NetIO::recvData(char* const packet, const int maxSize)
 }
 
 //------------------------------------------------------------------------------
-// sendData() -- send data packet
+// recvBatch() -- receive up to 'n' data packets
+//------------------------------------------------------------------------------
+unsigned int NetIO::recvBatch(char* const buffer, const int maxSize, unsigned int* const sizes, const unsigned int n)
+{
+   unsigned int result{};
+   if (netInput != nullptr) {
+      result = netInput->recvBatch(buffer, maxSize, sizes, n);
+   }
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// sendData() -- send data packet; while processing the output list, the
+// packet is queued, and it's sent at the end (see processOutputList())
 //------------------------------------------------------------------------------
 bool NetIO::sendData(const char* const packet, const int size)
 {
    bool result{};
    if (netOutput != nullptr) {
-      result = netOutput->sendData( packet, size );
+      if (queueOutput && size > 0 && size <= MAX_PDU_SIZE) {
+         queueOutputPdu(packet, size);
+         result = true;
+      } else {
+         result = netOutput->sendData( packet, size );
+      }
    }
    return result;
 }
@@ -719,6 +867,16 @@ double NetIO::getMaxEntityRangeSquared(const interop::INib* const nib) const
    return value;
 }
 
+// True if the entity at 'geocPos', which is managed by 'nib', is of interest to 'im' (see note #10)
+bool NetIO::isEntityOfInterest(const interop::InterestManager* const im, const interop::INib* const nib, const base::Vec3d& geocPos) const
+{
+   const auto disNib = dynamic_cast<const Nib*>(nib);
+   if (disNib != nullptr) {
+      return BaseClass::isEntityOfInterest(im, geocPos, disNib->getEntityKind(), disNib->getEntityDomain());
+   }
+   return BaseClass::isEntityOfInterest(im, nib, geocPos);
+}
+
 double NetIO::getMaxTimeDR(const interop::INib* const nib) const
 {
    double value{};
@@ -839,6 +997,24 @@ bool NetIO::setExerciseID(const unsigned char v)
     return true;
 }
 
+// Enables/disables output PDU bundling
+bool NetIO::setOutputBundling(const bool flg)
+{
+    bundleOutput = flg;
+    return true;
+}
+
+// Sets the max size of the bundled datagrams (bytes)
+bool NetIO::setMaxDatagramSize(const unsigned int v)
+{
+    bool ok{};
+    if (v > 0 && v <= MAX_PDU_SIZE) {
+        maxDatagramSize = v;
+        ok = true;
+    }
+    return ok;
+}
+
 // setMaxEntityRange() -- Sets max entity range (meters)
 bool NetIO::setMaxEntityRange(const double v, const unsigned char kind, const unsigned char domain)
 {
@@ -1502,6 +1678,31 @@ bool NetIO::setSlotExerciseID(const base::Integer* const x)
     return ok;
 }
 
+// Sets output PDU bundling
+bool NetIO::setSlotBundleOutput(const base::Boolean* const x)
+{
+    bool ok {};
+    if (x != nullptr) {
+        ok = setOutputBundling(x->asBool());
+    }
+    return ok;
+}
+
+// Sets the max bundled datagram size (bytes)
+bool NetIO::setSlotMaxDatagramSize(const base::Integer* const x)
+{
+    bool ok {};
+    if (x != nullptr) {
+        const int v {x->asInt()};
+        if (v > 0 && v <= MAX_PDU_SIZE) {
+            ok = setMaxDatagramSize(static_cast<unsigned int>(v));
+        } else {
+            std::cerr << "NetIO::setSlotMaxDatagramSize(): invalid size(" << v << "); valid range:[1 ... " << MAX_PDU_SIZE << "]" << std::endl;
+        }
+    }
+    return ok;
+}
+
 //------------------------------------------------------------------------------
 // Test quick lookup of incoming entity types
 //------------------------------------------------------------------------------
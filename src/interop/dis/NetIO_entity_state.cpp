@@ -17,9 +17,51 @@
 #include "mixr/base/Identifier.hpp"
 #include "mixr/base/util/str_utils.hpp"
 
+#include <cstdint>
+
 namespace mixr {
 namespace dis {
 
+// Appearance state bit (1 - deactivated)
+static const unsigned int DEACTIVATE_BIT {0x00800000};
+
+// Interest management key of an incoming entity
+static std::uint64_t entityKey(const unsigned short playerId, const unsigned short site, const unsigned short app)
+{
+    return ((static_cast<std::uint64_t>(site) << 32) | (static_cast<std::uint64_t>(app) << 16) | playerId);
+}
+
+//------------------------------------------------------------------------------
+// processEntityStateView() callback -- updates the Nib of a known (input)
+// entity from the PDU, which is still in network byte order; returns false if
+// the PDU needs to be byte swapped and passed to processEntityStatePDU().
+//------------------------------------------------------------------------------
+bool NetIO::processEntityStateView(const EntityStatePduView& view)
+{
+    const unsigned short site {view.getSiteID()};
+    const unsigned short app  {view.getApplicationID()};
+
+    // Reject PDUs with our application and site IDs
+    if (site == getSiteID() &&  app == getApplicationID()) return true;
+
+    // Only the entities that are already on our input list
+    Nib* const nib {static_cast<Nib*>( findDisNib(view.getEntityID(), site, app, INPUT_NIB) )};
+    if (nib == nullptr) return false;
+
+    // Remove the entities that have left our areas of interest (see note #10)
+    const interop::InterestManager* const interest {getInputInterest()};
+    if (interest != nullptr) {
+        const base::Vec3d pos(view.getLocation(0), view.getLocation(1), view.getLocation(2));
+        if (!isEntityOfInterest(interest, nib, pos)) {
+            nib->setMode(models::IPlayer::Mode::DELETE_REQUEST);
+            inputEntityFiltered(entityKey(view.getEntityID(), site, app));
+            return true;
+        }
+    }
+
+    return nib->entityStateView2Nib(view);
+}
+
 //------------------------------------------------------------------------------
 // processEntityStatePDU() callback --
 //------------------------------------------------------------------------------
@@ -46,6 +88,22 @@ void NetIO::processEntityStatePDU(const EntityStatePDU* const pdu)
     // ---
     Nib* nib {static_cast<Nib*>( findDisNib(playerId, site, app, INPUT_NIB) )};
 
+    // ---
+    // Drop the PDUs of entities that are not of interest (see note #10); their
+    // NIBs are not created, or are removed if they've left our areas of interest.
+    // ---
+    const interop::InterestManager* const interest {getInputInterest()};
+    if (interest != nullptr) {
+        const base::Vec3d pos(pdu->entityLocation.X_coord, pdu->entityLocation.Y_coord, pdu->entityLocation.Z_coord);
+        if (!BaseClass::isEntityOfInterest(interest, pos, pdu->entityType.kind, pdu->entityType.domain)) {
+            if (nib != nullptr) nib->setMode(models::IPlayer::Mode::DELETE_REQUEST);
+            if ((pdu->appearance & DEACTIVATE_BIT) != 0) inputEntityRemoved(entityKey(playerId, site, app));
+            else inputEntityFiltered(entityKey(playerId, site, app));
+            return;
+        }
+        if (nib == nullptr) inputEntityAccepted(entityKey(playerId, site, app));
+    }
+
     // ---
     // When we don't have a NIB, create one
     // ---
@@ -96,6 +96,11 @@ void Nib::copyData(const Nib& org, const bool cc)
    iffLastExecTime = 0;
    iffEventId = 0;
    timeOffset = 0.0;
+
+   // Clear (not copy) the last entity state PDU data
+   lastAppearance = 0;
+   haveAppearance = false;
+   articulationData.clear();
 }
 
 void Nib::deleteData()
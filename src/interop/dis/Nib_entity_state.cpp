@@ -94,51 +94,147 @@ void Nib::entityStatePdu2Nib(const EntityStatePDU* const pdu)
       arates[base::nav::IY] = pdu->DRentityAngularVelocity.y_axis;
       arates[base::nav::IZ] = pdu->DRentityAngularVelocity.z_axis;
 
-#if 0
       // (re)initialize the dead reckoning function
-      resetDeadReckoning(
+      pdu2DeadReckoning(
+         pdu->header.timeStamp,
          pdu->deadReckoningAlgorithm,
          geocPos,
          geocVel,
          geocAcc,
          geocAngles,
          arates);
-#else
-      const unsigned long disTimeStamp {pdu->header.timeStamp};
-      double currentTime {getTimeExec()};
-      if (disTimeStamp & 0x01) {
-          currentTime = getTimeUtc();
-      }
-      currentTime = std::fmod(currentTime, 3600.0);      // just get seconds after the hour
-      double timeStamp {(static_cast<double>(disTimeStamp >> 1)) * 3600.0 / (static_cast<double>(0x7fffffff))};
-      double relTimeStamp {timeStamp + timeOffset};
-      double diffTime {currentTime - relTimeStamp};
-
-      if (std::fabs(diffTime) > 0.1) {     // If we get ahead of ourselves, or first pass
-          timeOffset = currentTime - timeStamp;
-          relTimeStamp = currentTime;
-          diffTime = 0.0;
-      }
+   }
+
+   // Appearance
+   appearance2Nib(pdu->appearance);
+   lastAppearance = pdu->appearance;
+   haveAppearance = (getPlayer() != nullptr);
+
+   // Process the articulated parameters and attached parts
+   processArticulationParameters(pdu);
+}
+
+//------------------------------------------------------------------------------
+// entityStateView2Nib() -- (Input support)
+//  Transfers data from the incoming EntityStatePDU, which is still in network
+//  byte order, to the NIB without byte swapping the whole PDU.  The appearance
+//  and articulation parameters are only processed when they've changed.
+//  Returns false if the PDU needs to be byte swapped and transferred using
+//  entityStatePdu2Nib() (i.e., its articulation parameters have changed).
+//------------------------------------------------------------------------------
+bool Nib::entityStateView2Nib(const EntityStatePduView& view)
+{
+   // Articulation parameters; these are handled by entityStatePdu2Nib()
+   // when they change (including when they're all removed), so save the
+   // new ones and let it process them.
+   const unsigned int artSize {view.getArticulationDataSize()};
+   const uint8_t* const artData {view.getArticulationData()};
+   if (artSize != articulationData.size() ||
+       (artSize > 0 && std::memcmp(artData, articulationData.data(), artSize) != 0)) {
+      articulationData.assign(artData, artData + artSize);
+      return false;
+   }
+
+   NetIO* const disIO {static_cast<NetIO*>(getNetIO())};
+   simulation::ISimulation* sim {disIO->getSimulation()};
+
+   // Mark the current time
+   setTimeExec( static_cast<double>(sim->getExecTimeSec()) );
+   setTimeUtc( static_cast<double>(sim->getSysTimeOfDay()) );
+
+   // Get the geocentric position, velocity, acceleration, orientation and angular velocities
+   // from the PDU and use them to reset the dead reckoning.
+   {
+      const base::Vec3d geocPos(view.getLocation(0), view.getLocation(1), view.getLocation(2));
+      const base::Vec3d geocVel(view.getLinearVelocity(0), view.getLinearVelocity(1), view.getLinearVelocity(2));
+      const base::Vec3d geocAcc(view.getLinearAcceleration(0), view.getLinearAcceleration(1), view.getLinearAcceleration(2));
+
+      base::Vec3d geocAngles;
+      geocAngles[base::nav::IPHI] = view.getPhi();
+      geocAngles[base::nav::ITHETA] = view.getTheta();
+      geocAngles[base::nav::IPSI] = view.getPsi();
+
+      const base::Vec3d arates(view.getAngularVelocityX(), view.getAngularVelocityY(), view.getAngularVelocityZ());
 
       // (re)initialize the dead reckoning function
-      resetDeadReckoning(
-         pdu->deadReckoningAlgorithm,
+      pdu2DeadReckoning(
+         view.getTimeStamp(),
+         view.getDeadReckoningAlgorithm(),
          geocPos,
          geocVel,
          geocAcc,
          geocAngles,
-         arates,
-         diffTime);
-#endif
+         arates);
+   }
+
+   // Appearance; the frozen and active states are always set, but the rest
+   // of the appearance is only decoded when it's changed (or when we didn't
+   // have a proxy player the last time it was decoded)
+   const unsigned int appearance {view.getAppearance()};
+   if (!haveAppearance || appearance != lastAppearance) {
+      appearance2Nib(appearance);
+      lastAppearance = appearance;
+      haveAppearance = (getPlayer() != nullptr);
+   } else {
+      freeze( (appearance & FROZEN_BIT) != 0 );
+      if ((appearance & DEACTIVATE_BIT) != 0) setMode(models::IPlayer::Mode::INACTIVE);
+      else setMode(models::IPlayer::Mode::ACTIVE);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// pdu2DeadReckoning() -- (re)initialize the dead reckoning function using the
+// PDU's time stamp and DR parameters
+//------------------------------------------------------------------------------
+void Nib::pdu2DeadReckoning(
+      const unsigned int disTimeStamp,
+      const unsigned char drAlgorithm,
+      const base::Vec3d& geocPos,
+      const base::Vec3d& geocVel,
+      const base::Vec3d& geocAcc,
+      const base::Vec3d& geocAngles,
+      const base::Vec3d& arates)
+{
+   double currentTime {getTimeExec()};
+   if (disTimeStamp & 0x01) {
+       currentTime = getTimeUtc();
    }
+   currentTime = std::fmod(currentTime, 3600.0);      // just get seconds after the hour
+   double timeStamp {(static_cast<double>(disTimeStamp >> 1)) * 3600.0 / (static_cast<double>(0x7fffffff))};
+   double relTimeStamp {timeStamp + timeOffset};
+   double diffTime {currentTime - relTimeStamp};
+
+   if (std::fabs(diffTime) > 0.1) {     // If we get ahead of ourselves, or first pass
+       timeOffset = currentTime - timeStamp;
+       relTimeStamp = currentTime;
+       diffTime = 0.0;
+   }
+
+   // (re)initialize the dead reckoning function
+   resetDeadReckoning(
+      drAlgorithm,
+      geocPos,
+      geocVel,
+      geocAcc,
+      geocAngles,
+      arates,
+      diffTime);
+}
 
+//------------------------------------------------------------------------------
+// appearance2Nib() -- transfers the PDU's appearance bits to the NIB
+//------------------------------------------------------------------------------
+void Nib::appearance2Nib(const unsigned int appearance)
+{
    // Frozen?
-   bool frz {((pdu->appearance & FROZEN_BIT) != 0)};
+   bool frz {((appearance & FROZEN_BIT) != 0)};
    freeze(frz);
 
    // Damaged?  (Bits 3-4) Standard (IST-CF-03-01, May 5, 2003)
    {
-      unsigned int bits {( (pdu->appearance >> 3) & 0x00000003 )};
+      unsigned int bits {( (appearance >> 3) & 0x00000003 )};
       if (bits == 3)       setDamage(1.0f);
       else if (bits == 2)  setDamage(0.66f);
       else if (bits == 1)  setDamage(0.33f);
@@ -147,7 +243,7 @@ void Nib::entityStatePdu2Nib(const EntityStatePDU* const pdu)
 
    // Smoking?  (Bits 5-6) Standard (IST-CF-03-01, May 5, 2003)
    {
-      unsigned int bits {( (pdu->appearance >> 5) & 0x00000003 )};
+      unsigned int bits {( (appearance >> 5) & 0x00000003 )};
       if (bits == 3)       setSmoke(1.0f);
       else if (bits == 2)  setSmoke(0.66f);
       else if (bits == 1)  setSmoke(0.33f);
@@ -156,7 +252,7 @@ void Nib::entityStatePdu2Nib(const EntityStatePDU* const pdu)
 
    // Flames? (Bit 15) Standard (IST-CF-03-01, May 5, 2003)
    {
-      if ((pdu->appearance & FLAMES_BIT) != 0)
+      if ((appearance & FLAMES_BIT) != 0)
          setFlames(1.0f);
       else
          setFlames(0.0f);
@@ -167,8 +263,8 @@ void Nib::entityStatePdu2Nib(const EntityStatePDU* const pdu)
    {
       unsigned int bits {};
       {
-         if ((pdu->appearance & CAMOUFLAGE_BIT) != 0) {
-            bits = ( (pdu->appearance >> 17) & 0x00000003 );
+         if ((appearance & CAMOUFLAGE_BIT) != 0) {
+            bits = ( (appearance >> 17) & 0x00000003 );
             bits++;  // Our camouflage type is the DIS appearance bits plus one (because our zero is no camouflage)
          }
       }
@@ -177,7 +273,7 @@ void Nib::entityStatePdu2Nib(const EntityStatePDU* const pdu)
 
    // Life form states
    {
-      unsigned int bits {( (pdu->appearance >> 16) & 0x0000000f )};
+      unsigned int bits {( (appearance >> 16) & 0x0000000f )};
       if (getPlayer() != nullptr && getPlayer()->isMajorType(models::IPlayer::LIFE_FORM)) {
          const auto lf = dynamic_cast<models::LifeForm*>(getPlayer());
          if (lf != nullptr) {
@@ -202,15 +298,12 @@ void Nib::entityStatePdu2Nib(const EntityStatePDU* const pdu)
    }
 
    // Active or inactive
-   if ((pdu->appearance & DEACTIVATE_BIT) != 0) {
+   if ((appearance & DEACTIVATE_BIT) != 0) {
       // Player has just gone inactive
       setMode(models::IPlayer::Mode::INACTIVE);
    } else {
       setMode(models::IPlayer::Mode::ACTIVE);
    }
-
-   // Process the articulated parameters and attached parts
-   processArticulationParameters(pdu);
 }
 
 //------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #include "mixr/interop/dis/NetIO.hpp"
 #include "mixr/interop/dis/Ntm.hpp"
 #include "mixr/interop/dis/EmissionPduHandler.hpp"
+#include "mixr/interop/InterestManager.hpp"
 
 #include <string>
 
@@ -26,6 +27,9 @@ base::IObject* factory(const std::string& name)
     else if ( name == EmissionPduHandler::getFactoryName() ) {
         obj = new EmissionPduHandler();
     }
+    else if ( name == interop::InterestManager::getFactoryName() ) {
+        obj = new interop::InterestManager();
+    }
 
     return obj;
 }
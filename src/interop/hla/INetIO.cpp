@@ -759,14 +759,18 @@ void INetIO::addNibToObjectTables(interop::INib* const nib, const IoType ioType)
 {
    const auto hlaNib = dynamic_cast<INib*>(nib);
 
-   if (hlaNib != nullptr && nInObjects < MAX_OBJECTS) {
-      // Add to the 'by object name' and 'by object handle' tables
+   if (hlaNib != nullptr) {
+      // Add to the 'by object name' and 'by object handle' tables (which grow as needed)
       if (ioType == INPUT_NIB ) {
+         inNameTbl.resize(nInObjects + 1);
+         inHandleTbl.resize(nInObjects + 1);
          addNibToNameTable(hlaNib, inNameTbl.data(), nInObjects);
          addNibToHandleTable(hlaNib, inHandleTbl.data(), nInObjects);
          nInObjects++;
       }
       else if (ioType == OUTPUT_NIB) {
+         outNameTbl.resize(nOutObjects + 1);
+         outHandleTbl.resize(nOutObjects + 1);
          addNibToNameTable(hlaNib, outNameTbl.data(), nOutObjects);
          addNibToHandleTable(hlaNib, outHandleTbl.data(), nOutObjects);
          nOutObjects++;
@@ -1,6 +1,7 @@
 
 #include "mixr/interop/hla/rprfom/factory.hpp"
 #include "mixr/interop/hla/rprfom/NetIO.hpp"
+#include "mixr/interop/InterestManager.hpp"
 
 #include <string>
 
@@ -14,6 +15,9 @@ base::IObject* formFunc(const std::string& name)
     if ( name == NetIO::getFactoryName() ) {
         obj = new NetIO();
     }
+    else if ( name == interop::InterestManager::getFactoryName() ) {
+        obj = new interop::InterestManager();
+    }
 
     return obj;
 }
@@ -1,11 +1,18 @@
 
 #include "mixr/models/IWorldModel.hpp"
 
+#include "mixr/models/SpatialIndex.hpp"
+#include "mixr/models/player/IPlayer.hpp"
+#include "mixr/simulation/IStation.hpp"
+#include "mixr/simulation/PlayerArray.hpp"
+
 #include "mixr/base/EarthModel.hpp"
 #include "mixr/base/Identifier.hpp"
 
 #include "mixr/base/Latitude.hpp"
 #include "mixr/base/Longitude.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/Pair.hpp"
 
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/INumber.hpp"
@@ -39,6 +46,8 @@ BEGIN_SLOTTABLE(IWorldModel)
 
    "terrain",                 //  6) Terrain elevation database
    "atmosphere",              //  7) Atmospheric model
+
+   "spatialIndexCellSize",    //  8) Cell size of the players-of-interest spatial index, or zero to disable
 END_SLOTTABLE(IWorldModel)
 
 BEGIN_SLOT_MAP(IWorldModel)
@@ -57,6 +66,8 @@ BEGIN_SLOT_MAP(IWorldModel)
 
     ON_SLOT( 6, setSlotTerrain,              terrain::ITerrain)
     ON_SLOT( 7, setSlotAtmosphere,           IAtmosphere)
+
+    ON_SLOT( 8, setSlotSpatialIndexCellSize, base::ILength)
 END_SLOT_MAP()
 
 IWorldModel::IWorldModel()
@@ -86,6 +97,11 @@ void IWorldModel::copyData(const IWorldModel& org, const bool cc)
    gaUseEmFlg = org.gaUseEmFlg;
    wm = org.wm;
 
+   // The spatial index is rebuilt from our own player list
+   spatialIndex = nullptr;
+   spatialIndexCellSize = org.spatialIndexCellSize;
+   tcFrameTime = 0.0;
+
 
    if (org.terrain != nullptr) {
       terrain::ITerrain* copy = org.terrain->clone();
@@ -110,6 +126,7 @@ void IWorldModel::deleteData()
 {
    setSlotAtmosphere( nullptr );
    setSlotTerrain( nullptr );
+   spatialIndex = nullptr;
 }
 
 void IWorldModel::reset()
@@ -129,6 +146,102 @@ void IWorldModel::reset()
    // Reset atmospheric model
    // ---
    if (atmosphere != nullptr) atmosphere->reset();
+
+   // ---
+   // Index the new player list
+   // ---
+   tcFrameTime = 0.0;
+   updateSpatialIndex();
+}
+
+//------------------------------------------------------------------------------
+// updateTC() -- update time critical stuff here
+//------------------------------------------------------------------------------
+void IWorldModel::updateTC(const double dt)
+{
+   BaseClass::updateTC(dt);
+
+   // Rebuild the spatial index using this frame's player positions; this is
+   // the only place that it's rebuilt while running, after the players have
+   // been updated, so the index never reads a player that's being moved
+   tcFrameTime = dt;
+   updateSpatialIndex();
+}
+
+//------------------------------------------------------------------------------
+// updateData() -- update non-time critical stuff here
+//------------------------------------------------------------------------------
+void IWorldModel::updateData(const double dt)
+{
+   BaseClass::updateData(dt);
+
+   // Let the terrain database know where our ownship is heading, so
+   // it can load the terrain data along its path (see ITerrain)
+   const simulation::IStation* sta{getStation()};
+   if (terrain != nullptr && sta != nullptr) {
+      const auto os = dynamic_cast<const IPlayer*>( sta->getOwnship() );
+      if (os != nullptr && os->isActive()) {
+         terrain->setOwnshipPath(os, os->getLatitude(), os->getLongitude(), os->getGroundTrackD(), os->getGroundSpeed());
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// updateBgBatch() -- updates the terrain elevations of the players, in one
+// batch for each interpolation mode
+//------------------------------------------------------------------------------
+void IWorldModel::updateBgBatch(simulation::PlayerArray* const players, const double dt)
+{
+   BaseClass::updateBgBatch(players, dt);
+
+   if (terrain == nullptr || players == nullptr) return;
+
+   // Collect the players from the player array snapshot, by interpolation mode
+   for (int k = 0; k < 2; k++) {
+      elevPlayers[k].clear();
+      elevLats[k].clear();
+      elevLons[k].clear();
+   }
+   const unsigned int np{players->getNumPlayers()};
+   for (unsigned int i = 0; i < np; i++) {
+      const auto p = dynamic_cast<IPlayer*>( players->getPlayer(i) );
+      if ( p != nullptr &&
+           (p->isMode(IPlayer::Mode::ACTIVE) || p->isMode(IPlayer::Mode::PRE_RELEASE)) &&
+           !p->isTerrainElevationRequired() ) {
+         const int k{p->isDtedTerrainInterpolationEnabled() ? 1 : 0};
+         elevPlayers[k].push_back(p);
+         elevLats[k].push_back(p->getLatitude());
+         elevLons[k].push_back(p->getLongitude());
+      }
+   }
+
+   // Find their elevations (zero if not found), which they use in their
+   // next updateElevation()
+   for (int k = 0; k < 2; k++) {
+      const auto n = static_cast<unsigned int>(elevPlayers[k].size());
+      if (n > 0) {
+         elevations.assign(n, 0.0);
+         terrain->getElevationsBatch(elevLats[k].data(), elevLons[k].data(), elevations.data(), nullptr, n, (k > 0));
+         for (unsigned int i = 0; i < n; i++) {
+            elevPlayers[k][i]->setBatchTerrainElevation(elevations[i]);
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// updateSpatialIndex() -- rebuilds the players-of-interest spatial index
+//------------------------------------------------------------------------------
+void IWorldModel::updateSpatialIndex()
+{
+   base::safe_ptr<base::PairStream> pl( getPlayers(), false );
+   if (spatialIndexCellSize > 0.0 && pl != nullptr) {
+      // The index is used until it's rebuilt at the end of the next frame
+      const auto si = new SpatialIndex(pl, spatialIndexCellSize, 2.0 * tcFrameTime);
+      spatialIndex.set(si, false);
+   } else {
+      spatialIndex = nullptr;
+   }
 }
 
 bool IWorldModel::shutdownNotification()
@@ -199,6 +312,64 @@ const base::Matrixd& IWorldModel::getWorldMat() const
    return wm;
 }
 
+// Returns the players-of-interest spatial index; pre-ref()'d
+SpatialIndex* IWorldModel::getSpatialIndex()
+{
+   return spatialIndex.getRefPtr();
+}
+
+// Returns the players-of-interest spatial index; pre-ref()'d (const version)
+const SpatialIndex* IWorldModel::getSpatialIndex() const
+{
+   return spatialIndex.getRefPtr();
+}
+
+// Spatial index cell size (meters), or zero if disabled
+double IWorldModel::getSpatialIndexCellSize() const
+{
+   return spatialIndexCellSize;
+}
+
+//------------------------------------------------------------------------------
+// getPlayersOfInterest() -- Appends to 'list', in player list order, the players
+// on 'players' that could be within 'range' meters of the geocentric position
+// 'pos', or all players if 'range' is zero.  Returns the number of players added.
+//------------------------------------------------------------------------------
+unsigned int IWorldModel::getPlayersOfInterest(
+      base::PairStream* const players,
+      const base::Vec3d& pos,
+      const double range,
+      std::vector<IPlayer*>& list) const
+{
+   if (players == nullptr) return 0;
+
+   // Use the spatial index if it was built from this player list
+   base::safe_ptr<const SpatialIndex> si( getSpatialIndex(), false );
+   if (si != nullptr && si->getPlayers() == players) {
+      return si->findPlayersInRange(pos, range, list);
+   }
+
+   // Otherwise, it's all of the players; from the player array, if it's for this player list
+   base::safe_ptr<const simulation::PlayerArray> pa( getPlayerArray(), false );
+   if (pa != nullptr && pa->getPlayerList() == players) {
+      const unsigned int np{pa->getNumPlayers()};
+      list.reserve(list.size() + np);
+      for (unsigned int i = 0; i < np; i++) {
+         list.push_back(static_cast<IPlayer*>(pa->getPlayer(i)));
+      }
+      return np;
+   }
+
+   unsigned int n{};
+   list.reserve(list.size() + players->entries());
+   for (base::IList::Item* item = players->getFirstItem(); item != nullptr; item = item->getNext()) {
+      base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
+      list.push_back(static_cast<IPlayer*>(pair->object()));
+      n++;
+   }
+   return n;
+}
+
 //------------------------------------------------------------------------------
 // Data set routines
 //------------------------------------------------------------------------------
@@ -258,6 +429,17 @@ bool IWorldModel::setMaxRefRange(const double v)
    return ok;
 }
 
+// Sets the spatial index cell size (meters), or zero to disable the index
+bool IWorldModel::setSpatialIndexCellSize(const double v)
+{
+   bool ok{v >= 0};
+   if (ok) {
+      spatialIndexCellSize = v;
+      if (v == 0) spatialIndex = nullptr;
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // Set Slot routines
 //------------------------------------------------------------------------------
@@ -307,6 +489,18 @@ bool IWorldModel::setSlotGamingAreaRange(const base::ILength* const x)
    return ok;
 }
 
+bool IWorldModel::setSlotSpatialIndexCellSize(const base::ILength* const x)
+{
+   bool ok{};
+   if (x != nullptr) {
+      ok = setSpatialIndexCellSize(x->getValueInMeters());
+      if (!ok) {
+         std::cerr << "IWorldModel::setSlotSpatialIndexCellSize(): invalid cell size; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
 bool IWorldModel::setSlotEarthModel(const base::EarthModel* const msg)
 {
    return setEarthModel(msg);
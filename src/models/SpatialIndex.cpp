@@ -0,0 +1,255 @@
+
+#include "mixr/models/SpatialIndex.hpp"
+
+#include "mixr/models/player/IPlayer.hpp"
+
+#include "mixr/base/IList.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/util/constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mixr {
+namespace models {
+
+IMPLEMENT_PARTIAL_SUBCLASS(SpatialIndex, "SpatialIndex")
+EMPTY_SLOTTABLE(SpatialIndex)
+
+// Cell indices are packed into 21 bits each
+static const int CELL_BITS{21};
+static const int CELL_OFFSET{1 << (CELL_BITS - 1)};
+
+SpatialIndex::SpatialIndex(base::PairStream* const pl, const double cs, const double maxAge)
+   : players(pl), cellSize(cs)
+{
+   STANDARD_CONSTRUCTOR()
+
+   if (pl == nullptr) return;
+
+   // ---
+   // Snapshot the players and their positions, and find our fastest player
+   // ---
+   const std::size_t n{pl->entries()};
+   plist.reserve(n);
+   ppos.reserve(n);
+   double maxSpeed{};
+   for (base::IList::Item* item = pl->getFirstItem(); item != nullptr; item = item->getNext()) {
+      base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
+      IPlayer* ip{static_cast<IPlayer*>(pair->object())};
+      plist.push_back(ip);
+      ppos.push_back(ip->getGeocPosition());
+      maxSpeed = std::max(maxSpeed, ip->getTotalVelocity());
+   }
+
+   // Max distance that anyone could move before we're rebuilt
+   margin = maxSpeed * std::max(maxAge, 0.0);
+
+   // ---
+   // Bucket the players by cell: sort the player indices by cell key and
+   // then group the runs of equal keys
+   // ---
+   if (cellSize > 0.0 && !plist.empty()) {
+      const auto np = static_cast<unsigned int>(plist.size());
+      std::vector<std::uint64_t> keys(np);
+      for (unsigned int i = 0; i < np; i++) {
+         keys[i] = cellKey( cellIndex(ppos[i].x()), cellIndex(ppos[i].y()), cellIndex(ppos[i].z()) );
+      }
+
+      cellPlayers.resize(np);
+      for (unsigned int i = 0; i < np; i++) {
+         cellPlayers[i] = i;
+      }
+      std::stable_sort(cellPlayers.begin(), cellPlayers.end(),
+         [&keys](const unsigned int a, const unsigned int b) { return keys[a] < keys[b]; } );
+
+      for (unsigned int i = 0; i < np; i++) {
+         const std::uint64_t key{keys[cellPlayers[i]]};
+         if (cells.empty() || cells.back() != key) {
+            cells.push_back(key);
+            cellStart.push_back(i);
+         }
+      }
+      cellStart.push_back(np);
+   }
+}
+
+SpatialIndex::SpatialIndex(const SpatialIndex& org)
+{
+   STANDARD_CONSTRUCTOR()
+   copyData(org, true);
+}
+
+SpatialIndex::~SpatialIndex()
+{
+   STANDARD_DESTRUCTOR()
+}
+
+SpatialIndex& SpatialIndex::operator=(const SpatialIndex& org)
+{
+   if (this != &org) copyData(org, false);
+   return *this;
+}
+
+SpatialIndex* SpatialIndex::clone() const
+{
+   return new SpatialIndex(*this);
+}
+
+void SpatialIndex::copyData(const SpatialIndex& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   players = const_cast<base::PairStream*>(org.getPlayers());
+   cellSize = org.cellSize;
+   margin = org.margin;
+   plist = org.plist;
+   ppos = org.ppos;
+   cells = org.cells;
+   cellStart = org.cellStart;
+   cellPlayers = org.cellPlayers;
+}
+
+void SpatialIndex::deleteData()
+{
+   plist.clear();
+   ppos.clear();
+   cells.clear();
+   cellStart.clear();
+   cellPlayers.clear();
+   players = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Finds the candidate players within 'range' meters of 'pos'
+//------------------------------------------------------------------------------
+unsigned int SpatialIndex::findPlayersInRange(const base::Vec3d& pos, const double range, std::vector<IPlayer*>& list) const
+{
+   std::vector<unsigned int> idx;
+   findCandidates(pos, range, idx);
+   return copyPlayers(idx, list);
+}
+
+//------------------------------------------------------------------------------
+// Finds the candidate players within 'range' meters of 'pos' and within
+// 'angle' radians of the direction vector, 'dir'
+//------------------------------------------------------------------------------
+unsigned int SpatialIndex::findPlayersInCone(
+      const base::Vec3d& pos,
+      const base::Vec3d& dir,
+      const double range,
+      const double angle,
+      std::vector<IPlayer*>& list) const
+{
+   std::vector<unsigned int> idx;
+   findCandidates(pos, range, idx);
+
+   if (angle > 0.0 && angle < base::PI) {
+      const double maxAngle{angle * RANGE_FACTOR};
+      auto last = std::remove_if(idx.begin(), idx.end(),
+         [this, &pos, &dir, maxAngle](const unsigned int i) {
+            base::Vec3d los{ppos[i] - pos};
+            const double d{los.normalize()};
+            // Players within our motion margin could be in any direction
+            if (d <= margin) return false;
+            // Allow for the angle that the player could have moved off the LOS
+            const double slack{std::asin(margin / d)};
+            const double cosAng{std::min(std::max(los * dir, -1.0), 1.0)};
+            return (std::acos(cosAng) > (maxAngle + slack));
+         } );
+      idx.erase(last, idx.end());
+   }
+
+   return copyPlayers(idx, list);
+}
+
+//------------------------------------------------------------------------------
+// Collects the indices, in player list order, of the players that could be
+// within 'range' meters of 'pos'
+//------------------------------------------------------------------------------
+unsigned int SpatialIndex::findCandidates(const base::Vec3d& pos, const double range, std::vector<unsigned int>& idx) const
+{
+   const auto np = static_cast<unsigned int>(plist.size());
+
+   // Unlimited range (or no grid) -- all players
+   if (range <= 0.0 || cells.empty()) {
+      idx.resize(np);
+      for (unsigned int i = 0; i < np; i++) {
+         idx[i] = i;
+      }
+      return np;
+   }
+
+   const double r{range * RANGE_FACTOR + margin};
+   const double r2{r * r};
+
+   // Cell bounds of the query volume
+   const int ix0{cellIndex(pos.x() - r)};
+   const int ix1{cellIndex(pos.x() + r)};
+   const int iy0{cellIndex(pos.y() - r)};
+   const int iy1{cellIndex(pos.y() + r)};
+   const int iz0{cellIndex(pos.z() - r)};
+   const int iz1{cellIndex(pos.z() + r)};
+   const double nc{static_cast<double>(ix1 - ix0 + 1) * (iy1 - iy0 + 1) * (iz1 - iz0 + 1)};
+
+   if (nc > MAX_CELLS_PER_QUERY || nc > cells.size()) {
+      // Large query volume -- it's cheaper to just scan the player positions
+      for (unsigned int i = 0; i < np; i++) {
+         if ((ppos[i] - pos).length2() <= r2) idx.push_back(i);
+      }
+   } else {
+      // Visit the occupied cells within the query volume
+      for (int ix = ix0; ix <= ix1; ix++) {
+         for (int iy = iy0; iy <= iy1; iy++) {
+            for (int iz = iz0; iz <= iz1; iz++) {
+               const std::uint64_t key{cellKey(ix, iy, iz)};
+               const auto it = std::lower_bound(cells.begin(), cells.end(), key);
+               if (it != cells.end() && *it == key) {
+                  const auto c = static_cast<unsigned int>(it - cells.begin());
+                  for (unsigned int j = cellStart[c]; j < cellStart[c+1]; j++) {
+                     const unsigned int i{cellPlayers[j]};
+                     if ((ppos[i] - pos).length2() <= r2) idx.push_back(i);
+                  }
+               }
+            }
+         }
+      }
+
+      // Back to player list order
+      std::sort(idx.begin(), idx.end());
+   }
+
+   return static_cast<unsigned int>(idx.size());
+}
+
+// Appends the indexed players to the list
+unsigned int SpatialIndex::copyPlayers(std::vector<unsigned int>& idx, std::vector<IPlayer*>& list) const
+{
+   list.reserve(list.size() + idx.size());
+   for (const unsigned int i : idx) {
+      list.push_back(plist[i]);
+   }
+   return static_cast<unsigned int>(idx.size());
+}
+
+// Cell index of a geocentric coordinate
+int SpatialIndex::cellIndex(const double v) const
+{
+   const double c{std::floor(v / cellSize)};
+   if (c < -(CELL_OFFSET - 1)) return -(CELL_OFFSET - 1);
+   if (c > (CELL_OFFSET - 1)) return (CELL_OFFSET - 1);
+   return static_cast<int>(c);
+}
+
+// Packed cell key
+std::uint64_t SpatialIndex::cellKey(const int ix, const int iy, const int iz) const
+{
+   const auto x = static_cast<std::uint64_t>(ix + CELL_OFFSET);
+   const auto y = static_cast<std::uint64_t>(iy + CELL_OFFSET);
+   const auto z = static_cast<std::uint64_t>(iz + CELL_OFFSET);
+   return ((x << (2 * CELL_BITS)) | (y << CELL_BITS) | z);
+}
+
+}
+}
@@ -7,14 +7,18 @@
 #include "mixr/base/Pair.hpp"
 
 #include "mixr/base/util/nav_utils.hpp"
-#include "mixr/base/util/osg_utils.hpp"
+#include "mixr/base/util/simd_utils.hpp"
 
 #include "mixr/models/player/IPlayer.hpp"
 #include "mixr/models/system/IGimbal.hpp"
 #include "mixr/models/IWorldModel.hpp"
 #include "mixr/terrain/ITerrain.hpp"
+#include "mixr/terrain/OccultingCache.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <new>
+#include <vector>
 
 namespace mixr {
 namespace models {
@@ -59,20 +63,20 @@ void Tdb::copyData(const Tdb& org, const bool)
 
    // Reallocate the space as needed
    resizeArrays(org.maxTargets);
-
-   if (targets != nullptr) {
-      for (unsigned int i = 0; i < org.numTgts; i++) {
-         org.targets[i]->ref();
-         targets[i] = org.targets[i];
-         ranges[i] = org.ranges[i];
-         rngRates[i] = org.rngRates[i];
-         losG[i] = org.losG[i];
-         losO2T[i] = org.losO2T[i];
-         losT2O[i] = org.losT2O[i];
-         aar[i] = org.aar[i];
-         aazr[i] = org.aazr[i];
-         aelr[i] = org.aelr[i];
-      }
+   reserveArrays(org.numTgts);
+
+   for (unsigned int i = 0; i < org.numTgts; i++) {
+      org.targets[i]->ref();
+      targets[i] = org.targets[i];
+      ranges[i] = org.ranges[i];
+      rngRates[i] = org.rngRates[i];
+      losG[i] = org.losG[i];
+      losO2T[i] = org.losO2T[i];
+      losT2O[i] = org.losT2O[i];
+      aar[i] = org.aar[i];
+      aazr[i] = org.aazr[i];
+      aelr[i] = org.aelr[i];
+      gains[i] = org.gains[i];
    }
    numTgts = org.numTgts;
    usingEcefFlg = org.usingEcefFlg;
@@ -105,65 +109,131 @@ void Tdb::clearArrays()
 }
 
 //------------------------------------------------------------------------------
-// Resize the target data arrays (0 .. Gimbal::MAX_PLAYERS)
+// Clears the targets and sets the max number of targets; the target data
+// arrays are kept, unless the new size is zero
 // -- old data is lost
 //------------------------------------------------------------------------------
 bool Tdb::resizeArrays(const unsigned int newSize)
 {
-   bool ok{};
-   if (newSize <= IGimbal::MAX_PLAYERS) {
-
-      // Clear out the old data
-      clearArrays();
-
-      if (newSize != maxTargets) {
-
-         // Free up the old memory
-         if (ranges   != nullptr)   { delete[] ranges;   ranges   = nullptr; }
-         if (rngRates != nullptr)   { delete[] rngRates; rngRates = nullptr; }
-         if (losG     != nullptr)   { delete[] losG;     losG     = nullptr; }
-         if (losO2T   != nullptr)   { delete[] losO2T;   losO2T   = nullptr; }
-         if (losT2O   != nullptr)   { delete[] losT2O;   losT2O   = nullptr; }
-         if (aar      != nullptr)   { delete[] aar;      aar      = nullptr; }
-         if (aazr     != nullptr)   { delete[] aazr;     aazr     = nullptr; }
-         if (aelr     != nullptr)   { delete[] aelr;     aelr     = nullptr; }
-
-         if (targets != nullptr)    { delete[] targets;  targets  = nullptr; }
-         maxTargets = 0;
-
-         if (xa  != nullptr)  { delete[] xa;  xa  = nullptr; }
-         if (ya  != nullptr)  { delete[] ya;  ya  = nullptr; }
-         if (za  != nullptr)  { delete[] za;  za  = nullptr; }
-         if (ra2 != nullptr)  { delete[] ra2; ra2 = nullptr; }
-         if (ra  != nullptr)  { delete[] ra;  ra  = nullptr; }
-
-         // Allocate new memory
-         if (newSize > 0) {
-            ranges   = new double[newSize];
-            rngRates = new double[newSize];
-            losG     = new base::Vec3d[newSize];
-            losO2T   = new base::Vec3d[newSize];
-            losT2O   = new base::Vec3d[newSize];
-            aar      = new double[newSize];
-            aazr     = new double[newSize];
-            aelr     = new double[newSize];
-            targets  = new IPlayer*[newSize];
-            for (unsigned int i = 0; i < newSize; i++) {
-               targets[i] = nullptr;
-            }
-            maxTargets = newSize;
-            xa = new double[newSize];
-            ya = new double[newSize];
-            za = new double[newSize];
-            ra2 = new double[newSize];
-            ra = new double[newSize];
-         }
+   // Clear out the old data
+   clearArrays();
 
-      }
+   maxTargets = newSize;
+   if (newSize == 0) freeArrays();
+
+   return true;
+}
 
-      ok = true;
+//------------------------------------------------------------------------------
+// Grow the target data arrays to hold at least 'n' targets
+// -- the current targets' data is kept
+//------------------------------------------------------------------------------
+bool Tdb::reserveArrays(const unsigned int n)
+{
+   if (n <= capacity) return true;
+
+   // New capacity: a multiple of 8, so each array of doubles is a
+   // multiple of 64 bytes, and all arrays start on 64-byte boundaries
+   const unsigned int newCap{((n + 7) / 8) * 8};
+   const auto alignUp = [](const std::size_t x) { return ((x + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT; };
+   const std::size_t ptrBytes{alignUp(newCap * sizeof(IPlayer*))};
+   const std::size_t vecBytes{alignUp(newCap * sizeof(base::Vec3d))};
+   const std::size_t dblBytes{alignUp(newCap * sizeof(double))};
+   const std::size_t total{ptrBytes + (NUM_VEC_ARRAYS * vecBytes) + (NUM_DBL_ARRAYS * dblBytes)};
+
+   void* const newBlock{::operator new(total, std::align_val_t{ALIGNMENT})};
+
+   // Carve up the new block
+   auto* p = static_cast<unsigned char*>(newBlock);
+   const auto nextPtrArray = [&p, ptrBytes]() { auto* a = reinterpret_cast<IPlayer**>(p); p += ptrBytes; return a; };
+   const auto nextDblArray = [&p, dblBytes]() { auto* a = reinterpret_cast<double*>(p); p += dblBytes; return a; };
+   const auto nextVecArray = [&p, vecBytes, newCap]() {
+      auto* a = reinterpret_cast<base::Vec3d*>(p);
+      for (unsigned int i = 0; i < newCap; i++) new (a + i) base::Vec3d();
+      p += vecBytes;
+      return a;
+   };
+
+   IPlayer** const nTargets{nextPtrArray()};
+   base::Vec3d* const nLosG{nextVecArray()};
+   base::Vec3d* const nLosO2T{nextVecArray()};
+   base::Vec3d* const nLosT2O{nextVecArray()};
+   double* const nRanges{nextDblArray()};
+   double* const nRngRates{nextDblArray()};
+   double* const nAar{nextDblArray()};
+   double* const nAazr{nextDblArray()};
+   double* const nAelr{nextDblArray()};
+   double* const nGains{nextDblArray()};
+   double* const nXa{nextDblArray()};
+   double* const nYa{nextDblArray()};
+   double* const nZa{nextDblArray()};
+   double* const nRa2{nextDblArray()};
+   double* const nRa{nextDblArray()};
+
+   // Copy the current targets' data
+   std::fill_n(nTargets, newCap, nullptr);
+   if (block != nullptr) {
+      std::copy_n(targets,  numTgts, nTargets);
+      std::copy_n(losG,     numTgts, nLosG);
+      std::copy_n(losO2T,   numTgts, nLosO2T);
+      std::copy_n(losT2O,   numTgts, nLosT2O);
+      std::copy_n(ranges,   numTgts, nRanges);
+      std::copy_n(rngRates, numTgts, nRngRates);
+      std::copy_n(aar,      numTgts, nAar);
+      std::copy_n(aazr,     numTgts, nAazr);
+      std::copy_n(aelr,     numTgts, nAelr);
+      std::copy_n(gains,    numTgts, nGains);
+      ::operator delete(block, std::align_val_t{ALIGNMENT});
+   }
+
+   block = newBlock;
+   capacity = newCap;
+   targets = nTargets;
+   losG = nLosG;
+   losO2T = nLosO2T;
+   losT2O = nLosT2O;
+   ranges = nRanges;
+   rngRates = nRngRates;
+   aar = nAar;
+   aazr = nAazr;
+   aelr = nAelr;
+   gains = nGains;
+   xa = nXa;
+   ya = nYa;
+   za = nZa;
+   ra2 = nRa2;
+   ra = nRa;
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Free the target data arrays
+//------------------------------------------------------------------------------
+void Tdb::freeArrays()
+{
+   clearArrays();
+   if (block != nullptr) {
+      ::operator delete(block, std::align_val_t{ALIGNMENT});
+      block = nullptr;
    }
-   return ok;
+   capacity = 0;
+
+   targets = nullptr;
+   losG = nullptr;
+   losO2T = nullptr;
+   losT2O = nullptr;
+   ranges = nullptr;
+   rngRates = nullptr;
+   aar = nullptr;
+   aazr = nullptr;
+   aelr = nullptr;
+   gains = nullptr;
+   xa = nullptr;
+   ya = nullptr;
+   za = nullptr;
+   ra2 = nullptr;
+   ra = nullptr;
 }
 
 
@@ -180,13 +250,17 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    // ---
    if (gimbal == nullptr || ownship == nullptr || players == nullptr || maxTargets == 0) return 0;
 
+   const IWorldModel* const sim{ownship->getWorldModel()};
+   if (sim == nullptr) return 0;
+
    // ---
    // Terrain occulting check setup
    // ---
    const terrain::ITerrain* terrain{};
+   terrain::OccultingCache* occultingCache{};
    if (gimbal->isTerrainOccultingEnabled()) {
-      const IWorldModel* const sim{ownship->getWorldModel()};
       terrain = sim->getTerrain();
+      occultingCache = gimbal->getTerrainOccultingCache();
    }
 
    // ---
@@ -274,14 +348,19 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    const bool osSpaceVehicle{ownship->isMajorType(IPlayer::SPACE_VEHICLE)};
 
    // ---
-   // 1) Scan the player list ---
+   // 1) Scan the players that could be within our max range (in player list order) ---
    // ---
+   std::vector<IPlayer*> candidates;
+   sim->getPlayersOfInterest(players, ownship->getGeocPosition(), maxRange, candidates);
+
+   // Room for all of the candidates (up to our max targets)
+   reserveArrays(numTgts + static_cast<unsigned int>(std::min<std::size_t>(candidates.size(), maxTargets - numTgts)));
+
    bool finished{};
-   for (base::IList::Item* item = players->getFirstItem(); item != nullptr && numTgts < maxTargets && !finished; item = item->getNext()) {
+   for (std::size_t i = 0; i < candidates.size() && numTgts < maxTargets && !finished; i++) {
 
       // Get the pointer to the target player
-      base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
-      IPlayer* target{static_cast<IPlayer*>(pair->object())};
+      IPlayer* target{candidates[i]};
 
       // Did we complete the local only players?
       finished = localOnly && target->isProxyPlayer();
@@ -368,8 +447,13 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
                         occulted = terrain->targetOcculting2(osLat, osLon, osAlt, tbrg, dist, -tanTgtAng);
                      } else {
                         // Occulting check between two standard player
-                        occulted = terrain->targetOcculting(osLat, osLon, static_cast<double>(osAlt),
-                                                            tgtLat, tgtLon, static_cast<double>(tgtAlt));
+                        if (occultingCache != nullptr) {
+                           occulted = occultingCache->targetOcculting(terrain, target, osLat, osLon, static_cast<double>(osAlt),
+                                                                      tgtLat, tgtLon, static_cast<double>(tgtAlt));
+                        } else {
+                           occulted = terrain->targetOcculting(osLat, osLon, static_cast<double>(osAlt),
+                                                               tgtLat, tgtLon, static_cast<double>(tgtAlt));
+                        }
                      }
                   }
 
@@ -492,38 +576,14 @@ unsigned int Tdb::computeBoresightData()
       // 2) Transform the ownship to target LOS vector into gimbal coordinate system
       //       losG = mm * losO2T;
       // ---
-      base::postMultVec3Array(losO2T, mm, losG, numTgts);
+      base::simd::postMultVec3Array(losO2T, mm, losG, numTgts);
    }
 
    // ---
-   // Get gimbal coordinate component arrays and x-y range squared
-   // ---
-   for (unsigned int i = 0; i < numTgts; i++) {
-         xa[i] = losG[i].x();
-         ya[i] = losG[i].y();
-         za[i] = -losG[i].z();
-         ra2[i] = xa[i]*xa[i] + ya[i]*ya[i];
-   }
-
-   // ---
-   // Compute range along antenna x-y plane
-   // ---
-   base::sqrtArray(ra2,ra,numTgts);
-
-   // ---
-   // Compute angle off antenna boresight
-   // ---
-   base::acosArray(xa, aar, numTgts);
-
-   // ---
-   // Compute azimuth off boresight
-   // ---
-   base::atan2Array(ya,xa,aazr,numTgts);
-
-   // ---
-   // Compute elevation off boresight
+   // Get gimbal coordinate component arrays, range along antenna x-y plane,
+   // angle off antenna boresight, and azimuth and elevation off boresight
    // ---
-   base::atan2Array(za,ra,aelr,numTgts);
+   base::simd::boresightArrays(losG, xa, ya, za, ra2, ra, aar, aazr, aelr, numTgts);
 
    return numTgts;
 }
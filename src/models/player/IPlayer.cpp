@@ -324,6 +324,8 @@ void IPlayer::copyData(const IPlayer& org, const bool cc)
 
    tElev = org.tElev;
    tElevValid = org.tElevValid;
+   batchElev = 0.0;
+   batchElevValid = false;
 
    altSlaved = org.altSlaved;
    posSlaved = org.posSlaved;
@@ -513,6 +515,7 @@ void IPlayer::reset()
 
       tElev    = 0.0;
       tElevValid = false;
+      batchElevValid = false;
 
       syncState1Ready = false;
       syncState2Ready = false;
@@ -629,7 +632,8 @@ void IPlayer::updateData(const double dt)
       if (irSignature != nullptr) irSignature->updateData(dt);
 
       // ---
-      // Update the terrain elevation
+      // Update the terrain elevation (our world model has usually found it,
+      // along with the other players' elevations, before we're called)
       // ---
       updateElevation();
 
@@ -1775,6 +1779,13 @@ void IPlayer::setTerrainElevation(const double v)
    tElevValid = true;
 }
 
+// Sets the terrain elevation (meters) found by our world model's batch
+void IPlayer::setBatchTerrainElevation(const double v)
+{
+   batchElev = v;
+   batchElevValid = true;
+}
+
 // Sets the ground clamping offset (meters)
 bool IPlayer::setTerrainOffset(const double v)
 {
@@ -3206,7 +3217,9 @@ void IPlayer::processComponents(
 //}
 
 //------------------------------------------------------------------------------
-// Get terrain elevation from the DTED database (if any)
+// Get terrain elevation from the DTED database (if any); each background frame,
+// IWorldModel::updateBgBatch() finds it for all of the players in one batch
+// (see setBatchTerrainElevation()), so it's only looked up here without one
 //------------------------------------------------------------------------------
 void IPlayer::updateElevation()
 {
@@ -3214,13 +3227,18 @@ void IPlayer::updateElevation()
    // elevation is from the IG system.
    const IWorldModel* s{getWorldModel()};
    if (s != nullptr && !isTerrainElevationRequired()) {
-      const terrain::ITerrain* terrain{s->getTerrain()};
-      if (terrain != nullptr) {
-         double el{};
-         terrain->getElevation(&el, getLatitude(), getLongitude(), isDtedTerrainInterpolationEnabled());
-         setTerrainElevation(el);
+      if (batchElevValid) {
+         setTerrainElevation(batchElev);
+      } else {
+         const terrain::ITerrain* terrain{s->getTerrain()};
+         if (terrain != nullptr) {
+            double el{};
+            terrain->getElevation(&el, getLatitude(), getLongitude(), isDtedTerrainInterpolationEnabled());
+            setTerrainElevation(el);
+         }
       }
    }
+   batchElevValid = false;
 }
 
 //------------------------------------------------------------------------------
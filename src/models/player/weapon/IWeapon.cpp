@@ -27,6 +27,9 @@
 
 #include "mixr/base/util/nav_utils.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace mixr {
 namespace models {
 
@@ -401,20 +404,25 @@ void IWeapon::checkDetonationEffect()
 
       base::PairStream* plist{s->getPlayers()};
       if (plist != nullptr) {
-         base::IList::Item* item{plist->getFirstItem()};
+
+         // Players that could be in range, which includes our target
+         double searchRng{maxRng};
+         if (tgt != nullptr) {
+            searchRng = std::max(searchRng, (tgt->getGeocPosition() - getGeocPosition()).length());
+         }
+         std::vector<IPlayer*> candidates;
+         s->getPlayersOfInterest(plist, getGeocPosition(), searchRng, candidates);
 
          // Process the detonation for all local, in-range players
          bool finished{};
-         while (item != nullptr && !finished) {
-            base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
-            IPlayer* p{static_cast<IPlayer*>(pair->object())};
+         for (std::size_t i = 0; i < candidates.size() && !finished; i++) {
+            IPlayer* p{candidates[i]};
             finished = p->isProxyPlayer();  // local only
             if (!finished && (p != this) ) {
                base::Vec3d dpos{p->getPosition() - getPosition()};
                const double rng{dpos.length()};
                if ( (rng <= maxRng) || (p == tgt) ) p->processDetonation(rng, this);
             }
-            item = item->getNext();
          }
 
          // cleanup
@@ -21,7 +21,9 @@
 #include "mixr/base/qty/powers.hpp"
 
 #include "mixr/base/util/math_utils.hpp"
+#include "mixr/base/util/simd_utils.hpp"
 
+#include <atomic>
 #include <cmath>
 
 namespace mixr {
@@ -115,6 +117,8 @@ void Antenna::reset()
 {
     BaseClass::reset();
     clearQueues();
+    emPoolHits = 0;
+    emPoolMisses = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -137,30 +141,14 @@ void Antenna::process(const double dt)
 
    // ---
    // Recycle emissions ...
-   // Update emission queues: from 'in-use' to 'free'
+   // Clear the emissions that have been returned to the pool since
+   // our last pass, so they don't hold on to their players
    // ---
-   if (recycle) {
-      unsigned int n{inUseEmQueue.entries()};
-
-      for (unsigned int i = 0; i < n; i++) {
-
-         base::lock(inUseEmLock);
-         RfEmission* em{inUseEmQueue.get()};
-         base::unlock(inUseEmLock);
-
-         if (em != nullptr && em->getRefCount() > 1) {
-            // Others are still referencing the emission, put back on in-use queue
-            base::lock(inUseEmLock);
-            inUseEmQueue.put(em);
-            base::unlock(inUseEmLock);
-         } else if (em != nullptr && em->getRefCount() <= 1) {
-            // No one else is referencing the emission, push to the free stack
-            em->clear();
-            base::lock(freeEmLock);
-            if (freeEmStack.isNotFull()) freeEmStack.push(em);
-            else em->unref();
-            base::unlock(freeEmLock);
-         }
+   for (PoolEntry& entry : emPool) {
+      if (entry.cleared != entry.generation && entry.em->getRefCount() == 1) {
+         std::atomic_thread_fence(std::memory_order_acquire);
+         entry.em->clear();
+         entry.cleared = entry.generation;
       }
    }
 }
@@ -181,21 +169,55 @@ bool Antenna::setSystem(IRfSystem* const s)
 //------------------------------------------------------------------------------
 void Antenna::clearQueues()
 {
-   base::lock(freeEmLock);
-   RfEmission* em{freeEmStack.pop()};
-   while (em != nullptr) {
-      em->unref();
-      em = freeEmStack.pop();
+   for (PoolEntry& entry : emPool) {
+      entry.em->unref();
    }
-   base::unlock(freeEmLock);
+   emPool.clear();
+   emPoolNext = 0;
+}
 
-   base::lock(inUseEmLock);
-   em = inUseEmQueue.get();
-   while (em != nullptr) {
-      em->unref();
-      em = inUseEmQueue.get();
+//------------------------------------------------------------------------------
+// getFreeEmission() -- Returns a free emission (pre-ref()'d) from the pool, or
+// a clone of 'xmit' when none of the next few pool entries are free.
+//------------------------------------------------------------------------------
+RfEmission* Antenna::getFreeEmission(const RfEmission* const xmit)
+{
+   // Emissions are usually released in the order that they were sent,
+   // so start with the oldest entries
+   const auto n = static_cast<unsigned int>(emPool.size());
+   for (unsigned int i = 0; i < n && i < MAX_POOL_PROBES; i++) {
+      if (emPoolNext >= n) emPoolNext = 0;
+      PoolEntry& entry{emPool[emPoolNext++]};
+      if (entry.em->getRefCount() == 1) {
+         // We hold the only reference; make sure that we see all of
+         // the receivers' uses of the emission before we reuse it
+         std::atomic_thread_fence(std::memory_order_acquire);
+         *entry.em = *xmit;
+         entry.em->ref();
+         entry.generation++;
+         emPoolHits++;
+         return entry.em;
+      }
    }
-   base::unlock(inUseEmLock);
+
+   // None free, so clone a new one, and add it to the pool
+   RfEmission* em{xmit->clone()};
+   emPoolMisses++;
+   if (em != nullptr && emPool.size() < static_cast<std::size_t>(MAX_EMISSIONS)) {
+      em->ref();
+      PoolEntry entry;
+      entry.em = em;
+      entry.generation = 1;
+      emPool.push_back(entry);
+   }
+   return em;
+}
+
+// Emission pool hit rate: hits / (hits + misses)
+double Antenna::getEmissionPoolHitRate() const
+{
+   const unsigned long total{emPoolHits + emPoolMisses};
+   return (total > 0) ? (static_cast<double>(emPoolHits) / static_cast<double>(total)) : 0.0;
 }
 
 bool Antenna::setPolarization(base::Identifier* const x)
@@ -388,7 +410,6 @@ void Antenna::rfTransmit(RfEmission* const xmit)
    // Compute gimbal boresight data for our targets
    // ---
    unsigned int ntgts{tdb->computeBoresightData()};
-   if (ntgts > MAX_PLAYERS) ntgts = MAX_PLAYERS;
 
    // ---
    // If we have targets
@@ -399,9 +420,10 @@ void Antenna::rfTransmit(RfEmission* const xmit)
       // ---
       // Lookup gain from antenna gain pattern, compute antenna
       // effective gain and effective radiated power.
+      // (gains are computed in place in the TDB's gain array)
       // ---
+      double* const aeGain{tdb->getTargetGains()};
       bool haveGainTgt{};
-      double gainTgt[MAX_PLAYERS]{};
       if (gainPattern != nullptr) {
          const auto gainFunc1 = dynamic_cast<base::Func1*>(gainPattern);
          const auto gainFunc2 = dynamic_cast<base::Func2*>(gainPattern);
@@ -417,17 +439,19 @@ void Antenna::rfTransmit(RfEmission* const xmit)
             const double* aelr{tdb->getBoresightElevationErrors()};
 
             // Lookup gain in 2D table and convert from dB
-            double gainTgt0[MAX_PLAYERS]{};
             if (gainPatternDeg) {
-               for (unsigned int i1 = 0; i1 < ntgts; i1++) {
-                  gainTgt0[i1] = gainFunc2->f( (aazr[i1] * base::angle::R2DCC), (aelr[i1] * base::angle::R2DCC) )/10.0;
-               }
+               gainIv1.resize(ntgts);
+               gainIv2.resize(ntgts);
+               base::simd::multArrayConst(aazr, base::angle::R2DCC, gainIv1.data(), ntgts);
+               base::simd::multArrayConst(aelr, base::angle::R2DCC, gainIv2.data(), ntgts);
+               gainFunc2->f(gainIv1.data(), gainIv2.data(), aeGain, ntgts);
             } else {
-               for (unsigned int i1 = 0; i1 < ntgts; i1++) {
-                  gainTgt0[i1] = gainFunc2->f( aazr[i1], aelr[i1] )/10.0f;
-               }
+               gainFunc2->f(aazr, aelr, aeGain, ntgts);
+            }
+            for (unsigned int i1 = 0; i1 < ntgts; i1++) {
+               aeGain[i1] /= 10.0;
             }
-            base::pow10Array(gainTgt0, gainTgt, ntgts);
+            base::simd::pow10Array(aeGain, aeGain, ntgts);
             haveGainTgt = true;
          } else if (gainFunc1 != nullptr) {
             // ---
@@ -438,17 +462,17 @@ void Antenna::rfTransmit(RfEmission* const xmit)
             const double* aar{tdb->getBoresightErrorAngles()};
 
             // Lookup gain in 1D table and convert from dB
-            double gainTgt0[MAX_PLAYERS]{};
             if (gainPatternDeg) {
-               for (unsigned int i2 = 0; i2 < ntgts; i2++) {
-                  gainTgt0[i2] = gainFunc1->f( aar[i2] * base::angle::R2DCC )/10.0;
-               }
+               gainIv1.resize(ntgts);
+               base::simd::multArrayConst(aar, base::angle::R2DCC, gainIv1.data(), ntgts);
+               gainFunc1->f(gainIv1.data(), aeGain, ntgts);
             } else {
-               for (unsigned int i2 = 0; i2 < ntgts; i2++) {
-                  gainTgt0[i2] = gainFunc1->f( aar[i2] )/10.0f;
-               }
+               gainFunc1->f(aar, aeGain, ntgts);
+            }
+            for (unsigned int i2 = 0; i2 < ntgts; i2++) {
+               aeGain[i2] /= 10.0;
             }
-            base::pow10Array(gainTgt0, gainTgt, ntgts);
+            base::simd::pow10Array(aeGain, aeGain, ntgts);
             haveGainTgt = true;
          }
       }
@@ -457,17 +481,15 @@ void Antenna::rfTransmit(RfEmission* const xmit)
          // No antenna pattern table
          // ---
          for (unsigned int i = 0; i < ntgts; i++) {
-            gainTgt[i] = 1.0;
+            aeGain[i] = 1.0;
          }
       }
 
       // Compute antenna effective gain
-      double aeGain[MAX_PLAYERS]{};
-      base::multArrayConst(gainTgt, getGain(), aeGain, ntgts);
+      base::simd::multArrayConst(aeGain, getGain(), aeGain, ntgts);
 
-      // Compute Effective Radiated Power (watts) (Equation 2-1)
-      double erp[MAX_PLAYERS]{};
-      base::multArrayConst(aeGain, xmit->getPower(), erp, ntgts);
+      // Transmitter power (watts) for the Effective Radiated Power (Equation 2-1)
+      const double xmitPower{xmit->getPower()};
 
       // Fetch the required data arrays from the TargetDataBlock
       const double* ranges{tdb->getTargetRanges()};
@@ -481,31 +503,21 @@ void Antenna::rfTransmit(RfEmission* const xmit)
       // ---
       for (unsigned int i = 0; i < ntgts; i++) {
 
+         // Effective Radiated Power (watts) (Equation 2-1)
+         const double erp{aeGain[i] * xmitPower};
+
          // Only of power exceeds an optional threshold
-         if (erp[i] > threshold) {
+         if (erp > threshold) {
 
-            // Get a free emission packet
+            // Get a free emission packet (copy of the template emission)
             RfEmission* em{};
-            if (recycle) {
-               base::lock(freeEmLock);
-               em = freeEmStack.pop();
-               base::unlock(freeEmLock);
-            }
-
-            bool cloned{};
-            if (em == nullptr) {
-               // Otherwise, clone a new one
-               em = xmit->clone();
-               cloned = true;
-            }
+            if (recycle) em = getFreeEmission(xmit);
+            else em = xmit->clone();
 
             // Send the emission to the other player
             if (em != nullptr) {
 
-               // a) Copy the template emission
-               if (!cloned) *em = *xmit;
-
-               // b) Set target unique data
+               // a) Set target unique data
                em->setGimbal(this);
                em->setOwnship(ownship);
 
@@ -517,30 +529,16 @@ void Antenna::rfTransmit(RfEmission* const xmit)
 
                em->setGimbalAzimuth( static_cast<double>(getAzimuth()) );
                em->setGimbalElevation( static_cast<double>(getElevation()) );
-               em->setPower( static_cast<double>(erp[i]) );
+               em->setPower( static_cast<double>(erp) );
                em->setGain( static_cast<double>(aeGain[i]) );
                em->setPolarization(getPolarization());
                em->setLocalPlayersOnly( isLocalPlayersOfInterestOnly() );
 
-               // c) Send the emission to the target
+               // b) Send the emission to the target
                targets[i]->event(RF_EMISSION, em);
 
-               // d) Recycle the emission (we don't bother)
-               //bool recycled = false;
-               //if (recycle) {
-               //   base::lock(inUseEmLock);
-               //   if (inUseEmQueue.isNotFull()) {
-                     // Store for future reference
-               //      inUseEmQueue.put(em);
-               //      recycled = true;
-               //   }
-               //   base::unlock(inUseEmLock);
-               //}
-
-               // or just forget it
-               //else {
-                  em->unref();
-               //}
+               // c) Release our reference (a pooled emission is also held by the pool)
+               em->unref();
 
             } else {
                // When we couldn't get a free emission packet
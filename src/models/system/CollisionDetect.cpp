@@ -12,6 +12,7 @@
 #include "mixr/base/util/str_utils.hpp"
 
 #include <cmath>
+#include <vector>
 
 namespace mixr {
 namespace models {
@@ -193,13 +194,15 @@ void CollisionDetect::updateData(const double dt)
    base::PairStream* plist{sim->getPlayers()};
    if (plist != nullptr) {
 
-      base::IList::Item* item{plist->getFirstItem()};
+      // Players that could be within our max range (in player list order)
+      std::vector<IPlayer*> candidates;
+      sim->getPlayersOfInterest(plist, ownship->getGeocPosition(), maxRange2Players, candidates);
+
       bool finished{};
-      while ( item != nullptr && !finished ) {
+      for (std::size_t i = 0; i < candidates.size() && !finished; i++) {
 
          // Get the pointer to the target player
-         base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
-         IPlayer* target{static_cast<IPlayer*>(pair->object())};
+         IPlayer* target{candidates[i]};
 
          // Did we complete the local only players?
          finished = localOnly && target->isProxyPlayer();
@@ -264,9 +267,6 @@ void CollisionDetect::updateData(const double dt)
                }
             }
          }
-
-         // Next player ...
-         item = item->getNext();
       }
 
       // Unref the player list
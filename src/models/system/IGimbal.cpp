@@ -15,6 +15,9 @@
 
 #include "mixr/base/util/nav_utils.hpp"
 
+#include "mixr/terrain/OccultingCache.hpp"
+
+#include <atomic>
 #include <cmath>
 
 namespace mixr {
@@ -69,6 +72,7 @@ BEGIN_SLOTTABLE(IGimbal)
     "localPlayersOfInterestOnly",   // 34: Sets the local only players of interest flag (default: false)
     "useWorldCoordinates",          // 35: Using player of interest's world (ECEF) coordinate system
     "ownHeadingOnly",               // 36: Whether only the ownship heading is used by the target data block
+    "terrainOccultingTolerance",    // 37: Terrain occulting cache tolerance, or zero for no caching (default: 0)
 END_SLOTTABLE(IGimbal)
 
 BEGIN_SLOT_MAP(IGimbal)
@@ -120,6 +124,7 @@ BEGIN_SLOT_MAP(IGimbal)
 
     ON_SLOT(35, setSlotUseWorldCoordinates,        base::Boolean)    // Using player of interest's world (ECEF) coordinate system
     ON_SLOT(36, setSlotUseOwnHeadingOnly,          base::Boolean)
+    ON_SLOT(37, setSlotTerrainOccultingTolerance,  base::ILength)    // Terrain occulting cache tolerance (default: 0)
 END_SLOT_MAP()
 
 BEGIN_EVENT_HANDLER(IGimbal)
@@ -186,11 +191,17 @@ void IGimbal::copyData(const IGimbal& org, const bool cc)
    maxPlayers = org.maxPlayers;
 
    tdb = nullptr;
+   spareTdb = nullptr;
+
+   setTerrainOccultingTolerance(org.getTerrainOccultingTolerance());
 }
 
 void IGimbal::deleteData()
 {
    tdb = nullptr;
+   spareTdb = nullptr;
+
+   setTerrainOccultingTolerance(0);
 }
 
 //------------------------------------------------------------------------------
@@ -211,6 +222,7 @@ void IGimbal::reset()
 bool IGimbal::shutdownNotification()
 {
     tdb = nullptr;
+    spareTdb = nullptr;
 
     return BaseClass::shutdownNotification();
 }
@@ -527,6 +539,31 @@ bool IGimbal::setTerrainOccultingEnabled(const bool flg)
    return true;
 }
 
+// Terrain occulting cache tolerance, or zero if not caching (meters)
+double IGimbal::getTerrainOccultingTolerance() const
+{
+   double v{};
+   if (occultingCache != nullptr) {
+      v = occultingCache->getTolerance();
+   }
+   return v;
+}
+
+// Sets the terrain occulting cache tolerance, or zero for no caching (meters)
+bool IGimbal::setTerrainOccultingTolerance(const double meters)
+{
+   if (meters > 0) {
+      if (occultingCache == nullptr) {
+         occultingCache = new terrain::OccultingCache();
+      }
+      occultingCache->setTolerance(meters);
+   } else if (occultingCache != nullptr) {
+      delete occultingCache;
+      occultingCache = nullptr;
+   }
+   return true;
+}
+
 // Sets the horizon check enabled flag
 bool IGimbal::setHorizonCheckEnabled(const bool flg)
 {
@@ -1136,6 +1173,16 @@ bool IGimbal::setSlotMaxPlayers(const base::Integer* const msg)
    return ok;
 }
 
+// Terrain occulting cache tolerance, or zero for no caching
+bool IGimbal::setSlotTerrainOccultingTolerance(const base::ILength* const x)
+{
+    bool ok{};
+    if (x != nullptr) {
+        ok = setTerrainOccultingTolerance(x->getValueInMeters());
+    }
+    return ok;
+}
+
 // Max range to players of interest or zero for all (meters)
 bool IGimbal::setSlotMaxRange2PlayersOfInterest(const base::ILength* const x)
 {
@@ -1289,9 +1336,25 @@ void IGimbal::limitVec(base::Vec3d& vec, const base::Vec3d& ll, const base::Vec3
 //------------------------------------------------------------------------------
 unsigned int IGimbal::processPlayersOfInterest(base::PairStream* const poi)
 {
-   const auto tdb0 = new Tdb(maxPlayers, this);
+   // Reuse the previous TDB, and its target data arrays, if no one is still
+   // using it (we hold the only reference), otherwise create a new one.
+   Tdb* tdb0{};
+   if (spareTdb != nullptr && spareTdb->getRefCount() == 1) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      tdb0 = spareTdb.getRefPtr();
+      spareTdb = nullptr;
+      tdb0->setMaxTargets(maxPlayers);
+   } else {
+      tdb0 = new Tdb(maxPlayers, this);
+   }
 
    unsigned int ntgts{tdb0->processPlayers(poi)};
+   spareTdb = tdb;
+
+   // Drop the occulting results of the players that are no longer of interest
+   if (occultingCache != nullptr) {
+      occultingCache->update();
+   }
    setCurrentTdb(tdb0);
    tdb0->unref();
 
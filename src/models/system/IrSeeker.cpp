@@ -17,6 +17,7 @@
 
 #include "mixr/base/util/nav_utils.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 // Requirements:
@@ -191,7 +192,6 @@ void IrSeeker::irRequestSignature(IrQueryMsg* const irQuery)
 
    // FAB - cannot use ownHdgOnly
    unsigned int ntgts{tdb0->computeBoresightData()};
-   if (ntgts > MAX_PLAYERS) ntgts = MAX_PLAYERS;
 
    // ---
    // If we have targets
@@ -365,6 +365,9 @@ unsigned int TdbIr::processPlayers(base::PairStream* const players)
    base::Vec3d p0 = ownship->getPosition();  // Position Vector
    base::Vec3d v0 = ownship->getVelocity();  // Ownship Velocity Vector
 
+   // Room for all of the players (up to our max targets)
+   reserveArrays(static_cast<unsigned int>(std::min<std::size_t>(players->entries(), maxTargets)));
+
    // ---
    // 1) Scan the player list --- compute the normalized Line-Of-Sight (LOS) vectors,
    // range, and range rate for each target.
@@ -1,5 +1,6 @@
 
 #include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/RecordArena.hpp"
 #include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
 
 namespace mixr {
@@ -19,10 +20,19 @@ DataRecordHandle::DataRecordHandle(proto::DataRecord* const r) : record(r)
    STANDARD_CONSTRUCTOR()
 }
 
+DataRecordHandle::DataRecordHandle(proto::DataRecord* const r, RecordArena* const a) : record(r), arena(a)
+{
+   STANDARD_CONSTRUCTOR()
+   if (arena != nullptr) arena->ref();
+}
+
 void DataRecordHandle::copyData(const DataRecordHandle& org, const bool cc)
 {
    BaseClass::copyData(org);
-   if (cc) record = new proto::DataRecord();
+   if (cc) {
+      record = new proto::DataRecord();
+      arena = nullptr;
+   }
 
    // Copy the record
    *record = *org.record;
@@ -30,7 +40,10 @@ void DataRecordHandle::copyData(const DataRecordHandle& org, const bool cc)
 
 void DataRecordHandle::deleteData()
 {
-   if (record != nullptr) { delete record;  record = nullptr; }
+   // An arena's record is released with the arena
+   if (arena != nullptr) { arena->unref(); arena = nullptr; }
+   else if (record != nullptr) { delete record; }
+   record = nullptr;
 }
 
 }
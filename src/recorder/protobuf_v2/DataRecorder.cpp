@@ -1,8 +1,10 @@
 
 #include "mixr/recorder/protobuf_v2/DataRecorder.hpp"
+#include "RecorderWriterPeriodicThread.hpp"
 
 #include "mixr/recorder/protobuf_v2/IOutputHandler.hpp"
 #include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/RecordArena.hpp"
 #include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
 
 #include "mixr/models/player/air/IAirVehicle.hpp"
@@ -18,6 +20,7 @@
 
 #include "mixr/base/Identifier.hpp"
 #include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/INumber.hpp"
 #include "mixr/base/util/math_utils.hpp"
 
 #include <cstdio>
@@ -40,6 +43,8 @@ BEGIN_SLOTTABLE(DataRecorder)
    "day",               // 8) Day of the month (1 .. 31))
    "month",             // 9) Month (1 .. 12)
    "year",              // 10) Year (e.g., 2010 or 10)
+   "writerRate",        // 11) Writer thread rate (Hz)
+   "writerPriority",    // 12) Writer thread priority
 END_SLOTTABLE(DataRecorder)
 
 BEGIN_SLOT_MAP(DataRecorder)
@@ -53,6 +58,8 @@ BEGIN_SLOT_MAP(DataRecorder)
    ON_SLOT( 8, setSlotDay,         base::Integer)
    ON_SLOT( 9, setSlotMonth,       base::Integer)
    ON_SLOT( 10, setSlotYear,       base::Integer)
+   ON_SLOT( 11, setSlotWriterRate, base::INumber)
+   ON_SLOT( 12, setSlotWriterPriority, base::INumber)
 END_SLOT_MAP()
 
 BEGIN_RECORDER_HANDLER_TABLE(DataRecorder)
@@ -79,11 +86,18 @@ END_RECORDER_HANDLER_TABLE()
 DataRecorder::DataRecorder()
 {
    STANDARD_CONSTRUCTOR()
+   initData();
 }
 
-void DataRecorder::copyData(const DataRecorder& org, const bool)
+void DataRecorder::initData()
+{
+   idArena = new RecordArena();
+}
+
+void DataRecorder::copyData(const DataRecorder& org, const bool cc)
 {
    BaseClass::copyData(org);
+   if (cc) initData();
 
    {  // clone the original's output handler
       IOutputHandler* copy = nullptr;
@@ -100,27 +114,65 @@ void DataRecorder::copyData(const DataRecorder& org, const bool)
    day = org.day;
    month = org.month;
    year = org.year;
+   writerRate = org.writerRate;
+   writerPriority = org.writerPriority;
+   writerThread = nullptr;
 }
 
 void DataRecorder::deleteData()
 {
+   writerThread = nullptr;
    setOutputHandler(nullptr);
+
+   // (the arenas are released after the last of their records)
+   if (frameArena != nullptr) { frameArena->unref(); frameArena = nullptr; }
+   playerIds.clear();
+   if (idArena != nullptr) { idArena->unref(); idArena = nullptr; }
 }
 
 //------------------------------------------------------------------------------
-// Background thread processing of the output data record queue
+// Background thread processing of the output data record queue, unless we
+// have our own writer thread
 //------------------------------------------------------------------------------
 void DataRecorder::processRecords()
+{
+   if (outputHandler != nullptr && writerThread == nullptr) outputHandler->processQueue();
+}
+
+//------------------------------------------------------------------------------
+// Writer thread processing of the output data record queue
+//------------------------------------------------------------------------------
+void DataRecorder::writeRecords()
 {
    if (outputHandler != nullptr) outputHandler->processQueue();
 }
 
+//------------------------------------------------------------------------------
+// createWriterThread() -- Create the writer thread
+//------------------------------------------------------------------------------
+void DataRecorder::createWriterThread()
+{
+   if ( writerThread == nullptr ) {
+      writerThread = new RecorderWriterPeriodicThread(this, writerRate);
+      writerThread->unref(); // 'writerThread' is a safe_ptr<>
+
+      bool ok{writerThread->start(writerPriority)};
+      if (!ok) {
+         writerThread = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "DataRecorder::createWriterThread(): ERROR, failed to create the thread!" << std::endl;
+         }
+      }
+   }
+}
+
 //------------------------------------------------------------------------------
 // Process the unhandled or unknown recorder event ID
 //------------------------------------------------------------------------------
 bool DataRecorder::processUnhandledId(const unsigned int id)
 {
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // Record the unknown ID
    proto::UnknownIdMsg* unknownIdMsg {msg->mutable_unknown_id_msg()};
@@ -131,7 +183,7 @@ bool DataRecorder::processUnhandledId(const unsigned int id)
    msg->set_id( REID_UNHANDLED_ID_TOKEN );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -144,10 +196,16 @@ void DataRecorder::reset()
 {
    BaseClass::reset();
 
-   const auto msg = new proto::DataRecord();
+   // Create the writer thread (if needed)
+   if (writerRate > 0.0 && outputHandler != nullptr && writerThread == nullptr) {
+      createWriterThread();
+   }
+
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
    timeStamp(msg);
    msg->set_id( REID_RESET_EVENT );
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 }
 
 
@@ -159,18 +217,28 @@ bool DataRecorder::shutdownNotification()
    if (outputHandler != nullptr) {
 
       // Send an end-of-data message
-      const auto msg = new proto::DataRecord();
+      RecordArena* arena {};
+      const auto msg = createRecord(&arena);
       timeStamp(msg);
       msg->set_id( REID_END_OF_DATA );
-      sendDataRecord(msg);
+      sendDataRecord(msg, arena);
 
-      // Flush the output queues
+      // Flush the output queues (waits for the writer thread, if it's
+      // processing the queue)
       outputHandler->processQueue();
 
       // Shutdown the output handlers
       outputHandler->event(SHUTDOWN_EVENT);
    }
 
+   // The writer thread stops with our shutdown
+   writerThread = nullptr;
+
+   // Release the current frame's arena
+   base::lock(arenaLock);
+   if (frameArena != nullptr) { frameArena->unref(); frameArena = nullptr; }
+   base::unlock(arenaLock);
+
    return BaseClass::shutdownNotification();
 }
 
@@ -182,7 +250,8 @@ bool DataRecorder::shutdownNotification()
 //------------------------------------------------------------------------------
 bool DataRecorder::recordMarker(const base::IObject* objs[4], const double values[4])
 {
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -194,7 +263,7 @@ bool DataRecorder::recordMarker(const base::IObject* objs[4], const double value
    markerMsg->set_source_id( static_cast<unsigned int>(base::nintd(values[1])) );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -207,7 +276,8 @@ bool DataRecorder::recordMarker(const base::IObject* objs[4], const double value
 //------------------------------------------------------------------------------
 bool DataRecorder::recordAI(const base::IObject* objs[4], const double values[4])
 {
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -220,7 +290,7 @@ bool DataRecorder::recordAI(const base::IObject* objs[4], const double values[4]
    aiMsg->set_value( static_cast<float>(values[2]) );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -234,7 +304,8 @@ bool DataRecorder::recordAI(const base::IObject* objs[4], const double values[4]
 //------------------------------------------------------------------------------
 bool DataRecorder::recordDI(const base::IObject* objs[4], const double values[4])
 {
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -247,7 +318,7 @@ bool DataRecorder::recordDI(const base::IObject* objs[4], const double values[4]
    diMsg->set_value( static_cast<float>(values[2]) );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -262,7 +333,8 @@ bool DataRecorder::recordNewPlayer(const base::IObject* objs[4], const double va
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -271,11 +343,11 @@ bool DataRecorder::recordNewPlayer(const base::IObject* objs[4], const double va
    // new player message
    proto::NewPlayerEventMsg* newPlayerMsg {msg->mutable_new_player_event_msg()};
 
-   genPlayerId( newPlayerMsg->mutable_id(), player );
+   newPlayerMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( newPlayerMsg->mutable_state(), player );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -289,7 +361,8 @@ bool DataRecorder::recordPlayerRemoved(const base::IObject* objs[4], const doubl
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -298,11 +371,12 @@ bool DataRecorder::recordPlayerRemoved(const base::IObject* objs[4], const doubl
    // removed player message
    proto::PlayerRemovedEventMsg* removedEventMsg {msg->mutable_player_removed_event_msg()};
 
-   genPlayerId( removedEventMsg->mutable_id(), player );
+   removedEventMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( removedEventMsg->mutable_state(), player );
+   removePlayerId(player);
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -316,7 +390,8 @@ bool DataRecorder::recordPlayerData(const base::IObject* objs[4], const double v
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -325,7 +400,7 @@ bool DataRecorder::recordPlayerData(const base::IObject* objs[4], const double v
    // player data
    proto::PlayerDataMsg* playerDataMsg {msg->mutable_player_data_msg()};
 
-   genPlayerId( playerDataMsg->mutable_id(), player );
+   playerDataMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( playerDataMsg->mutable_state(), player );
 
    const auto av = dynamic_cast<const models::IAirVehicle*>( player );
@@ -336,7 +411,7 @@ bool DataRecorder::recordPlayerData(const base::IObject* objs[4], const double v
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -350,7 +425,8 @@ bool DataRecorder::recordPlayerDamaged(const base::IObject* objs[4], const doubl
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -359,11 +435,11 @@ bool DataRecorder::recordPlayerDamaged(const base::IObject* objs[4], const doubl
    // player damaged message
    proto::PlayerDamagedEventMsg* playerDamagedMsg {msg->mutable_player_damaged_event_msg()};
 
-   genPlayerId( playerDamagedMsg->mutable_id(), player );
+   playerDamagedMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( playerDamagedMsg->mutable_state(), player );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
    return true;
 }
 
@@ -377,7 +453,8 @@ bool DataRecorder::recordPlayerCollision(const base::IObject* objs[4], const dou
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -386,16 +463,16 @@ bool DataRecorder::recordPlayerCollision(const base::IObject* objs[4], const dou
    // player collision message
    proto::PlayerCollisionEventMsg* playerCollisionMsg {msg->mutable_player_collision_event_msg()};
 
-   genPlayerId( playerCollisionMsg->mutable_id(), player );
+   playerCollisionMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( playerCollisionMsg->mutable_state(), player );
 
    const auto otherPlayer = dynamic_cast<const models::IPlayer*>( objs[1] );
    if (otherPlayer != nullptr) {
-      genPlayerId( playerCollisionMsg->mutable_other_player_id(), otherPlayer );
+      playerCollisionMsg->unsafe_arena_set_allocated_other_player_id( internPlayerId(otherPlayer, arena) );
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -409,7 +486,8 @@ bool DataRecorder::recordPlayerCrash(const base::IObject* objs[4], const double
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -418,11 +496,11 @@ bool DataRecorder::recordPlayerCrash(const base::IObject* objs[4], const double
    // player crashed message
    proto::PlayerCrashEventMsg* playerCrashMsg {msg->mutable_player_crash_event_msg()};
 
-   genPlayerId( playerCrashMsg->mutable_id(), player );
+   playerCrashMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( playerCrashMsg->mutable_state(), player );
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
    return true;
 }
 
@@ -436,7 +514,8 @@ bool DataRecorder::recordPlayerKilled(const base::IObject* objs[4], const double
    const auto player = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -445,16 +524,16 @@ bool DataRecorder::recordPlayerKilled(const base::IObject* objs[4], const double
    // player killed message
    proto::PlayerKilledEventMsg* playerKilledMsg {msg->mutable_player_killed_event_msg()};
 
-   genPlayerId( playerKilledMsg->mutable_id(), player );
+   playerKilledMsg->unsafe_arena_set_allocated_id( internPlayerId(player, arena) );
    genPlayerState( playerKilledMsg->mutable_state(), player );
 
    const auto shooter = dynamic_cast<const models::IPlayer*>( objs[1] );
    if (shooter != nullptr) {
-      genPlayerId( playerKilledMsg->mutable_shooter_id(), shooter );
+      playerKilledMsg->unsafe_arena_set_allocated_shooter_id( internPlayerId(shooter, arena) );
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
    return true;
 }
 
@@ -469,7 +548,8 @@ bool DataRecorder::recordWeaponReleased(const base::IObject* objs[4], const doub
    const auto wpn = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (wpn == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -478,21 +558,21 @@ bool DataRecorder::recordWeaponReleased(const base::IObject* objs[4], const doub
    // Weapon Released message
    proto::WeaponReleaseEventMsg* wpnRelMsg {msg->mutable_weapon_release_event_msg()};
 
-   genPlayerId( wpnRelMsg->mutable_wpn_id(), wpn );
+   wpnRelMsg->unsafe_arena_set_allocated_wpn_id( internPlayerId(wpn, arena) );
    genPlayerState( wpnRelMsg->mutable_wpn_state(), wpn );
 
    const auto shooter = dynamic_cast<const models::IPlayer*>( objs[1] );
    if (shooter != nullptr) {
-      genPlayerId( wpnRelMsg->mutable_shooter_id(), shooter );
+      wpnRelMsg->unsafe_arena_set_allocated_shooter_id( internPlayerId(shooter, arena) );
    }
 
    const auto tgt = dynamic_cast<const models::IPlayer*>( objs[2] );
    if (tgt != nullptr) {
-      genPlayerId( wpnRelMsg->mutable_tgt_id(), tgt );
+      wpnRelMsg->unsafe_arena_set_allocated_tgt_id( internPlayerId(tgt, arena) );
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -508,7 +588,8 @@ bool DataRecorder::recordWeaponHung(const base::IObject* objs[4], const double v
    const auto wpn = dynamic_cast<const models::IPlayer*>( objs[0] );
    if (wpn == nullptr) return false;
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -517,21 +598,21 @@ bool DataRecorder::recordWeaponHung(const base::IObject* objs[4], const double v
    // Weapon Hung message
    proto::WeaponHungEventMsg* wpnHungMsg {msg->mutable_weapon_hung_event_msg()};
 
-   genPlayerId( wpnHungMsg->mutable_wpn_id(), wpn );
+   wpnHungMsg->unsafe_arena_set_allocated_wpn_id( internPlayerId(wpn, arena) );
    genPlayerState( wpnHungMsg->mutable_wpn_state(), wpn );
 
    const auto shooter = dynamic_cast<const models::IPlayer*>( objs[1] );
    if (shooter != nullptr) {
-      genPlayerId( wpnHungMsg->mutable_shooter_id(), shooter );
+      wpnHungMsg->unsafe_arena_set_allocated_shooter_id( internPlayerId(shooter, arena) );
    }
 
    const auto tgt = dynamic_cast<const models::IPlayer*>( objs[2] );
    if (tgt != nullptr) {
-      genPlayerId( wpnHungMsg->mutable_tgt_id(), tgt );
+      wpnHungMsg->unsafe_arena_set_allocated_tgt_id( internPlayerId(tgt, arena) );
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
    return true;
 }
 
@@ -553,7 +634,8 @@ bool DataRecorder::recordWeaponDetonation(const base::IObject* objs[4], const do
 
    const double missDist{values[1]};
 
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -562,17 +644,17 @@ bool DataRecorder::recordWeaponDetonation(const base::IObject* objs[4], const do
    // Weapon Hung message
    proto::WeaponDetonationEventMsg* wpnDetMsg = msg->mutable_weapon_detonation_event_msg();
 
-   genPlayerId(wpnDetMsg->mutable_wpn_id(), wpn );
+   wpnDetMsg->unsafe_arena_set_allocated_wpn_id( internPlayerId(wpn, arena) );
    genPlayerState(wpnDetMsg->mutable_wpn_state(), wpn );
 
    const auto shooter = dynamic_cast<const models::IPlayer*>( objs[1] );
    if (shooter != nullptr) {
-      genPlayerId(wpnDetMsg->mutable_shooter_id(), shooter );
+      wpnDetMsg->unsafe_arena_set_allocated_shooter_id( internPlayerId(shooter, arena) );
    }
 
    const auto tgt = dynamic_cast<const models::IPlayer*>( objs[2] );
    if (tgt != nullptr) {
-      genPlayerId(wpnDetMsg->mutable_tgt_id(), tgt );
+      wpnDetMsg->unsafe_arena_set_allocated_tgt_id( internPlayerId(tgt, arena) );
    }
 
    // Get detonation type
@@ -614,7 +696,7 @@ bool DataRecorder::recordWeaponDetonation(const base::IObject* objs[4], const do
    wpnDetMsg->set_miss_dist(missDist);
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -630,7 +712,8 @@ bool DataRecorder::recordGunFired(const base::IObject* objs[4], const double val
    if (shooter == nullptr) return false;
 
    const auto rounds = static_cast<const unsigned int>( values[0] );
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -639,11 +722,11 @@ bool DataRecorder::recordGunFired(const base::IObject* objs[4], const double val
    // Gun Fired message
    proto::GunFiredEventMsg* gunFiredMsg {msg->mutable_gun_fired_event_msg()};
 
-   genPlayerId(gunFiredMsg->mutable_shooter_id(), shooter );
+   gunFiredMsg->unsafe_arena_set_allocated_shooter_id( internPlayerId(shooter, arena) );
    gunFiredMsg->set_rounds(rounds);
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
    return true;
 }
 
@@ -660,7 +743,8 @@ bool DataRecorder::recordNewTrack(const base::IObject* objs[4], const double val
    if (player == nullptr || newTrack == nullptr) return false;
 
    // message
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -670,7 +754,7 @@ bool DataRecorder::recordNewTrack(const base::IObject* objs[4], const double val
    proto::NewTrackEventMsg* newTrackMsg {msg->mutable_new_track_event_msg()};
 
    // player ID and state
-   genPlayerId(newTrackMsg->mutable_player_id(), player );
+   newTrackMsg->unsafe_arena_set_allocated_player_id( internPlayerId(player, arena) );
    genPlayerState(newTrackMsg->mutable_player_state(), player );
 
    // Track ID
@@ -682,7 +766,7 @@ bool DataRecorder::recordNewTrack(const base::IObject* objs[4], const double val
    // Track player
    const models::IPlayer* trkPlayer {newTrack->getTarget()};
    if (trkPlayer != nullptr) {
-      genPlayerId( newTrackMsg->mutable_trk_player_id(), trkPlayer);
+      newTrackMsg->unsafe_arena_set_allocated_trk_player_id( internPlayerId(trkPlayer, arena) );
       genPlayerState( newTrackMsg->mutable_trk_player_state(), trkPlayer );
    }
 
@@ -692,13 +776,13 @@ bool DataRecorder::recordNewTrack(const base::IObject* objs[4], const double val
 
       const models::RfEmission* emissionData {rfTrk->getLastEmission()};
       if (emissionData != nullptr) {
-         genEmissionData( newTrackMsg->mutable_emission_data(), emissionData);
+         genEmissionData( newTrackMsg->mutable_emission_data(), emissionData, arena);
       }
 
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -716,7 +800,8 @@ bool DataRecorder::recordTrackRemoved(const base::IObject* objs[4], const double
    if (player == nullptr || track == nullptr) return false;
 
    // message
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -725,13 +810,13 @@ bool DataRecorder::recordTrackRemoved(const base::IObject* objs[4], const double
    // Track Removed message
    proto::TrackRemovedEventMsg* trackRemovedMsg {msg->mutable_track_removed_event_msg()};
 
-   genPlayerId(trackRemovedMsg->mutable_player_id(), player);
+   trackRemovedMsg->unsafe_arena_set_allocated_player_id( internPlayerId(player, arena) );
 
    // Track ID
    trackRemovedMsg->set_track_id(genTrackId(track));
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -749,7 +834,8 @@ bool DataRecorder::recordTrackData(const base::IObject* objs[4], const double va
    if (player == nullptr || trackData == nullptr) return false;
 
    // message
-   const auto msg = new proto::DataRecord();
+   RecordArena* arena {};
+   const auto msg = createRecord(&arena);
 
    // DataRecord header
    timeStamp(msg);
@@ -759,7 +845,7 @@ bool DataRecorder::recordTrackData(const base::IObject* objs[4], const double va
    proto::TrackDataMsg* trackDataMsg{msg->mutable_track_data_msg()};
 
    // player ID and state
-   genPlayerId(trackDataMsg->mutable_player_id(), player );
+   trackDataMsg->unsafe_arena_set_allocated_player_id( internPlayerId(player, arena) );
    genPlayerState(trackDataMsg->mutable_player_state(), player );
 
    // Track ID
@@ -771,7 +857,7 @@ bool DataRecorder::recordTrackData(const base::IObject* objs[4], const double va
    // track player
    const models::IPlayer* trkPlayer{trackData->getTarget()};
    if (trkPlayer != nullptr) {
-      genPlayerId( trackDataMsg->mutable_trk_player_id(), trkPlayer);
+      trackDataMsg->unsafe_arena_set_allocated_trk_player_id( internPlayerId(trkPlayer, arena) );
       genPlayerState( trackDataMsg->mutable_trk_player_state(), trkPlayer );
    }
 
@@ -780,12 +866,12 @@ bool DataRecorder::recordTrackData(const base::IObject* objs[4], const double va
    if (rfTrk != nullptr) {
       const models::RfEmission* emissionData = rfTrk->getLastEmission();
       if (emissionData != nullptr) {
-         genEmissionData( trackDataMsg->mutable_emission_data(), emissionData);
+         genEmissionData( trackDataMsg->mutable_emission_data(), emissionData, arena);
       }
    }
 
    // Send the message for processing
-   sendDataRecord(msg);
+   sendDataRecord(msg, arena);
 
    return true;
 }
@@ -925,7 +1011,7 @@ void DataRecorder::genTrackData(proto::TrackData* const trkMsg, const models::IT
 //------------------------------------------------------------------------------
 // Generate the Emission data
 //------------------------------------------------------------------------------
-void DataRecorder::genEmissionData(proto::EmissionData* const emMsg, const models::RfEmission* const emData)
+void DataRecorder::genEmissionData(proto::EmissionData* const emMsg, const models::RfEmission* const emData, RecordArena* const arena)
 {
    if (emMsg != nullptr) {
       if (emData != nullptr) {
@@ -943,7 +1029,8 @@ void DataRecorder::genEmissionData(proto::EmissionData* const emMsg, const model
          {
             const models::IPlayer* p {emData->getOwnship()};
             if (p != nullptr) {
-               genPlayerId(emMsg->mutable_origin_id(), p);
+               if (arena != nullptr) emMsg->unsafe_arena_set_allocated_origin_id( internPlayerId(p, arena) );
+               else genPlayerId(emMsg->mutable_origin_id(), p);
             }
          }
 
@@ -951,7 +1038,8 @@ void DataRecorder::genEmissionData(proto::EmissionData* const emMsg, const model
          {
             const models::IPlayer* p {emData->getTarget()};
             if (p != nullptr) {
-               genPlayerId(emMsg->mutable_target_id(), p);
+               if (arena != nullptr) emMsg->unsafe_arena_set_allocated_target_id( internPlayerId(p, arena) );
+               else genPlayerId(emMsg->mutable_target_id(), p);
             }
          }
 
@@ -992,9 +1080,98 @@ void DataRecorder::genEmissionData(proto::EmissionData* const emMsg, const model
 
 
 //------------------------------------------------------------------------------
-// Time stamp and send the DataRecord to our output handler
+// Creates a new DataRecord on the current frame's arena; a new arena is
+// started with each frame, or when the arena gets too large.  The interned
+// player IDs' arena is recycled, when it gets too large, only as a new
+// frame arena is started.
+//------------------------------------------------------------------------------
+proto::DataRecord* DataRecorder::createRecord(RecordArena** const arena)
+{
+   // Current frame (the executive counter counts the frames' four phases)
+   unsigned int frame {};
+   const simulation::ISimulation* sim {getSimulation()};
+   if (sim != nullptr) frame = (sim->getExecCounter() >> 2);
+
+   base::lock(arenaLock);
+   if (frameArena == nullptr || frame != arenaFrame || frameArena->getSpaceAllocated() >= MAX_ARENA_SIZE) {
+      if (frameArena != nullptr) frameArena->unref();
+      frameArena = new RecordArena();
+
+      // (the old ID arena is kept by the older frame arenas)
+      base::lock(idLock);
+      if (idArena->getSpaceAllocated() >= MAX_ARENA_SIZE) {
+         playerIds.clear();
+         idArena->unref();
+         idArena = new RecordArena();
+      }
+      frameArena->setSharedArena(idArena);
+      base::unlock(idLock);
+
+      arenaFrame = frame;
+   }
+   RecordArena* const a {frameArena};
+   a->ref();
+   base::unlock(arenaLock);
+
+   *arena = a;
+   return a->createRecord();
+}
+
+//------------------------------------------------------------------------------
+// Returns the player's interned PlayerId; a new one is generated, using
+// genPlayerId(), when the player's ID or names change.  The old PlayerIds
+// are kept, with the ID arena, for the records that are still using them.
+// A record 'arena' that was started before the ID arena was recycled doesn't
+// keep the new ID arena, so its records get their own PlayerIds.
+//------------------------------------------------------------------------------
+proto::PlayerId* DataRecorder::internPlayerId(const models::IPlayer* const player, RecordArena* const arena)
+{
+   proto::PlayerId* id {};
+   if (player != nullptr) {
+      const simulation::INib* nib {player->getNib()};
+
+      base::lock(idLock);
+      if (arena->getSharedArena() == idArena) {
+         const auto it = playerIds.find(player);
+         if (it != playerIds.end()) id = it->second;
+
+         const bool current {
+            id != nullptr &&
+            id->id() == static_cast<unsigned int>(player->getID()) &&
+            id->name() == player->getName() &&
+            ((nib == nullptr || nib->getFederateName().empty()) ? !id->has_fed_name() : id->fed_name() == nib->getFederateName())
+         };
+         if (!current) {
+            id = idArena->createPlayerId();
+            genPlayerId(id, player);
+            playerIds[player] = id;
+         }
+      } else {
+         // (the record's arena is older than the ID arena)
+         id = arena->createPlayerId();
+         genPlayerId(id, player);
+      }
+      base::unlock(idLock);
+   }
+   return id;
+}
+
+//------------------------------------------------------------------------------
+// Removes the (removed) player's interned PlayerId
+//------------------------------------------------------------------------------
+void DataRecorder::removePlayerId(const models::IPlayer* const player)
+{
+   base::lock(idLock);
+   playerIds.erase(player);
+   base::unlock(idLock);
+}
+
+//------------------------------------------------------------------------------
+// Time stamp and send the DataRecord to our output handler; the DataRecord
+// is owned by its 'arena' (and our ref to the arena is released), or, without
+// an arena, by its handle
 //------------------------------------------------------------------------------
-void DataRecorder::sendDataRecord(proto::DataRecord* const msg)
+void DataRecorder::sendDataRecord(proto::DataRecord* const msg, RecordArena* const arena)
 {
    if (msg != nullptr && outputHandler != nullptr) {
 
@@ -1034,10 +1211,17 @@ void DataRecorder::sendDataRecord(proto::DataRecord* const msg)
       }
 
       // Create a handle and send the message to be processed
-      const auto h = new DataRecordHandle(msg);
+      const auto h = new DataRecordHandle(msg, arena);
       outputHandler->addToQueue(h);
       h->unref();
    }
+   else if (arena == nullptr && msg != nullptr) {
+      // no output handler
+      delete msg;
+   }
+
+   // The handle has its own ref to the arena
+   if (arena != nullptr) arena->unref();
 }
 
 //------------------------------------------------------------------------------
@@ -1171,6 +1355,50 @@ bool DataRecorder::setSlotYear(base::Integer* const msg)
    return ok;
 }
 
+bool DataRecorder::setWriterRate(const double hz)
+{
+   bool ok{};
+   if (hz >= 0.0) {
+      writerRate = hz;
+      ok = true;
+   }
+   return ok;
+}
+
+bool DataRecorder::setWriterPriority(const double pri)
+{
+   bool ok{};
+   if (pri >= 0.0 && pri <= 1.0) {
+      writerPriority = pri;
+      ok = true;
+   }
+   return ok;
+}
+
+bool DataRecorder::setSlotWriterRate(const base::INumber* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setWriterRate(msg->asDouble());
+      if (!ok) {
+         std::cerr << "DataRecorder::setSlotWriterRate(): Thread rate is invalid; must be greater than or equal zero." << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool DataRecorder::setSlotWriterPriority(const base::INumber* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setWriterPriority(msg->asDouble());
+      if (!ok) {
+         std::cerr << "DataRecorder::setSlotWriterPriority(): Priority is invalid, range: [0 .. 1]" << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
 }
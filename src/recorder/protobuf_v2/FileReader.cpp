@@ -2,12 +2,17 @@
 #include "mixr/recorder/protobuf_v2/FileReader.hpp"
 #include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
 #include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/qty/times.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/util/str_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <cstdlib>
+#include <limits>
 
 namespace mixr {
 namespace recorder {
@@ -18,11 +23,15 @@ IMPLEMENT_SUBCLASS(FileReader, "RecorderFileReader")
 BEGIN_SLOTTABLE(FileReader)
     "filename",         // 1) Data file name
     "pathname",         // 2) Path to the data file directory (optional)
+    "startTime",        // 3) Start reading at this sim time (optional)
+    "player",           // 4) Only read the records of this player ID (optional)
 END_SLOTTABLE(FileReader)
 
 BEGIN_SLOT_MAP(FileReader)
-    ON_SLOT( 1, setSlotFilename, base::String)
-    ON_SLOT( 2, setSlotPathName, base::String)
+    ON_SLOT( 1, setSlotFilename,  base::String)
+    ON_SLOT( 2, setSlotPathName,  base::String)
+    ON_SLOT( 3, setSlotStartTime, base::ITime)
+    ON_SLOT( 4, setSlotPlayer,    base::Integer)
 END_SLOT_MAP()
 
 FileReader::FileReader()
@@ -33,7 +42,7 @@ FileReader::FileReader()
 
 void FileReader::initData()
 {
-   ibuf = new char[MAX_INPUT_BUFFER_SIZE];
+   ibuf.resize(MAX_INPUT_BUFFER_SIZE);
 }
 
 void FileReader::copyData(const FileReader& org, const bool cc)
@@ -52,6 +61,24 @@ void FileReader::copyData(const FileReader& org, const bool cc)
    fileOpened = false;
    fileFailed = false;
    firstPassFlg = true;
+
+   indexed = false;
+   indexBlocks.clear();
+   numIndexedRecs = 0;
+   indexEntries.clear();
+   indexBlock = 0;
+   indexLoaded = false;
+   nextRec = 0;
+
+   blocks = false;
+   blockLoaded = false;
+   deltaState.clear();
+
+   startTime = org.startTime;
+   startTimeFlg = org.startTimeFlg;
+   tailTimeFlg = false;
+   playerFilter = org.playerFilter;
+   playerFilterFlg = org.playerFilterFlg;
 }
 
 void FileReader::deleteData()
@@ -64,8 +91,6 @@ void FileReader::deleteData()
 
    setFilename(nullptr);
    setPathName(nullptr);
-
-   if (ibuf != nullptr) { delete[] ibuf; ibuf = nullptr; }
 }
 
 //------------------------------------------------------------------------------
@@ -157,6 +182,34 @@ bool FileReader::openFile()
             tFailed = true;
          }
 
+         //---
+         // Indexed or legacy file?
+         //---
+         else {
+            unsigned char hdr[RecordFileFormat::HEADER_SIZE]{};
+            std::uint32_t flags{};
+            sin->read(reinterpret_cast<char*>(hdr), RecordFileFormat::HEADER_SIZE);
+            indexed = (!sin->fail() && RecordFileFormat::decodeHeader(hdr, &flags) &&
+                       (flags & ~RecordFileFormat::BLOCKS_FLAG) == 0);
+            blocks = (indexed && (flags & RecordFileFormat::BLOCKS_FLAG) != 0);
+            blockLoaded = false;
+            if (indexed) {
+               readIndex();
+            }
+            else if (!sin->fail() && std::equal(hdr, hdr + sizeof(RecordFileFormat::MAGIC), RecordFileFormat::MAGIC)) {
+               if (isMessageEnabled(MSG_ERROR)) {
+                  std::cerr << "FileReader::openFile(): Unsupported indexed file version or flags: " << fullname << std::endl;
+               }
+               tOpened = false;
+               tFailed = true;
+            }
+            else {
+               // legacy file; start over
+               sin->clear();
+               sin->seekg(0);
+            }
+         }
+
       }
 
       delete[] fullname;
@@ -180,21 +233,574 @@ void FileReader::closeFile()
    }
 }
 
+//------------------------------------------------------------------------------
+// Summarize the index blocks of the open indexed file, which are found by
+// following the chain of index blocks back from the trailer, or, without a
+// trailer, by scanning the chunks.  Leaves the file at its first chunk.
+//------------------------------------------------------------------------------
+bool FileReader::readIndex()
+{
+   indexBlocks.clear();
+   numIndexedRecs = 0;
+   indexEntries.clear();
+   indexBlock = 0;
+   indexLoaded = false;
+   nextRec = 0;
+   tailTimeFlg = false;
+
+   sin->clear();
+   sin->seekg(0, std::ios_base::end);
+   const std::uint64_t fileSize{static_cast<std::uint64_t>(sin->tellg())};
+   dataEnd = fileSize;
+   tailOffset = RecordFileFormat::HEADER_SIZE;
+
+   unsigned char type{};
+
+   // ---
+   // Follow the chain of index blocks back from the trailer
+   // ---
+   bool ok{};
+   std::uint64_t offset{};
+   if (fileSize >= (RecordFileFormat::HEADER_SIZE + RecordFileFormat::TRAILER_SIZE)) {
+      unsigned char trailer[RecordFileFormat::TRAILER_SIZE]{};
+      sin->seekg(fileSize - RecordFileFormat::TRAILER_SIZE);
+      sin->read(reinterpret_cast<char*>(trailer), RecordFileFormat::TRAILER_SIZE);
+      ok = (!sin->fail() && RecordFileFormat::decodeTrailer(trailer, &offset));
+   }
+   if (ok) {
+      dataEnd = fileSize - RecordFileFormat::TRAILER_SIZE;
+      while (ok && offset >= RecordFileFormat::HEADER_SIZE) {
+         IndexBlock blk;
+         blk.offset = offset;
+         std::uint64_t prev{};
+         ok = (offset < dataEnd && readChunk(offset, &type, indexChunk) && type == RecordFileFormat::INDEX_CHUNK &&
+               summarizeIndexBlock(indexChunk, &blk, &prev) && prev < offset);
+         indexBlocks.push_back(std::move(blk));
+         offset = prev;
+      }
+      std::reverse(indexBlocks.begin(), indexBlocks.end());
+      tailOffset = dataEnd;
+   }
+
+   // ---
+   // No trailer (or a bad chain); scan the chunks for the index blocks
+   // ---
+   if (!ok) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "FileReader::readIndex(): no valid index trailer; scanning the file" << std::endl;
+      }
+      indexBlocks.clear();
+      dataEnd = fileSize;
+      tailOffset = RecordFileFormat::HEADER_SIZE;
+      std::uint64_t pos{RecordFileFormat::HEADER_SIZE};
+      bool scanning{true};
+      while (scanning && pos < dataEnd) {
+         sin->clear();
+         sin->seekg(pos);
+         std::uint64_t size{};
+         std::size_t h{};
+         scanning = readChunkHeader(&type, &size, &h) && (pos + h + size) <= dataEnd;
+         if (scanning && type == RecordFileFormat::INDEX_CHUNK) {
+            IndexBlock blk;
+            blk.offset = pos;
+            std::uint64_t prev{};
+            scanning = readChunk(pos, &type, indexChunk) && summarizeIndexBlock(indexChunk, &blk, &prev);
+            if (scanning) {
+               indexBlocks.push_back(std::move(blk));
+               tailOffset = pos + h + size;
+            }
+         }
+         pos += (h + size);
+      }
+   }
+
+   // ---
+   // Number the records, and make the max sim times running maxes
+   // ---
+   double maxTime{std::numeric_limits<double>::lowest()};
+   for (IndexBlock& blk : indexBlocks) {
+      blk.firstRec = numIndexedRecs;
+      numIndexedRecs += blk.numRecs;
+      if (blk.numRecs > 0 && blk.maxTime > maxTime) maxTime = blk.maxTime;
+      blk.maxTime = maxTime;
+   }
+
+   // Start at the first chunk
+   sin->clear();
+   sin->seekg(RecordFileFormat::HEADER_SIZE);
+   filePos = RecordFileFormat::HEADER_SIZE;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Summarize an index block's payload: its number of records, their max sim
+// time, the offsets of its first and last records and its players
+//------------------------------------------------------------------------------
+bool FileReader::summarizeIndexBlock(const std::vector<char>& payload, IndexBlock* const blk, std::uint64_t* const prev)
+{
+   indexEntries.clear();
+   const bool ok{RecordFileFormat::decodeIndex(reinterpret_cast<const unsigned char*>(payload.data()), payload.size(),
+                                               prev, indexEntries, blocks)};
+   if (ok) {
+      blk->numRecs = indexEntries.size();
+      blk->players.clear();
+      for (std::size_t i = 0; i < indexEntries.size(); i++) {
+         const RecordFileFormat::IndexEntry& e{indexEntries[i]};
+         if (i == 0 || e.simTime > blk->maxTime) blk->maxTime = e.simTime;
+         if (e.hasPlayer) blk->players.push_back(e.playerId);
+      }
+      std::sort(blk->players.begin(), blk->players.end());
+      blk->players.erase(std::unique(blk->players.begin(), blk->players.end()), blk->players.end());
+      blk->players.shrink_to_fit();
+      if (!indexEntries.empty()) {
+         blk->firstOffset = indexEntries.front().offset;
+         blk->lastOffset = indexEntries.back().offset;
+         blk->firstInner = indexEntries.front().inner;
+         blk->lastInner = indexEntries.back().inner;
+      }
+   }
+   indexEntries.clear();
+   indexLoaded = false;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Index block of the indexed record 'rec'
+//------------------------------------------------------------------------------
+std::size_t FileReader::findIndexBlock(const std::size_t rec) const
+{
+   const auto it = std::upper_bound(indexBlocks.begin(), indexBlocks.end(), rec,
+                                    [](const std::size_t r, const IndexBlock& b) { return r < b.firstRec; });
+   return static_cast<std::size_t>(it - indexBlocks.begin()) - 1;
+}
+
+//------------------------------------------------------------------------------
+// Index entry of the indexed record 'rec', whose index block is read if it's
+// not the current one; returns zero if there's no such record, or if the
+// block can't be read
+//------------------------------------------------------------------------------
+const RecordFileFormat::IndexEntry* FileReader::indexEntry(const std::size_t rec)
+{
+   if (rec >= numIndexedRecs) return nullptr;
+
+   const IndexBlock* blk{&indexBlocks[indexBlock]};
+   if (!indexLoaded || rec < blk->firstRec || rec >= (blk->firstRec + blk->numRecs)) {
+      indexBlock = findIndexBlock(rec);
+      blk = &indexBlocks[indexBlock];
+
+      unsigned char type{};
+      std::uint64_t prev{};
+      indexEntries.clear();
+      indexLoaded = (readChunk(blk->offset, &type, indexChunk) && type == RecordFileFormat::INDEX_CHUNK &&
+                     RecordFileFormat::decodeIndex(reinterpret_cast<const unsigned char*>(indexChunk.data()), indexChunk.size(),
+                                                   &prev, indexEntries, blocks) &&
+                     indexEntries.size() == blk->numRecs);
+      if (!indexLoaded && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+         std::cerr << "FileReader::readRecord() -- unable to read the index block at " << blk->offset << std::endl;
+      }
+
+      // Back to the current record
+      sin->clear();
+      sin->seekg(filePos);
+   }
+   return (indexLoaded ? &indexEntries[rec - blk->firstRec] : nullptr);
+}
+
+//------------------------------------------------------------------------------
+// The player filter's next indexed record, starting at 'nextRec', or the
+// number of indexed records if there isn't one; the index blocks without
+// the player's records are skipped
+//------------------------------------------------------------------------------
+std::size_t FileReader::nextPlayerRecord()
+{
+   std::size_t rec{nextRec};
+   while (rec < numIndexedRecs) {
+      const std::size_t b{findIndexBlock(rec)};
+      const std::size_t end{indexBlocks[b].firstRec + indexBlocks[b].numRecs};
+      if (hasPlayerRecords(playerFilter, b)) {
+         for ( ; rec < end; rec++) {
+            const RecordFileFormat::IndexEntry* const e{indexEntry(rec)};
+            if (e == nullptr) return numIndexedRecs;
+            if (e->hasPlayer && e->playerId == playerFilter) return rec;
+         }
+      }
+      rec = end;
+   }
+   return numIndexedRecs;
+}
+
+//------------------------------------------------------------------------------
+// Filters an unindexed record: true if the sim time hasn't reached the tail
+// time yet (see seekTime()), or if it's not the player filter's record
+//------------------------------------------------------------------------------
+bool FileReader::isSkipped(const proto::DataRecord& record)
+{
+   if (tailTimeFlg) {
+      if (record.time().sim_time() < tailTime) return true;
+      tailTimeFlg = false;
+   }
+   unsigned int id{};
+   return (playerFilterFlg && !(RecordFileFormat::getPlayerId(record, &id) && id == playerFilter));
+}
+
+//------------------------------------------------------------------------------
+// Read a chunk's header at the current file position
+//------------------------------------------------------------------------------
+bool FileReader::readChunkHeader(unsigned char* const type, std::uint64_t* const size, std::size_t* const hdrSize)
+{
+   unsigned char hdr[RecordFileFormat::MAX_CHUNK_HEADER]{};
+   std::size_t n{};
+   int c{};
+   do {
+      c = sin->get();
+      if (c == std::ifstream::traits_type::eof()) return false;
+      hdr[n++] = static_cast<unsigned char>(c);
+   } while ((n == 1 || (c & 0x80) != 0) && n < RecordFileFormat::MAX_CHUNK_HEADER);
+
+   const unsigned char* p{hdr + 1};
+   if (!RecordFileFormat::getVarint(&p, hdr + n, size)) return false;
+   *type = hdr[0];
+   *hdrSize = n;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Read the chunk at 'offset'
+//------------------------------------------------------------------------------
+bool FileReader::readChunk(const std::uint64_t offset, unsigned char* const type, std::vector<char>& payload)
+{
+   sin->clear();
+   sin->seekg(offset);
+   std::uint64_t size{};
+   std::size_t h{};
+   bool ok{readChunkHeader(type, &size, &h) && (offset + h + size) <= dataEnd};
+   if (ok) {
+      payload.resize(size);
+      sin->read(payload.data(), size);
+      ok = !sin->fail();
+   }
+   return ok;
+}
+
+
+//------------------------------------------------------------------------------
+// Seek and filter functions
+//------------------------------------------------------------------------------
+
+bool FileReader::seekTime(const double simTime)
+{
+   bool ok{};
+   if (isOpen() && indexed) {
+      // The first index block whose records have reached the time, and then
+      // the record in it; otherwise the unindexed records are skipped until
+      // they reach it
+      nextRec = numIndexedRecs;
+      tailTimeFlg = false;
+      const auto it = std::lower_bound(indexBlocks.begin(), indexBlocks.end(), simTime,
+                                       [](const IndexBlock& b, const double t) { return b.maxTime < t; });
+      if (it != indexBlocks.end()) {
+         double maxTime{(it != indexBlocks.begin()) ? std::prev(it)->maxTime : std::numeric_limits<double>::lowest()};
+         for (std::size_t rec = it->firstRec; rec < (it->firstRec + it->numRecs); rec++) {
+            const RecordFileFormat::IndexEntry* const e{indexEntry(rec)};
+            if (e == nullptr) break;
+            if (e->simTime > maxTime) maxTime = e->simTime;
+            if (maxTime >= simTime) {
+               nextRec = rec;
+               break;
+            }
+         }
+      }
+      else {
+         tailTime = simTime;
+         tailTimeFlg = true;
+      }
+      ok = true;
+   }
+   return ok;
+}
+
+bool FileReader::hasPlayerRecords(const unsigned int id, const std::size_t b) const
+{
+   return (b < indexBlocks.size() && std::binary_search(indexBlocks[b].players.begin(), indexBlocks[b].players.end(), id));
+}
+
+bool FileReader::setPlayerFilter(const unsigned int id)
+{
+   playerFilter = id;
+   playerFilterFlg = true;
+   return true;
+}
+
+bool FileReader::clearPlayerFilter()
+{
+   playerFilterFlg = false;
+   return true;
+}
+
+
 //------------------------------------------------------------------------------
 // Read a record
 //------------------------------------------------------------------------------
 const DataRecordHandle* FileReader::readRecordImp()
 {
-   DataRecordHandle* handle{};
+   const DataRecordHandle* handle{};
 
    // First pass?  Does the file need to be opened?
    if (firstPassFlg) {
       if ( !isOpen() && !isFailed() ) {
          openFile();
       }
+      if (startTimeFlg) seekTime(startTime);
       firstPassFlg = false;
    }
 
+   if (blocks) handle = readBlockRecord();
+   else if (indexed) handle = readIndexedRecord();
+   else {
+      // legacy files are filtered one record after the other
+      handle = readLegacyRecord();
+      unsigned int id{};
+      while (handle != nullptr && playerFilterFlg &&
+             !(RecordFileFormat::getPlayerId(*handle->getRecord(), &id) && id == playerFilter)) {
+         handle->unref();
+         handle = readLegacyRecord();
+      }
+   }
+
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// Read the next record from an indexed file
+//------------------------------------------------------------------------------
+const DataRecordHandle* FileReader::readIndexedRecord()
+{
+   DataRecordHandle* handle{};
+
+   bool finished{!isOpen() || isFailed()};
+   while (!finished) {
+
+      // ---
+      // Find the next record's chunk; with a player filter, use the
+      // index to skip to the player's next indexed record
+      // ---
+      if (playerFilterFlg && nextRec < numIndexedRecs) nextRec = nextPlayerRecord();
+      const RecordFileFormat::IndexEntry* const entry{indexEntry(nextRec)};
+      if (entry == nullptr) nextRec = numIndexedRecs;
+      const bool indexedRec{entry != nullptr};
+      std::uint64_t pos{filePos};
+      if (indexedRec) pos = entry->offset;
+      else if (pos < tailOffset) pos = tailOffset;
+
+      // End of the data?
+      if (pos >= dataEnd) {
+         finished = true;
+      }
+
+      else {
+         if (pos != filePos) {
+            sin->clear();
+            sin->seekg(pos);
+         }
+
+         // ---
+         // Read the chunk
+         // ---
+         unsigned char type{};
+         std::uint64_t n{};
+         std::size_t h{};
+         bool ok{readChunkHeader(&type, &n, &h) && (pos + h + n) <= dataEnd};
+         if (ok) {
+            if (ibuf.size() < n) ibuf.resize(n);
+            sin->read(ibuf.data(), n);
+            ok = !sin->fail();
+         }
+
+         if (!ok) {
+            // A partial chunk is the end of a file that wasn't closed
+            filePos = dataEnd;
+            finished = true;
+         }
+
+         // ---
+         // Parse the DataRecord (the index blocks are skipped) and put it into a Handle
+         // ---
+         else {
+            filePos = pos + h + n;
+            if (indexedRec) nextRec++;
+
+            if (type == RecordFileFormat::RECORD_CHUNK) {
+               auto dataRecord = new proto::DataRecord();
+               ok = dataRecord->ParseFromArray(ibuf.data(), static_cast<int>(n));
+
+               // The unindexed records are filtered here
+               const bool skip{ok && !indexedRec && isSkipped(*dataRecord)};
+
+               // Create a handle for the DataRecord (it now has ownership)
+               if (ok && !skip) {
+                  handle = new DataRecordHandle(dataRecord);
+                  finished = true;
+               }
+
+               else {
+                  // parsing error
+                  if (!ok && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+                     std::cerr << "FileReader::readRecord() -- ParseFromArray() error" << std::endl;
+                  }
+                  delete dataRecord;
+                  dataRecord = nullptr;
+               }
+            }
+         }
+      }
+
+   }
+
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// Read the next record from a compressed (indexed) file
+//------------------------------------------------------------------------------
+const DataRecordHandle* FileReader::readBlockRecord()
+{
+   DataRecordHandle* handle{};
+
+   bool finished{!isOpen() || isFailed()};
+   while (!finished) {
+
+      // ---
+      // Find the next record; with a player filter, use the index to skip
+      // to the player's next indexed record
+      // ---
+      if (playerFilterFlg && nextRec < numIndexedRecs) nextRec = nextPlayerRecord();
+      const RecordFileFormat::IndexEntry* const entry{indexEntry(nextRec)};
+      if (entry == nullptr) nextRec = numIndexedRecs;
+      const bool indexedRec{entry != nullptr};
+
+      proto::DataRecord* dataRecord{};
+      bool ok{true};
+
+      if (indexedRec) {
+         // ---
+         // Indexed record: load its block, if it's not the current one, and
+         // decode the block's records up to it (for their player data samples)
+         // ---
+         const std::uint64_t offset{entry->offset};
+         const std::size_t inner{entry->inner};
+         if (!blockLoaded || blockOffset != offset) ok = (loadBlock(offset) && !blockData.empty());
+         if (ok && inner < blockPos) {
+            blockPos = 0;
+            deltaState.clear();
+         }
+         while (ok && blockPos < inner) {
+            delete nextBlockRecord(&ok);
+         }
+         if (ok) dataRecord = nextBlockRecord(&ok);
+         nextRec++;
+
+         if (!ok) {
+            // skip the rest of the bad block's records
+            if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+               std::cerr << "FileReader::readRecord() -- invalid compressed block at " << offset << std::endl;
+            }
+            const RecordFileFormat::IndexEntry* e{indexEntry(nextRec)};
+            while (e != nullptr && e->offset == offset) e = indexEntry(++nextRec);
+            blockLoaded = false;
+         }
+      }
+
+      else if (blockLoaded && blockOffset >= tailOffset && blockPos < blockData.size()) {
+         // ---
+         // The next unindexed record in the current block
+         // ---
+         dataRecord = nextBlockRecord(&ok);
+         if (!ok) blockLoaded = false;
+      }
+
+      else {
+         // ---
+         // Load the next unindexed block (other chunks are skipped)
+         // ---
+         const std::uint64_t pos{std::max(filePos, tailOffset)};
+         if (pos >= dataEnd || !loadBlock(pos)) {
+            // End of the data; a partial chunk is the end of a file that wasn't closed
+            filePos = dataEnd;
+            finished = true;
+         }
+      }
+
+      // ---
+      // Put the DataRecord into a Handle; the unindexed records are filtered here
+      // ---
+      if (dataRecord != nullptr) {
+         const bool skip{!indexedRec && isSkipped(*dataRecord)};
+         if (!skip) {
+            handle = new DataRecordHandle(dataRecord);
+            finished = true;
+         }
+         else {
+            delete dataRecord;
+            dataRecord = nullptr;
+         }
+      }
+
+   }
+
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// Load (read and decompress) the block at 'offset'; a chunk that's not a
+// block is skipped (an empty block)
+//------------------------------------------------------------------------------
+bool FileReader::loadBlock(const std::uint64_t offset)
+{
+   unsigned char type{};
+   bool ok{readChunk(offset, &type, blockChunk)};
+   if (ok) {
+      filePos = static_cast<std::uint64_t>(sin->tellg());
+      if (type == RecordFileFormat::BLOCK_CHUNK) {
+         ok = RecordFileFormat::decompressBlock(blockChunk.data(), blockChunk.size(), blockData);
+         if (!ok && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileReader::loadBlock() -- decompression error at " << offset << std::endl;
+         }
+      }
+      else blockData.clear();
+   }
+   if (!ok) blockData.clear();
+
+   blockOffset = offset;
+   blockPos = 0;
+   blockLoaded = ok;
+   deltaState.clear();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Parse (and delta decode) the next record of the current block; returns zero
+// with 'ok' false if the block doesn't have a valid record chunk
+//------------------------------------------------------------------------------
+proto::DataRecord* FileReader::nextBlockRecord(bool* const ok)
+{
+   proto::DataRecord* dataRecord{};
+   unsigned char type{};
+   const char* payload{};
+   std::size_t n{};
+   *ok = RecordFileFormat::getChunk(blockData.data(), blockData.size(), &blockPos, &type, &payload, &n);
+   if (*ok) {
+      dataRecord = RecordFileFormat::parseRecord(type, payload, n, deltaState);
+      *ok = (dataRecord != nullptr);
+   }
+   return dataRecord;
+}
+
+//------------------------------------------------------------------------------
+// Read the next record from a legacy file
+//------------------------------------------------------------------------------
+const DataRecordHandle* FileReader::readLegacyRecord()
+{
+   DataRecordHandle* handle{};
 
    // When the file is open and ready ...
    if ( isOpen() && !isFailed() && !sin->eof() ) {
@@ -230,7 +836,8 @@ const DataRecordHandle* FileReader::readRecordImp()
       if (n > 0) {
 
          // Read message into ibuf
-         sin->read(ibuf, n);
+         if (ibuf.size() < n) ibuf.resize(n);
+         sin->read(ibuf.data(), n);
 
          // Check for error or eof
          if ( sin->eof() || sin->fail() ) {
@@ -244,7 +851,7 @@ const DataRecordHandle* FileReader::readRecordImp()
          else {
 
             // Parse the DataRecord
-            std::string wireFormat(ibuf, n);
+            std::string wireFormat(ibuf.data(), n);
             auto dataRecord = new proto::DataRecord();
             bool ok{dataRecord->ParseFromString(wireFormat)};
 
@@ -296,6 +903,34 @@ bool FileReader::setPathName(const base::String* const msg)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool FileReader::setSlotStartTime(const base::ITime* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      startTime = msg->getValueInSeconds();
+      startTimeFlg = true;
+      ok = true;
+   }
+   return ok;
+}
+
+bool FileReader::setSlotPlayer(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int id{msg->asInt()};
+      if (id >= 0) {
+         ok = setPlayerFilter(static_cast<unsigned int>(id));
+      } else {
+         std::cerr << "FileReader::setSlotPlayer(): Player ID is invalid; must be zero or greater." << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
 }
@@ -2,11 +2,17 @@
 #include "mixr/recorder/protobuf_v2/FileWriter.hpp"
 #include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
 #include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/FileReader.hpp"
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/util/str_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <cstdio>
 #include <cstring>
 
 namespace mixr {
@@ -18,11 +24,19 @@ IMPLEMENT_SUBCLASS(FileWriter, "RecorderFileWriter")
 BEGIN_SLOTTABLE(FileWriter)
     "filename",         // 1) Data file name (required)
     "pathname",         // 2) Path to the data file directory (optional)
+    "format",           // 3) File format: indexed or legacy (optional)
+    "compress",         // 4) Compress the records in blocks (optional)
+    "blockSize",        // 5) Uncompressed block size (bytes) (optional)
+    "deltaEncoding",    // 6) Delta encode the player data (optional)
 END_SLOTTABLE(FileWriter)
 
 BEGIN_SLOT_MAP(FileWriter)
     ON_SLOT( 1, setSlotFilename, base::String)
     ON_SLOT( 2, setSlotPathName, base::String)
+    ON_SLOT( 3, setSlotFormat,   base::Identifier)
+    ON_SLOT( 4, setSlotCompress, base::Boolean)
+    ON_SLOT( 5, setSlotBlockSize, base::Integer)
+    ON_SLOT( 6, setSlotDeltaEncoding, base::Boolean)
 END_SLOT_MAP()
 
 FileWriter::FileWriter()
@@ -36,13 +50,21 @@ void FileWriter::copyData(const FileWriter& org, const bool)
 
    setFilename(org.filename);
    setPathName(org.pathname);
+   format = org.format;
+   compress = org.compress;
+   blockSize = org.blockSize;
+   deltaEncoding = org.deltaEncoding;
 
    // Need to re-open the file
    if (sout != nullptr) {
-      if (isOpen()) sout->close();
+      if (isOpen()) {
+         flushBuffer();
+         sout->close();
+      }
       delete sout;
    }
    sout = nullptr;
+   bufferUsed = 0;
    fileOpened = false;
    fileFailed = false;
    eodFlag    = false;
@@ -52,10 +74,14 @@ void FileWriter::copyData(const FileWriter& org, const bool)
 void FileWriter::deleteData()
 {
    if (sout != nullptr) {
-      if (isOpen()) sout->close();
+      if (isOpen()) {
+         flushBuffer();
+         sout->close();
+      }
       delete sout;
    }
    sout = nullptr;
+   bufferUsed = 0;
 
    setFilename(nullptr);
    setPathName(nullptr);
@@ -219,6 +245,23 @@ bool FileWriter::openFile()
             tFailed = true;
          }
 
+         //---
+         // Start the indexed file with its header
+         //---
+         bufferUsed = 0;
+         fileOffset = 0;
+         index.clear();
+         lastIndexOffset = 0;
+         blocks = (compress && format == Format::INDEXED);
+         blockUsed = 0;
+         blockIndex.clear();
+         deltaState.clear();
+         if (tOpened && format == Format::INDEXED) {
+            char* const p{reserveBuffer(RecordFileFormat::HEADER_SIZE)};
+            RecordFileFormat::encodeHeader(reinterpret_cast<unsigned char*>(p), (blocks ? RecordFileFormat::BLOCKS_FLAG : 0));
+            bufferUsed += RecordFileFormat::HEADER_SIZE;
+         }
+
       }
 
       delete[] fullname;
@@ -264,7 +307,20 @@ void FileWriter::closeFile()
          handle = nullptr;
       }
 
-      // now close the file
+      // ---
+      // End the indexed file with the last index block and the trailer
+      if (format == Format::INDEXED) {
+         writeBlock();
+         writeIndex();
+         if (lastIndexOffset > 0) {
+            char* const p{reserveBuffer(RecordFileFormat::TRAILER_SIZE)};
+            RecordFileFormat::encodeTrailer(reinterpret_cast<unsigned char*>(p), lastIndexOffset);
+            bufferUsed += RecordFileFormat::TRAILER_SIZE;
+         }
+      }
+
+      // now write the rest of the buffer and close the file
+      flushBuffer();
       sout->close();
       fileOpened = false;
       fileFailed = false;
@@ -294,39 +350,74 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
       // The DataRecord to be sent
       const proto::DataRecord* dataRecord{handle->getRecord()};
 
-      // Serialize the DataRecord
-      std::string wireFormat;
-	   bool ok{dataRecord->SerializeToString(&wireFormat)};
-
-      // Write the serialized DataRecord with its length to the file
-      if (ok) {
-		  int n{static_cast<int>(wireFormat.length())};
-
-         // Convert size to an integer string
-         char nbuff[8];
-         std::sprintf(nbuff, "%04d", n);
-
-         // Convert the leading zeros to spaces
-         if (nbuff[0] == '0') {
-            nbuff[0] = ' ';
-            if (nbuff[1] == '0') {
-               nbuff[1] = ' ';
-               if (nbuff[2] == '0') {
-                  nbuff[2] = ' ';
-               }
-            }
+      // Size of the serialized DataRecord
+      const std::size_t n{dataRecord->ByteSizeLong()};
+      bool ok{};
+
+      if (blocks) {
+         // Add the DataRecord's chunk to the block
+         RecordFileFormat::IndexEntry entry;
+         entry.inner = static_cast<std::uint32_t>(blockUsed);
+         ok = RecordFileFormat::appendRecord(block, &blockUsed, *dataRecord, (deltaEncoding ? &deltaState : nullptr));
+
+         if (ok) {
+            // Index the record (the block's offset is set when it's written)
+            entry.simTime = dataRecord->time().sim_time();
+            entry.hasPlayer = RecordFileFormat::getPlayerId(*dataRecord, &entry.playerId);
+            blockIndex.push_back(entry);
+
+            if (blockUsed >= blockSize) writeBlock();
          }
+      }
 
-         // Write the size of the serialized DataRecord as an ascii string
-         sout->write(nbuff, 4);
+      else if (format == Format::INDEXED) {
+         // Serialize the DataRecord straight into the buffer, after its chunk header
+         unsigned char hdr[RecordFileFormat::MAX_CHUNK_HEADER];
+         const std::size_t h{RecordFileFormat::encodeChunkHeader(hdr, RecordFileFormat::RECORD_CHUNK, n)};
+         char* const p{reserveBuffer(h + n)};
+         ok = dataRecord->SerializeToArray(p + h, static_cast<int>(n));
+
+         if (ok) {
+            std::memcpy(p, hdr, h);
+
+            // Index the record
+            RecordFileFormat::IndexEntry entry;
+            entry.offset = fileOffset + bufferUsed;
+            entry.simTime = dataRecord->time().sim_time();
+            entry.hasPlayer = RecordFileFormat::getPlayerId(*dataRecord, &entry.playerId);
+            index.push_back(entry);
+
+            bufferUsed += (h + n);
+            if (index.size() >= RecordFileFormat::INDEX_INTERVAL) writeIndex();
+         }
+      }
 
-         // Write the serialized DataRecord
-         sout->write( wireFormat.c_str(), n );
+      else if (n <= 9999) {
+         // Serialize the DataRecord straight into the buffer, after its size
+         char* const p{reserveBuffer(4 + n)};
+         ok = dataRecord->SerializeToArray(p + 4, static_cast<int>(n));
+
+         if (ok) {
+            // The size of the serialized DataRecord as an ascii string
+            // with leading spaces
+            char nbuff[16];
+            std::snprintf(nbuff, sizeof(nbuff), "%4d", static_cast<int>(n));
+            std::memcpy(p, nbuff, 4);
+            bufferUsed += (4 + n);
+         }
       }
 
-      else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+      else {
+         // Too large for the legacy format's 4 character size
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileWriter::processRecordImp() -- data record is too large for the legacy format: " << n << " bytes" << std::endl;
+         }
+         ok = true;     // (skipped; it's not a serialization error)
+      }
+
+      if (!ok && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
          // If we had an error serializing the DataRecord
-         std::cerr << "FileWriter::processRecordImp() -- SerializeToString() error" << std::endl;
+         std::cerr << "FileWriter::processRecordImp() -- SerializeToArray() error" << std::endl;
       }
 
       // Check for END_OF_DATA message
@@ -344,6 +435,120 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// Returns a pointer to room for 'n' more bytes in the output buffer
+//------------------------------------------------------------------------------
+char* FileWriter::reserveBuffer(const std::size_t n)
+{
+   if (bufferUsed + n > buffer.size()) {
+      flushBuffer();
+      if (n > buffer.size()) buffer.resize(std::max(BUFFER_SIZE, n));
+   }
+   return buffer.data() + bufferUsed;
+}
+
+//------------------------------------------------------------------------------
+// Write the output buffer to the file
+//------------------------------------------------------------------------------
+void FileWriter::flushBuffer()
+{
+   if (bufferUsed > 0 && sout != nullptr) {
+      sout->write(buffer.data(), static_cast<std::streamsize>(bufferUsed));
+      fileOffset += bufferUsed;
+   }
+   bufferUsed = 0;
+}
+
+//------------------------------------------------------------------------------
+// Write an index block of the records since the last one
+//------------------------------------------------------------------------------
+void FileWriter::writeIndex()
+{
+   if (!index.empty()) {
+      indexData.clear();
+      RecordFileFormat::encodeIndex(indexData, lastIndexOffset, index, blocks);
+
+      unsigned char hdr[RecordFileFormat::MAX_CHUNK_HEADER];
+      const std::size_t h{RecordFileFormat::encodeChunkHeader(hdr, RecordFileFormat::INDEX_CHUNK, indexData.size())};
+      char* const p{reserveBuffer(h + indexData.size())};
+      std::memcpy(p, hdr, h);
+      std::memcpy(p + h, indexData.data(), indexData.size());
+
+      lastIndexOffset = fileOffset + bufferUsed;
+      bufferUsed += (h + indexData.size());
+      index.clear();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Compress and write the block of records, and move its records' index entries
+// to the index
+//------------------------------------------------------------------------------
+void FileWriter::writeBlock()
+{
+   if (blockUsed > 0) {
+      const std::size_t n{RecordFileFormat::compressBlock(block.data(), blockUsed, compressed)};
+
+      unsigned char hdr[RecordFileFormat::MAX_CHUNK_HEADER];
+      const std::size_t h{RecordFileFormat::encodeChunkHeader(hdr, RecordFileFormat::BLOCK_CHUNK, n)};
+      char* const p{reserveBuffer(h + n)};
+      std::memcpy(p, hdr, h);
+      std::memcpy(p + h, compressed.data(), n);
+
+      const std::uint64_t offset{fileOffset + bufferUsed};
+      bufferUsed += (h + n);
+
+      for (RecordFileFormat::IndexEntry& entry : blockIndex) {
+         entry.offset = offset;
+         index.push_back(entry);
+      }
+      blockIndex.clear();
+      blockUsed = 0;
+      deltaState.clear();
+
+      if (index.size() >= RecordFileFormat::INDEX_INTERVAL) writeIndex();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Converts a (legacy or indexed) data file to an indexed data file; if the
+// output file already exists, a version number is appended (see openFile())
+//------------------------------------------------------------------------------
+bool FileWriter::convert(const char* const inFilename, const char* const outFilename, const bool compress)
+{
+   const auto reader{new FileReader()};
+   const auto inName{new base::String(inFilename)};
+   reader->setFilename(inName);
+   inName->unref();
+
+   const auto writer{new FileWriter()};
+   const auto outName{new base::String(outFilename)};
+   writer->setFilename(outName);
+   outName->unref();
+   writer->setFormat(Format::INDEXED);
+   writer->setCompress(compress);
+
+   bool ok{reader->openFile() && writer->openFile()};
+   if (ok) {
+      // Copy the records up to the end of data (which closes the output file)
+      bool eod{};
+      const DataRecordHandle* handle{reader->readRecord()};
+      while (handle != nullptr && !eod) {
+         eod = (handle->getRecord()->id() == REID_END_OF_DATA);
+         writer->processRecordImp(handle);
+         handle->unref();
+         if (!eod) handle = reader->readRecord();
+      }
+      ok = !writer->isFailed();
+      writer->closeFile();
+   }
+
+   writer->unref();
+   reader->unref();
+   return ok;
+}
+
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -377,6 +582,76 @@ bool FileWriter::setPathName(const base::String* const msg)
    return true;
 }
 
+bool FileWriter::setFormat(const Format x)
+{
+   format = x;
+   return true;
+}
+
+bool FileWriter::setCompress(const bool x)
+{
+   compress = x;
+   return true;
+}
+
+bool FileWriter::setBlockSize(const std::size_t n)
+{
+   bool ok{};
+   if (n >= MIN_BLOCK_SIZE && n <= MAX_BLOCK_SIZE) {
+      blockSize = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool FileWriter::setDeltaEncoding(const bool x)
+{
+   deltaEncoding = x;
+   return true;
+}
+
+bool FileWriter::setSlotCompress(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) ok = setCompress(msg->asBool());
+   return ok;
+}
+
+bool FileWriter::setSlotBlockSize(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n > 0) ok = setBlockSize(static_cast<std::size_t>(n));
+      if (!ok) {
+         std::cerr << "FileWriter::setSlotBlockSize(): invalid block size: " << n;
+         std::cerr << " -- valid sizes are [ " << MIN_BLOCK_SIZE << " .. " << MAX_BLOCK_SIZE << " ] bytes" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotDeltaEncoding(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) ok = setDeltaEncoding(msg->asBool());
+   return ok;
+}
+
+bool FileWriter::setSlotFormat(const base::Identifier* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      if (*msg == "indexed")     ok = setFormat(Format::INDEXED);
+      else if (*msg == "legacy") ok = setFormat(Format::LEGACY);
+      else {
+         std::cerr << "FileWriter::setSlotFormat(): invalid file format: " << *msg << std::endl;
+         std::cerr << " -- valid formats are { indexed, legacy }" << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
 }
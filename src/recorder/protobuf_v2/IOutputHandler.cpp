@@ -1,8 +1,8 @@
-
 #include "mixr/recorder/protobuf_v2/IOutputHandler.hpp"
 #include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
 #include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
 
+#include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/PairStream.hpp"
 
@@ -11,28 +11,44 @@ namespace recorder {
 namespace protobuf_v2 {
 
 IMPLEMENT_SUBCLASS(IOutputHandler, "IOutputHandler")
-EMPTY_SLOTTABLE(IOutputHandler)
+
+BEGIN_SLOTTABLE(IOutputHandler)
+   "queueSize",         // 1) Size of the data record queue
+END_SLOTTABLE(IOutputHandler)
+
+BEGIN_SLOT_MAP(IOutputHandler)
+   ON_SLOT( 1, setSlotQueueSize, base::Integer)
+END_SLOT_MAP()
 
 IOutputHandler::IOutputHandler()
 {
    STANDARD_CONSTRUCTOR()
+
+   queue = new base::mpsc_ring<const DataRecordHandle*>(DEFAULT_QUEUE_SIZE);
 }
 
 void IOutputHandler::copyData(const IOutputHandler& org, const bool)
 {
    BaseClass::copyData(org);
 
-   // Don't copy the queue
+   // Don't copy the queue's records, just its size
+   clearQueue();
    base::lock(semaphore);
-   queue.clear();
+   delete queue;
+   queue = new base::mpsc_ring<const DataRecordHandle*>(org.getQueueSize());
    base::unlock(semaphore);
+
+   numDropped = 0;
+   highWaterMark = 0;
 }
 
 void IOutputHandler::deleteData()
 {
    // clear the queue
+   clearQueue();
    base::lock(semaphore);
-   queue.clear();
+   delete queue;
+   queue = nullptr;
    base::unlock(semaphore);
 }
 
@@ -41,6 +57,18 @@ void IOutputHandler::deleteData()
 //------------------------------------------------------------------------------
 bool IOutputHandler::shutdownNotification()
 {
+   // Report our queue statistics
+   const unsigned int dropped{getNumDropped()};
+   if (dropped > 0 && isMessageEnabled(MSG_WARNING)) {
+      std::cerr << "IOutputHandler::shutdownNotification(): " << dropped;
+      std::cerr << " data records were dropped; the queue was full (queueSize: " << getQueueSize() << ")" << std::endl;
+   }
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "IOutputHandler::shutdownNotification(): queue size: " << getQueueSize();
+      std::cout << ", high-water mark: " << getQueueHighWaterMark();
+      std::cout << ", dropped records: " << dropped << std::endl;
+   }
+
    // Pass the shutdown notification to our subcomponent recorders
    base::PairStream* subcomponents{getComponents()};
    if (subcomponents != nullptr) {
@@ -89,15 +117,17 @@ void IOutputHandler::processRecord(const DataRecordHandle* const dataRecord)
 
 
 //------------------------------------------------------------------------------
-// Queue the data record handle to be processed later
+// Queue the data record handle to be processed later; the record is dropped
+// if the queue is full (we never wait on the thread processing the queue)
 //------------------------------------------------------------------------------
 void IOutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 {
-   if (dataRecord != nullptr) {
-      base::lock( semaphore );
-      // const cast away to put into the queue
-      queue.put( const_cast<DataRecordHandle*>(static_cast<const DataRecordHandle*>(dataRecord)) );
-      base::unlock( semaphore );
+   if (dataRecord != nullptr && queue != nullptr) {
+      dataRecord->ref();
+      if ( !queue->put(dataRecord) ) {
+         dataRecord->unref();
+         numDropped.fetch_add(1, std::memory_order_relaxed);
+      }
    }
 }
 
@@ -107,22 +137,94 @@ void IOutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 //------------------------------------------------------------------------------
 void IOutputHandler::processQueue()
 {
-   // Get the first record from the queue
+   // Only one thread at a time processes the queue
+   base::lock( semaphore );
+
+   if (queue != nullptr) {
+      // Track the queue's high-water mark
+      const unsigned int n{queue->entries()};
+      if (n > highWaterMark) highWaterMark = n;
+
+      // While we have records ...
+      const DataRecordHandle* dataRecord{};
+      bool processed{};
+      while (queue->get(&dataRecord)) {
+         // process this record
+         processRecord(dataRecord);
+         dataRecord->unref();
+         processed = true;
+      }
+
+      // Flush the batched records
+      if (processed) flush();
+   }
+
+   base::unlock( semaphore );
+}
+
+
+//------------------------------------------------------------------------------
+// Flush our batched data records, and then our subcomponents'
+//------------------------------------------------------------------------------
+void IOutputHandler::flush()
+{
+   flushImp();
+
+   base::PairStream* subcomponents{getComponents()};
+   if (subcomponents != nullptr) {
+      for (base::IList::Item* item = subcomponents->getFirstItem(); item != nullptr; item = item->getNext()) {
+         base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
+         IOutputHandler* sc{static_cast<IOutputHandler*>(pair->object())};
+         sc->flush();
+      }
+      subcomponents->unref();
+      subcomponents = nullptr;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Removes (without processing) all data records from the queue
+//------------------------------------------------------------------------------
+void IOutputHandler::clearQueue()
+{
    base::lock( semaphore );
-   const DataRecordHandle* dataRecord{static_cast<const DataRecordHandle*>(queue.get())};
+   if (queue != nullptr) {
+      const DataRecordHandle* dataRecord{};
+      while (queue->get(&dataRecord)) {
+         dataRecord->unref();
+      }
+   }
    base::unlock( semaphore );
+}
+
+
+//------------------------------------------------------------------------------
+// Queue size and statistics
+//------------------------------------------------------------------------------
+
+unsigned int IOutputHandler::getQueueSize() const
+{
+   return (queue != nullptr ? queue->size() : 0);
+}
 
-   // While we have records ...
-   while (dataRecord != nullptr) {
-      // process this record,
-      processRecord(dataRecord);
-      dataRecord->unref();
+unsigned int IOutputHandler::getQueueEntries() const
+{
+   return (queue != nullptr ? queue->entries() : 0);
+}
 
-      // and get the next one from the queue
+bool IOutputHandler::setQueueSize(const unsigned int n)
+{
+   bool ok{};
+   if (n > 0) {
+      clearQueue();
       base::lock( semaphore );
-      dataRecord = static_cast<const DataRecordHandle*>(queue.get());
+      delete queue;
+      queue = new base::mpsc_ring<const DataRecordHandle*>(n);
       base::unlock( semaphore );
+      ok = true;
    }
+   return ok;
 }
 
 
@@ -134,6 +236,14 @@ void IOutputHandler::processRecordImp(const DataRecordHandle* const)
 }
 
 
+//------------------------------------------------------------------------------
+// flushImp() stub
+//------------------------------------------------------------------------------
+void IOutputHandler::flushImp()
+{
+}
+
+
 //------------------------------------------------------------------------------
 // Check the data filters and return true if we should process this type message
 //------------------------------------------------------------------------------
@@ -157,6 +267,24 @@ void IOutputHandler::processComponents(
    BaseClass::processComponents(list, typeid(IOutputHandler), add, remove);
 }
 
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool IOutputHandler::setSlotQueueSize(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n > 0) {
+         ok = setQueueSize(static_cast<unsigned int>(n));
+      } else {
+         std::cerr << "IOutputHandler::setSlotQueueSize(): Queue size is invalid; must be greater than zero." << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
 }
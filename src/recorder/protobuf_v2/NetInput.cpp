@@ -5,6 +5,8 @@
 #include "mixr/base/network/INetHandler.hpp"
 #include "mixr/base/numeric/Boolean.hpp"
 
+#include <cstring>
+
 namespace mixr {
 namespace recorder {
 namespace protobuf_v2 {
@@ -44,6 +46,9 @@ void NetInput::copyData(const NetInput& org, const bool cc)
    networkInitialized = false;
    networkInitFailed = false;
    firstPassFlg = true;
+   batch.clear();
+   batchPos = 0;
+   deltaState.clear();
 }
 
 void NetInput::deleteData()
@@ -103,19 +108,35 @@ const DataRecordHandle* NetInput::readRecordImp()
 
    DataRecordHandle* handle = nullptr;
 
-   // When the file is open and ready ...
-   if ( networkInitialized && netHandler->isConnected() ) {
+   // When the file is open and ready, and we're not reading a batch ...
+   if ( batchPos >= batch.size() && networkInitialized && netHandler->isConnected() ) {
 
       // ---
       // Try to read a message into 'ibuf'
       // ---
       unsigned int n{netHandler->recvData( ibuf, MAX_INPUT_BUFFER_SIZE )};
+      const std::size_t m{sizeof(RecordFileFormat::BATCH_MAGIC)};
+
+      // ---
+      // A compressed batch of records; decompress it, and read its
+      // records (below)
+      // ---
+      if (n > m && std::memcmp(ibuf, RecordFileFormat::BATCH_MAGIC, m) == 0) {
+         batchPos = 0;
+         deltaState.clear();
+         if (!RecordFileFormat::decompressBlock(ibuf + m, n - m, batch)) {
+            if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+               std::cerr << "NetInput::readRecord() -- record batch decompression error" << std::endl;
+            }
+            batch.clear();
+         }
+      }
 
       // ---
       // If we've successfully read a message from the network
       // then parse it as a DataRecord and put it into a Handle.
       // ---
-      if (n > 0) {
+      else if (n > 0) {
          // Parse the data record
          std::string wireFormat(ibuf, n);
          auto dataRecord = new proto::DataRecord();
@@ -134,6 +155,32 @@ const DataRecordHandle* NetInput::readRecordImp()
 
       }
    }
+
+   // ---
+   // The next record of the batch
+   // ---
+   if (batchPos < batch.size()) {
+      unsigned char type{};
+      const char* payload{};
+      std::size_t n{};
+      proto::DataRecord* dataRecord{};
+      if (RecordFileFormat::getChunk(batch.data(), batch.size(), &batchPos, &type, &payload, &n)) {
+         dataRecord = RecordFileFormat::parseRecord(type, payload, n, deltaState);
+      }
+
+      if (dataRecord != nullptr) {
+         // Create a handle for the data record (it now has ownership)
+         handle = new DataRecordHandle(dataRecord);
+      }
+      else {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "NetInput::readRecord() -- invalid record batch" << std::endl;
+         }
+         batch.clear();
+         batchPos = 0;
+      }
+   }
+
    return handle;
 }
 
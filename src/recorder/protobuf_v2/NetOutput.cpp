@@ -4,6 +4,9 @@
 #include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
 #include "mixr/base/network/INetHandler.hpp"
 #include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+
+#include <cstring>
 
 namespace mixr {
 namespace recorder {
@@ -14,11 +17,17 @@ IMPLEMENT_SUBCLASS(NetOutput, "RecorderNetOutput")
 BEGIN_SLOTTABLE(NetOutput)
    "netHandler",           // 1) Network handler
    "noWait",               // 2) No wait (unblocked) I/O flag (default: false -- blocked I/O)
+   "compress",             // 3) Send compressed batches of records (default: false)
+   "batchSize",            // 4) Uncompressed batch size (bytes)
+   "deltaEncoding",        // 5) Delta encode the player data (default: false)
 END_SLOTTABLE(NetOutput)
 
 BEGIN_SLOT_MAP(NetOutput)
     ON_SLOT(1, setSlotNetwork,   mixr::base::INetHandler)
     ON_SLOT(2, setSlotNoWait,    mixr::base::Boolean)
+    ON_SLOT(3, setSlotCompress,  mixr::base::Boolean)
+    ON_SLOT(4, setSlotBatchSize, mixr::base::Integer)
+    ON_SLOT(5, setSlotDeltaEncoding, mixr::base::Boolean)
 END_SLOT_MAP()
 
 NetOutput::NetOutput()
@@ -30,10 +39,16 @@ void NetOutput::copyData(const NetOutput& org, const bool)
 {
    BaseClass::copyData(org);
 
+   compress = org.compress;
+   batchSize = org.batchSize;
+   deltaEncoding = org.deltaEncoding;
+
    // We need to init this ourselves, so ...
    netHandler = nullptr;
    networkInitialized = false;
    networkInitFailed = false;
+   batchUsed = 0;
+   deltaState.clear();
 }
 
 void NetOutput::deleteData()
@@ -95,22 +110,38 @@ void NetOutput::processRecordImp(const DataRecordHandle* const handle)
       // The DataRecord to be sent
       const proto::DataRecord* dataRecord{handle->getRecord()};
 
-      // Serialize the DataRecord
-      std::string wireFormat;
-      bool ok{dataRecord->SerializeToString(&wireFormat)};
+      // Check for END_OF_DATA message
+      thisIsEodMsg = (dataRecord->id() == REID_END_OF_DATA);
 
-      // Write the serialized message to the network
-      if (ok) {
-         netHandler->sendData( wireFormat.c_str(), static_cast<int>(wireFormat.length()) );
+      if (compress) {
+         // Send the batch first, if the record won't fit (the delta encoded
+         // record is the same size)
+         const std::size_t n{dataRecord->ByteSizeLong()};
+         if (batchUsed > 0 && (batchUsed + RecordFileFormat::MAX_CHUNK_HEADER + n) > batchSize) sendBatch();
+
+         // Add the DataRecord's chunk to the batch
+         const bool ok{RecordFileFormat::appendRecord(batch, &batchUsed, *dataRecord, (deltaEncoding ? &deltaState : nullptr))};
+         if (!ok && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "NetOutput::processRecordImp() -- SerializeToArray() error" << std::endl;
+         }
+         if (thisIsEodMsg) sendBatch();
       }
 
-      else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-         // If we had an error serializing the DataRecord
-         std::cerr << "NetOutput::processRecordImp() -- SerializeToString() error" << std::endl;
-      }
+      else {
+         // Serialize the DataRecord
+         std::string wireFormat;
+         bool ok{dataRecord->SerializeToString(&wireFormat)};
 
-      // Check for END_OF_DATA message
-      thisIsEodMsg = (dataRecord->id() == REID_END_OF_DATA);
+         // Write the serialized message to the network
+         if (ok) {
+            netHandler->sendData( wireFormat.c_str(), static_cast<int>(wireFormat.length()) );
+         }
+
+         else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            // If we had an error serializing the DataRecord
+            std::cerr << "NetOutput::processRecordImp() -- SerializeToString() error" << std::endl;
+         }
+      }
 
    }
 
@@ -123,6 +154,35 @@ void NetOutput::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// Send the partial batch
+//------------------------------------------------------------------------------
+void NetOutput::flushImp()
+{
+   sendBatch();
+}
+
+
+//------------------------------------------------------------------------------
+// Compress and send the batch of records
+//------------------------------------------------------------------------------
+void NetOutput::sendBatch()
+{
+   if (batchUsed > 0) {
+      if (networkInitialized && netHandler->isConnected()) {
+         const std::size_t n{RecordFileFormat::compressBlock(batch.data(), batchUsed, compressed)};
+         const std::size_t m{sizeof(RecordFileFormat::BATCH_MAGIC)};
+         packet.resize(m + n);
+         std::memcpy(packet.data(), RecordFileFormat::BATCH_MAGIC, m);
+         std::memcpy(packet.data() + m, compressed.data(), n);
+         netHandler->sendData( packet.data(), static_cast<int>(packet.size()) );
+      }
+      batchUsed = 0;
+      deltaState.clear();
+   }
+}
+
+
 //------------------------------------------------------------------------------
 // Slot functions
 //------------------------------------------------------------------------------
@@ -145,6 +205,46 @@ bool NetOutput::setSlotNoWait(mixr::base::Boolean* const msg)
    return ok;
 }
 
+// Send compressed batches of records
+bool NetOutput::setSlotCompress(mixr::base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      compress = msg->asBool();
+      ok = true;
+   }
+   return ok;
+}
+
+// Uncompressed batch size (bytes)
+bool NetOutput::setSlotBatchSize(mixr::base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n >= static_cast<int>(MIN_BATCH_SIZE) && n <= static_cast<int>(RecordFileFormat::MAX_BATCH_SIZE)) {
+         batchSize = static_cast<std::size_t>(n);
+         ok = true;
+      }
+      else {
+         std::cerr << "NetOutput::setSlotBatchSize(): invalid batch size: " << n;
+         std::cerr << " -- valid sizes are [ " << MIN_BATCH_SIZE << " .. " << RecordFileFormat::MAX_BATCH_SIZE << " ] bytes" << std::endl;
+      }
+   }
+   return ok;
+}
+
+// Delta encode the player data
+bool NetOutput::setSlotDeltaEncoding(mixr::base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      deltaEncoding = msg->asBool();
+      ok = true;
+   }
+   return ok;
+}
+
 }
 }
 }
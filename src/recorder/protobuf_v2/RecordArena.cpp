@@ -0,0 +1,83 @@
+
+#include "mixr/recorder/protobuf_v2/RecordArena.hpp"
+#include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
+
+#include <google/protobuf/arena.h>
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+IMPLEMENT_SUBCLASS(RecordArena, "RecordArena")
+EMPTY_SLOTTABLE(RecordArena)
+
+RecordArena::RecordArena()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+void RecordArena::initData()
+{
+   google::protobuf::ArenaOptions options;
+   options.start_block_size = START_BLOCK_SIZE;
+   options.max_block_size = MAX_BLOCK_SIZE;
+   arena = new google::protobuf::Arena(options);
+}
+
+void RecordArena::copyData(const RecordArena& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   // (the records are not copied; a copy is a new, empty arena)
+   if (cc) initData();
+}
+
+void RecordArena::deleteData()
+{
+   if (arena != nullptr) { delete arena; arena = nullptr; }
+   setSharedArena(nullptr);
+}
+
+//------------------------------------------------------------------------------
+// Creates a new (empty) DataRecord on the arena
+//------------------------------------------------------------------------------
+proto::DataRecord* RecordArena::createRecord()
+{
+   return google::protobuf::Arena::CreateMessage<proto::DataRecord>(arena);
+}
+
+//------------------------------------------------------------------------------
+// Creates a new (empty) PlayerId on the arena
+//------------------------------------------------------------------------------
+proto::PlayerId* RecordArena::createPlayerId()
+{
+   return google::protobuf::Arena::CreateMessage<proto::PlayerId>(arena);
+}
+
+//------------------------------------------------------------------------------
+// Keeps the arena of the submessages shared by this arena's records; it's
+// released after this arena's records
+//------------------------------------------------------------------------------
+void RecordArena::setSharedArena(RecordArena* const x)
+{
+   if (x != nullptr) x->ref();
+   if (sharedArena != nullptr) sharedArena->unref();
+   sharedArena = x;
+}
+
+RecordArena* RecordArena::getSharedArena() const
+{
+   return sharedArena;
+}
+
+//------------------------------------------------------------------------------
+// Bytes allocated by the arena
+//------------------------------------------------------------------------------
+std::size_t RecordArena::getSpaceAllocated() const
+{
+   return static_cast<std::size_t>(arena->SpaceAllocated());
+}
+
+}
+}
+}
@@ -0,0 +1,973 @@
+
+#include "mixr/recorder/protobuf_v2/RecordExporter.hpp"
+#include "RecordExporterThread.hpp"
+
+#include "mixr/recorder/protobuf_v2/FileReader.hpp"
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+#include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
+
+#include "mixr/simulation/dataRecorderTokens.hpp"
+
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/String.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+IMPLEMENT_SUBCLASS(RecordExporter, "RecordExporter")
+
+BEGIN_SLOTTABLE(RecordExporter)
+   "filename",          // 1) Data file name
+   "pathname",          // 2) Path to the data file directory (optional)
+   "output",            // 3) Output file name prefix
+   "format",            // 4) Output format { csv, columns }
+   "numThreads",        // 5) Number of decoder threads
+   "players",           // 6) Export the player state table
+   "tracks",            // 7) Export the track table
+   "detonations",       // 8) Export the weapon detonation table
+   "player",            // 9) Only export the records of this player ID (optional)
+END_SLOTTABLE(RecordExporter)
+
+BEGIN_SLOT_MAP(RecordExporter)
+   ON_SLOT( 1, setSlotFilename,    base::String)
+   ON_SLOT( 2, setSlotPathName,    base::String)
+   ON_SLOT( 3, setSlotOutput,      base::String)
+   ON_SLOT( 4, setSlotFormat,      base::Identifier)
+   ON_SLOT( 5, setSlotNumThreads,  base::Integer)
+   ON_SLOT( 6, setSlotPlayers,     base::Boolean)
+   ON_SLOT( 7, setSlotTracks,      base::Boolean)
+   ON_SLOT( 8, setSlotDetonations, base::Boolean)
+   ON_SLOT( 9, setSlotPlayer,      base::Integer)
+END_SLOT_MAP()
+
+namespace {
+
+const double NaN{std::numeric_limits<double>::quiet_NaN()};
+
+using ColumnType = RecordExporter::ColumnType;
+
+const RecordExporter::Column playerColumns[] = {
+   { "sim_time",     ColumnType::FLOAT64 },
+   { "exec_time",    ColumnType::FLOAT64 },
+   { "utc_time",     ColumnType::FLOAT64 },
+   { "event",        ColumnType::UINT32 },
+   { "player_id",    ColumnType::UINT32 },
+   { "player_name",  ColumnType::UTF8 },
+   { "fed_name",     ColumnType::UTF8 },
+   { "pos_x",        ColumnType::FLOAT64 },
+   { "pos_y",        ColumnType::FLOAT64 },
+   { "pos_z",        ColumnType::FLOAT64 },
+   { "roll",         ColumnType::FLOAT64 },
+   { "pitch",        ColumnType::FLOAT64 },
+   { "yaw",          ColumnType::FLOAT64 },
+   { "vel_x",        ColumnType::FLOAT64 },
+   { "vel_y",        ColumnType::FLOAT64 },
+   { "vel_z",        ColumnType::FLOAT64 },
+   { "damage",       ColumnType::FLOAT64 },
+   { "alpha",        ColumnType::FLOAT64 },
+   { "beta",         ColumnType::FLOAT64 },
+   { "cas",          ColumnType::FLOAT64 },
+};
+
+const RecordExporter::Column trackColumns[] = {
+   { "sim_time",        ColumnType::FLOAT64 },
+   { "exec_time",       ColumnType::FLOAT64 },
+   { "utc_time",        ColumnType::FLOAT64 },
+   { "event",           ColumnType::UINT32 },
+   { "player_id",       ColumnType::UINT32 },
+   { "player_name",     ColumnType::UTF8 },
+   { "track_id",        ColumnType::UTF8 },
+   { "trk_player_id",   ColumnType::UINT32 },
+   { "trk_player_name", ColumnType::UTF8 },
+   { "type",            ColumnType::UINT32 },
+   { "quality",         ColumnType::FLOAT64 },
+   { "true_az",         ColumnType::FLOAT64 },
+   { "rel_az",          ColumnType::FLOAT64 },
+   { "elevation",       ColumnType::FLOAT64 },
+   { "range",           ColumnType::FLOAT64 },
+   { "latitude",        ColumnType::FLOAT64 },
+   { "longitude",       ColumnType::FLOAT64 },
+   { "altitude",        ColumnType::FLOAT64 },
+   { "avg_signal",      ColumnType::FLOAT64 },
+};
+
+const RecordExporter::Column detonationColumns[] = {
+   { "sim_time",     ColumnType::FLOAT64 },
+   { "exec_time",    ColumnType::FLOAT64 },
+   { "utc_time",     ColumnType::FLOAT64 },
+   { "wpn_id",       ColumnType::UINT32 },
+   { "wpn_name",     ColumnType::UTF8 },
+   { "shooter_id",   ColumnType::UINT32 },
+   { "shooter_name", ColumnType::UTF8 },
+   { "tgt_id",       ColumnType::UINT32 },
+   { "tgt_name",     ColumnType::UTF8 },
+   { "det_type",     ColumnType::UINT32 },
+   { "miss_dist",    ColumnType::FLOAT64 },
+   { "pos_x",        ColumnType::FLOAT64 },
+   { "pos_y",        ColumnType::FLOAT64 },
+   { "pos_z",        ColumnType::FLOAT64 },
+};
+
+const RecordExporter::Table tables[RecordExporter::NUM_TABLES] = {
+   { "players",      playerColumns,      sizeof(playerColumns) / sizeof(playerColumns[0]) },
+   { "tracks",       trackColumns,       sizeof(trackColumns) / sizeof(trackColumns[0]) },
+   { "detonations",  detonationColumns,  sizeof(detonationColumns) / sizeof(detonationColumns[0]) },
+};
+
+const char* typeName(const ColumnType type)
+{
+   const char* name{"utf8"};
+   if (type == ColumnType::FLOAT64) name = "float64";
+   else if (type == ColumnType::UINT32) name = "uint32";
+   return name;
+}
+
+}
+
+RecordExporter::RecordExporter()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void RecordExporter::copyData(const RecordExporter& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   filename = org.filename;
+   pathname = org.pathname;
+   output = org.output;
+   format = org.format;
+   numThreads = org.numThreads;
+   for (unsigned int t = 0; t < NUM_TABLES; t++) {
+      tableEnabled[t] = org.tableEnabled[t];
+      numRows[t] = 0;
+   }
+   playerFilter = org.playerFilter;
+   playerFilterFlg = org.playerFilterFlg;
+   numErrors = 0;
+}
+
+void RecordExporter::deleteData()
+{
+   clearThreads();
+   closeOutput();
+   units.clear();
+}
+
+//------------------------------------------------------------------------------
+// Get functions
+//------------------------------------------------------------------------------
+const RecordExporter::Table& RecordExporter::getTable(const unsigned int t)
+{
+   return tables[t < NUM_TABLES ? t : 0];
+}
+
+std::size_t RecordExporter::getNumRows(const unsigned int t) const
+{
+   return (t < NUM_TABLES ? numRows[t] : 0);
+}
+
+//------------------------------------------------------------------------------
+// Export the data file
+//------------------------------------------------------------------------------
+bool RecordExporter::exportFile()
+{
+   numErrors = 0;
+   for (unsigned int t = 0; t < NUM_TABLES; t++) numRows[t] = 0;
+   units.clear();
+   nextUnit = 0;
+   unitsWritten = 0;
+
+   if (filename.empty() || output.empty()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RecordExporter::exportFile(): the data file name and the output name are required" << std::endl;
+      }
+      return false;
+   }
+   fullname = (pathname.empty() ? filename : pathname + "/" + filename);
+
+   // ---
+   // Read the data file's index and make the units of work, one for each index
+   // block (with a player filter, only the blocks with the player's records),
+   // and one for the unindexed records of a file that wasn't closed
+   // ---
+   bool ok{};
+   {
+      const auto reader = new FileReader();
+      {
+         const auto s = new base::String(filename.c_str());
+         reader->setFilename(s);
+         s->unref();
+      }
+      if (!pathname.empty()) {
+         const auto s = new base::String(pathname.c_str());
+         reader->setPathName(s);
+         s->unref();
+      }
+
+      ok = reader->openFile() && reader->isOpen() && !reader->isFailed();
+      if (ok && !reader->isIndexed()) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "RecordExporter::exportFile(): " << fullname;
+            std::cerr << " is not an indexed data file; convert it first (see FileWriter::convert())" << std::endl;
+         }
+         ok = false;
+      }
+      else if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RecordExporter::exportFile(): unable to open the data file: " << fullname << std::endl;
+      }
+
+      if (ok) {
+         const std::size_t numBlocks{reader->getNumIndexBlocks()};
+         units.reserve(numBlocks + 1);
+         for (std::size_t b = 0; b < numBlocks; b++) {
+            const FileReader::IndexBlock& blk{reader->getIndexBlock(b)};
+            if (blk.numRecs > 0 && (!playerFilterFlg || reader->hasPlayerRecords(playerFilter, b))) {
+               Unit unit;
+               unit.begin = blk.firstOffset;
+               unit.last = blk.lastOffset;
+               unit.innerFirst = blk.firstInner;
+               unit.innerLast = blk.lastInner;
+               units.push_back(std::move(unit));
+            }
+         }
+         dataEnd = reader->getDataEnd();
+         if (reader->getTailOffset() < dataEnd) {
+            Unit unit;
+            unit.begin = reader->getTailOffset();
+            unit.last = dataEnd;
+            unit.tail = true;
+            units.push_back(std::move(unit));
+         }
+      }
+
+      reader->closeFile();
+      reader->unref();
+   }
+
+   // ---
+   // Open the output files
+   // ---
+   if (ok) ok = openOutput();
+
+   // ---
+   // Start the decoder threads
+   // ---
+   if (ok && !units.empty()) {
+      std::size_t n{numThreads};
+      if (n == 0) n = static_cast<std::size_t>(RecordExporterThread::getNumProcessors());
+      if (n == 0) n = 1;
+      if (n > units.size()) n = units.size();
+      maxAhead = MAX_UNITS_AHEAD * n;
+
+      for (std::size_t i = 0; i < n; i++) {
+         base::lock(unitLock);
+         numRunning++;
+         base::unlock(unitLock);
+
+         const auto thread = new RecordExporterThread(this);
+         if (thread->start(0.0)) threads.push_back(thread);
+         else {
+            thread->unref();
+            base::lock(unitLock);
+            numRunning--;
+            base::unlock(unitLock);
+         }
+      }
+      if (threads.empty()) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "RecordExporter::exportFile(): ERROR, failed to create the decoder threads!" << std::endl;
+         }
+         ok = false;
+      }
+   }
+
+   // ---
+   // Write the units, in order, as they're decoded
+   // ---
+   if (ok) {
+      bool writeOk{true};
+      while (unitsWritten < units.size()) {
+         base::lock(unitLock);
+         const bool ready{units[unitsWritten].done};
+         base::unlock(unitLock);
+
+         if (ready) {
+            Unit& unit{units[unitsWritten]};
+            if (writeOk) writeOk = writeUnit(unit);
+            numErrors += unit.errors;
+            for (unsigned int t = 0; t < NUM_TABLES; t++) unit.tables[t] = TableBuffer();
+
+            base::lock(unitLock);
+            unitsWritten++;
+            base::unlock(unitLock);
+         }
+         else {
+            base::msleep(1);
+         }
+      }
+
+      if (!writeOk && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RecordExporter::exportFile(): error writing the output files: " << output << std::endl;
+      }
+      if (numErrors > 0 && isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "RecordExporter::exportFile(): " << numErrors << " bad chunks or records were skipped" << std::endl;
+      }
+      ok = writeOk;
+   }
+
+   // Wait for the decoder threads
+   clearThreads();
+
+   if (ok && format == Format::COLUMNS) ok = writeSchemas();
+   closeOutput();
+   units.clear();
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Wait for the decoder threads to finish and release them
+//------------------------------------------------------------------------------
+void RecordExporter::clearThreads()
+{
+   // (a thread that finishes while it's being started may not be flagged as
+   // terminated, so we wait for the decoders to return from decodeUnits())
+   bool running{true};
+   while (running) {
+      base::lock(unitLock);
+      running = (numRunning > 0);
+      base::unlock(unitLock);
+      if (running) base::msleep(1);
+   }
+   for (const auto thread : threads) {
+      thread->unref();
+   }
+   threads.clear();
+}
+
+//------------------------------------------------------------------------------
+// Output files
+//------------------------------------------------------------------------------
+bool RecordExporter::openOutput()
+{
+   bool ok{true};
+   for (unsigned int t = 0; ok && t < NUM_TABLES; t++) {
+      if (tableEnabled[t]) {
+         const Table& table{tables[t]};
+         const std::string prefix{output + "_" + table.name};
+
+         if (format == Format::CSV) {
+            const auto f = new std::ofstream(prefix + ".csv", std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+            files[t].push_back(f);
+            for (std::size_t c = 0; c < table.numColumns; c++) {
+               if (c > 0) *f << ',';
+               *f << table.columns[c].name;
+            }
+            *f << '\n';
+            ok = !f->fail();
+         }
+         else {
+            stringBytes[t].assign(table.numColumns, 0);
+            for (std::size_t c = 0; ok && c < table.numColumns; c++) {
+               const std::string name{prefix + "." + table.columns[c].name};
+               const auto f = new std::ofstream(name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+               files[t].push_back(f);
+               ok = !f->fail();
+               std::ofstream* g{};
+               if (table.columns[c].type == ColumnType::UTF8) {
+                  g = new std::ofstream(name + ".offsets", std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+                  ok = ok && !g->fail();
+               }
+               files[t].push_back(g);
+            }
+         }
+
+         if (!ok && isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "RecordExporter::openOutput(): unable to create the output files: " << prefix << std::endl;
+         }
+      }
+   }
+   return ok;
+}
+
+void RecordExporter::closeOutput()
+{
+   for (unsigned int t = 0; t < NUM_TABLES; t++) {
+      for (const auto f : files[t]) {
+         if (f != nullptr) {
+            f->close();
+            delete f;
+         }
+      }
+      files[t].clear();
+      stringBytes[t].clear();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Write a decoded unit's rows to the output files
+//------------------------------------------------------------------------------
+bool RecordExporter::writeUnit(Unit& unit)
+{
+   bool ok{true};
+   for (unsigned int t = 0; t < NUM_TABLES; t++) {
+      const TableBuffer& buff{unit.tables[t]};
+      if (tableEnabled[t] && buff.rows > 0) {
+
+         if (format == Format::CSV) {
+            files[t][0]->write(buff.csv.data(), buff.csv.size());
+            ok = ok && !files[t][0]->fail();
+         }
+         else {
+            for (std::size_t c = 0; c < buff.data.size(); c++) {
+               std::ofstream* const f{files[t][2 * c]};
+               f->write(buff.data[c].data(), buff.data[c].size());
+               ok = ok && !f->fail();
+
+               // string offsets: from the start of the column's file
+               std::ofstream* const g{files[t][2 * c + 1]};
+               if (g != nullptr) {
+                  const std::vector<std::uint64_t>& offsets{buff.offsets[c]};
+                  std::vector<unsigned char> tmp(offsets.size() * 8);
+                  for (std::size_t i = 0; i < offsets.size(); i++) {
+                     RecordFileFormat::putUint64(&tmp[i * 8], stringBytes[t][c] + offsets[i]);
+                  }
+                  g->write(reinterpret_cast<const char*>(tmp.data()), tmp.size());
+                  ok = ok && !g->fail();
+                  stringBytes[t][c] += buff.data[c].size();
+               }
+            }
+         }
+         numRows[t] += buff.rows;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Write the tables' schema files (columns format)
+//------------------------------------------------------------------------------
+bool RecordExporter::writeSchemas()
+{
+   bool ok{true};
+   for (unsigned int t = 0; t < NUM_TABLES; t++) {
+      if (tableEnabled[t]) {
+         const Table& table{tables[t]};
+         std::ofstream f(output + "_" + table.name + ".schema", std::ios_base::out | std::ios_base::trunc);
+         f << "rows " << numRows[t] << '\n';
+         for (std::size_t c = 0; c < table.numColumns; c++) {
+            f << table.columns[c].name << ' ' << typeName(table.columns[c].type) << '\n';
+         }
+         ok = ok && !f.fail();
+      }
+   }
+   return ok;
+}
+
+
+//------------------------------------------------------------------------------
+// Decoder threads: decode the next unit (in the file's order), while the
+// writer isn't too far behind, until they're all done
+//------------------------------------------------------------------------------
+void RecordExporter::decodeUnits()
+{
+   Decoder dec;
+   dec.sin.open(fullname, std::ios_base::in | std::ios_base::binary);
+   dec.record = new proto::DataRecord();
+
+   bool finished{};
+   while (!finished) {
+      std::size_t u{};
+      bool wait{};
+      base::lock(unitLock);
+      if (nextUnit >= units.size()) finished = true;
+      else if (nextUnit >= (unitsWritten + maxAhead)) wait = true;
+      else u = nextUnit++;
+      base::unlock(unitLock);
+
+      if (wait) {
+         base::msleep(1);
+      }
+      else if (!finished) {
+         decodeUnit(dec, units[u]);
+         base::lock(unitLock);
+         units[u].done = true;
+         base::unlock(unitLock);
+      }
+   }
+
+   delete dec.record;
+
+   base::lock(unitLock);
+   numRunning--;
+   base::unlock(unitLock);
+}
+
+//------------------------------------------------------------------------------
+// Decode (read, decompress and parse) and export the records of a unit
+//------------------------------------------------------------------------------
+void RecordExporter::decodeUnit(Decoder& dec, Unit& unit)
+{
+   RecordFileFormat::DeltaState delta;
+   std::uint64_t pos{unit.begin};
+   dec.sin.clear();
+   dec.sin.seekg(pos);
+
+   // the unit's chunks are the chunks that start at, or before, its last chunk
+   bool ok{!dec.sin.fail()};
+   while (ok && pos <= unit.last && pos < dataEnd) {
+      const std::uint64_t offset{pos};
+      unsigned char type{};
+      ok = readChunk(dec, &pos, &type);
+
+      if (!ok) {
+         // (a partial chunk is the end of a file that wasn't closed)
+         if (!unit.tail) unit.errors++;
+      }
+
+      else if (type == RecordFileFormat::RECORD_CHUNK) {
+         if (RecordFileFormat::parseRecord(type, dec.chunk.data(), dec.chunk.size(), delta, dec.record)) {
+            exportRecord(*dec.record, unit);
+         }
+         else unit.errors++;
+      }
+
+      else if (type == RecordFileFormat::BLOCK_CHUNK) {
+         if (RecordFileFormat::decompressBlock(dec.chunk.data(), dec.chunk.size(), dec.block)) {
+            // A block can be shared with the previous or the next unit; its
+            // records before ours are only decoded (delta encoding), and the
+            // records after ours are the next unit's
+            const std::size_t first{(!unit.tail && offset == unit.begin) ? unit.innerFirst : 0};
+            const std::size_t last{(!unit.tail && offset == unit.last) ? unit.innerLast : dec.block.size()};
+            delta.clear();
+            std::size_t bpos{};
+            bool bok{true};
+            while (bok && bpos < dec.block.size() && bpos <= last) {
+               const std::size_t inner{bpos};
+               unsigned char rtype{};
+               const char* payload{};
+               std::size_t n{};
+               bok = RecordFileFormat::getChunk(dec.block.data(), dec.block.size(), &bpos, &rtype, &payload, &n) &&
+                     RecordFileFormat::parseRecord(rtype, payload, n, delta, dec.record);
+               if (!bok) unit.errors++;
+               else if (inner >= first) exportRecord(*dec.record, unit);
+            }
+         }
+         else unit.errors++;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Read the chunk at 'pos' (the stream's position); moves 'pos' to the next chunk
+//------------------------------------------------------------------------------
+bool RecordExporter::readChunk(Decoder& dec, std::uint64_t* const pos, unsigned char* const type)
+{
+   unsigned char hdr[RecordFileFormat::MAX_CHUNK_HEADER]{};
+   std::size_t h{};
+   int c{};
+   do {
+      c = dec.sin.get();
+      if (c == std::ifstream::traits_type::eof()) return false;
+      hdr[h++] = static_cast<unsigned char>(c);
+   } while ((h == 1 || (c & 0x80) != 0) && h < RecordFileFormat::MAX_CHUNK_HEADER);
+
+   std::uint64_t size{};
+   const unsigned char* p{hdr + 1};
+   bool ok{RecordFileFormat::getVarint(&p, hdr + h, &size) && (*pos + h + size) <= dataEnd};
+   if (ok) {
+      dec.chunk.resize(static_cast<std::size_t>(size));
+      dec.sin.read(dec.chunk.data(), size);
+      ok = !dec.sin.fail();
+   }
+   if (ok) {
+      *type = hdr[0];
+      *pos += (h + size);
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Export a record to its table (if it's one of the tables' records, its
+// table is enabled and it passes the player filter)
+//------------------------------------------------------------------------------
+void RecordExporter::exportRecord(const proto::DataRecord& record, Unit& unit)
+{
+   if (playerFilterFlg) {
+      unsigned int id{};
+      if (!RecordFileFormat::getPlayerId(record, &id) || id != playerFilter) return;
+   }
+
+   const bool players{tableEnabled[PLAYERS_TABLE]};
+   const bool tracks{tableEnabled[TRACKS_TABLE]};
+   TableBuffer& pt{unit.tables[PLAYERS_TABLE]};
+   TableBuffer& tt{unit.tables[TRACKS_TABLE]};
+
+   switch (record.id()) {
+      case REID_NEW_PLAYER: {
+         if (players) {
+            const proto::NewPlayerEventMsg& msg{record.new_player_event_msg()};
+            putPlayerRow(pt, record, msg.id(), &msg.state(), nullptr);
+         }
+         break;
+      }
+      case REID_PLAYER_REMOVED: {
+         if (players) {
+            const proto::PlayerRemovedEventMsg& msg{record.player_removed_event_msg()};
+            putPlayerRow(pt, record, msg.id(), (msg.has_state() ? &msg.state() : nullptr), nullptr);
+         }
+         break;
+      }
+      case REID_PLAYER_DATA: {
+         if (players) {
+            const proto::PlayerDataMsg& msg{record.player_data_msg()};
+            putPlayerRow(pt, record, msg.id(), &msg.state(), &msg);
+         }
+         break;
+      }
+      case REID_NEW_TRACK: {
+         if (tracks) {
+            const proto::NewTrackEventMsg& msg{record.new_track_event_msg()};
+            putTrackRow(tt, record, msg.player_id(), msg.track_id(),
+                        (msg.has_trk_player_id() ? &msg.trk_player_id() : nullptr),
+                        (msg.has_track_data() ? &msg.track_data() : nullptr));
+         }
+         break;
+      }
+      case REID_TRACK_REMOVED: {
+         if (tracks) {
+            const proto::TrackRemovedEventMsg& msg{record.track_removed_event_msg()};
+            putTrackRow(tt, record, msg.player_id(), msg.track_id(), nullptr, nullptr);
+         }
+         break;
+      }
+      case REID_TRACK_DATA: {
+         if (tracks) {
+            const proto::TrackDataMsg& msg{record.track_data_msg()};
+            putTrackRow(tt, record, msg.player_id(), msg.track_id(),
+                        (msg.has_trk_player_id() ? &msg.trk_player_id() : nullptr),
+                        (msg.has_track_data() ? &msg.track_data() : nullptr));
+         }
+         break;
+      }
+      case REID_WEAPON_DETONATION: {
+         if (tableEnabled[DETONATIONS_TABLE]) {
+            putDetonationRow(unit.tables[DETONATIONS_TABLE], record, record.weapon_detonation_event_msg());
+         }
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Table rows
+//------------------------------------------------------------------------------
+void RecordExporter::putPlayerRow(TableBuffer& t, const proto::DataRecord& record, const proto::PlayerId& id,
+                                  const proto::PlayerState* const state, const proto::PlayerDataMsg* const data)
+{
+   beginRow(t, PLAYERS_TABLE);
+   putTime(t, record);
+   putUint(t, record.id());
+   putPlayerId(t, &id);
+   putString(t, id.fed_name());
+   if (state != nullptr) {
+      putVector(t, true, state->pos().x(), state->pos().y(), state->pos().z());
+      putVector(t, true, state->angles().x(), state->angles().y(), state->angles().z());
+      putVector(t, state->has_vel(), state->vel().x(), state->vel().y(), state->vel().z());
+      putDouble(t, state->has_damage() ? state->damage() : NaN);
+   }
+   else {
+      for (unsigned int i = 0; i < 3; i++) putVector(t, false, 0, 0, 0);
+      putDouble(t, NaN);
+   }
+   putDouble(t, (data != nullptr && data->has_alpha()) ? data->alpha() : NaN);
+   putDouble(t, (data != nullptr && data->has_beta()) ? data->beta() : NaN);
+   putDouble(t, (data != nullptr && data->has_cas()) ? data->cas() : NaN);
+   endRow(t);
+}
+
+void RecordExporter::putTrackRow(TableBuffer& t, const proto::DataRecord& record, const proto::PlayerId& id,
+                                 const std::string& trackId, const proto::PlayerId* const trkId, const proto::TrackData* const data)
+{
+   beginRow(t, TRACKS_TABLE);
+   putTime(t, record);
+   putUint(t, record.id());
+   putPlayerId(t, &id);
+   putString(t, trackId);
+   putPlayerId(t, trkId);
+   if (data != nullptr) {
+      putUint(t, data->type());
+      putDouble(t, data->has_quality() ? data->quality() : NaN);
+      putDouble(t, data->has_true_az() ? data->true_az() : NaN);
+      putDouble(t, data->has_rel_az() ? data->rel_az() : NaN);
+      putDouble(t, data->has_elevation() ? data->elevation() : NaN);
+      putDouble(t, data->has_range() ? data->range() : NaN);
+      putDouble(t, data->has_latitude() ? data->latitude() : NaN);
+      putDouble(t, data->has_longitude() ? data->longitude() : NaN);
+      putDouble(t, data->has_altitude() ? data->altitude() : NaN);
+      putDouble(t, data->has_avg_signal() ? data->avg_signal() : NaN);
+   }
+   else {
+      putUint(t, 0);
+      for (unsigned int i = 0; i < 9; i++) putDouble(t, NaN);
+   }
+   endRow(t);
+}
+
+void RecordExporter::putDetonationRow(TableBuffer& t, const proto::DataRecord& record, const proto::WeaponDetonationEventMsg& msg)
+{
+   beginRow(t, DETONATIONS_TABLE);
+   putTime(t, record);
+   putPlayerId(t, &msg.wpn_id());
+   putPlayerId(t, msg.has_shooter_id() ? &msg.shooter_id() : nullptr);
+   putPlayerId(t, msg.has_tgt_id() ? &msg.tgt_id() : nullptr);
+   putUint(t, msg.det_type());
+   putDouble(t, msg.has_miss_dist() ? msg.miss_dist() : NaN);
+   const proto::PlayerState& state{msg.wpn_state()};
+   putVector(t, msg.has_wpn_state(), state.pos().x(), state.pos().y(), state.pos().z());
+   endRow(t);
+}
+
+void RecordExporter::putTime(TableBuffer& t, const proto::DataRecord& record)
+{
+   const proto::Time& time{record.time()};
+   putDouble(t, time.sim_time());
+   putDouble(t, time.has_exec_time() ? time.exec_time() : NaN);
+   putDouble(t, time.has_utc_time() ? time.utc_time() : NaN);
+}
+
+void RecordExporter::putPlayerId(TableBuffer& t, const proto::PlayerId* const id)
+{
+   if (id != nullptr) {
+      putUint(t, id->id());
+      putString(t, id->name());
+   }
+   else {
+      putUint(t, 0);
+      putString(t, std::string());
+   }
+}
+
+void RecordExporter::putVector(TableBuffer& t, const bool valid, const double x, const double y, const double z)
+{
+   putDouble(t, valid ? x : NaN);
+   putDouble(t, valid ? y : NaN);
+   putDouble(t, valid ? z : NaN);
+}
+
+//------------------------------------------------------------------------------
+// Row values; CSV text or little-endian column data
+//------------------------------------------------------------------------------
+void RecordExporter::beginRow(TableBuffer& t, const unsigned int table)
+{
+   if (format == Format::COLUMNS && t.data.empty()) {
+      t.data.resize(tables[table].numColumns);
+      t.offsets.resize(tables[table].numColumns);
+   }
+   t.col = 0;
+}
+
+void RecordExporter::putDouble(TableBuffer& t, const double v)
+{
+   if (format == Format::CSV) {
+      // shortest text that reads back as the same value; NaN is empty
+      if (!std::isnan(v)) {
+         char buff[32]{};
+         const std::to_chars_result r{std::to_chars(buff, buff + sizeof(buff), v)};
+         t.csv.append(buff, r.ptr);
+      }
+      t.csv.push_back(',');
+   }
+   else {
+      std::vector<char>& d{t.data[t.col]};
+      const std::size_t n{d.size()};
+      d.resize(n + 8);
+      RecordFileFormat::putDouble(reinterpret_cast<unsigned char*>(&d[n]), v);
+   }
+   t.col++;
+}
+
+void RecordExporter::putUint(TableBuffer& t, const std::uint32_t v)
+{
+   if (format == Format::CSV) {
+      char buff[16]{};
+      const std::to_chars_result r{std::to_chars(buff, buff + sizeof(buff), v)};
+      t.csv.append(buff, r.ptr);
+      t.csv.push_back(',');
+   }
+   else {
+      std::vector<char>& d{t.data[t.col]};
+      for (unsigned int i = 0; i < 4; i++) d.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+   }
+   t.col++;
+}
+
+void RecordExporter::putString(TableBuffer& t, const std::string& v)
+{
+   if (format == Format::CSV) {
+      // quoted, if needed
+      if (v.find_first_of(",\"\r\n") == std::string::npos) {
+         t.csv.append(v);
+      }
+      else {
+         t.csv.push_back('"');
+         for (const char c : v) {
+            if (c == '"') t.csv.push_back('"');
+            t.csv.push_back(c);
+         }
+         t.csv.push_back('"');
+      }
+      t.csv.push_back(',');
+   }
+   else {
+      std::vector<char>& d{t.data[t.col]};
+      d.insert(d.end(), v.begin(), v.end());
+      t.offsets[t.col].push_back(d.size());
+   }
+   t.col++;
+}
+
+void RecordExporter::endRow(TableBuffer& t)
+{
+   if (format == Format::CSV) t.csv.back() = '\n';
+   t.rows++;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool RecordExporter::setFilename(const base::String* const msg)
+{
+   filename = (msg != nullptr ? msg->c_str() : "");
+   return true;
+}
+
+bool RecordExporter::setPathName(const base::String* const msg)
+{
+   pathname = (msg != nullptr ? msg->c_str() : "");
+   return true;
+}
+
+bool RecordExporter::setOutput(const base::String* const msg)
+{
+   output = (msg != nullptr ? msg->c_str() : "");
+   return true;
+}
+
+bool RecordExporter::setFormat(const Format x)
+{
+   format = x;
+   return true;
+}
+
+bool RecordExporter::setNumThreads(const unsigned int n)
+{
+   numThreads = n;
+   return true;
+}
+
+bool RecordExporter::setTableEnabled(const unsigned int t, const bool f)
+{
+   bool ok{};
+   if (t < NUM_TABLES) {
+      tableEnabled[t] = f;
+      ok = true;
+   }
+   return ok;
+}
+
+bool RecordExporter::setPlayerFilter(const unsigned int id)
+{
+   playerFilter = id;
+   playerFilterFlg = true;
+   return true;
+}
+
+bool RecordExporter::clearPlayerFilter()
+{
+   playerFilterFlg = false;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool RecordExporter::setSlotFormat(const base::Identifier* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      if (*msg == "csv") ok = setFormat(Format::CSV);
+      else if (*msg == "columns") ok = setFormat(Format::COLUMNS);
+
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "RecordExporter::setSlotFormat(): Invalid output format: " << msg->asString();
+         std::cerr << ", specify one of the following identifiers: { csv, columns }" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RecordExporter::setSlotNumThreads(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      if (n >= 0) {
+         ok = setNumThreads(static_cast<unsigned int>(n));
+      } else {
+         std::cerr << "RecordExporter::setSlotNumThreads(): Number of threads is invalid; must be zero or greater." << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool RecordExporter::setSlotPlayers(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) ok = setTableEnabled(PLAYERS_TABLE, msg->asBool());
+   return ok;
+}
+
+bool RecordExporter::setSlotTracks(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) ok = setTableEnabled(TRACKS_TABLE, msg->asBool());
+   return ok;
+}
+
+bool RecordExporter::setSlotDetonations(const base::Boolean* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) ok = setTableEnabled(DETONATIONS_TABLE, msg->asBool());
+   return ok;
+}
+
+bool RecordExporter::setSlotPlayer(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int id{msg->asInt()};
+      if (id >= 0) {
+         ok = setPlayerFilter(static_cast<unsigned int>(id));
+      } else {
+         std::cerr << "RecordExporter::setSlotPlayer(): Player ID is invalid; must be zero or greater." << std::endl;
+      }
+   }
+   return ok;
+}
+
+}
+}
+}
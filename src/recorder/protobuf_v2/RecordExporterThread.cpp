@@ -0,0 +1,23 @@
+
+#include "RecordExporterThread.hpp"
+
+#include "mixr/recorder/protobuf_v2/RecordExporter.hpp"
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+RecordExporterThread::RecordExporterThread(base::IComponent* const parent): base::IOneShotThread(parent)
+{
+}
+
+unsigned long RecordExporterThread::userFunc()
+{
+   RecordExporter* exporter{static_cast<RecordExporter*>(getParent())};
+   exporter->decodeUnits();
+   return 0;
+}
+
+}
+}
+}
@@ -0,0 +1,24 @@
+
+#ifndef __mixr_recorder_protobuf_v2_RecordExporterThread_HPP__
+#define __mixr_recorder_protobuf_v2_RecordExporterThread_HPP__
+
+#include "mixr/base/threads/IOneShotThread.hpp"
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+// ---
+// Record exporter's decoder thread
+// ---
+class RecordExporterThread final : public base::IOneShotThread
+{
+   public: RecordExporterThread(base::IComponent* const parent);
+   private: unsigned long userFunc() final;
+};
+
+}
+}
+}
+
+#endif
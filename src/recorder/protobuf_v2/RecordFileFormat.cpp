@@ -0,0 +1,509 @@
+
+#include "mixr/recorder/protobuf_v2/RecordFileFormat.hpp"
+#include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
+
+#include "mixr/base/util/compress_utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+const char RecordFileFormat::MAGIC[8]{'M', 'I', 'X', 'R', 'R', 'E', 'C', '\0'};
+const char RecordFileFormat::TRAILER_MAGIC[8]{'M', 'I', 'X', 'R', 'I', 'D', 'X', '\0'};
+const char RecordFileFormat::BATCH_MAGIC[4]{'M', 'X', 'R', 'B'};
+
+namespace {
+
+// Encodes the value as the difference between its bits, as an integer, and
+// those of the previous sample (or decodes it), and replaces the previous
+// sample with the value.  The bits of close values of the same sign and
+// exponent have the same high bytes, so the difference's high bytes are zeros
+// (or ones).
+double deltaValue(const double v, double* const prev, const bool encode)
+{
+   std::uint64_t a{}, b{};
+   std::memcpy(&a, &v, sizeof(a));
+   std::memcpy(&b, prev, sizeof(b));
+   a = (encode ? a - b : a + b);
+   double r{};
+   std::memcpy(&r, &a, sizeof(r));
+   *prev = (encode ? v : r);
+   return r;
+}
+
+void deltaVector(proto::Vector* const v, double* const prev, const bool encode)
+{
+   v->set_x(deltaValue(v->x(), &prev[0], encode));
+   v->set_y(deltaValue(v->y(), &prev[1], encode));
+   if (v->has_z()) v->set_z(deltaValue(v->z(), &prev[2], encode));
+}
+
+// Delta encodes (or decodes) the player data fields: position, angles and
+// velocity (x, y and z), and alpha, beta and cas
+bool deltaPlayerData(proto::DataRecord* const record, RecordFileFormat::DeltaState& delta, const bool encode)
+{
+   if (!record->has_player_data_msg()) return false;
+   proto::PlayerDataMsg* const msg{record->mutable_player_data_msg()};
+   if (!msg->has_id() || !msg->has_state() || !msg->state().has_pos() || !msg->state().has_angles()) return false;
+
+   // previous sample (or zeros)
+   double* const prev{delta[msg->id().id()].data()};
+
+   proto::PlayerState* const state{msg->mutable_state()};
+   deltaVector(state->mutable_pos(), &prev[0], encode);
+   deltaVector(state->mutable_angles(), &prev[3], encode);
+   if (state->has_vel()) deltaVector(state->mutable_vel(), &prev[6], encode);
+   if (msg->has_alpha()) msg->set_alpha(deltaValue(msg->alpha(), &prev[9], encode));
+   if (msg->has_beta()) msg->set_beta(deltaValue(msg->beta(), &prev[10], encode));
+   if (msg->has_cas()) msg->set_cas(deltaValue(msg->cas(), &prev[11], encode));
+   return true;
+}
+
+// ---
+// Delta encoding of a serialized player data record, in place: the player
+// data fields are doubles, which are serialized as 8 byte, little-endian
+// (fixed64) values, so their delta encoded values have the same size.
+// ---
+
+// Field numbers (see DataRecord.proto)
+const std::uint32_t PLAYER_DATA_MSG_FIELD{33};    // DataRecord
+const std::uint32_t STATE_FIELD{2};               // PlayerDataMsg
+const std::uint32_t ALPHA_FIELD{3};
+const std::uint32_t BETA_FIELD{4};
+const std::uint32_t CAS_FIELD{5};
+const std::uint32_t POS_FIELD{1};                 // PlayerState
+const std::uint32_t ANGLES_FIELD{2};
+const std::uint32_t VEL_FIELD{3};
+
+const unsigned int FIXED64_WIRE_TYPE{1};
+const unsigned int LENGTH_WIRE_TYPE{2};
+
+// Calls f(field number, wire type, value, end of value) for each field of the
+// serialized message [p, end); returns false if it's malformed or f() fails
+template <typename F>
+bool walkFields(const unsigned char* p, const unsigned char* const end, F f)
+{
+   while (p < end) {
+      std::uint64_t tag{};
+      if (!RecordFileFormat::getVarint(&p, end, &tag)) return false;
+      const unsigned int type{static_cast<unsigned int>(tag & 7)};
+      std::uint64_t len{};
+      switch (type) {
+         case 0:  if (!RecordFileFormat::getVarint(&p, end, &len)) return false;      // varint (skipped)
+                  len = 0;
+                  break;
+         case FIXED64_WIRE_TYPE:  len = 8;  break;
+         case LENGTH_WIRE_TYPE:   if (!RecordFileFormat::getVarint(&p, end, &len)) return false;  break;
+         case 5:  len = 4;  break;                                                    // fixed32
+         default: return false;                                                       // (groups aren't used)
+      }
+      if (len > static_cast<std::uint64_t>(end - p)) return false;
+      if (!f(static_cast<std::uint32_t>(tag >> 3), type, p, p + len)) return false;
+      p += len;
+   }
+   return true;
+}
+
+// A player data field of a serialized record
+struct DeltaField {
+   std::size_t offset{};      // Offset of the (fixed64) value
+   std::size_t k{};           // Index of the previous sample
+};
+
+// Finds the player data fields of the serialized record [data, data + n), which
+// deltaPlayerData() encodes; returns the number of fields, or zero if it's malformed
+std::size_t findDeltaFields(const unsigned char* const data, const std::size_t n, std::array<DeltaField, RecordFileFormat::NUM_DELTA_FIELDS>& fields)
+{
+   std::size_t num{};
+   const auto add = [&](const unsigned char* const p, const std::size_t k) {
+      if (num < fields.size()) fields[num++] = DeltaField{static_cast<std::size_t>(p - data), k};
+   };
+
+   // Vector x, y and z
+   const auto vector = [&](const unsigned char* const p, const unsigned char* const end, const std::size_t k) {
+      return walkFields(p, end, [&](const std::uint32_t field, const unsigned int type, const unsigned char* const v, const unsigned char*) {
+         if (type == FIXED64_WIRE_TYPE && field >= 1 && field <= 3) add(v, k + field - 1);
+         return true;
+      });
+   };
+
+   // PlayerState pos, angles and vel
+   const auto state = [&](const unsigned char* const p, const unsigned char* const end) {
+      return walkFields(p, end, [&](const std::uint32_t field, const unsigned int type, const unsigned char* const v, const unsigned char* const vend) {
+         if (type != LENGTH_WIRE_TYPE) return true;
+         if (field == POS_FIELD) return vector(v, vend, 0);
+         if (field == ANGLES_FIELD) return vector(v, vend, 3);
+         if (field == VEL_FIELD) return vector(v, vend, 6);
+         return true;
+      });
+   };
+
+   // PlayerDataMsg state, alpha, beta and cas
+   const auto playerData = [&](const unsigned char* const p, const unsigned char* const end) {
+      return walkFields(p, end, [&](const std::uint32_t field, const unsigned int type, const unsigned char* const v, const unsigned char* const vend) {
+         if (type == LENGTH_WIRE_TYPE && field == STATE_FIELD) return state(v, vend);
+         if (type == FIXED64_WIRE_TYPE && field == ALPHA_FIELD) add(v, 9);
+         if (type == FIXED64_WIRE_TYPE && field == BETA_FIELD) add(v, 10);
+         if (type == FIXED64_WIRE_TYPE && field == CAS_FIELD) add(v, 11);
+         return true;
+      });
+   };
+
+   const bool ok{walkFields(data, data + n, [&](const std::uint32_t field, const unsigned int type, const unsigned char* const v, const unsigned char* const vend) {
+      if (type == LENGTH_WIRE_TYPE && field == PLAYER_DATA_MSG_FIELD) return playerData(v, vend);
+      return true;
+   })};
+   return (ok ? num : 0);
+}
+
+// Delta encodes the player data of the serialized REID_PLAYER_DATA 'record', which
+// is at [data, data + n), in place (see deltaPlayerData()); returns false if it's
+// not a player data record (and it's left as is)
+bool deltaEncodeSerialized(const proto::DataRecord& record, unsigned char* const data, const std::size_t n, RecordFileFormat::DeltaState& delta)
+{
+   if (!record.has_player_data_msg()) return false;
+   const proto::PlayerDataMsg& msg{record.player_data_msg()};
+   if (!msg.has_id() || !msg.has_state() || !msg.state().has_pos() || !msg.state().has_angles()) return false;
+
+   // (deltaVector() sets a missing x or y, which can't be done in place)
+   const proto::PlayerState& state{msg.state()};
+   for (const proto::Vector* v : {&state.pos(), &state.angles(), (state.has_vel() ? &state.vel() : nullptr)}) {
+      if (v != nullptr && (!v->has_x() || !v->has_y())) return false;
+   }
+
+   std::array<DeltaField, RecordFileFormat::NUM_DELTA_FIELDS> fields;
+   const std::size_t num{findDeltaFields(data, n, fields)};
+   if (num == 0) return false;
+
+   // previous sample (or zeros)
+   double* const prev{delta[msg.id().id()].data()};
+   for (std::size_t i = 0; i < num; i++) {
+      unsigned char* const p{data + fields[i].offset};
+      const double v{deltaValue(RecordFileFormat::getDouble(p), &prev[fields[i].k], true)};
+      RecordFileFormat::putDouble(p, v);
+   }
+   return true;
+}
+
+}
+
+//------------------------------------------------------------------------------
+// File header and trailer
+//------------------------------------------------------------------------------
+void RecordFileFormat::encodeHeader(unsigned char* const p, const std::uint32_t flags)
+{
+   std::memcpy(p, MAGIC, sizeof(MAGIC));
+   for (int i = 0; i < 4; i++) {
+      p[8 + i] = static_cast<unsigned char>((VERSION >> (8 * i)) & 0xff);
+      p[12 + i] = static_cast<unsigned char>((flags >> (8 * i)) & 0xff);
+   }
+}
+
+bool RecordFileFormat::decodeHeader(const unsigned char* const p, std::uint32_t* const flags)
+{
+   if (std::memcmp(p, MAGIC, sizeof(MAGIC)) != 0) return false;
+   std::uint32_t version{};
+   std::uint32_t f{};
+   for (int i = 0; i < 4; i++) {
+      version |= (static_cast<std::uint32_t>(p[8 + i]) << (8 * i));
+      f |= (static_cast<std::uint32_t>(p[12 + i]) << (8 * i));
+   }
+   if (flags != nullptr) *flags = f;
+   return (version == VERSION);
+}
+
+void RecordFileFormat::encodeTrailer(unsigned char* const p, const std::uint64_t lastIndexOffset)
+{
+   putUint64(p, lastIndexOffset);
+   std::memcpy(p + 8, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+}
+
+bool RecordFileFormat::decodeTrailer(const unsigned char* const p, std::uint64_t* const lastIndexOffset)
+{
+   if (std::memcmp(p + 8, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) return false;
+   *lastIndexOffset = getUint64(p);
+   return (*lastIndexOffset >= HEADER_SIZE);
+}
+
+//------------------------------------------------------------------------------
+// Chunk header
+//------------------------------------------------------------------------------
+std::size_t RecordFileFormat::encodeChunkHeader(unsigned char* const p, const unsigned char type, const std::uint64_t size)
+{
+   p[0] = type;
+   return 1 + putVarint(p + 1, size);
+}
+
+//------------------------------------------------------------------------------
+// Index blocks
+//------------------------------------------------------------------------------
+void RecordFileFormat::encodeIndex(
+      std::vector<unsigned char>& out,
+      const std::uint64_t prevIndexOffset,
+      const std::vector<IndexEntry>& entries,
+      const bool blocks
+   )
+{
+   unsigned char tmp[10 + 10 + 8 + 10];
+
+   putUint64(tmp, prevIndexOffset);
+   out.insert(out.end(), tmp, tmp + 8);
+   out.insert(out.end(), tmp, tmp + putVarint(tmp, entries.size()));
+
+   std::uint64_t offset{};
+   for (const IndexEntry& e : entries) {
+      std::size_t n{putVarint(tmp, e.offset - offset)};
+      if (blocks) n += putVarint(tmp + n, e.inner);
+      putDouble(tmp + n, e.simTime);
+      n += 8;
+      n += putVarint(tmp + n, (e.hasPlayer ? static_cast<std::uint64_t>(e.playerId) + 1 : 0));
+      out.insert(out.end(), tmp, tmp + n);
+      offset = e.offset;
+   }
+}
+
+bool RecordFileFormat::decodeIndex(
+      const unsigned char* const data,
+      const std::size_t size,
+      std::uint64_t* const prevIndexOffset,
+      std::vector<IndexEntry>& entries,
+      const bool blocks
+   )
+{
+   const unsigned char* const end{data + size};
+   if (size < 8) return false;
+   *prevIndexOffset = getUint64(data);
+
+   const unsigned char* p{data + 8};
+   std::uint64_t n{};
+   if (!getVarint(&p, end, &n)) return false;
+
+   std::uint64_t offset{};
+   for (std::uint64_t i = 0; i < n; i++) {
+      IndexEntry e;
+      std::uint64_t delta{};
+      if (!getVarint(&p, end, &delta)) return false;
+      offset += delta;
+      e.offset = offset;
+      if (blocks) {
+         std::uint64_t inner{};
+         if (!getVarint(&p, end, &inner) || inner > 0xffffffffU) return false;
+         e.inner = static_cast<std::uint32_t>(inner);
+      }
+      if ((end - p) < 8) return false;
+      e.simTime = getDouble(p);
+      p += 8;
+      std::uint64_t id{};
+      if (!getVarint(&p, end, &id)) return false;
+      e.hasPlayer = (id > 0);
+      if (e.hasPlayer) e.playerId = static_cast<unsigned int>(id - 1);
+      entries.push_back(e);
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Blocks of record chunks
+//------------------------------------------------------------------------------
+bool RecordFileFormat::appendRecord(
+      std::vector<char>& block,
+      std::size_t* const used,
+      const proto::DataRecord& record,
+      DeltaState* const delta
+   )
+{
+   const std::size_t n{record.ByteSizeLong()};
+   const std::size_t need{*used + MAX_CHUNK_HEADER + n};
+   if (block.size() < need) block.resize(std::max(need, block.size() * 2));
+
+   unsigned char* const p{reinterpret_cast<unsigned char*>(block.data() + *used)};
+   const std::size_t h{encodeChunkHeader(p, RECORD_CHUNK, n)};
+   const bool ok{record.SerializeToArray(p + h, static_cast<int>(n))};
+
+   // Delta encode a player data record's serialized data (the record isn't copied)
+   if (ok && delta != nullptr && deltaEncodeSerialized(record, p + h, n, *delta)) {
+      p[0] = DELTA_CHUNK;
+   }
+
+   if (ok) *used += (h + n);
+   return ok;
+}
+
+bool RecordFileFormat::getChunk(
+      const char* const block,
+      const std::size_t size,
+      std::size_t* const pos,
+      unsigned char* const type,
+      const char** const payload,
+      std::size_t* const n
+   )
+{
+   if (*pos >= size) return false;
+   const unsigned char* const end{reinterpret_cast<const unsigned char*>(block + size)};
+   const unsigned char* p{reinterpret_cast<const unsigned char*>(block + *pos)};
+   const unsigned char t{*p++};
+   std::uint64_t len{};
+   if (!getVarint(&p, end, &len) || len > static_cast<std::uint64_t>(end - p)) return false;
+   *type = t;
+   *payload = reinterpret_cast<const char*>(p);
+   *n = static_cast<std::size_t>(len);
+   *pos = static_cast<std::size_t>(reinterpret_cast<const char*>(p) - block) + *n;
+   return true;
+}
+
+proto::DataRecord* RecordFileFormat::parseRecord(
+      const unsigned char type,
+      const char* const payload,
+      const std::size_t n,
+      DeltaState& delta
+   )
+{
+   if (type != RECORD_CHUNK && type != DELTA_CHUNK) return nullptr;
+   auto record = new proto::DataRecord();
+   if (!parseRecord(type, payload, n, delta, record)) {
+      delete record;
+      record = nullptr;
+   }
+   return record;
+}
+
+bool RecordFileFormat::parseRecord(
+      const unsigned char type,
+      const char* const payload,
+      const std::size_t n,
+      DeltaState& delta,
+      proto::DataRecord* const record
+   )
+{
+   if (type != RECORD_CHUNK && type != DELTA_CHUNK) return false;
+   bool ok{record->ParseFromArray(payload, static_cast<int>(n))};
+   if (ok && type == DELTA_CHUNK) ok = deltaDecode(record, delta);
+   return ok;
+}
+
+std::size_t RecordFileFormat::compressBlock(const char* const block, const std::size_t n, std::vector<char>& out)
+{
+   out.resize(10 + base::lz4CompressBound(n));
+   const std::size_t h{putVarint(reinterpret_cast<unsigned char*>(out.data()), n)};
+   const std::size_t c{base::lz4Compress(block, n, out.data() + h, out.size() - h)};
+   return (c > 0 ? h + c : 0);
+}
+
+bool RecordFileFormat::decompressBlock(const char* const data, const std::size_t n, std::vector<char>& block)
+{
+   const unsigned char* p{reinterpret_cast<const unsigned char*>(data)};
+   const unsigned char* const end{p + n};
+   std::uint64_t size{};
+   // (a compressed byte can't expand to more than 255 bytes)
+   if (!getVarint(&p, end, &size) || size > (static_cast<std::uint64_t>(n) * 255 + 16)) return false;
+   block.resize(static_cast<std::size_t>(size));
+   const std::size_t c{static_cast<std::size_t>(end - p)};
+   const std::size_t d{base::lz4Decompress(reinterpret_cast<const char*>(p), c, block.data(), block.size())};
+   return (d != base::LZ4_ERROR && d == size);
+}
+
+//------------------------------------------------------------------------------
+// Delta encoding of the player data
+//------------------------------------------------------------------------------
+bool RecordFileFormat::deltaEncode(proto::DataRecord* const record, DeltaState& delta)
+{
+   return deltaPlayerData(record, delta, true);
+}
+
+bool RecordFileFormat::deltaDecode(proto::DataRecord* const record, DeltaState& delta)
+{
+   return deltaPlayerData(record, delta, false);
+}
+
+//------------------------------------------------------------------------------
+// Gets the ID of the record's (main) player: the player, the weapon, the
+// shooter of a gun or the ownship of a track
+//------------------------------------------------------------------------------
+bool RecordFileFormat::getPlayerId(const proto::DataRecord& record, unsigned int* const id)
+{
+   bool ok{true};
+   if (record.has_player_data_msg())                 *id = record.player_data_msg().id().id();
+   else if (record.has_new_player_event_msg())       *id = record.new_player_event_msg().id().id();
+   else if (record.has_player_removed_event_msg())   *id = record.player_removed_event_msg().id().id();
+   else if (record.has_player_damaged_event_msg())   *id = record.player_damaged_event_msg().id().id();
+   else if (record.has_player_collision_event_msg()) *id = record.player_collision_event_msg().id().id();
+   else if (record.has_player_crash_event_msg())     *id = record.player_crash_event_msg().id().id();
+   else if (record.has_player_killed_event_msg())    *id = record.player_killed_event_msg().id().id();
+   else if (record.has_weapon_release_event_msg())   *id = record.weapon_release_event_msg().wpn_id().id();
+   else if (record.has_weapon_hung_event_msg())      *id = record.weapon_hung_event_msg().wpn_id().id();
+   else if (record.has_weapon_detonation_event_msg()) *id = record.weapon_detonation_event_msg().wpn_id().id();
+   else if (record.has_gun_fired_event_msg())        *id = record.gun_fired_event_msg().shooter_id().id();
+   else if (record.has_track_data_msg())             *id = record.track_data_msg().player_id().id();
+   else if (record.has_new_track_event_msg())        *id = record.new_track_event_msg().player_id().id();
+   else if (record.has_track_removed_event_msg())    *id = record.track_removed_event_msg().player_id().id();
+   else ok = false;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Varint, uint64 and float64 encoding
+//------------------------------------------------------------------------------
+std::size_t RecordFileFormat::putVarint(unsigned char* const p, std::uint64_t v)
+{
+   std::size_t n{};
+   while (v >= 0x80) {
+      p[n++] = static_cast<unsigned char>(v | 0x80);
+      v >>= 7;
+   }
+   p[n++] = static_cast<unsigned char>(v);
+   return n;
+}
+
+bool RecordFileFormat::getVarint(const unsigned char** const p, const unsigned char* const end, std::uint64_t* const v)
+{
+   std::uint64_t x{};
+   const unsigned char* q{*p};
+   for (int shift = 0; shift < 64 && q < end; shift += 7) {
+      const unsigned char b{*q++};
+      x |= (static_cast<std::uint64_t>(b & 0x7f) << shift);
+      if ((b & 0x80) == 0) {
+         *v = x;
+         *p = q;
+         return true;
+      }
+   }
+   return false;
+}
+
+void RecordFileFormat::putUint64(unsigned char* const p, const std::uint64_t v)
+{
+   for (int i = 0; i < 8; i++) {
+      p[i] = static_cast<unsigned char>((v >> (8 * i)) & 0xff);
+   }
+}
+
+std::uint64_t RecordFileFormat::getUint64(const unsigned char* const p)
+{
+   std::uint64_t v{};
+   for (int i = 0; i < 8; i++) {
+      v |= (static_cast<std::uint64_t>(p[i]) << (8 * i));
+   }
+   return v;
+}
+
+void RecordFileFormat::putDouble(unsigned char* const p, const double v)
+{
+   std::uint64_t bits{};
+   std::memcpy(&bits, &v, sizeof(bits));
+   putUint64(p, bits);
+}
+
+double RecordFileFormat::getDouble(const unsigned char* const p)
+{
+   const std::uint64_t bits{getUint64(p)};
+   double v{};
+   std::memcpy(&v, &bits, sizeof(v));
+   return v;
+}
+
+}
+}
+}
@@ -0,0 +1,23 @@
+
+#include "RecorderWriterPeriodicThread.hpp"
+
+#include "mixr/recorder/protobuf_v2/DataRecorder.hpp"
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+RecorderWriterPeriodicThread::RecorderWriterPeriodicThread(base::IComponent* const parent, const double rate): base::IPeriodicThread(parent, rate)
+{
+}
+
+unsigned long RecorderWriterPeriodicThread::userFunc(const double)
+{
+   DataRecorder* recorder{static_cast<DataRecorder*>(getParent())};
+   recorder->writeRecords();
+   return 0;
+}
+
+}
+}
+}
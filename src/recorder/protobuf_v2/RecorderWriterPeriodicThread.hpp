@@ -0,0 +1,24 @@
+
+#ifndef __mixr_recorder_protobuf_v2_RecorderWriterPeriodicThread_HPP__
+#define __mixr_recorder_protobuf_v2_RecorderWriterPeriodicThread_HPP__
+
+#include "mixr/base/threads/IPeriodicThread.hpp"
+
+namespace mixr {
+namespace recorder {
+namespace protobuf_v2 {
+
+// ---
+// Data recorder's writer thread
+// ---
+class RecorderWriterPeriodicThread final : public base::IPeriodicThread
+{
+   public: RecorderWriterPeriodicThread(base::IComponent* const parent, const double rate);
+   private: unsigned long userFunc(const double dt) final;
+};
+
+}
+}
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include "mixr/recorder/protobuf_v2/TabPrinter.hpp"
 #include "mixr/recorder/protobuf_v2/PrintPlayer.hpp"
 #include "mixr/recorder/protobuf_v2/PrintSelected.hpp"
+#include "mixr/recorder/protobuf_v2/RecordExporter.hpp"
 
 #include <string>
 
@@ -46,6 +47,9 @@ base::IObject* factory(const std::string& name)
     else if ( name == PrintSelected::getFactoryName() ) {
         obj = new PrintSelected();
     }
+    else if ( name == RecordExporter::getFactoryName() ) {
+        obj = new RecordExporter();
+    }
 
     return obj;
 }
@@ -6,6 +6,8 @@
 
 #include "mixr/simulation/INetIO.hpp"
 #include "mixr/simulation/INib.hpp"
+#include "mixr/simulation/ISimulation.hpp"
+#include "mixr/simulation/PlayerArray.hpp"
 
 namespace mixr {
 namespace simulation {
@@ -115,11 +117,46 @@ const INib* IPlayer::getLocalNib(const int netId) const
    return p;
 }
 
+//-----------------------------------------------------------------------------
+// Player's IDs and name: the simulation's player array indexes the players by
+// their IDs and names, so it's rebuilt when an indexed player's keys change
+//-----------------------------------------------------------------------------
+
+// True if we're in our simulation's player array
+bool IPlayer::isIndexed() const
+{
+   const auto sim = dynamic_cast<const ISimulation*>(container());
+   if (sim == nullptr) return false;
+   base::safe_ptr<const PlayerArray> pa( sim->getPlayerArray(), false );
+   return (pa != nullptr && pa->findPlayerByName(name) == this);
+}
+
+// Sets the player's ID
+void IPlayer::setID(const int x)
+{
+   if (x != id) {
+      const bool indexed{isIndexed()};
+      id = x;
+      if (indexed) static_cast<ISimulation*>(container())->rebuildPlayerArray();
+   }
+}
+
+// Sets the player's name
+void IPlayer::setName(const std::string& x)
+{
+   if (x != name) {
+      const bool indexed{isIndexed()};
+      name = x;
+      if (indexed) static_cast<ISimulation*>(container())->rebuildPlayerArray();
+   }
+}
+
 //-----------------------------------------------------------------------------
 
 // Sets a pointer to the Network Interface Block (NIB)
 bool IPlayer::setNib(INib* const n)
 {
+   const bool indexed{n != nib && isIndexed()};
    if (nib != nullptr) nib->unref();
    nib = n;
    if (nib != nullptr) {
@@ -130,6 +167,7 @@ bool IPlayer::setNib(INib* const n)
    } else {
       netID = 0;
    }
+   if (indexed) static_cast<ISimulation*>(container())->rebuildPlayerArray();
    return true;
 }
 
@@ -2,9 +2,11 @@
 #include "mixr/simulation/ISimulation.hpp"
 
 #include "mixr/simulation/IPlayer.hpp"
+#include "mixr/simulation/PlayerArray.hpp"
 
 #include "SimulationTcSyncThread.hpp"
 #include "SimulationBgSyncThread.hpp"
+#include "SimulationTaskScheduler.hpp"
 
 #include "mixr/simulation/IDataRecorder.hpp"
 #include "mixr/simulation/INib.hpp"
@@ -17,10 +19,14 @@
 #include "mixr/base/numeric/Boolean.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/qty/times.hpp"
+#include "mixr/base/util/platform_api.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <cmath>
+#include <string>
+#include <unordered_set>
 
 namespace mixr {
 namespace simulation {
@@ -102,10 +108,11 @@ void ISimulation::copyData(const ISimulation& org, const bool)
    }
 
    // Copy active players
-   if (players != nullptr)     { players = nullptr; }
+   if (players != nullptr)     { swapPlayers(nullptr); }
    if (org.players != nullptr) {
-      players = org.players->clone();
-      players->unref();  // safe_ptr<> has it
+      base::PairStream* pl{org.players->clone()};
+      swapPlayers(pl);
+      pl->unref();  // safe_ptr<> has it
    }
 
    // Timing
@@ -146,6 +153,10 @@ void ISimulation::copyData(const ISimulation& org, const bool)
    numTcThreads = 0;
    tcThreadsFailed = false;
    reqTcThreads = org.reqTcThreads;
+   if (tcScheduler != nullptr) {
+      delete tcScheduler;
+      tcScheduler = nullptr;
+   }
 
    for (int i = 0; i < numBgThreads; i++) {
       bgThreads[i]->terminate();
@@ -155,6 +166,10 @@ void ISimulation::copyData(const ISimulation& org, const bool)
    numBgThreads = 0;
    bgThreadsFailed = false;
    reqBgThreads = org.reqBgThreads;
+   if (bgScheduler != nullptr) {
+      delete bgScheduler;
+      bgScheduler = nullptr;
+   }
 
    // Timing statistics
    if (frameTimingStats != nullptr) {
@@ -171,7 +186,7 @@ void ISimulation::copyData(const ISimulation& org, const bool)
 void ISimulation::deleteData()
 {
    if (origPlayers != nullptr) { origPlayers = nullptr; }
-   if (players != nullptr)     { players = nullptr; }
+   if (players != nullptr)     { swapPlayers(nullptr); }
 
    base::Pair* newPlayer{newPlayerQueue.get()};
    while (newPlayer != nullptr) {
@@ -186,6 +201,10 @@ void ISimulation::deleteData()
     }
    numTcThreads = 0;
    tcThreadsFailed = false;
+   if (tcScheduler != nullptr) {
+      delete tcScheduler;
+      tcScheduler = nullptr;
+   }
 
    for (int i = 0; i < numBgThreads; i++) {
       bgThreads[i]->terminate();
@@ -194,6 +213,10 @@ void ISimulation::deleteData()
    }
    numBgThreads = 0;
    bgThreadsFailed = false;
+   if (bgScheduler != nullptr) {
+      delete bgScheduler;
+      bgScheduler = nullptr;
+   }
 
    station = nullptr;
 
@@ -215,6 +238,9 @@ void ISimulation::reset()
    base::safe_ptr<base::PairStream> newList( new base::PairStream() );
    newList->unref();  // 'newList' has it, so unref() from the 'new'
 
+   // Players to be inserted into the new list
+   std::vector<base::Pair*> newPlayers;
+
    // ---
    // Copy original players to the new list
    // ---
@@ -230,8 +256,7 @@ void ISimulation::reset()
             ip->container(this);
             ip->setName((pair->slot()));
 
-            // Insert the player into the new list in sorted order
-            insertPlayerSort(pair, newList);
+            newPlayers.push_back(pair);
             item = item->getNext();
          }
       }
@@ -253,18 +278,20 @@ void ISimulation::reset()
                ip->container(this);
                ip->setName(pair->slot());
 
-               // Insert the proxy player into the new list in sorted order
-               insertPlayerSort(pair, newList);
+               newPlayers.push_back(pair);
             }
             item = item->getNext();
          }
       }
    }
 
+   // Insert the players into the new list in sorted order
+   insertPlayersSorted(newPlayers, newList);
+
    // ---
    // Swap the lists
    // ---
-   players = newList;
+   swapPlayers(newList);
 
    // ---
    // Create the T/C thread pool
@@ -297,6 +324,11 @@ void ISimulation::reset()
       // and we don't want to try again.
       tcThreadsFailed = (reqTcThreads > 1 && numTcThreads == 0);
 
+      // The scheduler keeps a cost history for each of the 4 phases
+      if (numTcThreads > 0 && tcScheduler == nullptr) {
+         tcScheduler = new SimulationTaskScheduler(4);
+      }
+
    }
 
    // ---
@@ -330,6 +362,10 @@ void ISimulation::reset()
       // and we don't want to try again.
       bgThreadsFailed = (reqBgThreads > 1 && numBgThreads == 0);
 
+      if (numBgThreads > 0 && bgScheduler == nullptr) {
+         bgScheduler = new SimulationTaskScheduler(1);
+      }
+
    }
 
    // ---
@@ -599,8 +635,13 @@ void ISimulation::updateTC(const double dt)
    // Called once per frame -- Process 4 phases per frame
    // ---
    {
-      // This locks the current player list for this time-critical frame
-      base::safe_ptr<base::PairStream> currentPlayerList = players;
+      // This locks the current player list (and its array) for this time-critical frame
+      base::safe_ptr<PlayerArray> currentPlayers = playerArray;
+
+      // Player array for the thread pool's scheduler
+      if (reqTcThreads > 1 && tcScheduler != nullptr) {
+         tcScheduler->setPlayers(currentPlayers);
+      }
 
       for (unsigned int f = 0; f < 4; f++) {
 
@@ -609,18 +650,21 @@ void ISimulation::updateTC(const double dt)
 
          if (reqTcThreads == 1) {
             // Our single TC thread
-            updateTcPlayerList(currentPlayerList, (dt0/4.0), 1, 1);
+            updateTcPlayerList(currentPlayers, (dt0/4.0), 1, 1);
          } else if (numTcThreads > 0) {
+            // Chunk this phase's players using their phase cost history
+            tcScheduler->prepare(f, reqTcThreads);
+
             // multiple threads
             for (unsigned short i = 0; i < numTcThreads; i++) {
 
                // assign the threads from the pool
                unsigned int idx {static_cast<unsigned int>(i+1)};
-               tcThreads[i]->start0(currentPlayerList, (dt0/4.0), idx, reqTcThreads);
+               tcThreads[i]->start0(currentPlayers, (dt0/4.0), idx, reqTcThreads);
             }
 
             // we're the last thread
-            updateTcPlayerList(currentPlayerList, (dt0/4.0), reqTcThreads, reqTcThreads);
+            updateTcPlayerList(currentPlayers, (dt0/4.0), reqTcThreads, reqTcThreads);
 
             // Now wait for the other thread(s) to complete
             base::ISyncThread** pp {reinterpret_cast<base::ISyncThread**>(&tcThreads[0])};
@@ -646,28 +690,22 @@ void ISimulation::updateTC(const double dt)
 }
 
 //------------------------------------------------------------------------------
-// Time critical thread processing for every n'th player starting
-// with the idx'th player
+// Time critical thread processing as the idx'th of n threads: the scheduler's
+// chunks when it's been prepared for this player array and number of threads,
+// otherwise every n'th player starting with the idx'th player
 //------------------------------------------------------------------------------
 void ISimulation::updateTcPlayerList(
-   base::PairStream* const playerList,
+   PlayerArray* const pa,
    const double dt,
    const unsigned int idx,
    const unsigned int n)
 {
-   if (playerList != nullptr) {
-      unsigned int index{idx};
-      unsigned int count{};
-      base::IList::Item* item {playerList->getFirstItem()};
-      while (item != nullptr) {
-         count++;
-         if (count == index) {
-            base::Pair* pair {static_cast<base::Pair*>(item->getValue())};
-            IPlayer* ip {static_cast<IPlayer*>(pair->object())};
-            ip->tcFrame(dt);
-            index += n;
-         }
-         item = item->getNext();
+   if (idx > 0 && tcScheduler != nullptr && tcScheduler->isPrepared(pa, n)) {
+      tcScheduler->run(idx - 1, [dt](IPlayer* const ip) { ip->tcFrame(dt); });
+   } else if (pa != nullptr && idx > 0) {
+      const unsigned int np{pa->getNumPlayers()};
+      for (unsigned int i = (idx - 1); i < np; i += n) {
+         pa->getPlayer(i)->tcFrame(dt);
       }
    }
 }
@@ -688,22 +726,29 @@ void ISimulation::updateData(const double dt)
     updatePlayerList();
 
     // Update all players
-    if (players != nullptr) {
-         base::safe_ptr<base::PairStream> currentPlayerList = players;
+    base::safe_ptr<PlayerArray> currentPlayers = playerArray;
+    if (currentPlayers != nullptr) {
+
+         // Batch processing for all of the players
+         updateBgBatch(currentPlayers, dt0);
 
          if (reqBgThreads == 1) {
             // Our single thread
-            updateBgPlayerList(currentPlayerList, dt0, 1, 1);
+            updateBgPlayerList(currentPlayers, dt0, 1, 1);
          } else if (numBgThreads > 0) {
+            // Chunk the players using their cost history
+            bgScheduler->setPlayers(currentPlayers);
+            bgScheduler->prepare(0, reqBgThreads);
+
             // multiple threads
             for (int i = 0; i < numBgThreads; i++) {
                // assign the threads from the pool
                unsigned int idx {static_cast<unsigned int>(i+1)};
-               bgThreads[i]->start0(currentPlayerList, dt0, idx, reqBgThreads);
+               bgThreads[i]->start0(currentPlayers, dt0, idx, reqBgThreads);
             }
 
             // we're the last thread
-            updateBgPlayerList(currentPlayerList, dt0, reqBgThreads, reqBgThreads);
+            updateBgPlayerList(currentPlayers, dt0, reqBgThreads, reqBgThreads);
 
             // Now wait for the other thread(s) to complete
             base::ISyncThread** pp = reinterpret_cast<base::ISyncThread**>(&bgThreads[0]);
@@ -719,32 +764,34 @@ void ISimulation::updateData(const double dt)
 }
 
 //------------------------------------------------------------------------------
-// Background thread processing for every n'th player starting
-// with the idx'th player
+// Background thread processing as the idx'th of n threads: the scheduler's
+// chunks when it's been prepared for this player array and number of threads,
+// otherwise every n'th player starting with the idx'th player
 //------------------------------------------------------------------------------
 void ISimulation::updateBgPlayerList(
-         base::PairStream* const playerList,
+         PlayerArray* const pa,
          const double dt,
          const unsigned int idx,
          const unsigned int n)
 {
-   if (playerList != nullptr) {
-      unsigned int index{idx};
-      unsigned int count{};
-      base::IList::Item* item{playerList->getFirstItem()};
-      while (item != nullptr) {
-         count++;
-         if (count == index) {
-         base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
-            IPlayer* ip{static_cast<IPlayer*>(pair->object())};
-            ip->updateData(dt);
-            index += n;
-         }
-         item = item->getNext();
+   if (idx > 0 && bgScheduler != nullptr && bgScheduler->isPrepared(pa, n)) {
+      bgScheduler->run(idx - 1, [dt](IPlayer* const ip) { ip->updateData(dt); });
+   } else if (pa != nullptr && idx > 0) {
+      const unsigned int np{pa->getNumPlayers()};
+      for (unsigned int i = (idx - 1); i < np; i += n) {
+         pa->getPlayer(i)->updateData(dt);
       }
    }
 }
 
+//------------------------------------------------------------------------------
+// updateBgBatch() -- background processing that's done for all of the players
+// at once, before the players' updateData() (e.g., see IWorldModel)
+//------------------------------------------------------------------------------
+void ISimulation::updateBgBatch(PlayerArray* const, const double)
+{
+}
+
 //------------------------------------------------------------------------------
 // printFrameTimingStats() --Print the time critical frame timing statistics
 //------------------------------------------------------------------------------
@@ -791,6 +838,18 @@ const base::PairStream* ISimulation::getPlayers() const
    return players.getRefPtr();
 }
 
+// Returns the contiguous player array of the player list; pre-ref()'d
+PlayerArray* ISimulation::getPlayerArray()
+{
+   return playerArray.getRefPtr();
+}
+
+// Returns the contiguous player array of the player list; pre-ref()'d (const version)
+const PlayerArray* ISimulation::getPlayerArray() const
+{
+   return playerArray.getRefPtr();
+}
+
 // Real-time cycle counter
 unsigned int ISimulation::cycle() const
 {
@@ -908,7 +967,7 @@ bool ISimulation::setSlotPlayers(base::PairStream* const pl)
    // Early out if we're just zeroing the player lists
    if (pl == nullptr) {
       origPlayers = nullptr;
-      players = nullptr;
+      swapPlayers(nullptr);
       return true;
    }
 
@@ -940,43 +999,33 @@ bool ISimulation::setSlotPlayers(base::PairStream* const pl)
 
    // Next, make sure we have unique player names and IDs
    if (ok) {
+      std::unordered_set<int> ids;
+      std::unordered_set<std::string> names;
+      ids.reserve(pl->entries());
+      names.reserve(pl->entries());
+
       // For all players ...
-      base::IList::Item* item1{pl->getFirstItem()};
-      while (item1 != nullptr) {
-         base::Pair* pair1{static_cast<base::Pair*>(item1->getValue())};
-         item1 = item1->getNext();
-         IPlayer* ip1{static_cast<IPlayer*>(pair1->object())};
+      base::IList::Item* item{pl->getFirstItem()};
+      while (item != nullptr) {
+         base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
+         item = item->getNext();
+         IPlayer* ip{static_cast<IPlayer*>(pair->object())};
 
          // unassigned ID
-         if ( (ip1->getID() == 0) && (maxID < 65535) ) {
-            ip1->setID(maxID);
+         if ( (ip->getID() == 0) && (maxID < 65535) ) {
+            ip->setID(maxID);
             ++maxID;
          }
 
-         base::IList::Item* item2{item1};
-         while (item2 != nullptr) {
-            base::Pair* pair2{static_cast<base::Pair*>(item2->getValue())};
-            IPlayer* ip2{static_cast<IPlayer*>(pair2->object())};
-
-            // unassigned ID
-            if ( (ip2->getID() == 0)  && (maxID < 65535) ) {
-               ip2->setID(maxID);
-               ++maxID;
-            }
-
-            if (ip1->getID() == ip2->getID()) {
-               std::cerr << "Simulation::setSlotPlayers: duplicate player ID: " << ip1->getID() << std::endl;
-               ok = false;
-            }
-
-            if (pair1->slot() == pair2->slot()) {
-               std::cerr << "Simulation::setSlotPlayers: duplicate player name: " << pair1->slot() << std::endl;
-               ok = false;
-            }
-
-            item2 = item2->getNext();
+         if (!ids.insert(ip->getID()).second) {
+            std::cerr << "Simulation::setSlotPlayers: duplicate player ID: " << ip->getID() << std::endl;
+            ok = false;
          }
 
+         if (!names.insert(pair->slot()).second) {
+            std::cerr << "Simulation::setSlotPlayers: duplicate player name: " << pair->slot() << std::endl;
+            ok = false;
+         }
       }
    }
 
@@ -1001,16 +1050,18 @@ bool ISimulation::setSlotPlayers(base::PairStream* const pl)
       // Copy original players to the new list
       if (origPlayers != nullptr) {
          base::safe_ptr<base::PairStream> origPlayerList = origPlayers;
+         std::vector<base::Pair*> newPlayers;
+         newPlayers.reserve(origPlayerList->entries());
          base::IList::Item* item {origPlayerList->getFirstItem()};
          while (item != nullptr) {
-            base::Pair* pair {static_cast<base::Pair*>(item->getValue())};
-            insertPlayerSort(pair, newList);
+            newPlayers.push_back(static_cast<base::Pair*>(item->getValue()));
             item = item->getNext();
          }
+         insertPlayersSorted(newPlayers, newList);
       }
 
       // Set the active player list pointer
-      players = newList;
+      swapPlayers(newList);
       newList->unref();
    }
 
@@ -1080,6 +1131,7 @@ void ISimulation::updatePlayerList()
         // ---
         // Add any new players
         // ---
+        std::vector<base::Pair*> newPlayers;
         base::Pair* newPlayer{newPlayerQueue.get()};
         while (newPlayer != nullptr) {
             // get the player
@@ -1093,18 +1145,21 @@ void ISimulation::updatePlayerList()
             ip->container(this);
             ip->setName(newPlayer->slot());
 
-            // Insert the new player into the new list in sorted order
-            insertPlayerSort(newPlayer, newList);
-
-            newPlayer->unref();
+            newPlayers.push_back(newPlayer);
 
          newPlayer = newPlayerQueue.get();
         }
 
+        // Merge the new players into the new list in sorted order
+        insertPlayersSorted(newPlayers, newList);
+        for (base::Pair* const pair : newPlayers) {
+            pair->unref();
+        }
+
         // ---
         // Swap the lists
         // ---
-        players = newList;
+        swapPlayers(newList);
     }
 }
 
@@ -1141,71 +1196,111 @@ bool ISimulation::addNewPlayer(const char* const playerName, IPlayer* const play
 }
 
 //------------------------------------------------------------------------------
-// insertPlayerSort() -- Insert the new player into the new list in sorted order
+// swapPlayers() -- Sets the new player list and builds its player array
 //------------------------------------------------------------------------------
-bool ISimulation::insertPlayerSort(base::Pair* const newPlayerPair, base::PairStream* const newList)
+void ISimulation::swapPlayers(base::PairStream* const newList)
 {
-    newList->ref();
-
-    // create a new base::List::Item to hold the player
-    base::IList::Item* newItem{new base::List::Item};
-    newPlayerPair->ref();
-    newItem->value = newPlayerPair;
+   // (the old array, and any removed players, are released after the swap,
+   // as the players' deleteData() can look up our player array)
+   base::safe_ptr<PlayerArray> oldArray( playerArray );
+   base::lock(playersLock);
+   if (newList != nullptr) {
+      base::safe_ptr<PlayerArray> newArray( new PlayerArray(newList) );
+      newArray->unref();  // 'newArray' has it, so unref() from the 'new'
+      players = newList;
+      playerArray = newArray;
+   } else {
+      players = nullptr;
+      playerArray = nullptr;
+   }
+   base::unlock(playersLock);
+}
 
-    // Get the player
-    const auto newPlayer = static_cast<IPlayer*>(newPlayerPair->object());
+//------------------------------------------------------------------------------
+// rebuildPlayerArray() -- Rebuilds the player array of the current player
+// list, whose indexes are keyed by the players' IDs and names (see PlayerArray)
+//------------------------------------------------------------------------------
+void ISimulation::rebuildPlayerArray()
+{
+   base::safe_ptr<PlayerArray> oldArray( playerArray );
+   base::lock(playersLock);
+   base::safe_ptr<base::PairStream> pl( players );
+   if (pl != nullptr) {
+      base::safe_ptr<PlayerArray> newArray( new PlayerArray(pl) );
+      newArray->unref();  // 'newArray' has it, so unref() from the 'new'
+      playerArray = newArray;
+   }
+   base::unlock(playersLock);
+}
 
-    // Search the new player list and insert into the correct position --
-    //  -- sorted by network ID and player ID
-    bool inserted{};
-    base::IList::Item* refItem{newList->getFirstItem()};
-    while (refItem != nullptr && !inserted) {
-        base::Pair* refPair{static_cast<base::Pair*>(refItem->getValue())};
-        const auto refPlayer = static_cast<IPlayer*>(refPair->object());
-
-        bool insert{};
-        if (newPlayer->isProxyPlayer()) {
-
-            // *** Insert proxy player -- after local players and lower NIB IDs first
-            if (refPlayer->isProxyPlayer()) {
-
-               // Get the NIBs
-               const INib* nNib{newPlayer->getNib()};
-               const INib* rNib{refPlayer->getNib()};
-
-               // Compare federate names
-               int result{nNib->getFederateName() == rNib->getFederateName()};
-               if (result == 0) {
-                  // Same federate name; compare player IDs
-                  if (nNib->getPlayerID() > rNib->getPlayerID()) result = +1;
-                  else if (nNib->getPlayerID() < rNib->getPlayerID()) result = -1;
-               }
-
-               // Insert if the new NIB's IDs are less than the ref NIB's IDs
-               insert = (result < 0);
-            }
-        } else {
+//------------------------------------------------------------------------------
+// insertPlayersSorted() -- Merge the new players into the (sorted) new list
+//
+//    The new players are sorted, and then merged into the list with a single
+//    pass, so a burst of k new players costs O(n + k log k) rather than one
+//    list search per player.  New players are placed after any players that
+//    have the same sort keys, in the order that they were given.
+//------------------------------------------------------------------------------
+void ISimulation::insertPlayersSorted(std::vector<base::Pair*>& newPlayers, base::PairStream* const newList)
+{
+    if (newPlayers.empty()) return;
 
-            // *** Insert a local player -- by player ID and before any proxy player
-            insert = ( (newPlayer->getID() < refPlayer->getID()) || refPlayer->isProxyPlayer() );
+    newList->ref();
 
-        }
+    std::stable_sort(newPlayers.begin(), newPlayers.end(),
+       [](const base::Pair* const p1, const base::Pair* const p2) {
+          return isPlayerBefore(static_cast<const IPlayer*>(p1->object()), static_cast<const IPlayer*>(p2->object()));
+       } );
 
-        if (insert) {
-            newList->insert(newItem, refItem);
-            inserted = true;
+    base::IList::Item* refItem{newList->getFirstItem()};
+    for (base::Pair* const newPlayerPair : newPlayers) {
+        const auto newPlayer = static_cast<const IPlayer*>(newPlayerPair->object());
+
+        // Find the first player that the new player goes before
+        while (refItem != nullptr) {
+            const auto refPair = static_cast<const base::Pair*>(refItem->getValue());
+            if (isPlayerBefore(newPlayer, static_cast<const IPlayer*>(refPair->object()))) break;
+            refItem = refItem->getNext();
         }
 
-        refItem = refItem->getNext();
+        // create a new base::List::Item to hold the player, and insert it
+        // before the ref item (or at the tail)
+        base::IList::Item* newItem{new base::List::Item};
+        newPlayerPair->ref();
+        newItem->value = newPlayerPair;
+        newList->insert(newItem, refItem);
     }
 
-    // Hasn't been inserted yet, so add to the tail
-    if (!inserted) {
-        newList->insert(newItem, nullptr);
+    newList->unref();
+}
+
+//------------------------------------------------------------------------------
+// isPlayerBefore() -- True if player 'p1' is sorted before player 'p2':
+//    local players by player ID, then the proxy players by federate name
+//    and player ID
+//------------------------------------------------------------------------------
+bool ISimulation::isPlayerBefore(const IPlayer* const p1, const IPlayer* const p2)
+{
+    if (p1->isProxyPlayer()) {
+        // *** Proxy player -- after local players and lower NIB IDs first
+        if (p2->isLocalPlayer()) return false;
+
+        // Get the NIBs
+        const INib* nNib{p1->getNib()};
+        const INib* rNib{p2->getNib()};
+
+        // Compare federate names
+        int result{nNib->getFederateName().compare(rNib->getFederateName())};
+        if (result == 0) {
+           // Same federate name; compare player IDs
+           if (nNib->getPlayerID() > rNib->getPlayerID()) result = +1;
+           else if (nNib->getPlayerID() < rNib->getPlayerID()) result = -1;
+        }
+        return (result < 0);
     }
 
-    newList->unref();
-    return true;
+    // *** Local player -- by player ID and before any proxy player
+    return ( p2->isProxyPlayer() || (p1->getID() < p2->getID()) );
 }
 
 
@@ -1225,31 +1320,11 @@ const IPlayer* ISimulation::findPlayer(const short id, const int netID) const
 IPlayer* ISimulation::findPlayerPrivate(const short id, const int netID) const
 {
     // Quick out
-    if (players == nullptr) return nullptr;
+    base::safe_ptr<const PlayerArray> pa( getPlayerArray(), false );
+    if (pa == nullptr) return nullptr;
 
     // Find a Player that matches player ID and Sources
-    IPlayer* player{};
-    const base::IList::Item* item{players->getFirstItem()};
-    while (player == nullptr && item != nullptr) {
-        const auto pair = static_cast<const base::Pair*>(item->getValue());
-        if (pair != nullptr) {
-            const auto ip = const_cast<IPlayer*>(static_cast<const IPlayer*>(pair->object()));
-            if (ip != nullptr) {
-                if (netID > 0) {
-                    if ((ip->getID() == id) && (ip->getNetworkID() == netID)) {
-                        player = ip;
-                    }
-                } else {
-                    if (ip->getID() == id) {
-                        player = ip;
-                    }
-                }
-            }
-        }
-        item = item->getNext();
-    }
-
-    return player;
+    return pa->findPlayer(id, netID);
 }
 
 //------------------------------------------------------------------------------
@@ -1268,23 +1343,11 @@ const IPlayer* ISimulation::findPlayerByName(const char* const playerName) const
 IPlayer* ISimulation::findPlayerByNamePrivate(const char* const playerName) const
 {
     // Quick out
-    if (players == nullptr || playerName == nullptr) return nullptr;
+    base::safe_ptr<const PlayerArray> pa( getPlayerArray(), false );
+    if (pa == nullptr || playerName == nullptr) return nullptr;
 
     // Find a Player named 'playerName'
-    IPlayer* player{};
-    const base::IList::Item* item{players->getFirstItem()};
-    while (player == nullptr && item != nullptr) {
-        const auto pair = static_cast<const base::Pair*>(item->getValue());
-        if (pair != nullptr) {
-            const auto ip = const_cast<IPlayer*>(static_cast<const IPlayer*>(pair->object()));
-            if (ip != nullptr && ip->isName(playerName)) {
-               player = ip;
-            }
-        }
-        item = item->getNext();
-    }
-
-    return player;
+    return pa->findPlayerByName(playerName);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,125 @@
+
+#include "mixr/simulation/PlayerArray.hpp"
+
+#include "mixr/simulation/IPlayer.hpp"
+
+#include "mixr/base/IList.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/Pair.hpp"
+
+#include <algorithm>
+
+namespace mixr {
+namespace simulation {
+
+IMPLEMENT_PARTIAL_SUBCLASS(PlayerArray, "PlayerArray")
+EMPTY_SLOTTABLE(PlayerArray)
+
+PlayerArray::PlayerArray(base::PairStream* const pl) : playerList(pl)
+{
+   STANDARD_CONSTRUCTOR()
+
+   if (pl != nullptr) {
+      players.reserve(pl->entries());
+      for (base::IList::Item* item = pl->getFirstItem(); item != nullptr; item = item->getNext()) {
+         base::Pair* pair{static_cast<base::Pair*>(item->getValue())};
+         players.push_back(static_cast<IPlayer*>(pair->object()));
+      }
+
+      // The player list is sorted with the local players first, but
+      // make sure that our partitions are correct
+      const auto it = std::stable_partition(players.begin(), players.end(),
+                                            [](const IPlayer* const ip) { return ip->isLocalPlayer(); } );
+      numLocal = static_cast<unsigned int>(it - players.begin());
+
+      // Indexes; emplace() keeps the first player with each key
+      idIndex.reserve(players.size());
+      netIndex.reserve(players.size());
+      nameIndex.reserve(players.size());
+      for (unsigned int i = 0; i < players.size(); i++) {
+         const IPlayer* const ip{players[i]};
+         idIndex.emplace(ip->getID(), i);
+         netIndex.emplace(netKey(ip->getID(), ip->getNetworkID()), i);
+         nameIndex.emplace(ip->getName(), i);
+      }
+   }
+}
+
+PlayerArray::PlayerArray(const PlayerArray& org)
+{
+   STANDARD_CONSTRUCTOR()
+   copyData(org, true);
+}
+
+PlayerArray::~PlayerArray()
+{
+   STANDARD_DESTRUCTOR()
+}
+
+PlayerArray& PlayerArray::operator=(const PlayerArray& org)
+{
+   if (this != &org) copyData(org, false);
+   return *this;
+}
+
+PlayerArray* PlayerArray::clone() const
+{
+   return new PlayerArray(*this);
+}
+
+void PlayerArray::copyData(const PlayerArray& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   playerList = const_cast<base::PairStream*>(org.getPlayerList());
+   players = org.players;
+   numLocal = org.numLocal;
+   idIndex = org.idIndex;
+   netIndex = org.netIndex;
+   nameIndex = org.nameIndex;
+}
+
+void PlayerArray::deleteData()
+{
+   players.clear();
+   numLocal = 0;
+   idIndex.clear();
+   netIndex.clear();
+   nameIndex.clear();
+   playerList = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// findPlayer() -- Find the first player that matches 'id' and, if 'netID'
+// is greater than zero, 'netID'
+//------------------------------------------------------------------------------
+IPlayer* PlayerArray::findPlayer(const short id, const int netID) const
+{
+   if (netID > 0) {
+      const auto it = netIndex.find(netKey(id, netID));
+      if (it != netIndex.end()) return players[it->second];
+   } else {
+      const auto it = idIndex.find(id);
+      if (it != idIndex.end()) return players[it->second];
+   }
+   return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// findPlayerByName() -- Find the first player named 'name'
+//------------------------------------------------------------------------------
+IPlayer* PlayerArray::findPlayerByName(const std::string& name) const
+{
+   const auto it = nameIndex.find(name);
+   if (it != nameIndex.end()) return players[it->second];
+   return nullptr;
+}
+
+// Key of the network and player ID index
+std::uint64_t PlayerArray::netKey(const int id, const int netID)
+{
+   return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(netID)) << 32) | static_cast<std::uint32_t>(id);
+}
+
+}
+}
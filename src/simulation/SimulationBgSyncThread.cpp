@@ -4,7 +4,6 @@
 #include "mixr/simulation/ISimulation.hpp"
 
 #include "mixr/base/IComponent.hpp"
-#include "mixr/base/PairStream.hpp"
 
 namespace mixr {
 namespace simulation {
@@ -14,7 +13,7 @@ SimulationBgSyncThread::SimulationBgSyncThread(base::IComponent* const parent):
 }
 
 void SimulationBgSyncThread::start0(
-         base::PairStream* const pl1,
+         PlayerArray* const pl1,
          const double dt1,
          const unsigned int idx1,
          const unsigned int n1
@@ -30,7 +29,7 @@ void SimulationBgSyncThread::start0(
 
 unsigned long SimulationBgSyncThread::userFunc()
 {
-   // Make sure we've a player list and our index is valid ...
+   // Make sure we've a player array and our index is valid ...
    if (pl0 != nullptr && idx0 > 0 && idx0 <= n0) {
       // then call the simulation executives update TC player list functions
       ISimulation* sim{static_cast<ISimulation*>(getParent())};
@@ -0,0 +1,163 @@
+
+#include "SimulationTaskScheduler.hpp"
+
+#include "mixr/simulation/IPlayer.hpp"
+
+#include <chrono>
+#include <unordered_map>
+
+namespace mixr {
+namespace simulation {
+
+SimulationTaskScheduler::SimulationTaskScheduler(const unsigned int numSlots) : costs(numSlots)
+{
+}
+
+//------------------------------------------------------------------------------
+// setPlayers() -- set the new player array, if it has changed, and carry
+// over the cost history of the players that are still with us.
+//------------------------------------------------------------------------------
+void SimulationTaskScheduler::setPlayers(PlayerArray* const pa)
+{
+   if (static_cast<PlayerArray*>(players) == pa) return;
+
+   // Old player indices
+   std::unordered_map<const IPlayer*, unsigned int> oldIdx;
+   if (players != nullptr) {
+      for (unsigned int i = 0; i < players->getNumPlayers(); i++) {
+         oldIdx[players->getPlayer(i)] = i;
+      }
+   }
+
+   const unsigned int np{(pa != nullptr) ? pa->getNumPlayers() : 0};
+   for (std::vector<double>& cost : costs) {
+      std::vector<double> newCost(np);
+      for (unsigned int i = 0; i < np; i++) {
+         const auto it = oldIdx.find(pa->getPlayer(i));
+         if (it != oldIdx.end()) newCost[i] = cost[it->second];
+      }
+      cost.swap(newCost);
+   }
+
+   players = pa;
+   numWorkers = 0;
+}
+
+//------------------------------------------------------------------------------
+// prepare() -- build the chunks for cost slot 's' and deal them out to the
+// workers' deques
+//------------------------------------------------------------------------------
+void SimulationTaskScheduler::prepare(const unsigned int s, const unsigned int n)
+{
+   slot = (s < costs.size()) ? s : 0;
+   numWorkers = (n < MAX_WORKERS) ? n : MAX_WORKERS;
+   chunks.clear();
+   if (numWorkers == 0) return;
+
+   const unsigned int np{(players != nullptr) ? players->getNumPlayers() : 0};
+   const std::vector<double>& cost = costs[slot];
+
+   // Estimated cost of each player: new players (no history yet) are
+   // given the average cost of the others, or all are equal.
+   double known{};
+   unsigned int nKnown{};
+   for (unsigned int i = 0; i < np; i++) {
+      if (cost[i] > 0.0) { known += cost[i]; nKnown++; }
+   }
+   const double avg{(nKnown > 0) ? (known / nKnown) : 1.0};
+   std::vector<double> est(np);
+   double total{};
+   for (unsigned int i = 0; i < np; i++) {
+      est[i] = (cost[i] > 0.0) ? cost[i] : avg;
+      total += est[i];
+   }
+
+   // Chunks of consecutive players; a heavy player is a chunk by itself
+   const double chunkCost{total / (numWorkers * CHUNKS_PER_WORKER)};
+   std::vector<double> chunkCosts;
+   unsigned int begin{};
+   double acc{};
+   for (unsigned int i = 0; i < np; i++) {
+      acc += est[i];
+      if (acc >= chunkCost || i == (np - 1)) {
+         chunks.push_back( Chunk{begin, i + 1} );
+         chunkCosts.push_back(acc);
+         begin = i + 1;
+         acc = 0.0;
+      }
+   }
+
+   // Deal out consecutive chunks so that each worker starts with
+   // about the same total cost
+   const auto nc = static_cast<unsigned int>(chunks.size());
+   unsigned int head{};
+   double dealt{};
+   for (unsigned int w = 0; w < numWorkers; w++) {
+      unsigned int tail{head};
+      if (w == (numWorkers - 1)) {
+         tail = nc;
+      } else {
+         const double share{total * (w + 1) / numWorkers};
+         while (tail < nc && (dealt + chunkCosts[tail] * 0.5) < share) {
+            dealt += chunkCosts[tail];
+            tail++;
+         }
+      }
+      deques[w].range.store((static_cast<std::uint64_t>(head) << 32) | tail, std::memory_order_relaxed);
+      head = tail;
+   }
+}
+
+// True if we've been prepared for this player array and number of workers
+bool SimulationTaskScheduler::isPrepared(const PlayerArray* const pa, const unsigned int n) const
+{
+   return (pa != nullptr && players == pa && numWorkers == n);
+}
+
+//------------------------------------------------------------------------------
+// Deque operations
+//------------------------------------------------------------------------------
+
+// Owner takes the chunk at the head of its deque
+bool SimulationTaskScheduler::popFront(const unsigned int worker, unsigned int* const chunk)
+{
+   std::atomic<std::uint64_t>& range = deques[worker].range;
+   std::uint64_t r{range.load(std::memory_order_acquire)};
+   for (;;) {
+      const auto head = static_cast<unsigned int>(r >> 32);
+      const auto tail = static_cast<unsigned int>(r & 0xffffffff);
+      if (head >= tail) return false;
+      const std::uint64_t nr{(static_cast<std::uint64_t>(head + 1) << 32) | tail};
+      if (range.compare_exchange_weak(r, nr, std::memory_order_acq_rel, std::memory_order_acquire)) {
+         *chunk = head;
+         return true;
+      }
+   }
+}
+
+// Thief takes the chunk at the tail of the victim's deque
+bool SimulationTaskScheduler::stealBack(const unsigned int victim, unsigned int* const chunk)
+{
+   std::atomic<std::uint64_t>& range = deques[victim].range;
+   std::uint64_t r{range.load(std::memory_order_acquire)};
+   for (;;) {
+      const auto head = static_cast<unsigned int>(r >> 32);
+      const auto tail = static_cast<unsigned int>(r & 0xffffffff);
+      if (head >= tail) return false;
+      const std::uint64_t nr{(static_cast<std::uint64_t>(head) << 32) | (tail - 1)};
+      if (range.compare_exchange_weak(r, nr, std::memory_order_acq_rel, std::memory_order_acquire)) {
+         *chunk = tail - 1;
+         return true;
+      }
+   }
+}
+
+// Current time (seconds) for the cost history
+double SimulationTaskScheduler::now()
+{
+   using namespace std::chrono;
+   return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+}
+}
@@ -0,0 +1,131 @@
+
+#ifndef __mixr_simulation_SimulationTaskScheduler_HPP__
+#define __mixr_simulation_SimulationTaskScheduler_HPP__
+
+#include "mixr/simulation/PlayerArray.hpp"
+#include "mixr/base/safe_ptr.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace mixr {
+namespace simulation {
+class IPlayer;
+class PlayerArray;
+
+//------------------------------------------------------------------------------
+// Class: SimulationTaskScheduler
+// Description: Work-stealing scheduler used to distribute the players across the
+//              simulation's time critical or background thread pool.
+//
+//    setPlayers() takes the simulation's player array (see PlayerArray), which is
+//    only rebuilt when the player list changes.
+//
+//    prepare() splits the snapshot into chunks of consecutive players, sized using
+//    each player's cost (execution time) history for the given slot (e.g., T/C phase),
+//    and deals the chunks out to a deque for each worker thread, so that each worker
+//    starts with about the same amount of work.
+//
+//    run() is called by each worker thread, which processes the chunks from the
+//    front of its own deque and, once its deque is empty, steals chunks from the
+//    back of the other workers' deques, until all of the chunks are completed.
+//    The execution time of each player is saved for the next prepare().
+//
+//    Deques are lock-free: a deque's [ head, tail ) chunk range is a single
+//    atomic value that is updated using compare-and-swap by its owner (head)
+//    and by thieves (tail).
+//
+//    The parent thread must call setPlayers() and prepare() before it signals the
+//    workers to start, and must wait for all workers to complete before calling
+//    them again.
+//------------------------------------------------------------------------------
+class SimulationTaskScheduler final
+{
+public:
+   static const unsigned int MAX_WORKERS{32};
+
+   SimulationTaskScheduler(const unsigned int numSlots);
+   SimulationTaskScheduler(const SimulationTaskScheduler&) = delete;
+   SimulationTaskScheduler& operator=(const SimulationTaskScheduler&) = delete;
+
+   // Sets the player array, if it has changed
+   void setPlayers(PlayerArray* const playerArray);
+
+   // Builds and deals out the chunks for cost slot 'slot' to 'numWorkers' workers
+   void prepare(const unsigned int slot, const unsigned int numWorkers);
+
+   // True if we've been prepared for this player array and number of workers
+   bool isPrepared(const PlayerArray* const playerArray, const unsigned int numWorkers) const;
+
+   // Worker 'worker' [ 0 .. numWorkers-1 ] processes its chunks and then steals
+   // from the others; 'func' is called for each player
+   template <class F> void run(const unsigned int worker, F func);
+
+private:
+   // Target number of chunks per worker; more chunks give better balancing at
+   // the cost of more deque traffic
+   static const unsigned int CHUNKS_PER_WORKER{4};
+
+   struct Chunk {
+      unsigned int begin{};     // first player index
+      unsigned int end{};       // one past the last player index
+   };
+
+   struct alignas(64) Deque {
+      std::atomic<std::uint64_t> range{};    // chunk indices [ head, tail ): head in the upper 32 bits
+   };
+
+   bool popFront(const unsigned int worker, unsigned int* const chunk);
+   bool stealBack(const unsigned int victim, unsigned int* const chunk);
+   template <class F> void runChunk(const unsigned int chunk, F func);
+   static double now();
+
+   base::safe_ptr<PlayerArray> players;          // Player array (list order)
+   std::vector<std::vector<double>> costs;       // Player cost history (seconds) for each slot
+
+   std::vector<Chunk> chunks;                    // Chunks for the current slot
+   std::array<Deque, MAX_WORKERS> deques;        // Worker deques of chunk indices
+   unsigned int numWorkers{};                    // Number of workers prepared for
+   unsigned int slot{};                          // Current cost slot
+};
+
+template <class F>
+void SimulationTaskScheduler::run(const unsigned int worker, F func)
+{
+   if (worker >= numWorkers) return;
+
+   // Our own work first
+   unsigned int chunk{};
+   while (popFront(worker, &chunk)) {
+      runChunk(chunk, func);
+   }
+
+   // Then help the others
+   for (unsigned int i = 1; i < numWorkers; i++) {
+      const unsigned int victim{(worker + i) % numWorkers};
+      while (stealBack(victim, &chunk)) {
+         runChunk(chunk, func);
+      }
+   }
+}
+
+template <class F>
+void SimulationTaskScheduler::runChunk(const unsigned int chunk, F func)
+{
+   std::vector<double>& cost = costs[slot];
+   double t0{now()};
+   for (unsigned int i = chunks[chunk].begin; i < chunks[chunk].end; i++) {
+      func(players->getPlayer(i));
+      const double t1{now()};
+      // Smoothed cost history
+      cost[i] = (cost[i] > 0.0) ? (0.75 * cost[i] + 0.25 * (t1 - t0)) : (t1 - t0);
+      t0 = t1;
+   }
+}
+
+}
+}
+
+#endif
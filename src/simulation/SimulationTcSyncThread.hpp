@@ -5,8 +5,9 @@
 #include "mixr/base/threads/ISyncThread.hpp"
 
 namespace mixr {
-namespace base { class IComponent; class PairStream; }
+namespace base { class IComponent; }
 namespace simulation {
+class PlayerArray;
 
 //------------------------------------------------------------------------------
 // Class: SimulationTcSyncThread
@@ -19,7 +20,7 @@ public:
 
    // Parent thread signals start to this child thread with these parameters.
    void start0(
-      base::PairStream* const pl0,
+      PlayerArray* const pl0,
       const double dt0,
       const unsigned int idx0,
       const unsigned int n0
@@ -30,7 +31,7 @@ private:
    unsigned long userFunc() final;
 
 private:
-   base::PairStream* pl0{};
+   PlayerArray* pl0{};
    double dt0{};
    unsigned int idx0{};
    unsigned int n0{};
@@ -3,6 +3,9 @@
 
 #include "mixr/base/qty/util/angle_utils.hpp"
 #include "mixr/base/qty/util/length_utils.hpp"
+#include "mixr/base/util/nav_utils.hpp"
+
+#include <cmath>
 
 namespace mixr {
 namespace terrain {
@@ -42,6 +45,8 @@ void DataFile::copyData(const DataFile& org, const bool)
          }
       }
    } // end columns check
+
+   maxPyramid = org.maxPyramid;
 }
 
 void DataFile::deleteData()
@@ -49,6 +54,18 @@ void DataFile::deleteData()
     clearData();
 }
 
+//------------------------------------------------------------------------------
+// reset() -- loads the data (see ITerrain) and builds the max elevation pyramid
+//------------------------------------------------------------------------------
+void DataFile::reset()
+{
+   BaseClass::reset();
+
+   if (isDataLoaded() && maxPyramid.empty()) {
+      buildMaxPyramid();
+   }
+}
+
 //------------------------------------------------------------------------------
 // Access functions
 //------------------------------------------------------------------------------
@@ -102,6 +119,22 @@ const short* DataFile::getColumn(const unsigned int idx) const
    return p;
 }
 
+// Number of levels in the max elevation pyramid
+unsigned int DataFile::getNumMaxPyramidLevels() const
+{
+   return static_cast<unsigned int>(maxPyramid.size());
+}
+
+// Returns the k'th level of the max elevation pyramid
+const short* DataFile::getMaxPyramidLevel(const unsigned int k) const
+{
+   const short* p{};
+   if (k < maxPyramid.size()) {
+      p = maxPyramid[k].data();
+   }
+   return p;
+}
+
 // Has the data been loaded
 bool DataFile::isDataLoaded() const
 {
@@ -310,6 +343,272 @@ bool DataFile::getElevation(
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Locates the elevations (meters) of an array of reference points, and sets
+// their valid flags (if provided); returns the number of points found
+//------------------------------------------------------------------------------
+unsigned int DataFile::getElevationsBatch(
+      const double* const lats,     // Reference latitude array (degs)
+      const double* const lons,     // Reference longitude array (degs)
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found), or nullptr
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   // Early out tests
+   if ( !isDataLoaded() ||          // Not loaded or
+        lats == nullptr ||          // no latitudes or
+        lons == nullptr ||          // no longitudes or
+        elevations == nullptr ||    // no elevation array or
+        nptlat < 2 || nptlong < 2   // too few posts
+        ) return 0;
+
+   const double swLat{getLatitudeSW()};
+   const double swLon{getLongitudeSW()};
+   const double neLat{getLatitudeNE()};
+   const double neLon{getLongitudeNE()};
+
+   // Max post indices
+   const unsigned int maxRow{interp ? (nptlat-2) : (nptlat-1)};
+   const unsigned int maxCol{interp ? (nptlong-2) : (nptlong-1)};
+
+   // Nearest post, or the south-west corner post when interpolating
+   const double round{interp ? 0.0 : 0.5};
+
+   unsigned int num{};
+
+   bool found[BATCH_SIZE];
+   unsigned int irows[BATCH_SIZE];
+   unsigned int icols[BATCH_SIZE];
+   double deltaLat[BATCH_SIZE];
+   double deltaLon[BATCH_SIZE];
+   double elevSW[BATCH_SIZE];
+   double elevNW[BATCH_SIZE];
+   double elevSE[BATCH_SIZE];
+   double elevNE[BATCH_SIZE];
+
+   for (unsigned int i0 = 0; i0 < n; i0 += BATCH_SIZE) {
+      const unsigned int m{(n - i0) < BATCH_SIZE ? (n - i0) : BATCH_SIZE};
+      const double* const blat{&lats[i0]};
+      const double* const blon{&lons[i0]};
+
+      // ---
+      // Post indices and deltas from the posts; the points that are outside
+      // of the data are clamped to the edges, so their posts can be looked
+      // up as well (their elevations aren't returned)
+      // ---
+      for (unsigned int k = 0; k < m; k++) {
+         found[k] = (blat[k] >= swLat && blat[k] <= neLat && blon[k] >= swLon && blon[k] <= neLon);
+
+         double pointsLat{(blat[k] - swLat) / latSpacing};
+         if (!(pointsLat >= 0)) pointsLat = 0;
+         if (pointsLat > nptlat) pointsLat = nptlat;
+
+         double pointsLon{(blon[k] - swLon) / lonSpacing};
+         if (!(pointsLon >= 0)) pointsLon = 0;
+         if (pointsLon > nptlong) pointsLon = nptlong;
+
+         unsigned int irow{static_cast<unsigned int>(pointsLat + round)};
+         unsigned int icol{static_cast<unsigned int>(pointsLon + round)};
+         if (irow > maxRow) irow = maxRow;
+         if (icol > maxCol) icol = maxCol;
+
+         irows[k] = irow;
+         icols[k] = icol;
+         deltaLat[k] = pointsLat - static_cast<double>(irow);
+         deltaLon[k] = pointsLon - static_cast<double>(icol);
+      }
+
+      // ---
+      // Look up the elevation posts, and compute the elevations
+      // ---
+      if (interp) {
+         for (unsigned int k = 0; k < m; k++) {
+            const short* const west{columns[icols[k]] + irows[k]};
+            const short* const east{columns[icols[k]+1] + irows[k]};
+            elevSW[k] = static_cast<double>(west[0]);
+            elevNW[k] = static_cast<double>(west[1]);
+            elevSE[k] = static_cast<double>(east[0]);
+            elevNE[k] = static_cast<double>(east[1]);
+         }
+         for (unsigned int k = 0; k < m; k++) {
+            // Interpolate the west and east points, and then between them
+            const double westPoint{elevSW[k] + (elevNW[k] - elevSW[k]) * deltaLat[k]};
+            const double eastPoint{elevSE[k] + (elevNE[k] - elevSE[k]) * deltaLat[k]};
+            elevSW[k] = westPoint + (eastPoint - westPoint) * deltaLon[k];
+         }
+      } else {
+         for (unsigned int k = 0; k < m; k++) {
+            elevSW[k] = static_cast<double>(columns[icols[k]][irows[k]]);
+         }
+      }
+
+      // ---
+      // Return the elevations of the points that were found
+      // ---
+      for (unsigned int k = 0; k < m; k++) {
+         if (found[k]) {
+            elevations[i0 + k] = elevSW[k];
+            num++;
+         }
+         if (validFlags != nullptr) validFlags[i0 + k] = found[k];
+      }
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Target occulting: returns true if a target point [ tgtLat tgtLon tgtAlt ] is
+// occulted by the terrain as seen from the ref point [ refLat refLon refAlt ].
+//
+// This walks the same elevation points as ITerrain::targetOcculting(), but it
+// uses the max elevation pyramid to skip runs of points whose nearest posts
+// are all below the line of sight, so it only looks up the posts near the
+// line of sight.  Each point's location and range is still accumulated, step
+// by step, exactly as getElevations() and occultCheck() do, so the points that
+// are looked up, and the result, are the same.
+//------------------------------------------------------------------------------
+bool DataFile::targetOcculting(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const double refAlt,    // Ref altitude (meters)
+      const double tgtLat,    // Target latitude (degs)
+      const double tgtLon,    // Target longitude (degs)
+      const double tgtAlt     // Target altitude (meters)
+   ) const
+{
+   // Without the pyramid, use the default
+   if (maxPyramid.empty()) {
+      return BaseClass::targetOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+
+   // Same number of points as ITerrain::targetOcculting()
+   static const unsigned int MAX_POINTS{1200};
+
+   // Max number of points in a run, and the altitude margin (meters) that
+   // a run's posts must be below the line of sight to be skipped
+   static const unsigned int MAX_RUN{128};
+   static const double ALT_MARGIN{0.01};
+
+   bool occulted{};
+
+   // Compute bearing and distance to target (flat earth)
+   double brgDeg{};
+   double distNM{};
+   base::nav::fll2bd(refLat, refLon, tgtLat, tgtLon, &brgDeg, &distNM);
+   const double dist{distNM * base::length::NM2M};
+
+   // Number of points (default: 100M data)
+   unsigned int numPts{static_cast<unsigned int>((dist / 100.0f) + 0.5f)};
+   if (numPts > MAX_POINTS) numPts = MAX_POINTS;
+
+   // Early out tests (see getElevations() and occultCheck())
+   if ( numPts < 3 || refLat < -89.0 || refLat > 89.0 || dist <= 0 ) return occulted;
+
+   // Upper limit points
+   const double maxLatPoint{static_cast<double>(nptlat-1)};
+   const double maxLonPoint{static_cast<double>(nptlong-1)};
+
+   // Starting points
+   double pointsLat{(refLat - getLatitudeSW()) / latSpacing};
+   double pointsLon{(refLon - getLongitudeSW()) / lonSpacing};
+
+   // Spacing between points (in each direction)
+   const double deltaPoint{dist / (numPts - 1)};
+   const double dirR{brgDeg * base::angle::D2RCC};
+   const double deltaNorth{deltaPoint * std::cos(dirR) * base::length::M2NM};  // (NM)
+   const double deltaEast{deltaPoint * std::sin(dirR) * base::length::M2NM};
+   const double deltaLat{deltaNorth/60.0};
+   const double deltaLon{deltaEast/(60.0 * std::cos(refLat * base::angle::D2RCC))};
+   const double deltaPointsLat{deltaLat / latSpacing};
+   const double deltaPointsLon{deltaLon / lonSpacing};
+
+   // Tangent of the angle to the target point, and the range between points
+   const double tgtTan{(tgtAlt - refAlt) / dist};
+   const double deltaRng{dist / (numPts - 1)};
+   double currentRange{};
+
+   // Skip the ref point
+   pointsLat += deltaPointsLat;
+   pointsLon += deltaPointsLon;
+
+   // ---
+   // Check points [ 1 .. numPts-2 ] in runs of points; a run is skipped if its
+   // posts are below the line of sight, otherwise the run is split in half,
+   // until the run is a single point that's checked using its elevation post.
+   // ---
+   unsigned int run{MAX_RUN};
+   unsigned int i{1};
+   while (i < (numPts-1) && !occulted) {
+
+      if (run > (numPts - 1 - i)) run = (numPts - 1 - i);
+
+      if (run > 1) {
+         // Rows and columns of the run's nearest posts, plus a one post margin
+         const double lat1{pointsLat + deltaPointsLat * (run - 1)};
+         const double lon1{pointsLon + deltaPointsLon * (run - 1)};
+         const double rowLo{std::floor(std::fmin(pointsLat, lat1) - 0.5)};
+         const double rowHi{std::floor(std::fmax(pointsLat, lat1) + 1.5)};
+         const double colLo{std::floor(std::fmin(pointsLon, lon1) - 0.5)};
+         const double colHi{std::floor(std::fmax(pointsLon, lon1) + 1.5)};
+
+         bool skip{true};
+         if (rowHi >= 0 && rowLo <= maxLatPoint && colHi >= 0 && colLo <= maxLonPoint) {
+            // Lowest point of the line of sight over the run (with an extra
+            // point of range when it's descending)
+            double rng{currentRange + deltaRng};
+            if (tgtTan < 0) rng = currentRange + deltaRng * (run + 1);
+            const double minAlt{refAlt + tgtTan * rng - ALT_MARGIN};
+
+            const unsigned int irow0{rowLo > 0 ? static_cast<unsigned int>(rowLo) : 0};
+            const unsigned int icol0{colLo > 0 ? static_cast<unsigned int>(colLo) : 0};
+            const unsigned int irow1{rowHi < maxLatPoint ? static_cast<unsigned int>(rowHi) : (nptlat-1)};
+            const unsigned int icol1{colHi < maxLonPoint ? static_cast<unsigned int>(colHi) : (nptlong-1)};
+            skip = (static_cast<double>(getMaxElevation(irow0, irow1, icol0, icol1)) < minAlt);
+         }
+
+         if (skip) {
+            // Step over the run
+            for (unsigned int k = 0; k < run; k++) {
+               currentRange += deltaRng;
+               pointsLat += deltaPointsLat;
+               pointsLon += deltaPointsLon;
+            }
+            i += run;
+            if (run < MAX_RUN) run *= 2;
+         } else {
+            // Split the run
+            run /= 2;
+         }
+      }
+
+      else {
+         // Check this point using its nearest post
+         currentRange += deltaRng;
+         if ( (pointsLat >= 0 && pointsLat <= maxLatPoint) &&
+              (pointsLon >= 0 && pointsLon <= maxLonPoint) ) {
+            unsigned int irow{static_cast<unsigned int>(pointsLat + 0.5)};
+            unsigned int icol{static_cast<unsigned int>(pointsLon + 0.5)};
+            if (irow >= nptlat) irow = (nptlat-1);
+            if (icol >= nptlong) icol = (nptlong-1);
+
+            const double tstTan{(static_cast<double>(columns[icol][irow]) - refAlt) / currentRange};
+            if (tstTan >= tgtTan) {
+               occulted = true;
+            }
+         }
+         pointsLat += deltaPointsLat;
+         pointsLon += deltaPointsLon;
+         i++;
+         run = 2;
+      }
+   }
+
+   return occulted;
+}
+
 //------------------------------------------------------------------------------
 // Computes the nearest row index for the latitude (degs).
 // Returns true if the index is valid
@@ -394,6 +693,77 @@ bool DataFile::computeLongitude(double* const lon, const unsigned int icol) cons
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Builds the max elevation pyramid from the columns of elevation data
+//------------------------------------------------------------------------------
+void DataFile::buildMaxPyramid()
+{
+   maxPyramid.clear();
+   if (!isDataLoaded() || nptlat == 0 || nptlong == 0) return;
+
+   // The first level is built from the posts, and each level after
+   // that is built from the level before it, until we're down to one.
+   unsigned int nrows{nptlat};
+   unsigned int ncols{nptlong};
+   while (nrows > 1 || ncols > 1) {
+      const unsigned int nrows1{(nrows - 1) / 2 + 1};
+      const unsigned int ncols1{(ncols - 1) / 2 + 1};
+      const std::vector<short>* const prev{maxPyramid.empty() ? nullptr : &maxPyramid.back()};
+
+      std::vector<short> level(static_cast<std::size_t>(nrows1) * ncols1);
+      for (unsigned int icol = 0; icol < ncols1; icol++) {
+         for (unsigned int irow = 0; irow < nrows1; irow++) {
+            short value{-32768};
+            for (unsigned int c = 2*icol; c < (2*icol + 2) && c < ncols; c++) {
+               for (unsigned int r = 2*irow; r < (2*irow + 2) && r < nrows; r++) {
+                  const short e{prev != nullptr ? (*prev)[static_cast<std::size_t>(c) * nrows + r] : columns[c][r]};
+                  if (e > value) value = e;
+               }
+            }
+            level[static_cast<std::size_t>(icol) * nrows1 + irow] = value;
+         }
+      }
+      maxPyramid.push_back(std::move(level));
+
+      nrows = nrows1;
+      ncols = ncols1;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Sets the max elevation pyramid (e.g., from a file)
+//------------------------------------------------------------------------------
+void DataFile::setMaxPyramid(std::vector< std::vector<short> >& levels)
+{
+   maxPyramid.swap(levels);
+}
+
+//------------------------------------------------------------------------------
+// Max elevation of the posts in rows [ irow0 .. irow1 ] and columns [ icol0 .. icol1 ]
+//------------------------------------------------------------------------------
+short DataFile::getMaxElevation(
+      const unsigned int irow0, const unsigned int irow1,
+      const unsigned int icol0, const unsigned int icol1
+   ) const
+{
+   // Find the first level where the posts are within a 2x2 block of elevations
+   unsigned int shift{};
+   while ( ((irow1 >> shift) - (irow0 >> shift)) > 1 || ((icol1 >> shift) - (icol0 >> shift)) > 1 ) {
+      shift++;
+   }
+   if (shift > maxPyramid.size()) shift = static_cast<unsigned int>(maxPyramid.size());
+
+   short value{-32768};
+   const unsigned int nrows{((nptlat - 1) >> shift) + 1};
+   for (unsigned int c = (icol0 >> shift); c <= (icol1 >> shift); c++) {
+      for (unsigned int r = (irow0 >> shift); r <= (irow1 >> shift); r++) {
+         const short e{shift > 0 ? maxPyramid[shift-1][static_cast<std::size_t>(c) * nrows + r] : columns[c][r]};
+         if (e > value) value = e;
+      }
+   }
+   return value;
+}
+
 //------------------------------------------------------------------------------
 // clear our data
 //------------------------------------------------------------------------------
@@ -413,6 +783,9 @@ void DataFile::clearData()
       columns = nullptr;
    }
 
+   // Delete the max elevation pyramid
+   maxPyramid.clear();
+
    nptlat = 0;
    nptlong = 0;
 
@@ -423,6 +796,8 @@ void DataFile::clearData()
 
    setMinElevation(0);
    setMaxElevation(0);
+
+   BaseClass::clearData();
 }
 
 }
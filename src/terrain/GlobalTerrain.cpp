@@ -0,0 +1,369 @@
+
+#include "mixr/terrain/GlobalTerrain.hpp"
+
+#include "TerrainPrefetchPeriodicThread.hpp"
+
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/qty/times.hpp"
+#include "mixr/base/qty/util/length_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/nav_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(GlobalTerrain, "GlobalTerrain")
+
+BEGIN_SLOTTABLE(GlobalTerrain)
+   "cellFormat",     // 1) Format of the cells in the 'path' directory tree
+   "prefetchTime",   // 2) Look ahead time along the ownship paths
+END_SLOTTABLE(GlobalTerrain)
+
+BEGIN_SLOT_MAP(GlobalTerrain)
+   ON_SLOT(1, setSlotCellFormat,   base::Identifier)
+   ON_SLOT(2, setSlotPrefetchTime, base::ITime)
+END_SLOT_MAP()
+
+GlobalTerrain::GlobalTerrain()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void GlobalTerrain::copyData(const GlobalTerrain& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   cellFormat = org.cellFormat;
+   prefetchTime = org.prefetchTime;
+   paths.clear();
+   prefetchThread = nullptr;
+
+   if (org.isDataLoaded()) {
+      loadData();
+   }
+}
+
+void GlobalTerrain::deleteData()
+{
+   prefetchThread = nullptr;
+   clearData();
+}
+
+//------------------------------------------------------------------------------
+// reset() -- loads the data (see ITerrain) and starts the prefetch thread
+//------------------------------------------------------------------------------
+void GlobalTerrain::reset()
+{
+   BaseClass::reset();
+
+   if (prefetchTime > 0.0 && isDataLoaded() && !isShutdown()) {
+      createPrefetchThread();
+   }
+}
+
+bool GlobalTerrain::shutdownNotification()
+{
+   // The thread terminates once we're shutdown
+   prefetchThread = nullptr;
+   return BaseClass::shutdownNotification();
+}
+
+//------------------------------------------------------------------------------
+// createPrefetchThread() -- creates the (low priority) prefetch thread
+//------------------------------------------------------------------------------
+void GlobalTerrain::createPrefetchThread()
+{
+   if (prefetchThread == nullptr) {
+      prefetchThread = new TerrainPrefetchPeriodicThread(this, PREFETCH_RATE);
+      prefetchThread->unref(); // 'prefetchThread' is a safe_ptr<>
+
+      bool ok{prefetchThread->start(0.0)};
+      if (!ok) {
+         prefetchThread = nullptr;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "GlobalTerrain::createPrefetchThread(): ERROR, failed to create the thread!" << std::endl;
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Access functions
+//------------------------------------------------------------------------------
+
+// Has the data been loaded
+bool GlobalTerrain::isDataLoaded() const
+{
+   return !grid.empty();
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool GlobalTerrain::setCellFormat(const CellFormat fmt)
+{
+   cellFormat = fmt;
+   return true;
+}
+
+bool GlobalTerrain::setPrefetchTime(const double seconds)
+{
+   bool ok{seconds >= 0.0};
+   if (ok) prefetchTime = seconds;
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Load the data -- maps the 'files' and builds the grid directory
+//------------------------------------------------------------------------------
+bool GlobalTerrain::loadData()
+{
+   BaseClass::loadData();
+
+   dir.clear();
+   const char* const p{getPathname()};
+   if (p != nullptr) {
+      dir = p;
+      dir += '/';
+   }
+
+   lockTilesNoIo();
+
+   // Index the mapped cells in each one degree square that they overlap;
+   // the first cell is used where they overlap
+   const int entry{(cellFormat != CellFormat::NONE) ? UNKNOWN_CELL : NO_CELL};
+   grid.assign(NUM_LAT * NUM_LON, entry);
+   for (unsigned int i = 0; i < getNumCells(); i++) {
+      const Cell* const cell{getCell(i)};
+      const int lat0{static_cast<int>(std::floor(cell->swLat)) + 90};
+      const int lon0{static_cast<int>(std::floor(cell->swLon)) + 180};
+      int lat1{static_cast<int>(std::ceil(cell->neLat)) + 90 - 1};
+      int lon1{static_cast<int>(std::ceil(cell->neLon)) + 180 - 1};
+      if (lat1 < lat0) lat1 = lat0;
+      if (lon1 < lon0) lon1 = lon0;
+      for (int ilat = lat0; ilat <= lat1; ilat++) {
+         for (int ilon = lon0; ilon <= lon1; ilon++) {
+            if (ilat >= 0 && ilat < NUM_LAT && ilon >= 0 && ilon < NUM_LON && grid[ilat * NUM_LON + ilon] < 0) {
+               grid[ilat * NUM_LON + ilon] = static_cast<int>(i);
+            }
+         }
+      }
+   }
+
+   unlockTiles();
+
+   // The directory tree can cover the globe
+   if (cellFormat != CellFormat::NONE) {
+      setLatitudeSW(-90.0);
+      setLongitudeSW(-180.0);
+      setLatitudeNE(90.0);
+      setLongitudeNE(180.0);
+   }
+
+   return isDataLoaded();
+}
+
+//------------------------------------------------------------------------------
+// clearData() -- clears the grid directory and unmaps the cells
+//------------------------------------------------------------------------------
+void GlobalTerrain::clearData()
+{
+   lockTilesNoIo();
+   grid.clear();
+   unlockTiles();
+
+   BaseClass::clearData();
+}
+
+//------------------------------------------------------------------------------
+// findCell() -- returns the index of the cell that contains the point, or -1
+//------------------------------------------------------------------------------
+int GlobalTerrain::findCell(const double lat, const double lon) const
+{
+   if (grid.empty() || lat < -90.0 || lat > 90.0 || !std::isfinite(lon)) return NO_CELL;
+
+   // (longitude wrapped to [ -180 .. 180 ); see isInCell())
+   const double wlon{lon - 360.0 * std::floor((lon + 180.0) / 360.0)};
+   const double flat{std::floor(lat)};
+   const double flon{std::floor(wlon)};
+   const int ilat{static_cast<int>(flat) + 90};
+   const int ilon{static_cast<int>(flon) + 180};
+
+   // The point's square, and the squares to the south and west when
+   // it's on their edge
+   const int nlat{(lat == flat) ? 2 : 1};
+   const int nlon{(wlon == flon) ? 2 : 1};
+   for (int i = 0; i < nlat; i++) {
+      for (int j = 0; j < nlon; j++) {
+         const int r{ilat - i};
+         const int c{(ilon - j + NUM_LON) % NUM_LON};
+         if (r >= 0 && r < NUM_LAT) {
+            const int icell{gridCell(r, c)};
+            if (icell >= 0 && isInCell(*getCell(icell), lat, wlon)) return icell;
+         }
+      }
+   }
+   return NO_CELL;
+}
+
+//------------------------------------------------------------------------------
+// gridCell() -- returns the cell index of the grid square, mapping the cell's
+// file from the directory tree when it's first used
+//------------------------------------------------------------------------------
+int GlobalTerrain::gridCell(const int ilat, const int ilon) const
+{
+   const int index{ilat * NUM_LON + ilon};
+   if (grid[index] == UNKNOWN_CELL) {
+      // Open and map the file without holding the lock, and then add the
+      // cell, unless another thread has added it meanwhile
+      const std::string filename{cellFilename(ilat, ilon)};
+      suspendTilesLock();
+      Cell* cell{mapCell(filename)};
+      resumeTilesLock();
+      if (grid[index] == UNKNOWN_CELL) {
+         grid[index] = (cell != nullptr) ? insertCell(cell) : NO_CELL;
+         cell = nullptr;
+      }
+      delete cell;
+   }
+   return grid[index];
+}
+
+//------------------------------------------------------------------------------
+// cellFilename() -- file name of the cell at the grid square
+//------------------------------------------------------------------------------
+std::string GlobalTerrain::cellFilename(const int ilat, const int ilon) const
+{
+   const int lat{ilat - 90};
+   const int lon{ilon - 180};
+   char name[32]{};
+   switch (cellFormat) {
+      case CellFormat::DTED0:
+      case CellFormat::DTED1:
+      case CellFormat::DTED2: {
+         const int level{cellFormat == CellFormat::DTED0 ? 0 : (cellFormat == CellFormat::DTED1 ? 1 : 2)};
+         std::snprintf(name, sizeof(name), "%c%03d/%c%02d.dt%d",
+            (lon < 0 ? 'w' : 'e'), std::abs(lon), (lat < 0 ? 's' : 'n'), std::abs(lat), level);
+         break;
+      }
+      case CellFormat::SRTM: {
+         std::snprintf(name, sizeof(name), "%c%02d%c%03d.hgt",
+            (lat < 0 ? 'S' : 'N'), std::abs(lat), (lon < 0 ? 'W' : 'E'), std::abs(lon));
+         break;
+      }
+      case CellFormat::NONE: break;
+   }
+   return dir + name;
+}
+
+//------------------------------------------------------------------------------
+// Sets the predicted path of an ownship
+//------------------------------------------------------------------------------
+void GlobalTerrain::setOwnshipPath(
+      const void* const id,
+      const double lat,
+      const double lon,
+      const double direction,
+      const double speed
+   )
+{
+   if (id == nullptr) return;
+
+   base::lock(pathSemaphore);
+   Path* path{};
+   for (Path& p : paths) {
+      if (p.id == id) path = &p;
+   }
+   if (path == nullptr) {
+      paths.emplace_back();
+      path = &paths.back();
+      path->id = id;
+   }
+   path->lat = lat;
+   path->lon = lon;
+   path->direction = direction;
+   path->speed = speed;
+   path->time = std::chrono::steady_clock::now();
+   base::unlock(pathSemaphore);
+}
+
+//------------------------------------------------------------------------------
+// prefetchPaths() -- pages in the tiles along the ownship paths
+//------------------------------------------------------------------------------
+void GlobalTerrain::prefetchPaths()
+{
+   static const unsigned int MAX_POINTS{1000};
+
+   // Drop the stale paths, and make a copy of the others
+   std::vector<Path> current;
+   {
+      const auto now = std::chrono::steady_clock::now();
+      base::lock(pathSemaphore);
+      for (auto it = paths.begin(); it != paths.end(); ) {
+         if (std::chrono::duration<double>(now - it->time).count() > STALE_TIME) {
+            it = paths.erase(it);
+         } else {
+            current.push_back(*it);
+            ++it;
+         }
+      }
+      base::unlock(pathSemaphore);
+   }
+
+   for (const Path& path : current) {
+      // Points along the path, starting at the ownship
+      const double dist{path.speed * prefetchTime};
+      unsigned int n{static_cast<unsigned int>(dist / PREFETCH_STEP) + 1};
+      if (n > MAX_POINTS) n = MAX_POINTS;
+      const double step{(n > 1) ? (dist / (n - 1)) : 0.0};
+      for (unsigned int i = 0; i < n && !isShutdown(); i++) {
+         double lat{path.lat};
+         double lon{path.lon};
+         if (i > 0) {
+            base::nav::fbd2ll(path.lat, path.lon, path.direction, (step * i * base::length::M2NM), &lat, &lon);
+         }
+         prefetch(lat, lon);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool GlobalTerrain::setSlotCellFormat(const base::Identifier* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      if (*msg == "dted0")      ok = setCellFormat(CellFormat::DTED0);
+      else if (*msg == "dted1") ok = setCellFormat(CellFormat::DTED1);
+      else if (*msg == "dted2") ok = setCellFormat(CellFormat::DTED2);
+      else if (*msg == "srtm")  ok = setCellFormat(CellFormat::SRTM);
+      else {
+         std::cerr << "GlobalTerrain::setSlotCellFormat(): invalid cell format: " << *msg << std::endl;
+         std::cerr << " -- valid formats are { dted0, dted1, dted2, srtm }" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool GlobalTerrain::setSlotPrefetchTime(const base::ITime* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = setPrefetchTime(msg->getValueInSeconds());
+      if (!ok) {
+         std::cerr << "GlobalTerrain::setSlotPrefetchTime(): invalid time; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+}
+}
@@ -73,12 +73,45 @@ void ITerrain::reset()
 {
    if ( !isDataLoaded() ) {
       loadData();
+      dataVersion++;
    }
 
    BaseClass::reset();
 }
 
 void ITerrain::clearData()
+{
+   dataVersion++;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevations (meters) of an array of reference points (default:
+// one getElevation() call per point); returns the number of points found
+//------------------------------------------------------------------------------
+unsigned int ITerrain::getElevationsBatch(
+      const double* const lats,     // Reference latitude array (degs)
+      const double* const lons,     // Reference longitude array (degs)
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found), or nullptr
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   if (lats == nullptr || lons == nullptr || elevations == nullptr) return 0;
+
+   unsigned int num{};
+   for (unsigned int i = 0; i < n; i++) {
+      const bool found{getElevation(&elevations[i], lats[i], lons[i], interp)};
+      if (validFlags != nullptr) validFlags[i] = found;
+      if (found) num++;
+   }
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Sets the predicted path of an ownship (default: ignored)
+//------------------------------------------------------------------------------
+void ITerrain::setOwnshipPath(const void* const, const double, const double, const double, const double)
 {
 }
 
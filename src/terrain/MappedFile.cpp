@@ -0,0 +1,97 @@
+
+#include "mixr/terrain/MappedFile.hpp"
+
+#if defined(WIN32)
+   #include <windows.h>
+#else
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
+
+namespace mixr {
+namespace terrain {
+
+MappedFile::~MappedFile()
+{
+   close();
+}
+
+//------------------------------------------------------------------------------
+// open() -- maps the file; returns true if successful
+//------------------------------------------------------------------------------
+bool MappedFile::open(const char* const filename)
+{
+   close();
+   if (filename == nullptr) return false;
+
+#if defined(WIN32)
+   HANDLE f{ CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+   if (f == INVALID_HANDLE_VALUE) return false;
+
+   LARGE_INTEGER len{};
+   if (!GetFileSizeEx(f, &len) || len.QuadPart <= 0) {
+      CloseHandle(f);
+      return false;
+   }
+
+   HANDLE m{ CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+   if (m == nullptr) {
+      CloseHandle(f);
+      return false;
+   }
+
+   void* p{ MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) };
+   if (p == nullptr) {
+      CloseHandle(m);
+      CloseHandle(f);
+      return false;
+   }
+
+   hFile = f;
+   hMapping = m;
+   data = static_cast<const unsigned char*>(p);
+   size = static_cast<std::size_t>(len.QuadPart);
+#else
+   const int fd{ ::open(filename, O_RDONLY) };
+   if (fd < 0) return false;
+
+   struct stat st{};
+   if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      return false;
+   }
+
+   void* p{ ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+   // (the mapping holds its own reference to the file)
+   ::close(fd);
+   if (p == MAP_FAILED) return false;
+
+   data = static_cast<const unsigned char*>(p);
+   size = static_cast<std::size_t>(st.st_size);
+#endif
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// close() -- unmaps the file
+//------------------------------------------------------------------------------
+void MappedFile::close()
+{
+#if defined(WIN32)
+   if (data != nullptr) UnmapViewOfFile(data);
+   if (hMapping != nullptr) CloseHandle(hMapping);
+   if (hFile != nullptr) CloseHandle(hFile);
+   hMapping = nullptr;
+   hFile = nullptr;
+#else
+   if (data != nullptr) ::munmap(const_cast<unsigned char*>(data), size);
+#endif
+   data = nullptr;
+   size = 0;
+}
+
+}
+}
@@ -0,0 +1,128 @@
+
+#include "mixr/terrain/OccultingCache.hpp"
+
+#include "mixr/terrain/ITerrain.hpp"
+
+#include "mixr/base/IReferenced.hpp"
+
+#include "mixr/base/qty/util/angle_utils.hpp"
+#include "mixr/base/qty/util/length_utils.hpp"
+
+#include <cmath>
+
+namespace mixr {
+namespace terrain {
+
+OccultingCache::OccultingCache(const double x)
+{
+   setTolerance(x);
+}
+
+OccultingCache::~OccultingCache()
+{
+   clear();
+}
+
+// Sets the tolerance distance (meters), and clears the cache
+void OccultingCache::setTolerance(const double meters)
+{
+   tolerance = (meters > 0 ? meters : 0);
+   clear();
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the target, 'key', is occulted by the terrain as seen from
+// the ref point; uses the cached result if neither point has moved more than
+// the tolerance distance since it was computed.
+//------------------------------------------------------------------------------
+bool OccultingCache::targetOcculting(
+      const ITerrain* const terrain,
+      const base::IReferenced* const key,
+      const double refLat,
+      const double refLon,
+      const double refAlt,
+      const double tgtLat,
+      const double tgtLon,
+      const double tgtAlt
+   )
+{
+   if (terrain == nullptr) return false;
+
+   // No cache
+   if (tolerance <= 0 || key == nullptr) {
+      numMisses++;
+      return terrain->targetOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+
+   const unsigned int dataVersion{terrain->getDataVersion()};
+   const auto result = entries.try_emplace(key);
+   if (result.second) key->ref();
+   Entry& entry{result.first->second};
+   const bool valid{
+         entry.terrain == terrain &&
+         entry.dataVersion == dataVersion &&
+         isWithinTolerance(entry.refLat, entry.refLon, entry.refAlt, refLat, refLon, refAlt) &&
+         isWithinTolerance(entry.tgtLat, entry.tgtLon, entry.tgtAlt, tgtLat, tgtLon, tgtAlt)
+      };
+
+   if (valid) {
+      numHits++;
+   } else {
+      numMisses++;
+      entry.terrain = terrain;
+      entry.dataVersion = dataVersion;
+      entry.refLat = refLat;
+      entry.refLon = refLon;
+      entry.refAlt = refAlt;
+      entry.tgtLat = tgtLat;
+      entry.tgtLon = tgtLon;
+      entry.tgtAlt = tgtAlt;
+      entry.occulted = terrain->targetOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+   entry.used = true;
+
+   return entry.occulted;
+}
+
+//------------------------------------------------------------------------------
+// Removes the entries that weren't used since the previous update()
+//------------------------------------------------------------------------------
+void OccultingCache::update()
+{
+   auto it = entries.begin();
+   while (it != entries.end()) {
+      if (it->second.used) {
+         it->second.used = false;
+         ++it;
+      } else {
+         it->first->unref();
+         it = entries.erase(it);
+      }
+   }
+}
+
+// Removes all entries
+void OccultingCache::clear()
+{
+   for (const auto& e : entries) {
+      e.first->unref();
+   }
+   entries.clear();
+}
+
+//------------------------------------------------------------------------------
+// True if point #2 is within the tolerance distance of point #1 (flat earth)
+//------------------------------------------------------------------------------
+bool OccultingCache::isWithinTolerance(
+      const double lat1, const double lon1, const double alt1,
+      const double lat2, const double lon2, const double alt2
+   ) const
+{
+   const double north{(lat2 - lat1) * 60.0 * base::length::NM2M};
+   const double east{(lon2 - lon1) * 60.0 * base::length::NM2M * std::cos(lat1 * base::angle::D2RCC)};
+   const double up{alt2 - alt1};
+   return ((north * north + east * east + up * up) <= (tolerance * tolerance));
+}
+
+}
+}
@@ -0,0 +1,842 @@
+
+#include "mixr/terrain/PagedTerrain.hpp"
+#include "mixr/terrain/cache/TerrainCacheFile.hpp"
+
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/String.hpp"
+#include "mixr/base/qty/util/angle_utils.hpp"
+#include "mixr/base/qty/util/length_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(PagedTerrain, "PagedTerrain")
+
+BEGIN_SLOTTABLE(PagedTerrain)
+   "files",          // 1) Cell file names
+   "maxTiles",       // 2) Max number of tiles in the tile cache
+END_SLOTTABLE(PagedTerrain)
+
+BEGIN_SLOT_MAP(PagedTerrain)
+   ON_SLOT(1, setSlotFiles,    base::PairStream)
+   ON_SLOT(2, setSlotMaxTiles, base::Integer)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Cell file formats (see DtedFile, SrtmHgtFile and DedFile)
+//------------------------------------------------------------------------------
+static const std::size_t DTED_DATA_OFFSET{3428};      // UHL + DSI (648) + ACC (2700) records
+static const std::size_t DTED_COL_HEADER{8};          // Column record header
+static const std::size_t DTED_COL_FOOTER{4};          // Column record checksum
+static const unsigned char DTED_DATA_SENTINEL{170};   // 252 base 8
+
+static const std::size_t DED_STD_HDR_SIZE{128};       // Standard file header
+static const std::size_t DED_STATS_SIZE{32};          // Statistics record
+static const std::size_t DED_CELL_HDR_SIZE{40};       // Cell header
+static const double DED_SECS_PER_DEG_10{36000.0};     // # seconds in a degree * 10.0
+
+// Signed-magnitude value, high byte first (DTED and SRTM)
+static short signedMagnitude(const unsigned char* const p)
+{
+   short height{static_cast<short>(256 * static_cast<short>(p[0] & 0177) + static_cast<short>(p[1]))};
+   if (p[0] & ~0177) height = -height;
+   return height;
+}
+
+// Two's complement value, high byte first (DED)
+static short bigEndian16(const unsigned char* const p)
+{
+   return static_cast<short>((static_cast<unsigned int>(p[0]) << 8) | p[1]);
+}
+
+static std::uint32_t bigEndian32(const unsigned char* const p)
+{
+   return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16) |
+          (static_cast<std::uint32_t>(p[2]) << 8)  |  static_cast<std::uint32_t>(p[3]);
+}
+
+static float bigEndianFloat(const unsigned char* const p)
+{
+   const std::uint32_t v{bigEndian32(p)};
+   float f{};
+   std::memcpy(&f, &v, sizeof(f));
+   return f;
+}
+
+// Integer value of a fixed length text field
+static int textValue(const unsigned char* const p, const std::size_t n)
+{
+   char buff[16]{};
+   std::memcpy(buff, p, (n < sizeof(buff) ? n : sizeof(buff) - 1));
+   return std::atoi(buff);
+}
+
+PagedTerrain::PagedTerrain()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void PagedTerrain::copyData(const PagedTerrain& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   fileNames = org.fileNames;
+   maxTiles = org.maxTiles;
+
+   // Map our own copy of the files
+   if (org.isDataLoaded()) {
+      loadData();
+   }
+}
+
+void PagedTerrain::deleteData()
+{
+   clearData();
+}
+
+//------------------------------------------------------------------------------
+// Access functions
+//------------------------------------------------------------------------------
+
+// Has the data been loaded
+bool PagedTerrain::isDataLoaded() const
+{
+   return !cells.empty();
+}
+
+// Number of tiles in the cache
+unsigned int PagedTerrain::getNumTiles() const
+{
+   lockTiles();
+   const auto n = static_cast<unsigned int>(tiles.size());
+   unlockTiles();
+   return n;
+}
+
+void PagedTerrain::lockTiles() const
+{
+   base::lock(semaphore);
+}
+
+void PagedTerrain::unlockTiles() const
+{
+   base::unlock(semaphore);
+}
+
+void PagedTerrain::suspendTilesLock() const
+{
+   numIo++;
+   unlockTiles();
+}
+
+void PagedTerrain::resumeTilesLock() const
+{
+   lockTiles();
+   numIo--;
+}
+
+void PagedTerrain::lockTilesNoIo() const
+{
+   lockTiles();
+   while (numIo > 0) {
+      unlockTiles();
+      std::this_thread::yield();
+      lockTiles();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+// Sets the max number of tiles in the cache (at least four)
+bool PagedTerrain::setMaxTiles(const unsigned int n)
+{
+   // (at least four tiles, so the posts around a point that's interpolated are in the cache)
+   const bool ok{n >= 4};
+   if (ok) {
+      lockTiles();
+      maxTiles = n;
+      while (tiles.size() > maxTiles) {
+         tileMap.erase(tiles.back().key);
+         tiles.pop_back();
+      }
+      spares.clear();
+      lastTile = (tiles.empty() ? nullptr : &tiles.front());
+      unlockTiles();
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Load the data -- maps the cell files
+//------------------------------------------------------------------------------
+bool PagedTerrain::loadData()
+{
+   clearData();
+
+   std::vector<std::string> names;
+   if (getFilename() != nullptr) {
+      names.push_back(getFilename());
+   }
+   names.insert(names.end(), fileNames.begin(), fileNames.end());
+
+   std::string dir;
+   const char* const p{getPathname()};
+   if (p != nullptr) {
+      dir = p;
+      dir += '/';
+   }
+
+   for (const std::string& name : names) {
+      addFile((dir + name).c_str());
+   }
+
+   return isDataLoaded();
+}
+
+//------------------------------------------------------------------------------
+// addFile() -- maps a DTED, SRTM or DED cell file; returns true if successful
+//------------------------------------------------------------------------------
+bool PagedTerrain::addFile(const char* const filename)
+{
+   if (filename == nullptr) return false;
+
+   Cell* const cell{mapCell(filename)};
+   if (cell == nullptr) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "PagedTerrain::addFile() ERROR, could not map cell file: " << filename << std::endl;
+      }
+      return false;
+   }
+
+   // Update our corner points and elevations
+   const bool first{cells.empty()};
+   if (first || cell->swLat < getLatitudeSW())  setLatitudeSW(cell->swLat);
+   if (first || cell->swLon < getLongitudeSW()) setLongitudeSW(cell->swLon);
+   if (first || cell->neLat > getLatitudeNE())  setLatitudeNE(cell->neLat);
+   if (first || cell->neLon > getLongitudeNE()) setLongitudeNE(cell->neLon);
+   if (cell->hasElevations) {
+      if (first || cell->minElev < getMinElevation()) setMinElevation(cell->minElev);
+      if (first || cell->maxElev > getMaxElevation()) setMaxElevation(cell->maxElev);
+   }
+
+   lockTiles();
+   insertCell(cell);
+   unlockTiles();
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// mapCell() -- maps a cell file; returns the new cell, or nullptr
+//------------------------------------------------------------------------------
+PagedTerrain::Cell* PagedTerrain::mapCell(const std::string& filename) const
+{
+   // Format by file extension
+   std::string ext;
+   const std::size_t dot{filename.find_last_of('.')};
+   if (dot != std::string::npos) {
+      for (std::size_t i = dot; i < filename.size(); i++) {
+         ext += static_cast<char>(std::tolower(filename[i]));
+      }
+   }
+
+   auto cell = std::make_unique<Cell>();
+   if (ext == ".dt0" || ext == ".dt1" || ext == ".dt2") cell->format = Format::DTED;
+   else if (ext == ".hgt") cell->format = Format::SRTM;
+   else if (ext == ".ded") cell->format = Format::DED;
+   else if (ext == ".mtc") cell->format = Format::CACHE;
+   else return nullptr;
+
+   if (!cell->file.open(filename.c_str())) return nullptr;
+
+   bool ok{};
+   switch (cell->format) {
+      case Format::DTED: ok = mapDted(cell.get()); break;
+      case Format::SRTM: ok = mapSrtm(cell.get(), filename); break;
+      case Format::DED:  ok = mapDed(cell.get()); break;
+      case Format::CACHE: ok = mapCache(cell.get()); break;
+   }
+   if (!ok || cell->nptlat < 2 || cell->nptlong < 2 || cell->latSpacing <= 0 || cell->lonSpacing <= 0) {
+      return nullptr;
+   }
+
+   cell->neLat = cell->swLat + (cell->nptlat - 1) * cell->latSpacing;
+   cell->neLon = cell->swLon + (cell->nptlong - 1) * cell->lonSpacing;
+   return cell.release();
+}
+
+//------------------------------------------------------------------------------
+// insertCell() -- adds a mapped cell, and returns its index
+//------------------------------------------------------------------------------
+int PagedTerrain::insertCell(Cell* const cell) const
+{
+   cells.emplace_back(cell);
+   return static_cast<int>(cells.size() - 1);
+}
+
+// Reads the DTED headers (see DtedFile)
+bool PagedTerrain::mapDted(Cell* const cell) const
+{
+   const unsigned char* const p{cell->file.getData()};
+   if (cell->file.getSize() < DTED_DATA_OFFSET || std::strncmp(reinterpret_cast<const char*>(p), "UHL1", 4) != 0) {
+      return false;
+   }
+
+   // UHL: origin longitude [4], origin latitude [12], data intervals [20] and [24],
+   // and the number of longitude and latitude lines [47] and [51]
+   int swLat{textValue(p + 12, 3)};
+   int swLon{textValue(p + 4, 3)};
+   if (p[19] == 'S') swLat = -swLat;
+   if (p[11] == 'W') swLon = -swLon;
+   cell->swLat = swLat;
+   cell->swLon = swLon;
+
+   static const double TENTHS_OF_SECONDS_PER_DEGREE{36000.0};
+   cell->lonSpacing = textValue(p + 20, 4) / TENTHS_OF_SECONDS_PER_DEGREE;
+   cell->latSpacing = textValue(p + 24, 4) / TENTHS_OF_SECONDS_PER_DEGREE;
+   cell->nptlong = static_cast<unsigned int>(textValue(p + 47, 4));
+   cell->nptlat = static_cast<unsigned int>(textValue(p + 51, 4));
+
+   cell->offset = DTED_DATA_OFFSET + DTED_COL_HEADER;
+   cell->stride = DTED_COL_HEADER + 2 * static_cast<std::size_t>(cell->nptlat) + DTED_COL_FOOTER;
+
+   const std::size_t size{DTED_DATA_OFFSET + cell->stride * cell->nptlong};
+   return (cell->file.getSize() >= size && p[DTED_DATA_OFFSET] == DTED_DATA_SENTINEL);
+}
+
+// Determines the SRTM cell from its file name and size (see SrtmHgtFile)
+bool PagedTerrain::mapSrtm(Cell* const cell, const std::string& name) const
+{
+   if (name.size() < 11) return false;
+   const std::string srtmName{name.substr(name.size() - 11, 11)};
+
+   switch (cell->file.getSize()) {
+      case 2884802:
+         cell->latSpacing = 3.0 / 3600.0;
+         cell->lonSpacing = 3.0 / 3600.0;
+         cell->nptlat = 1201;
+         cell->nptlong = 1201;
+         break;
+      case 25934402:
+         cell->latSpacing = 1.0 / 3600.0;
+         cell->lonSpacing = 1.0 / 3600.0;
+         cell->nptlat = 3601;
+         cell->nptlong = 3601;
+         break;
+      default:
+         return false;
+   }
+
+   // nXXwXXX.hgt
+   const char ns{static_cast<char>(std::tolower(srtmName[0]))};
+   const char ew{static_cast<char>(std::tolower(srtmName[3]))};
+   if ((ns != 'n' && ns != 's') || (ew != 'e' && ew != 'w')) {
+      return false;
+   }
+   int swLat{std::atoi(srtmName.substr(1, 2).c_str())};
+   int swLon{std::atoi(srtmName.substr(4, 3).c_str())};
+   if (ns == 's') swLat = -swLat;
+   if (ew == 'w') swLon = -swLon;
+   cell->swLat = swLat;
+   cell->swLon = swLon;
+
+   // Rows, from north to south
+   cell->offset = 0;
+   cell->stride = 2 * static_cast<std::size_t>(cell->nptlong);
+   return true;
+}
+
+// Reads the DED headers; cell #0 only (see DedFile)
+bool PagedTerrain::mapDed(Cell* const cell) const
+{
+   const unsigned char* const p{cell->file.getData()};
+   const std::size_t hdrSize{DED_STD_HDR_SIZE + DED_STATS_SIZE + DED_CELL_HDR_SIZE};
+   if (cell->file.getSize() < hdrSize || std::strncmp(reinterpret_cast<const char*>(p + 4), "SSYS", 4) != 0) {
+      return false;
+   }
+
+   // Statistics record
+   const unsigned char* const stats{p + DED_STD_HDR_SIZE};
+   const std::uint32_t ncell{bigEndian32(stats)};
+   const short minz{bigEndian16(stats + 4)};
+   const short maxz{bigEndian16(stats + 6)};
+   if (ncell < 1) return false;
+
+   // Cell #0 header
+   const unsigned char* const hdr{stats + DED_STATS_SIZE};
+   const float latstart{bigEndianFloat(hdr)};
+   const float latend{bigEndianFloat(hdr + 4)};
+   const float longstart{bigEndianFloat(hdr + 8)};
+   const float longend{bigEndianFloat(hdr + 12)};
+   cell->swLat = (latstart <= latend ? latstart : latend);
+   cell->swLon = (longstart <= longend ? longstart : longend);
+   cell->latSpacing = bigEndianFloat(hdr + 16) / DED_SECS_PER_DEG_10;
+   cell->lonSpacing = bigEndianFloat(hdr + 20) / DED_SECS_PER_DEG_10;
+   cell->nptlat = static_cast<unsigned int>(bigEndianFloat(hdr + 24));
+   cell->nptlong = static_cast<unsigned int>(bigEndianFloat(hdr + 28));
+
+   cell->offset = DED_STD_HDR_SIZE + DED_STATS_SIZE + DED_CELL_HDR_SIZE * static_cast<std::size_t>(ncell);
+   cell->stride = 2 * static_cast<std::size_t>(cell->nptlat);
+
+   const std::size_t size{cell->offset + cell->stride * cell->nptlong};
+   if (cell->file.getSize() < size) return false;
+
+   // The DED headers have the min/max elevations
+   cell->hasElevations = true;
+   cell->minElev = minz;
+   cell->maxElev = maxz;
+   return true;
+}
+
+// Reads the terrain cache file header (see TerrainCacheFile)
+bool PagedTerrain::mapCache(Cell* const cell) const
+{
+   TerrainCacheFile::Header hdr;
+   if (!TerrainCacheFile::readHeader(&hdr, cell->file.getData(), cell->file.getSize())) {
+      return false;
+   }
+
+   cell->swLat = hdr.swLat;
+   cell->swLon = hdr.swLon;
+   cell->latSpacing = hdr.latSpacing;
+   cell->lonSpacing = hdr.lonSpacing;
+   cell->nptlat = hdr.nptlat;
+   cell->nptlong = hdr.nptlong;
+
+   // Columns of little-endian posts
+   cell->offset = static_cast<std::size_t>(hdr.postsOffset);
+   cell->stride = 2 * static_cast<std::size_t>(cell->nptlat);
+
+   cell->hasElevations = true;
+   cell->minElev = hdr.minElev;
+   cell->maxElev = hdr.maxElev;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// findCell() -- returns the index of the first cell that contains the point, or -1
+//------------------------------------------------------------------------------
+int PagedTerrain::findCell(const double lat, const double lon) const
+{
+   // Most recently found cell
+   if (lastCell >= 0 && isInCell(*cells[lastCell], lat, lon)) return lastCell;
+
+   const auto n = static_cast<int>(cells.size());
+   for (int i = 0; i < n; i++) {
+      if (isInCell(*cells[i], lat, lon)) {
+         lastCell = i;
+         return i;
+      }
+   }
+   return -1;
+}
+
+//------------------------------------------------------------------------------
+// getPost() -- returns the post at [ icol ][ irow ] of cell 'icell'
+//------------------------------------------------------------------------------
+short PagedTerrain::getPost(const unsigned int icell, const unsigned int icol, const unsigned int irow) const
+{
+   const Tile* const tile{findTile(icell, icol / TILE_SIZE, irow / TILE_SIZE)};
+   return tile->posts[(icol % TILE_SIZE) * TILE_SIZE + (irow % TILE_SIZE)];
+}
+
+// Tile cache key
+std::uint64_t PagedTerrain::tileKey(const unsigned int icell, const unsigned int tcol, const unsigned int trow)
+{
+   return (static_cast<std::uint64_t>(icell) << 32) | (static_cast<std::uint64_t>(tcol) << 16) | trow;
+}
+
+//------------------------------------------------------------------------------
+// findTile() -- finds the tile in the cache, or pages it in
+//------------------------------------------------------------------------------
+const PagedTerrain::Tile* PagedTerrain::findTile(const unsigned int icell, const unsigned int tcol, const unsigned int trow) const
+{
+   const std::uint64_t key{tileKey(icell, tcol, trow)};
+
+   // The most recently used tile is already at the front of the list
+   if (lastTile != nullptr && lastTile->key == key) {
+      numHits++;
+      return lastTile;
+   }
+
+   auto it = tileMap.find(key);
+   if (it != tileMap.end()) {
+      tiles.splice(tiles.begin(), tiles, it->second);
+      numHits++;
+   } else {
+      // Page in the tile, using a spare tile, without holding the lock
+      std::list<Tile> tile;
+      if (!spares.empty()) {
+         tile.splice(tile.begin(), spares, spares.begin());
+      } else {
+         tile.emplace_front();
+         tile.front().posts.resize(TILE_SIZE * TILE_SIZE);
+      }
+      const Cell& cell{*cells[icell]};
+      suspendTilesLock();
+      readTile(&tile.front(), cell, tcol, trow);
+      resumeTilesLock();
+      numMisses++;
+
+      // Unless another thread has paged it in meanwhile, add the tile to the
+      // cache, and evict the least recently used tiles
+      it = tileMap.find(key);
+      if (it != tileMap.end()) {
+         spares.splice(spares.begin(), tile);
+         tiles.splice(tiles.begin(), tiles, it->second);
+      } else {
+         tile.front().key = key;
+         tiles.splice(tiles.begin(), tile);
+         tileMap[key] = tiles.begin();
+         while (tiles.size() > maxTiles) {
+            tileMap.erase(tiles.back().key);
+            spares.splice(spares.begin(), tiles, std::prev(tiles.end()));
+         }
+      }
+   }
+
+   lastTile = &tiles.front();
+   return lastTile;
+}
+
+//------------------------------------------------------------------------------
+// readTile() -- decodes the tile's posts from the mapped cell file
+//------------------------------------------------------------------------------
+void PagedTerrain::readTile(Tile* const tile, const Cell& cell, const unsigned int tcol, const unsigned int trow) const
+{
+   const unsigned int col0{tcol * TILE_SIZE};
+   const unsigned int row0{trow * TILE_SIZE};
+   const unsigned int ncols{(cell.nptlong - col0) < TILE_SIZE ? (cell.nptlong - col0) : TILE_SIZE};
+   const unsigned int nrows{(cell.nptlat - row0) < TILE_SIZE ? (cell.nptlat - row0) : TILE_SIZE};
+   const unsigned char* const data{cell.file.getData()};
+   short* const posts{tile->posts.data()};
+
+   switch (cell.format) {
+      case Format::DTED: {
+         for (unsigned int c = 0; c < ncols; c++) {
+            const unsigned char* p{data + cell.offset + cell.stride * (col0 + c) + 2 * static_cast<std::size_t>(row0)};
+            short* const q{posts + c * TILE_SIZE};
+            for (unsigned int r = 0; r < nrows; r++, p += 2) {
+               q[r] = signedMagnitude(p);
+            }
+         }
+         break;
+      }
+      case Format::DED: {
+         for (unsigned int c = 0; c < ncols; c++) {
+            const unsigned char* p{data + cell.offset + cell.stride * (col0 + c) + 2 * static_cast<std::size_t>(row0)};
+            short* const q{posts + c * TILE_SIZE};
+            for (unsigned int r = 0; r < nrows; r++, p += 2) {
+               q[r] = bigEndian16(p);
+            }
+         }
+         break;
+      }
+      case Format::CACHE: {
+         for (unsigned int c = 0; c < ncols; c++) {
+            const unsigned char* p{data + cell.offset + cell.stride * (col0 + c) + 2 * static_cast<std::size_t>(row0)};
+            short* const q{posts + c * TILE_SIZE};
+            for (unsigned int r = 0; r < nrows; r++, p += 2) {
+               q[r] = static_cast<short>(p[0] | (p[1] << 8));
+            }
+         }
+         break;
+      }
+      case Format::SRTM: {
+         // Rows are stored from north to south
+         for (unsigned int r = 0; r < nrows; r++) {
+            const unsigned int row{cell.nptlat - 1 - (row0 + r)};
+            const unsigned char* p{data + cell.offset + cell.stride * row + 2 * static_cast<std::size_t>(col0)};
+            for (unsigned int c = 0; c < ncols; c++, p += 2) {
+               posts[c * TILE_SIZE + r] = signedMagnitude(p);
+            }
+         }
+         break;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// prefetch() -- pages in the tile containing the point
+//------------------------------------------------------------------------------
+void PagedTerrain::prefetch(const double lat, const double lon) const
+{
+   lockTiles();
+   const int icell{findCell(lat, lon)};
+   if (icell >= 0) {
+      const Cell& cell{*cells[icell]};
+      double pointsLat{(lat - cell.swLat) / cell.latSpacing};
+      if (pointsLat < 0) pointsLat = 0;
+      double pointsLon{(cellLongitude(cell, lon) - cell.swLon) / cell.lonSpacing};
+      if (pointsLon < 0) pointsLon = 0;
+      unsigned int tcol{static_cast<unsigned int>(pointsLon + 0.5) / TILE_SIZE};
+      unsigned int trow{static_cast<unsigned int>(pointsLat + 0.5) / TILE_SIZE};
+      if (tcol > (cell.nptlong-1) / TILE_SIZE) tcol = (cell.nptlong-1) / TILE_SIZE;
+      if (trow > (cell.nptlat-1) / TILE_SIZE) trow = (cell.nptlat-1) / TILE_SIZE;
+
+      // (the tile is paged in without holding the lock; see findTile())
+      findTile(static_cast<unsigned int>(icell), tcol, trow);
+   }
+   unlockTiles();
+}
+
+//------------------------------------------------------------------------------
+// cellElevation() -- elevation (meters) of the point in cell 'icell'
+//------------------------------------------------------------------------------
+double PagedTerrain::cellElevation(const unsigned int icell, const double lat, const double lon, const bool interp) const
+{
+   const Cell& cell{*cells[icell]};
+
+   double pointsLat{(lat - cell.swLat) / cell.latSpacing};
+   if (pointsLat < 0) pointsLat = 0;
+
+   double pointsLon{(cellLongitude(cell, lon) - cell.swLon) / cell.lonSpacing};
+   if (pointsLon < 0) pointsLon = 0;
+
+   double value{};
+   if (interp) {
+      // South-west corner post is [icol][irow]
+      unsigned int irow{static_cast<unsigned int>(pointsLat)};
+      unsigned int icol{static_cast<unsigned int>(pointsLon)};
+      if (irow > (cell.nptlat-2)) irow = (cell.nptlat-2);
+      if (icol > (cell.nptlong-2)) icol = (cell.nptlong-2);
+
+      // delta from s-w corner post
+      const double deltaLat{pointsLat - static_cast<double>(irow)};
+      const double deltaLon{pointsLon - static_cast<double>(icol)};
+
+      // Get the elevations at each corner
+      const double elevSW{static_cast<double>(getPost(icell, icol, irow))};
+      const double elevNW{static_cast<double>(getPost(icell, icol, irow+1))};
+      const double elevSE{static_cast<double>(getPost(icell, icol+1, irow))};
+      const double elevNE{static_cast<double>(getPost(icell, icol+1, irow+1))};
+
+      // Interpolate the west and east points, and then between them
+      const double westPoint{elevSW + (elevNW - elevSW) * deltaLat};
+      const double eastPoint{elevSE + (elevNE - elevSE) * deltaLat};
+      value = westPoint + (eastPoint - westPoint) * deltaLon;
+   } else {
+      // Nearest post
+      unsigned int irow{static_cast<unsigned int>(pointsLat + 0.5)};
+      unsigned int icol{static_cast<unsigned int>(pointsLon + 0.5)};
+      if (irow >= cell.nptlat) irow = (cell.nptlat-1);
+      if (icol >= cell.nptlong) icol = (cell.nptlong-1);
+      value = static_cast<double>(getPost(icell, icol, irow));
+   }
+   return value;
+}
+
+//------------------------------------------------------------------------------
+// Locates an array of (at least two) elevation points (and sets valid flags if found)
+// returns the number of points found within this database
+//------------------------------------------------------------------------------
+unsigned int PagedTerrain::getElevations(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of elevation and valdFlags arrays
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const double direction,       // True direction (heading) angle of the data (degs)
+      const double maxRng,          // Range to last elevation point (meters)
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num{};
+
+   // Early out tests
+   if ( !isDataLoaded() ||             // Not loaded, or
+        elevations == nullptr ||       // the elevation array wasn't provided, or
+        validFlags == nullptr ||       // the valid flag array wasn't provided, or
+        n < 2 ||                       // there are too few points, or
+        (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
+        maxRng <= 0                    // the max range is less than or equal to zero
+      ) return num;
+
+   // Spacing between points (in each direction)
+   const double deltaPoint{maxRng / (n - 1)};
+   const double dirR{direction * base::angle::D2RCC};
+   const double deltaNorth{deltaPoint * std::cos(dirR) * base::length::M2NM};  // (NM)
+   const double deltaEast{deltaPoint * std::sin(dirR) * base::length::M2NM};
+   const double deltaLat{deltaNorth/60.0};
+   const double deltaLon{deltaEast/(60.0 * std::cos(lat * base::angle::D2RCC))};
+
+   lockTiles();
+
+   // The cell is only searched for when the profile leaves the current cell
+   int icell{-1};
+   double pointLat{lat};
+   double pointLon{lon};
+   for (unsigned int i = 0; i < n; i++) {
+      if (!validFlags[i]) {
+         if (icell < 0 || !isInCell(*cells[icell], pointLat, pointLon)) {
+            icell = findCell(pointLat, pointLon);
+         }
+         if (icell >= 0) {
+            elevations[i] = cellElevation(icell, pointLat, pointLon, interp);
+            validFlags[i] = true;
+            num++;
+         }
+      }
+      pointLat += deltaLat;
+      pointLon += deltaLon;
+   }
+
+   unlockTiles();
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevations (meters) of an array of reference points, and sets
+// their valid flags (if provided); returns the number of points found
+//------------------------------------------------------------------------------
+unsigned int PagedTerrain::getElevationsBatch(
+      const double* const lats,     // Reference latitude array (degs)
+      const double* const lons,     // Reference longitude array (degs)
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found), or nullptr
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   if (!isDataLoaded() || lats == nullptr || lons == nullptr || elevations == nullptr) return 0;
+
+   lockTiles();
+
+   // Key each point by the tile of its (south-west corner) post
+   std::vector<std::pair<std::uint64_t, unsigned int>> batch;
+   batch.reserve(n);
+   for (unsigned int i = 0; i < n; i++) {
+      const int icell{findCell(lats[i], lons[i])};
+      if (icell >= 0) {
+         const Cell& cell{*cells[icell]};
+         unsigned int irow{static_cast<unsigned int>(std::fmax((lats[i] - cell.swLat) / cell.latSpacing, 0.0))};
+         unsigned int icol{static_cast<unsigned int>(std::fmax((cellLongitude(cell, lons[i]) - cell.swLon) / cell.lonSpacing, 0.0))};
+         if (irow >= cell.nptlat) irow = (cell.nptlat-1);
+         if (icol >= cell.nptlong) icol = (cell.nptlong-1);
+         batch.emplace_back(tileKey(icell, icol / TILE_SIZE, irow / TILE_SIZE), i);
+      }
+      else if (validFlags != nullptr) {
+         validFlags[i] = false;
+      }
+   }
+
+   // Then do the points tile by tile
+   std::sort(batch.begin(), batch.end());
+   for (const auto& b : batch) {
+      const unsigned int i{b.second};
+      elevations[i] = cellElevation(static_cast<unsigned int>(b.first >> 32), lats[i], lons[i], interp);
+      if (validFlags != nullptr) validFlags[i] = true;
+   }
+   const auto num = static_cast<unsigned int>(batch.size());
+
+   unlockTiles();
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates an elevation value (meters) for a given reference point and returns
+// it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+//------------------------------------------------------------------------------
+bool PagedTerrain::getElevation(
+      double* const elev,     // The elevation value (meters)
+      const double lat,       // Reference latitude (degs)
+      const double lon,       // Reference longitude (degs)
+      const bool interp       // Interpolate between elevation posts (if true)
+   ) const
+{
+   if (!isDataLoaded() || elev == nullptr) return false;
+
+   lockTiles();
+   const int icell{findCell(lat, lon)};
+   if (icell >= 0) {
+      *elev = cellElevation(icell, lat, lon, interp);
+   }
+   unlockTiles();
+
+   return (icell >= 0);
+}
+
+//------------------------------------------------------------------------------
+// clearData() -- unmaps the cells and empties the tile cache
+//------------------------------------------------------------------------------
+void PagedTerrain::clearData()
+{
+   lockTilesNoIo();
+   tileMap.clear();
+   tiles.clear();
+   spares.clear();
+   lastTile = nullptr;
+   lastCell = -1;
+   cells.clear();
+   unlockTiles();
+
+   setLatitudeSW(0);
+   setLongitudeSW(0);
+   setLatitudeNE(0);
+   setLongitudeNE(0);
+
+   setMinElevation(0);
+   setMaxElevation(0);
+
+   BaseClass::clearData();
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool PagedTerrain::setSlotFiles(const base::PairStream* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      ok = true;
+      std::vector<std::string> names;
+      const base::IList::Item* item{msg->getFirstItem()};
+      while (item != nullptr) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto name = dynamic_cast<const base::String*>(pair->object());
+         if (name != nullptr) {
+            names.push_back(name->c_str());
+         } else {
+            std::cerr << "PagedTerrain::setSlotFiles(): file " << pair->slot() << " is not a file name (base::String)" << std::endl;
+            ok = false;
+         }
+         item = item->getNext();
+      }
+      if (ok) fileNames = names;
+   }
+   return ok;
+}
+
+bool PagedTerrain::setSlotMaxTiles(const base::Integer* const msg)
+{
+   bool ok{};
+   if (msg != nullptr) {
+      const int n{msg->asInt()};
+      ok = (n > 0 && setMaxTiles(static_cast<unsigned int>(n)));
+      if (!ok) {
+         std::cerr << "PagedTerrain::setSlotMaxTiles(): invalid number of tiles; must be at least 4" << std::endl;
+      }
+   }
+   return ok;
+}
+
+}
+}
@@ -2,11 +2,15 @@
 #include "mixr/terrain/QuadMap.hpp"
 
 #include "mixr/terrain/ITerrain.hpp"
+#include "mixr/terrain/DataFile.hpp"
 
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/qty/angles.hpp"
 #include "mixr/base/qty/lengths.hpp"
+#include "mixr/base/util/nav_utils.hpp"
+
+#include <cmath>
 
 namespace mixr {
 namespace terrain {
@@ -57,6 +61,15 @@ bool QuadMap::isDataLoaded() const
    return (numDataFiles > 0);
 }
 
+unsigned int QuadMap::getDataVersion() const
+{
+   unsigned int v{BaseClass::getDataVersion()};
+   for (unsigned int i = 0; i < numDataFiles; i++) {
+      if (dataFiles[i] != nullptr) v += dataFiles[i]->getDataVersion();
+   }
+   return v;
+}
+
 unsigned int QuadMap::getNumDataFiles() const
 {
     return numDataFiles;
@@ -134,6 +147,66 @@ bool QuadMap::getElevation(
    return found;
 }
 
+//------------------------------------------------------------------------------
+// Target occulting: returns true if a target point [ tgtLat tgtLon tgtAlt ] is
+// occulted by the terrain as seen from the ref point [ refLat refLon refAlt ].
+//------------------------------------------------------------------------------
+bool QuadMap::targetOcculting(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const double refAlt,    // Ref altitude (meters)
+      const double tgtLat,    // Target latitude (degs)
+      const double tgtLon,    // Target longitude (degs)
+      const double tgtAlt     // Target altitude (meters)
+   ) const
+{
+   // Margin (degs) around the line of sight
+   static const double MARGIN{1.0e-6};
+
+   // Line of sight's end point, as stepped by getElevations()
+   double brgDeg{};
+   double distNM{};
+   base::nav::fll2bd(refLat, refLon, tgtLat, tgtLon, &brgDeg, &distNM);
+   const double dirR{brgDeg * base::angle::D2RCC};
+   const double endLat{refLat + (distNM * std::cos(dirR)) / 60.0};
+   const double endLon{refLon + (distNM * std::sin(dirR)) / (60.0 * std::cos(refLat * base::angle::D2RCC))};
+
+   const double minLat{std::fmin(refLat, endLat) - MARGIN};
+   const double maxLat{std::fmax(refLat, endLat) + MARGIN};
+   const double minLon{std::fmin(refLon, endLon) - MARGIN};
+   const double maxLon{std::fmax(refLon, endLon) + MARGIN};
+
+   // Find the first data file that contains the line of sight; we're done
+   // looking if one of the files before it overlaps the line of sight.
+   const DataFile* dataFile{};
+   bool done{};
+   for (unsigned int i = 0; i < numDataFiles && !done; i++) {
+      const auto df = dynamic_cast<const DataFile*>( dataFiles[i] );
+      if (df != nullptr && df->isDataLoaded()) {
+         const double swLat{df->getLatitudeSW()};
+         const double swLon{df->getLongitudeSW()};
+         const double neLat{swLat + (df->getNumLatPoints() - 1) * df->getLatSpacing()};
+         const double neLon{swLon + (df->getNumLonPoints() - 1) * df->getLonSpacing()};
+         if (minLat >= swLat && maxLat <= neLat && minLon >= swLon && maxLon <= neLon) {
+            dataFile = df;
+            done = true;
+         } else {
+            done = (maxLat >= swLat && minLat <= neLat && maxLon >= swLon && minLon <= neLon);
+         }
+      } else {
+         done = true;
+      }
+   }
+
+   bool occulted{};
+   if (dataFile != nullptr) {
+      occulted = dataFile->targetOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   } else {
+      occulted = BaseClass::targetOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+   return occulted;
+}
+
 
 //------------------------------------------------------------------------------
 // Initializes the channel array
@@ -233,6 +306,8 @@ bool QuadMap::setDataFile(const unsigned int i, ITerrain* newDF)
             dataFiles[i]->unref();
             dataFiles[i] = newDF;
             dataFiles[i]->ref();
+            // replaced the data, so change our data version
+            BaseClass::clearData();
         }
     }
     return true;
@@ -260,6 +335,8 @@ void QuadMap::clearData()
       }
    }
    numDataFiles = 0;
+
+   BaseClass::clearData();
 }
 
 }
@@ -0,0 +1,21 @@
+
+#include "TerrainPrefetchPeriodicThread.hpp"
+
+#include "mixr/terrain/GlobalTerrain.hpp"
+
+namespace mixr {
+namespace terrain {
+
+TerrainPrefetchPeriodicThread::TerrainPrefetchPeriodicThread(base::IComponent* const parent, const double rate): base::IPeriodicThread(parent, rate)
+{
+}
+
+unsigned long TerrainPrefetchPeriodicThread::userFunc(const double)
+{
+   GlobalTerrain* terrain{static_cast<GlobalTerrain*>(getParent())};
+   terrain->prefetchPaths();
+   return 0;
+}
+
+}
+}
@@ -0,0 +1,22 @@
+
+#ifndef __mixr_terrain_TerrainPrefetchPeriodicThread_HPP__
+#define __mixr_terrain_TerrainPrefetchPeriodicThread_HPP__
+
+#include "mixr/base/threads/IPeriodicThread.hpp"
+
+namespace mixr {
+namespace terrain {
+
+// ---
+// Terrain prefetch thread (see GlobalTerrain)
+// ---
+class TerrainPrefetchPeriodicThread final : public base::IPeriodicThread
+{
+   public: TerrainPrefetchPeriodicThread(base::IComponent* const parent, const double rate);
+   private: unsigned long userFunc(const double dt) final;
+};
+
+}
+}
+
+#endif
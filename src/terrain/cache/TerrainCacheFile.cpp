@@ -0,0 +1,403 @@
+
+#include "mixr/terrain/cache/TerrainCacheFile.hpp"
+
+#include "mixr/terrain/ded/DedFile.hpp"
+#include "mixr/terrain/dted/DtedFile.hpp"
+#include "mixr/terrain/srtm/SrtmHgtFile.hpp"
+
+#include "mixr/base/String.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mixr {
+namespace terrain {
+
+IMPLEMENT_SUBCLASS(TerrainCacheFile, "TerrainCacheFile")
+EMPTY_SLOTTABLE(TerrainCacheFile)
+
+const char TerrainCacheFile::MAGIC[8]{'M', 'I', 'X', 'R', 'T', 'R', 'C', '\0'};
+
+//------------------------------------------------------------------------------
+// Little-endian encoding
+//------------------------------------------------------------------------------
+static bool isLittleEndian()
+{
+   const std::uint16_t v{1};
+   unsigned char b{};
+   std::memcpy(&b, &v, 1);
+   return (b == 1);
+}
+
+static void putU16(unsigned char* const p, const std::uint16_t v)
+{
+   p[0] = static_cast<unsigned char>(v);
+   p[1] = static_cast<unsigned char>(v >> 8);
+}
+
+static void putU32(unsigned char* const p, const std::uint32_t v)
+{
+   for (unsigned int i = 0; i < 4; i++) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+static void putU64(unsigned char* const p, const std::uint64_t v)
+{
+   for (unsigned int i = 0; i < 8; i++) p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+static void putF64(unsigned char* const p, const double v)
+{
+   std::uint64_t u{};
+   std::memcpy(&u, &v, sizeof(u));
+   putU64(p, u);
+}
+
+static std::uint16_t getU16(const unsigned char* const p)
+{
+   return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+static std::uint32_t getU32(const unsigned char* const p)
+{
+   std::uint32_t v{};
+   for (unsigned int i = 0; i < 4; i++) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+   return v;
+}
+
+static std::uint64_t getU64(const unsigned char* const p)
+{
+   std::uint64_t v{};
+   for (unsigned int i = 0; i < 8; i++) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+   return v;
+}
+
+static double getF64(const unsigned char* const p)
+{
+   const std::uint64_t u{getU64(p)};
+   double v{};
+   std::memcpy(&v, &u, sizeof(v));
+   return v;
+}
+
+// Rounds the offset up to the alignment
+static std::uint64_t align(const std::uint64_t offset)
+{
+   const std::uint64_t n{TerrainCacheFile::ALIGNMENT};
+   return ((offset + n - 1) / n) * n;
+}
+
+// Number of elevations in level 'k' of the max elevation pyramid
+static std::uint64_t levelSize(const unsigned int nptlat, const unsigned int nptlong, const unsigned int k)
+{
+   const std::uint64_t nrows{((nptlat - 1) >> (k + 1)) + 1};
+   const std::uint64_t ncols{((nptlong - 1) >> (k + 1)) + 1};
+   return nrows * ncols;
+}
+
+// Copies 'n' little-endian elevations
+static void copyPosts(short* const dst, const unsigned char* const src, const std::size_t n)
+{
+   if (isLittleEndian()) {
+      std::memcpy(dst, src, 2 * n);
+   } else {
+      for (std::size_t i = 0; i < n; i++) {
+         dst[i] = static_cast<short>(getU16(src + 2 * i));
+      }
+   }
+}
+
+// Writes 'n' elevations, little-endian
+static bool writePosts(std::ostream& out, const short* const src, const std::size_t n)
+{
+   if (isLittleEndian()) {
+      out.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(2 * n));
+   } else {
+      std::vector<unsigned char> buff(2 * n);
+      for (std::size_t i = 0; i < n; i++) {
+         putU16(&buff[2 * i], static_cast<std::uint16_t>(src[i]));
+      }
+      out.write(reinterpret_cast<const char*>(buff.data()), static_cast<std::streamsize>(buff.size()));
+   }
+   return out.good();
+}
+
+// Pads the file to the alignment
+static bool writePadding(std::ostream& out, const std::uint64_t offset)
+{
+   static const char zeros[TerrainCacheFile::ALIGNMENT]{};
+   const std::uint64_t n{align(offset) - offset};
+   if (n > 0) out.write(zeros, static_cast<std::streamsize>(n));
+   return out.good();
+}
+
+//==============================================================================
+// TerrainCacheFile class
+//==============================================================================
+
+TerrainCacheFile::TerrainCacheFile()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void TerrainCacheFile::copyData(const TerrainCacheFile& org, const bool)
+{
+   // Unmap our file; our base class makes its own copy of the columns
+   clearData();
+   BaseClass::copyData(org);
+}
+
+void TerrainCacheFile::deleteData()
+{
+   clearData();
+}
+
+//------------------------------------------------------------------------------
+// Decodes and checks the header of a terrain cache file
+//------------------------------------------------------------------------------
+bool TerrainCacheFile::readHeader(Header* const hdr, const unsigned char* const data, const std::size_t size)
+{
+   if (hdr == nullptr || data == nullptr || size < HEADER_SIZE) return false;
+   if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || getU32(data + 8) != VERSION) return false;
+
+   hdr->nptlat = getU32(data + 12);
+   hdr->nptlong = getU32(data + 16);
+   hdr->numLevels = getU32(data + 20);
+   hdr->swLat = getF64(data + 24);
+   hdr->swLon = getF64(data + 32);
+   hdr->neLat = getF64(data + 40);
+   hdr->neLon = getF64(data + 48);
+   hdr->latSpacing = getF64(data + 56);
+   hdr->lonSpacing = getF64(data + 64);
+   hdr->minElev = getF64(data + 72);
+   hdr->maxElev = getF64(data + 80);
+   hdr->voidValue = static_cast<short>(getU16(data + 88));
+   hdr->postsOffset = getU64(data + 96);
+   hdr->pyramidOffset = getU64(data + 104);
+
+   if (hdr->nptlat < 2 || hdr->nptlong < 2 || !(hdr->latSpacing > 0) || !(hdr->lonSpacing > 0)) return false;
+
+   // The posts and the pyramid must be within the file
+   const std::uint64_t nposts{static_cast<std::uint64_t>(hdr->nptlat) * hdr->nptlong};
+   std::uint64_t npyramid{};
+   for (unsigned int k = 0; k < hdr->numLevels; k++) {
+      npyramid += levelSize(hdr->nptlat, hdr->nptlong, k);
+   }
+   return ( hdr->postsOffset >= HEADER_SIZE && (hdr->postsOffset % 2) == 0 &&
+            hdr->postsOffset + 2 * nposts <= size &&
+            (hdr->numLevels == 0 || (hdr->pyramidOffset >= HEADER_SIZE && hdr->pyramidOffset + 2 * npyramid <= size)) );
+}
+
+//------------------------------------------------------------------------------
+// Load the terrain cache file -- maps the file
+//------------------------------------------------------------------------------
+bool TerrainCacheFile::loadData()
+{
+   clearData();
+
+   std::string filename;
+   const char* p{getPathname()};
+   if (p != nullptr) {
+      filename += p;
+      filename += '/';
+   }
+   p = getFilename();
+   if (p != nullptr) {
+      filename += p;
+   }
+
+   if (!file.open(filename.c_str())) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TerrainCacheFile::loadData() ERROR, could not open file: " << filename << std::endl;
+      }
+      return false;
+   }
+
+   Header hdr;
+   if (!readHeader(&hdr, file.getData(), file.getSize())) {
+      file.close();
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TerrainCacheFile::loadData() ERROR, not a valid terrain cache file: " << filename << std::endl;
+      }
+      return false;
+   }
+
+   nptlat = hdr.nptlat;
+   nptlong = hdr.nptlong;
+   latSpacing = hdr.latSpacing;
+   lonSpacing = hdr.lonSpacing;
+   voidValue = hdr.voidValue;
+
+   // The columns of posts; in place, if we can
+   const unsigned char* const posts{file.getData() + hdr.postsOffset};
+   const std::size_t colSize{2 * static_cast<std::size_t>(nptlat)};
+   columns = new short*[nptlong];
+   mappedColumns = isLittleEndian();
+   for (unsigned int i = 0; i < nptlong; i++) {
+      if (mappedColumns) {
+         // (the mapped file is read only; DataFile never changes the posts)
+         columns[i] = const_cast<short*>(reinterpret_cast<const short*>(posts + colSize * i));
+      } else {
+         columns[i] = new short[nptlat];
+         copyPosts(columns[i], posts + colSize * i, nptlat);
+      }
+   }
+
+   // The max elevation pyramid
+   if (hdr.numLevels > 0) {
+      std::vector< std::vector<short> > levels(hdr.numLevels);
+      const unsigned char* level{file.getData() + hdr.pyramidOffset};
+      for (unsigned int k = 0; k < hdr.numLevels; k++) {
+         const auto n = static_cast<std::size_t>(levelSize(nptlat, nptlong, k));
+         levels[k].resize(n);
+         copyPosts(levels[k].data(), level, n);
+         level += 2 * n;
+      }
+      setMaxPyramid(levels);
+   }
+
+   setLatitudeSW(hdr.swLat);
+   setLongitudeSW(hdr.swLon);
+   setLatitudeNE(hdr.neLat);
+   setLongitudeNE(hdr.neLon);
+   setMinElevation(hdr.minElev);
+   setMaxElevation(hdr.maxElev);
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// clearData() -- clears the data and unmaps the file
+//------------------------------------------------------------------------------
+void TerrainCacheFile::clearData()
+{
+   // The mapped columns aren't ours to delete
+   if (mappedColumns && columns != nullptr) {
+      for (unsigned int i = 0; i < nptlong; i++) {
+         columns[i] = nullptr;
+      }
+   }
+   mappedColumns = false;
+
+   BaseClass::clearData();
+
+   file.close();
+}
+
+//------------------------------------------------------------------------------
+// Writes the loaded data file to a terrain cache file
+//------------------------------------------------------------------------------
+bool TerrainCacheFile::write(const DataFile* const src, const char* const filename)
+{
+   if (src == nullptr || filename == nullptr || !src->isDataLoaded()) return false;
+
+   const unsigned int nptlat{src->getNumLatPoints()};
+   const unsigned int nptlong{src->getNumLonPoints()};
+   if (nptlat < 2 || nptlong < 2) return false;
+   for (unsigned int i = 0; i < nptlong; i++) {
+      if (src->getColumn(i) == nullptr) return false;
+   }
+
+   const unsigned int numLevels{src->getNumMaxPyramidLevels()};
+   const std::uint64_t postsOffset{align(HEADER_SIZE)};
+   const std::uint64_t pyramidOffset{align(postsOffset + 2 * static_cast<std::uint64_t>(nptlat) * nptlong)};
+
+   // Header
+   unsigned char hdr[HEADER_SIZE]{};
+   std::memcpy(hdr, MAGIC, sizeof(MAGIC));
+   putU32(hdr + 8, VERSION);
+   putU32(hdr + 12, nptlat);
+   putU32(hdr + 16, nptlong);
+   putU32(hdr + 20, numLevels);
+   putF64(hdr + 24, src->getLatitudeSW());
+   putF64(hdr + 32, src->getLongitudeSW());
+   putF64(hdr + 40, src->getLatitudeNE());
+   putF64(hdr + 48, src->getLongitudeNE());
+   putF64(hdr + 56, src->getLatSpacing());
+   putF64(hdr + 64, src->getLonSpacing());
+   const ITerrain* const terrain{src};    // (DataFile hides ITerrain::getMaxElevation())
+   putF64(hdr + 72, terrain->getMinElevation());
+   putF64(hdr + 80, terrain->getMaxElevation());
+   putU16(hdr + 88, static_cast<std::uint16_t>(src->getVoidValue()));
+   putU64(hdr + 96, postsOffset);
+   putU64(hdr + 104, (numLevels > 0 ? pyramidOffset : 0));
+
+   std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+   if (!out.is_open()) {
+      std::cerr << "TerrainCacheFile::write() ERROR, could not create file: " << filename << std::endl;
+      return false;
+   }
+
+   bool ok{};
+   out.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+   ok = writePadding(out, HEADER_SIZE);
+
+   // Columns of posts
+   for (unsigned int i = 0; i < nptlong && ok; i++) {
+      ok = writePosts(out, src->getColumn(i), nptlat);
+   }
+
+   // Max elevation pyramid
+   if (ok && numLevels > 0) {
+      ok = writePadding(out, postsOffset + 2 * static_cast<std::uint64_t>(nptlat) * nptlong);
+      for (unsigned int k = 0; k < numLevels && ok; k++) {
+         ok = writePosts(out, src->getMaxPyramidLevel(k), static_cast<std::size_t>(levelSize(nptlat, nptlong, k)));
+      }
+   }
+
+   out.close();
+   if (!ok || out.fail()) {
+      std::cerr << "TerrainCacheFile::write() ERROR, could not write file: " << filename << std::endl;
+      ok = false;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Converts a DTED, SRTM or DED cell file to a terrain cache file
+//------------------------------------------------------------------------------
+bool TerrainCacheFile::convert(const char* const inFilename, const char* const outFilename)
+{
+   if (inFilename == nullptr || outFilename == nullptr) return false;
+
+   // Loader by file extension
+   const std::string name{inFilename};
+   std::string ext;
+   const std::size_t dot{name.find_last_of('.')};
+   if (dot != std::string::npos) {
+      for (std::size_t i = dot; i < name.size(); i++) {
+         ext += static_cast<char>(std::tolower(name[i]));
+      }
+   }
+
+   DataFile* src{};
+   if (ext == ".dt0" || ext == ".dt1" || ext == ".dt2") src = new DtedFile();
+   else if (ext == ".hgt") src = new SrtmHgtFile();
+   else if (ext == ".ded") src = new DedFile();
+   else {
+      std::cerr << "TerrainCacheFile::convert() ERROR, unknown cell file type: " << inFilename << std::endl;
+      return false;
+   }
+
+   // Load the cell (and build its max elevation pyramid), and write it
+   const auto fn = new base::String(inFilename);
+   src->setFilename(fn);
+   fn->unref();
+   src->reset();
+
+   bool ok{src->isDataLoaded()};
+   if (ok) {
+      ok = write(src, outFilename);
+   } else {
+      std::cerr << "TerrainCacheFile::convert() ERROR, could not load file: " << inFilename << std::endl;
+   }
+
+   src->unref();
+   return ok;
+}
+
+}
+}
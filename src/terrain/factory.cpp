@@ -4,6 +4,9 @@
 #include "mixr/base/IObject.hpp"
 
 #include "mixr/terrain/QuadMap.hpp"
+#include "mixr/terrain/GlobalTerrain.hpp"
+#include "mixr/terrain/PagedTerrain.hpp"
+#include "mixr/terrain/cache/TerrainCacheFile.hpp"
 #include "mixr/terrain/ded/DedFile.hpp"
 #include "mixr/terrain/dted/DtedFile.hpp"
 #include "mixr/terrain/srtm/SrtmHgtFile.hpp"
@@ -20,6 +23,15 @@ base::IObject* factory(const std::string& name)
     if ( name == QuadMap::getFactoryName() ) {
         obj = new QuadMap();
     }
+    else if ( name == GlobalTerrain::getFactoryName() ) {
+        obj = new GlobalTerrain();
+    }
+    else if ( name == PagedTerrain::getFactoryName() ) {
+        obj = new PagedTerrain();
+    }
+    else if ( name == TerrainCacheFile::getFactoryName() ) {
+        obj = new TerrainCacheFile();
+    }
     else if ( name == DedFile::getFactoryName() ) {
         obj = new DedFile();
     }
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+// Benchmark: UDP receive throughput over the loopback interface -- one
+// recvData() call per packet against recvBatch() (recvmmsg() on Linux).
+// Also checks that every packet arrives intact and that recvBatch() drops
+// and counts the packets that are larger than its buffers.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/network/UdpUnicastHandler.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/String.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const int RECV_PORT{43210};
+const int SEND_PORT{43211};
+const int PACKET_SIZE{1400};
+const int MAX_SIZE{1536};                 // Receive buffer size of each packet
+const unsigned int BURST{64};             // Packets sent before each receive
+const unsigned int NUM_BURSTS{4000};
+
+base::UdpUnicastHandler* makeHandler(const int port, const int localPort)
+{
+   const auto h = new base::UdpUnicastHandler();
+   const auto ip = new base::String("127.0.0.1");
+   const auto p = new base::Integer(port);
+   const auto lp = new base::Integer(localPort);
+   const auto kb = new base::Integer(1024);
+   h->setSlotByName("ipAddress", ip);
+   h->setSlotByName("port", p);
+   h->setSlotByName("localPort", lp);
+   h->setSlotByName("recvBuffSizeKb", kb);
+   h->setSlotByName("sendBuffSizeKb", kb);
+   ip->unref();
+   p->unref();
+   lp->unref();
+   kb->unref();
+   if (!h->initNetwork(true)) {
+      h->unref();
+      return nullptr;
+   }
+   return h;
+}
+
+// Sends BURST packets numbered from 'seq'
+void sendBurst(base::UdpUnicastHandler* const tx, const unsigned int seq)
+{
+   char packet[PACKET_SIZE]{};
+   for (unsigned int i = 0; i < BURST; i++) {
+      const unsigned int k{seq + i};
+      std::memset(packet, static_cast<int>(k & 0xff), sizeof(packet));
+      std::memcpy(packet, &k, sizeof(k));
+      tx->sendData(packet, sizeof(packet));
+   }
+}
+
+// True if 'packet' is packet number 'k'
+bool isPacket(const char* const packet, const unsigned int size, const unsigned int k)
+{
+   if (size != PACKET_SIZE) return false;
+   unsigned int k0{};
+   std::memcpy(&k0, packet, sizeof(k0));
+   return (k0 == k && static_cast<unsigned char>(packet[PACKET_SIZE - 1]) == (k & 0xff));
+}
+
+}
+
+int main()
+{
+   base::UdpUnicastHandler* const rx{makeHandler(SEND_PORT, RECV_PORT)};
+   base::UdpUnicastHandler* const tx{makeHandler(RECV_PORT, SEND_PORT)};
+   if (rx == nullptr || tx == nullptr) {
+      std::printf("ERROR: can't open the loopback sockets (ports %d and %d)\n", RECV_PORT, SEND_PORT);
+      return 1;
+   }
+
+   std::vector<char> buffer(static_cast<std::size_t>(BURST) * MAX_SIZE);
+   unsigned int sizes[BURST]{};
+   unsigned int errors{};
+
+   std::printf("%u packets of %d bytes, in bursts of %u\n", BURST * NUM_BURSTS, PACKET_SIZE, BURST);
+   for (int b = 0; b < 2; b++) {
+      const bool batch{b > 0};
+      double tRecv{};
+      unsigned int seq{};
+      for (unsigned int n = 0; n < NUM_BURSTS; n++) {
+         sendBurst(tx, seq);
+
+         const double start{base::getComputerTime()};
+         unsigned int num{};
+         if (batch) {
+            num = rx->recvBatch(buffer.data(), MAX_SIZE, sizes, BURST);
+         } else {
+            while (num < BURST && (sizes[num] = rx->recvData(buffer.data() + static_cast<std::size_t>(num) * MAX_SIZE, MAX_SIZE)) > 0) {
+               num++;
+            }
+         }
+         tRecv += base::getComputerTime() - start;
+
+         for (unsigned int i = 0; i < num; i++) {
+            if (!isPacket(buffer.data() + static_cast<std::size_t>(i) * MAX_SIZE, sizes[i], seq + i)) errors++;
+         }
+         if (num != BURST) errors += BURST - num;
+         seq += BURST;
+      }
+      std::printf("   %-10s %8.1f ns per packet, %8.1f MB/s\n", (batch ? "recvBatch" : "recvData"),
+                  tRecv * 1.0e9 / seq, (static_cast<double>(seq) * PACKET_SIZE) / tRecv / 1.0e6);
+   }
+
+   // An oversized packet between two good ones: dropped and counted
+   {
+      char big[MAX_SIZE + 100]{};
+      char packet[PACKET_SIZE]{};
+      const unsigned int k{7};
+      std::memset(packet, k, sizeof(packet));
+      std::memcpy(packet, &k, sizeof(k));
+      tx->sendData(packet, sizeof(packet));
+      tx->sendData(big, sizeof(big));
+      tx->sendData(packet, sizeof(packet));
+      const unsigned int num{rx->recvBatch(buffer.data(), MAX_SIZE, sizes, BURST)};
+      const bool ok{num == 2 && rx->getNumTruncated() == 1 &&
+                    isPacket(buffer.data(), sizes[0], k) && isPacket(buffer.data() + MAX_SIZE, sizes[1], k)};
+      std::printf("   oversized packet: %u received, %u truncated\n", num, rx->getNumTruncated());
+      if (!ok) {
+         std::printf("ERROR: expected 2 packets received and 1 truncated\n");
+         errors++;
+      }
+   }
+
+   rx->unref();
+   tx->unref();
+
+   if (errors > 0) {
+      std::printf("FAILED: %u packets missing or wrong\n", errors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+// Benchmark: replays a stream of DIS entity state PDUs, in network byte
+// order, through the two input decode paths of dis::NetIO -- copying and byte
+// swapping the whole PDU before reading its fields, and reading the fields in
+// place using an EntityStatePduView.  Also checks that both paths decode the
+// same values from every PDU.
+//------------------------------------------------------------------------------
+
+#include "mixr/interop/dis/NetIO.hpp"
+#include "mixr/interop/dis/pdu.hpp"
+#include "mixr/base/network/INetHandler.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int NUM_ENTITIES{1000};
+const unsigned int NUM_PDUS{4000000};         // PDUs replayed per path
+const unsigned int MAX_ARTS{2};               // Max articulation parameters per PDU
+const unsigned int MAX_SIZE{sizeof(dis::EntityStatePDU) + MAX_ARTS * sizeof(dis::VpArticulatedPart)};
+
+// The PDU fields that Nib::entityStatePdu2Nib() and Nib::entityStateView2Nib() use
+struct Fields
+{
+   double pos[3]{};
+   double vel[3]{};
+   double acc[3]{};
+   double angles[3]{};
+   double rates[3]{};
+   unsigned int timeStamp{};
+   unsigned int appearance{};
+   unsigned int numArts{};
+   unsigned char drAlgorithm{};
+
+   bool operator==(const Fields& f) const {
+      return std::memcmp(pos, f.pos, sizeof(pos)) == 0 && std::memcmp(vel, f.vel, sizeof(vel)) == 0 &&
+             std::memcmp(acc, f.acc, sizeof(acc)) == 0 && std::memcmp(angles, f.angles, sizeof(angles)) == 0 &&
+             std::memcmp(rates, f.rates, sizeof(rates)) == 0 && timeStamp == f.timeStamp &&
+             appearance == f.appearance && numArts == f.numArts && drAlgorithm == f.drAlgorithm;
+   }
+};
+
+// Current path: copy and swap the PDU, then read it
+void decodeSwapped(const char* const packet, const unsigned int size, char* const buffer, Fields* const f)
+{
+   std::memcpy(buffer, packet, size);
+   const auto pdu = reinterpret_cast<dis::EntityStatePDU*>(buffer);
+   if (base::INetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+
+   f->pos[0] = pdu->entityLocation.X_coord;
+   f->pos[1] = pdu->entityLocation.Y_coord;
+   f->pos[2] = pdu->entityLocation.Z_coord;
+   for (unsigned int i = 0; i < 3; i++) {
+      f->vel[i] = pdu->entityLinearVelocity.component[i];
+      f->acc[i] = pdu->DRentityLinearAcceleration.component[i];
+   }
+   f->angles[0] = pdu->entityOrientation.phi;
+   f->angles[1] = pdu->entityOrientation.theta;
+   f->angles[2] = pdu->entityOrientation.psi;
+   f->rates[0] = pdu->DRentityAngularVelocity.x_axis;
+   f->rates[1] = pdu->DRentityAngularVelocity.y_axis;
+   f->rates[2] = pdu->DRentityAngularVelocity.z_axis;
+   f->timeStamp = pdu->header.timeStamp;
+   f->appearance = pdu->appearance;
+   f->numArts = pdu->numberOfArticulationParameters;
+   f->drAlgorithm = pdu->deadReckoningAlgorithm;
+}
+
+// View path: read the fields in place
+void decodeView(const char* const packet, Fields* const f)
+{
+   const dis::EntityStatePduView view(reinterpret_cast<const dis::EntityStatePDU*>(packet),
+                                      base::INetHandler::isNotNetworkByteOrder());
+   for (unsigned int i = 0; i < 3; i++) {
+      f->pos[i] = view.getLocation(i);
+      f->vel[i] = view.getLinearVelocity(i);
+      f->acc[i] = view.getLinearAcceleration(i);
+   }
+   f->angles[0] = view.getPhi();
+   f->angles[1] = view.getTheta();
+   f->angles[2] = view.getPsi();
+   f->rates[0] = view.getAngularVelocityX();
+   f->rates[1] = view.getAngularVelocityY();
+   f->rates[2] = view.getAngularVelocityZ();
+   f->timeStamp = view.getTimeStamp();
+   f->appearance = view.getAppearance();
+   f->numArts = view.getNumberOfArticulationParameters();
+   f->drAlgorithm = view.getDeadReckoningAlgorithm();
+}
+
+}
+
+int main()
+{
+   std::mt19937_64 rng(1278);
+   std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+   // ---
+   // One PDU per entity, in network byte order (the stream is zero filled)
+   // ---
+   std::vector<char> stream(static_cast<std::size_t>(NUM_ENTITIES) * MAX_SIZE);
+   std::vector<unsigned int> sizes(NUM_ENTITIES);
+   for (unsigned int e = 0; e < NUM_ENTITIES; e++) {
+      char* const packet{&stream[static_cast<std::size_t>(e) * MAX_SIZE]};
+      const auto pdu = reinterpret_cast<dis::EntityStatePDU*>(packet);
+      const unsigned int numArts{e % (MAX_ARTS + 1)};
+      pdu->header.PDUType = dis::NetIO::PDU_ENTITY_STATE;
+      pdu->header.timeStamp = 1000u * e + 1;
+      pdu->header.length = static_cast<unsigned short>(sizeof(dis::EntityStatePDU) + numArts * sizeof(dis::VpArticulatedPart));
+      pdu->entityID.ID = static_cast<unsigned short>(e + 1);
+      pdu->entityLocation.X_coord = 6.4e6 * unit(rng);
+      pdu->entityLocation.Y_coord = 6.4e6 * unit(rng);
+      pdu->entityLocation.Z_coord = 6.4e6 * unit(rng);
+      for (unsigned int i = 0; i < 3; i++) {
+         pdu->entityLinearVelocity.component[i] = static_cast<float>(300.0 * unit(rng));
+         pdu->DRentityLinearAcceleration.component[i] = static_cast<float>(9.8 * unit(rng));
+      }
+      pdu->entityOrientation.phi = static_cast<float>(unit(rng));
+      pdu->entityOrientation.theta = static_cast<float>(unit(rng));
+      pdu->entityOrientation.psi = static_cast<float>(3.1 * unit(rng));
+      pdu->DRentityAngularVelocity.x_axis = static_cast<float>(0.1 * unit(rng));
+      pdu->DRentityAngularVelocity.y_axis = static_cast<float>(0.1 * unit(rng));
+      pdu->DRentityAngularVelocity.z_axis = static_cast<float>(0.1 * unit(rng));
+      pdu->appearance = 0x00800000u | e;
+      pdu->deadReckoningAlgorithm = static_cast<unsigned char>(1 + e % 9);
+      pdu->numberOfArticulationParameters = static_cast<unsigned char>(numArts);
+      for (unsigned int i = 0; i < numArts; i++) {
+         const auto ap = reinterpret_cast<dis::VpArticulatedPart*>(packet + sizeof(dis::EntityStatePDU) + i * sizeof(dis::VpArticulatedPart));
+         ap->parameterTypeDesignator = dis::VpArticulatedPart::ARTICULATED_PART;
+         ap->parameterType = dis::VpArticulatedPart::LANDING_GEAR + dis::VpArticulatedPart::POSITION;
+         ap->parameterValue.value[0] = static_cast<float>(unit(rng));
+      }
+      sizes[e] = pdu->header.length;
+      if (base::INetHandler::isNotNetworkByteOrder()) pdu->swapBytes();
+   }
+
+   // ---
+   // Check that both paths decode the same values
+   // ---
+   std::vector<char> buffer(MAX_SIZE);
+   unsigned int errors{};
+   for (unsigned int e = 0; e < NUM_ENTITIES; e++) {
+      const char* const packet{&stream[static_cast<std::size_t>(e) * MAX_SIZE]};
+      Fields a, b;
+      decodeSwapped(packet, sizes[e], buffer.data(), &a);
+      decodeView(packet, &b);
+      if (!(a == b)) {
+         if (errors < 10) std::printf("ERROR: entity %u: the swapped and view decodes differ\n", e + 1);
+         errors++;
+      }
+   }
+
+   // ---
+   // Replay
+   // ---
+   std::printf("%u entity state PDUs, %u entities\n", NUM_PDUS, NUM_ENTITIES);
+   double sum[2]{};
+   for (int k = 0; k < 2; k++) {
+      const double start{base::getComputerTime()};
+      Fields f;
+      for (unsigned int n = 0; n < NUM_PDUS; n++) {
+         const unsigned int e{n % NUM_ENTITIES};
+         const char* const packet{&stream[static_cast<std::size_t>(e) * MAX_SIZE]};
+         if (k == 0) decodeSwapped(packet, sizes[e], buffer.data(), &f);
+         else decodeView(packet, &f);
+         sum[k] += f.pos[0] + f.vel[1] + f.angles[2] + f.timeStamp + f.appearance;
+      }
+      const double elapsed{base::getComputerTime() - start};
+      std::printf("   %-14s %8.1f ms, %6.1f ns per PDU\n", (k == 0 ? "copy and swap" : "view"),
+                  elapsed * 1.0e3, elapsed * 1.0e9 / NUM_PDUS);
+   }
+   if (sum[0] != sum[1]) {
+      std::printf("ERROR: the replay checksums differ\n");
+      errors++;
+   }
+
+   if (errors > 0) {
+      std::printf("FAILED: %u errors\n", errors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+// Benchmark: IReferenced ref()/unref() -- the atomic reference count against
+// the spin-locked count that it replaced, with one thread and with several
+// threads sharing the same object.  Also checks that the count is exact and
+// that the object is deleted once.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/IReferenced.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const unsigned int NUM_PAIRS{10000000};     // ref()/unref() pairs per thread
+
+std::atomic<int> numDeleted{};
+
+// Object with the atomic reference count
+class Counted final : public mixr::base::IReferenced
+{
+public:
+   ~Counted() final { numDeleted++; }
+};
+
+// The spin-locked reference count that IReferenced used to have
+class Locked
+{
+public:
+   void ref() const {
+      mixr::base::lock(semaphore);
+      refCount++;
+      mixr::base::unlock(semaphore);
+   }
+   void unref() const {
+      mixr::base::lock(semaphore);
+      refCount--;
+      mixr::base::unlock(semaphore);
+   }
+   int getRefCount() const { return refCount; }
+private:
+   mutable long semaphore{};
+   mutable int refCount{1};
+};
+
+// Runs 'n' threads of ref()/unref() pairs on 'obj'; returns the time (ns) per pair
+template <class T>
+double run(const T* const obj, const unsigned int n)
+{
+   const double start{mixr::base::getComputerTime()};
+   std::vector<std::thread> threads;
+   for (unsigned int t = 0; t < n; t++) {
+      threads.emplace_back([obj]() {
+         for (unsigned int i = 0; i < NUM_PAIRS; i++) {
+            obj->ref();
+            obj->unref();
+         }
+      });
+   }
+   for (std::thread& t : threads) t.join();
+   const double elapsed{mixr::base::getComputerTime() - start};
+   return elapsed * 1.0e9 / NUM_PAIRS;
+}
+
+}
+
+int main()
+{
+   bool ok{true};
+   unsigned int maxThreads{std::thread::hardware_concurrency()};
+   if (maxThreads < 2) maxThreads = 2;
+   if (maxThreads > 8) maxThreads = 8;
+
+   std::printf("%8s %14s %14s\n", "threads", "atomic ns/op", "locked ns/op");
+   for (unsigned int n = 1; n <= maxThreads; n *= 2) {
+      const auto counted = new Counted();
+      const Locked locked;
+      const double ta{run(counted, n)};
+      const double tl{run(&locked, n)};
+      std::printf("%8u %14.2f %14.2f\n", n, ta, tl);
+
+      if (counted->getRefCount() != 1 || locked.getRefCount() != 1) {
+         std::printf("ERROR: reference count is %d (atomic) and %d (locked); expected 1\n",
+                     counted->getRefCount(), locked.getRefCount());
+         ok = false;
+      }
+      numDeleted = 0;
+      counted->unref();
+      if (numDeleted != 1) {
+         std::printf("ERROR: object deleted %d times\n", numDeleted.load());
+         ok = false;
+      }
+   }
+
+   return ok ? 0 : 1;
+}
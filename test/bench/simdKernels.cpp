@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+// Benchmark: the per-target boresight and antenna gain pipeline of Tdb and
+// Antenna (LOS rotation, boresight angles and the gain's dB to ratio), using
+// the scalar and the AVX2 kernels of simd_utils.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/util/simd_utils.hpp"
+#include "mixr/base/util/system_utils.hpp"
+#include "mixr/base/osg/Vec3d"
+#include "mixr/base/osg/Matrixd"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int NUM_TARGETS{100000};
+const unsigned int NUM_PASSES{50};
+
+}
+
+int main()
+{
+   std::mt19937_64 rng(12345);
+   std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+   std::vector<base::Vec3d> los(NUM_TARGETS);
+   for (base::Vec3d& v : los) {
+      v.set(unit(rng), unit(rng), unit(rng));
+      v.normalize();
+   }
+   base::Matrixd m;
+   m.makeRotate(0.3, base::Vec3d(0, 0, 1), -0.2, base::Vec3d(0, 1, 0), 0.1, base::Vec3d(1, 0, 0));
+
+   std::vector<base::Vec3d> losG(NUM_TARGETS);
+   std::vector<double> xa(NUM_TARGETS), ya(NUM_TARGETS), za(NUM_TARGETS), ra2(NUM_TARGETS), ra(NUM_TARGETS);
+   std::vector<double> aar(NUM_TARGETS), aazr(NUM_TARGETS), aelr(NUM_TARGETS), gain(NUM_TARGETS);
+
+   std::printf("%u targets, %u passes\n", NUM_TARGETS, NUM_PASSES);
+   for (int k = 0; k < 2; k++) {
+      const auto kernels = (k == 0) ? base::simd::Kernels::SCALAR : base::simd::Kernels::AVX2;
+      if (!base::simd::setKernels(kernels)) {
+         std::printf("%8s: not supported\n", "avx2");
+         continue;
+      }
+
+      const double start{base::getComputerTime()};
+      for (unsigned int p = 0; p < NUM_PASSES; p++) {
+         base::simd::postMultVec3Array(los.data(), m, losG.data(), NUM_TARGETS);
+         base::simd::boresightArrays(losG.data(), xa.data(), ya.data(), za.data(), ra2.data(), ra.data(),
+                                     aar.data(), aazr.data(), aelr.data(), NUM_TARGETS);
+         base::simd::multArrayConst(aar.data(), -3.0, gain.data(), NUM_TARGETS);
+         base::simd::pow10Array(gain.data(), gain.data(), NUM_TARGETS);
+      }
+      const double elapsed{(base::getComputerTime() - start) / NUM_PASSES};
+      std::printf("%8s: %8.3f ms per pass, %6.2f ns per target\n", (k == 0 ? "scalar" : "avx2"),
+                  elapsed * 1.0e3, elapsed * 1.0e9 / NUM_TARGETS);
+   }
+
+   return 0;
+}
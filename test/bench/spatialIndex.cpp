@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+// Benchmark: players-of-interest range queries at 100, 1k and 10k players --
+// the baseline linear scan of the player list against the SpatialIndex
+// candidates (with the same exact range check).  Also checks that both find
+// the same players.
+//------------------------------------------------------------------------------
+
+#include "mixr/models/SpatialIndex.hpp"
+#include "mixr/models/player/IPlayer.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int SIZES[]{100, 1000, 10000};
+const unsigned int NUM_QUERIES{2000};
+const double AREA{1000000.0};        // Gaming area size (meters)
+const double RANGE{40000.0};         // Query range (meters)
+const double CELL_SIZE{10000.0};     // Index cell size (meters; IWorldModel's default)
+
+// Player with a fixed geocentric position (no world model)
+class BenchPlayer : public models::IPlayer
+{
+public:
+   explicit BenchPlayer(const base::Vec3d& p) : pos(p) {}
+   const base::Vec3d& getGeocPosition() const override   { return pos; }
+   double getTotalVelocity() const override              { return 250.0; }
+private:
+   base::Vec3d pos;
+};
+
+bool inRange(const models::IPlayer* const p, const base::Vec3d& pos)
+{
+   return (p->getGeocPosition() - pos).length2() <= RANGE * RANGE;
+}
+
+}
+
+int main()
+{
+   std::mt19937_64 rng(1001);
+   std::uniform_real_distribution<double> unit(-0.5, 0.5);
+
+   unsigned int errors{};
+   std::printf("%u range queries of %g km, %g km cells\n", NUM_QUERIES, RANGE / 1000.0, CELL_SIZE / 1000.0);
+   for (const unsigned int n : SIZES) {
+
+      // Players spread over the gaming area, near the earth's surface
+      const auto players = new base::PairStream();
+      for (unsigned int i = 0; i < n; i++) {
+         const base::Vec3d p(6378137.0 + 10000.0 * unit(rng), AREA * unit(rng), AREA * unit(rng));
+         const auto player = new BenchPlayer(p);
+         const auto pair = new base::Pair(std::to_string(i + 1), player);
+         players->put(pair);
+         pair->unref();
+         player->unref();
+      }
+      const auto index = new models::SpatialIndex(players, CELL_SIZE, 0.05);
+
+      std::vector<base::Vec3d> queries(NUM_QUERIES);
+      for (base::Vec3d& q : queries) q.set(6378137.0, AREA * unit(rng), AREA * unit(rng));
+
+      // Baseline: scan the player list
+      std::vector<unsigned int> found(NUM_QUERIES);
+      double start{base::getComputerTime()};
+      for (unsigned int k = 0; k < NUM_QUERIES; k++) {
+         for (const base::IList::Item* item = players->getFirstItem(); item != nullptr; item = item->getNext()) {
+            const auto p = static_cast<const models::IPlayer*>(static_cast<const base::Pair*>(item->getValue())->object());
+            if (inRange(p, queries[k])) found[k]++;
+         }
+      }
+      const double tScan{base::getComputerTime() - start};
+
+      // Index: check only the candidates
+      std::vector<models::IPlayer*> list;
+      unsigned int numCandidates{};
+      start = base::getComputerTime();
+      for (unsigned int k = 0; k < NUM_QUERIES; k++) {
+         list.clear();
+         numCandidates += index->findPlayersInRange(queries[k], RANGE, list);
+         unsigned int num{};
+         for (const models::IPlayer* p : list) {
+            if (inRange(p, queries[k])) num++;
+         }
+         if (num != found[k]) errors++;
+      }
+      const double tIndex{base::getComputerTime() - start};
+
+      std::printf("   %6u players: scan %9.1f ns, index %9.1f ns per query (%.1f candidates, %.1f in range)\n",
+                  n, tScan * 1.0e9 / NUM_QUERIES, tIndex * 1.0e9 / NUM_QUERIES,
+                  static_cast<double>(numCandidates) / NUM_QUERIES,
+                  [&found]() { double s{}; for (unsigned int f : found) s += f; return s / NUM_QUERIES; }());
+
+      index->unref();
+      players->unref();
+   }
+
+   if (errors > 0) {
+      std::printf("FAILED: %u queries found different players\n", errors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+// Benchmark: 2D and 4D table lookups of random and of sorted points -- the
+// scalar lookups without search hints, and the batch lookups, which start
+// each search at the previous point's breakpoints, with and without the
+// breakpoint grid indexes.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/relations/Table4.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int NUM_POINTS{200000};
+const unsigned int NUM_BREAKPOINTS{60};    // Per axis (2D); 15 per axis (4D)
+
+std::vector<double> breakpoints(const unsigned int n)
+{
+   std::vector<double> bp(n);
+   for (unsigned int i = 0; i < n; i++) bp[i] = i * 100.0 / (n - 1);
+   return bp;
+}
+
+void run(const char* const name, const base::ITable* const t, const unsigned int nd,
+         const std::vector<double>* const iv, std::vector<double>& out)
+{
+   const auto t2 = static_cast<const base::Table2*>(t);
+   const auto t4 = static_cast<const base::Table4*>(t);
+
+   double start{base::getComputerTime()};
+   for (unsigned int i = 0; i < NUM_POINTS; i++) {
+      out[i] = (nd == 2) ? t2->lfi(iv[0][i], iv[1][i]) : t4->lfi(iv[0][i], iv[1][i], iv[2][i], iv[3][i]);
+   }
+   const double tScalar{base::getComputerTime() - start};
+
+   start = base::getComputerTime();
+   if (nd == 2) t2->lfi(iv[0].data(), iv[1].data(), out.data(), NUM_POINTS);
+   else t4->lfi(iv[0].data(), iv[1].data(), iv[2].data(), iv[3].data(), out.data(), NUM_POINTS);
+   const double tBatch{base::getComputerTime() - start};
+
+   std::printf("   %-28s scalar %7.2f ns, batch %7.2f ns per point\n", name,
+               tScalar * 1.0e9 / NUM_POINTS, tBatch * 1.0e9 / NUM_POINTS);
+}
+
+}
+
+int main()
+{
+   std::mt19937_64 rng(777);
+   std::uniform_real_distribution<double> unit(0.0, 100.0);
+
+   const std::vector<double> bp2{breakpoints(NUM_BREAKPOINTS)};
+   const std::vector<double> bp4{breakpoints(NUM_BREAKPOINTS / 4)};
+   std::vector<double> d2(bp2.size() * bp2.size());
+   std::vector<double> d4(bp4.size() * bp4.size() * bp4.size() * bp4.size());
+   for (double& v : d2) v = unit(rng);
+   for (double& v : d4) v = unit(rng);
+
+   const auto t2 = new base::Table2(d2.data(), static_cast<unsigned int>(d2.size()),
+                                    bp2.data(), NUM_BREAKPOINTS, bp2.data(), NUM_BREAKPOINTS);
+   const auto nb4 = static_cast<unsigned int>(bp4.size());
+   const auto t4 = new base::Table4(d4.data(), static_cast<unsigned int>(d4.size()),
+                                    bp4.data(), nb4, bp4.data(), nb4, bp4.data(), nb4, bp4.data(), nb4);
+
+   std::vector<double> iv[4];
+   for (auto& v : iv) {
+      v.resize(NUM_POINTS);
+      for (double& x : v) x = unit(rng);
+   }
+   std::vector<double> sorted[4];
+   for (int d = 0; d < 4; d++) {
+      sorted[d] = iv[d];
+      std::sort(sorted[d].begin(), sorted[d].end());
+   }
+   std::vector<double> out(NUM_POINTS);
+
+   std::printf("%u points\n", NUM_POINTS);
+   for (int g = 0; g < 2; g++) {
+      t2->setGridIndexEnabled(g > 0);
+      t4->setGridIndexEnabled(g > 0);
+      std::printf("grid index %s\n", (g > 0 ? "on" : "off"));
+      run("2D random", t2, 2, iv, out);
+      run("2D sorted", t2, 2, sorted, out);
+      run("4D random", t4, 4, iv, out);
+      run("4D sorted", t4, 4, sorted, out);
+   }
+
+   t2->unref();
+   t4->unref();
+   return 0;
+}
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+// Test: the LZ4 block compressor and decompressor (base::lz4Compress() and
+// base::lz4Decompress()) -- round trips of empty, incompressible, highly
+// repetitive and mixed data, and, since the decompressor parses untrusted
+// input (e.g., NetInput's record batches), truncated and corrupt blocks and
+// blocks whose offsets or lengths point past the input or the output, which
+// must be rejected (LZ4_ERROR) without writing past the output buffer.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/util/compress_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const std::size_t SIZES[]{0, 1, 4, 12, 13, 100, 1000, 65536, 300000};
+const std::size_t GUARD{64};              // Guard bytes after the output buffer
+const char GUARD_BYTE{'\x5a'};
+const unsigned int NUM_CORRUPT{20000};
+
+unsigned int numErrors{};
+
+void check(const bool ok, const char* const what, const double x)
+{
+   if (!ok) {
+      if (numErrors < 10) std::printf("   error: %s (%g)\n", what, x);
+      numErrors++;
+   }
+}
+
+std::vector<char> compress(const std::vector<char>& data)
+{
+   std::vector<char> out(base::lz4CompressBound(data.size()));
+   const std::size_t n{base::lz4Compress(data.data(), data.size(), out.data(), out.size())};
+   out.resize(n);
+   return out;
+}
+
+// Decompresses into a buffer of 'dstSize' bytes, followed by guard bytes, which
+// must not be written; returns the result and the decompressed data
+std::size_t decompress(const std::vector<char>& block, const std::size_t n, const std::size_t dstSize, std::vector<char>* const out)
+{
+   out->assign(dstSize + GUARD, GUARD_BYTE);
+   const std::size_t d{base::lz4Decompress(block.data(), n, out->data(), dstSize)};
+   bool guard{true};
+   for (std::size_t i = dstSize; i < out->size(); i++) guard = guard && ((*out)[i] == GUARD_BYTE);
+   check(guard, "wrote past the output buffer", static_cast<double>(dstSize));
+   check(d == base::LZ4_ERROR || d <= dstSize, "decompressed size", static_cast<double>(d));
+   out->resize(dstSize);
+   return d;
+}
+
+void checkRoundTrip(const std::vector<char>& data, const char* const what)
+{
+   const std::vector<char> block{compress(data)};
+   check(!block.empty() && block.size() <= base::lz4CompressBound(data.size()), what, static_cast<double>(data.size()));
+
+   std::vector<char> out;
+   check(decompress(block, block.size(), data.size(), &out) == data.size() && out == data, what, static_cast<double>(data.size()));
+
+   // (too small an output buffer)
+   if (!data.empty()) {
+      check(decompress(block, block.size(), data.size() - 1, &out) == base::LZ4_ERROR, "output buffer too small", static_cast<double>(data.size()));
+   }
+}
+
+}
+
+int main()
+{
+   std::mt19937_64 rng(2301);
+   std::uniform_int_distribution<int> byte(0, 255);
+
+   // ---
+   // Round trips
+   // ---
+   for (const std::size_t n : SIZES) {
+      // incompressible
+      std::vector<char> data(n);
+      for (char& c : data) c = static_cast<char>(byte(rng));
+      checkRoundTrip(data, "random data");
+
+      // highly repetitive: a single byte, and a short pattern
+      std::vector<char> same(n, 'a');
+      checkRoundTrip(same, "repeated byte");
+      for (std::size_t i = 0; i < n; i++) same[i] = "abcdefg"[i % 7];
+      checkRoundTrip(same, "repeated pattern");
+
+      // mixed: runs of random bytes and repeats of earlier data
+      for (std::size_t i = 0; i < n; i++) {
+         data[i] = (i >= 1000 && (i / 300) % 2 == 0) ? data[i - 1000] : static_cast<char>(byte(rng) & 0x0f);
+      }
+      checkRoundTrip(data, "mixed data");
+   }
+   if (compress(std::vector<char>(100000, 'x')).size() > 1000) check(false, "repeated data didn't compress", 100000);
+
+   // ---
+   // Empty blocks: a valid, empty block (a token without literals) decompresses
+   // to zero bytes; no input at all is an error
+   // ---
+   {
+      std::vector<char> out;
+      check(decompress(std::vector<char>{0}, 1, 0, &out) == 0, "empty block", 0);
+      check(decompress(std::vector<char>{0}, 1, 16, &out) == 0, "empty block into a buffer", 16);
+      check(decompress(std::vector<char>{}, 0, 16, &out) == base::LZ4_ERROR, "no input", 0);
+   }
+
+   // ---
+   // Truncated blocks: each shorter block is an error or a shorter result
+   // ---
+   {
+      std::vector<char> data(5000);
+      for (std::size_t i = 0; i < data.size(); i++) data[i] = (i % 500 < 100) ? static_cast<char>(byte(rng)) : data[i % 100];
+      const std::vector<char> block{compress(data)};
+      std::vector<char> out;
+      for (std::size_t n = 0; n < block.size(); n++) {
+         const std::size_t d{decompress(block, n, data.size(), &out)};
+         check(d != data.size(), "truncated block", static_cast<double>(n));
+      }
+   }
+
+   // ---
+   // Corrupt blocks: random bytes changed in valid blocks
+   // ---
+   {
+      std::vector<char> data(2000);
+      for (std::size_t i = 0; i < data.size(); i++) data[i] = (i % 200 < 50) ? static_cast<char>(byte(rng)) : data[i % 50];
+      const std::vector<char> block{compress(data)};
+      std::uniform_int_distribution<std::size_t> pos(0, block.size() - 1);
+      std::vector<char> out;
+      for (unsigned int k = 0; k < NUM_CORRUPT; k++) {
+         std::vector<char> bad{block};
+         for (unsigned int i = 0; i <= k % 4; i++) bad[pos(rng)] = static_cast<char>(byte(rng));
+         decompress(bad, bad.size(), data.size(), &out);
+      }
+
+      // random input
+      for (unsigned int k = 0; k < NUM_CORRUPT; k++) {
+         std::vector<char> bad(1 + k % 64);
+         for (char& c : bad) c = static_cast<char>(byte(rng));
+         decompress(bad, bad.size(), 256, &out);
+      }
+   }
+
+   // ---
+   // Crafted blocks: a token (literal and match lengths), literals, a match
+   // offset (little-endian) and the last, literals only, sequence
+   // ---
+   {
+      std::vector<char> out;
+
+      // valid: 4 literals, then a match of 8 at offset 4
+      const std::vector<char> ok{'\x44', 'a', 'b', 'c', 'd', 4, 0, '\x10', 'e'};
+      check(decompress(ok, ok.size(), 64, &out) == 13 && std::string(out.data(), 13) == "abcdabcdabcde", "crafted block", 13);
+
+      // offset zero
+      const std::vector<char> zero{'\x44', 'a', 'b', 'c', 'd', 0, 0, '\x10', 'e'};
+      check(decompress(zero, zero.size(), 64, &out) == base::LZ4_ERROR, "zero offset", 0);
+
+      // offsets past the start of the output
+      const std::vector<char> before{'\x44', 'a', 'b', 'c', 'd', 5, 0, '\x10', 'e'};
+      check(decompress(before, before.size(), 64, &out) == base::LZ4_ERROR, "offset past the output", 5);
+      const std::vector<char> far{'\x44', 'a', 'b', 'c', 'd', '\xff', '\xff', '\x10', 'e'};
+      check(decompress(far, far.size(), 64, &out) == base::LZ4_ERROR, "max offset", 65535);
+
+      // literal length past the input (also with extra length bytes)
+      const std::vector<char> lit{'\x50', 'a', 'b', 'c'};
+      check(decompress(lit, lit.size(), 64, &out) == base::LZ4_ERROR, "literal length past the input", 5);
+      const std::vector<char> litExtra{'\xf0', '\xff', '\xff', '\x10', 'a'};
+      check(decompress(litExtra, litExtra.size(), 1024, &out) == base::LZ4_ERROR, "extra literal length past the input", 540);
+      const std::vector<char> litMissing{'\xf0', '\xff'};
+      check(decompress(litMissing, litMissing.size(), 1024, &out) == base::LZ4_ERROR, "missing literal length", 270);
+
+      // literal length past the output
+      const std::vector<char> litOut{'\x50', 'a', 'b', 'c', 'd', 'e'};
+      check(decompress(litOut, litOut.size(), 4, &out) == base::LZ4_ERROR, "literal length past the output", 5);
+
+      // match length past the output (also with extra length bytes)
+      const std::vector<char> match{'\x4f', 'a', 'b', 'c', 'd', 1, 0, '\x40', '\x00'};
+      check(decompress(match, match.size(), 64, &out) == base::LZ4_ERROR, "match length past the output", 83);
+      const std::vector<char> matchExtra{'\x4f', 'a', 'b', 'c', 'd', 1, 0, '\xff', '\xff', '\x00', '\x00'};
+      check(decompress(matchExtra, matchExtra.size(), 256, &out) == base::LZ4_ERROR, "extra match length past the output", 533);
+
+      // truncated offset, and a missing last sequence
+      const std::vector<char> offset{'\x44', 'a', 'b', 'c', 'd', 4};
+      check(decompress(offset, offset.size(), 64, &out) == base::LZ4_ERROR, "truncated offset", 4);
+      const std::vector<char> last{'\x44', 'a', 'b', 'c', 'd', 4, 0};
+      check(decompress(last, last.size(), 64, &out) == base::LZ4_ERROR, "missing last sequence", 12);
+   }
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u errors\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+// Test: the batch dead reckoning (interop::DeadReckoningBatch) against each
+// NIB's own dead reckoning, for all of the standard DR algorithms (STATIC_DRM
+// to FVB_DRM; OTHER_DRM is user defined), random DR states
+// (including no rotation) and random DR times.  Using the scalar simd
+// kernels the results must be identical, and using the AVX2 kernels the
+// positions must be identical and the angles within MAX_ANGLE_ERROR.  Also
+// steps proxy (input) NIBs using batched results for their next DR step
+// (INib::getNextDrStep() and setDrResult()), which must match unbatched NIBs,
+// and checks that results for another step or delta time aren't used.
+//------------------------------------------------------------------------------
+
+#include "mixr/interop/DeadReckoningBatch.hpp"
+#include "mixr/interop/INib.hpp"
+#include "mixr/base/util/simd_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int NUM_PER_ALGORITHM{2000};
+const double MAX_ANGLE_ERROR{4.0e-15};       // (rad)
+const unsigned int NUM_STEPS{20};            // Proxy NIB DR steps
+const double STEP{0.08};                     // Proxy NIB DR step (sec)
+
+unsigned int numErrors{};
+
+bool identical(const base::Vec3d& a, const base::Vec3d& b)
+{
+   return std::memcmp(a.ptr(), b.ptr(), 3 * sizeof(double)) == 0;
+}
+
+// Largest angle difference (rad), wrapped to [ -pi .. pi ]
+double angleError(const base::Vec3d& a, const base::Vec3d& b)
+{
+   double worst{};
+   for (int k = 0; k < 3; k++) {
+      const double d{std::fabs(std::remainder(a[k] - b[k], 2.0 * M_PI))};
+      if (d > worst) worst = d;
+   }
+   return worst;
+}
+
+}
+
+int main()
+{
+   std::mt19937_64 rng(1278);
+   std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+   // ---
+   // NIBs of every DR algorithm, and their DR times
+   // ---
+   std::vector<interop::INib*> nibs;
+   std::vector<double> times;
+   for (unsigned char dr = interop::INib::STATIC_DRM; dr <= interop::INib::FVB_DRM; dr++) {
+      for (unsigned int i = 0; i < NUM_PER_ALGORITHM; i++) {
+         const base::Vec3d p(6.4e6 * unit(rng), 6.4e6 * unit(rng), 6.4e6 * unit(rng));
+         const base::Vec3d v(300.0 * unit(rng), 300.0 * unit(rng), 300.0 * unit(rng));
+         const base::Vec3d a(10.0 * unit(rng), 10.0 * unit(rng), 10.0 * unit(rng));
+         const base::Vec3d rpy(M_PI * unit(rng), 0.5 * M_PI * unit(rng), M_PI * unit(rng));
+         base::Vec3d av(0.5 * unit(rng), 0.5 * unit(rng), 0.5 * unit(rng));
+         if (i % 10 == 0) av.set(0, 0, 0);
+
+         const auto nib = new interop::INib(interop::INetIO::INPUT_NIB);
+         nib->resetDeadReckoning(dr, p, v, a, rpy, av);
+         nibs.push_back(nib);
+         times.push_back(i % 50 == 0 ? 0.0 : 10.0 * std::fabs(unit(rng)));
+      }
+   }
+   const auto n = static_cast<unsigned int>(nibs.size());
+
+   // ---
+   // Each NIB's own dead reckoning (from DR time zero)
+   // ---
+   std::vector<base::Vec3d> refPos(n), refAngles(n);
+   for (unsigned int i = 0; i < n; i++) {
+      nibs[i]->updateDeadReckoning(times[i], &refPos[i], &refAngles[i]);
+   }
+
+   // ---
+   // The batch, with the scalar and the AVX2 kernels
+   // ---
+   for (int k = 0; k < 2; k++) {
+      const bool avx2{k > 0};
+      if (!base::simd::setKernels(avx2 ? base::simd::Kernels::AVX2 : base::simd::Kernels::SCALAR)) {
+         std::printf("   %-6s kernels aren't supported on this CPU\n", "avx2");
+         continue;
+      }
+
+      interop::DeadReckoningBatch batch;
+      for (unsigned int i = 0; i < n; i++) {
+         batch.add(nibs[i], times[i]);
+      }
+      batch.compute();
+
+      unsigned int errors{};
+      double worst{};
+      for (unsigned int i = 0; i < n; i++) {
+         const double e{angleError(batch.getAngles(i), refAngles[i])};
+         if (e > worst) worst = e;
+         const bool ok{identical(batch.getPosition(i), refPos[i]) &&
+                       (avx2 ? (e <= MAX_ANGLE_ERROR) : identical(batch.getAngles(i), refAngles[i]))};
+         if (!ok) {
+            if (numErrors + errors < 20) {
+               std::printf("ERROR: %s kernels, DR algorithm %u, NIB %u (dT %g): position (%.17g, %.17g, %.17g), expected (%.17g, %.17g, %.17g); "
+                           "angles (%.17g, %.17g, %.17g), expected (%.17g, %.17g, %.17g)\n",
+                           (avx2 ? "avx2" : "scalar"), interop::INib::STATIC_DRM + i / NUM_PER_ALGORITHM, i, times[i],
+                           batch.getPosition(i)[0], batch.getPosition(i)[1], batch.getPosition(i)[2],
+                           refPos[i][0], refPos[i][1], refPos[i][2],
+                           batch.getAngles(i)[0], batch.getAngles(i)[1], batch.getAngles(i)[2],
+                           refAngles[i][0], refAngles[i][1], refAngles[i][2]);
+            }
+            errors++;
+         }
+      }
+      std::printf("   %-6s kernels: %u NIBs, %u mismatches, max angle error %g rad\n",
+                  (avx2 ? "avx2" : "scalar"), n, errors, worst);
+      numErrors += errors;
+   }
+
+   // ---
+   // Proxy NIBs: NIBs with the same DR states that are stepped using the
+   // batch's results for their next DR step (with the scalar kernels), against
+   // NIBs that use their own DR; every fifth step the batch's results are for the wrong step number
+   // or delta time, and mustn't be used
+   // ---
+   base::simd::setKernels(base::simd::Kernels::SCALAR);
+   {
+      std::vector<interop::INib*> owns(n), proxies(n);
+      for (unsigned int i = 0; i < n; i++) {
+         owns[i] = new interop::INib(interop::INetIO::INPUT_NIB);
+         proxies[i] = new interop::INib(interop::INetIO::INPUT_NIB);
+         for (interop::INib* nib : {owns[i], proxies[i]}) {
+            nib->resetDeadReckoning(nibs[i]->getDeadReckoning(), nibs[i]->getDrPosition(), nibs[i]->getDrVelocity(),
+                                    nibs[i]->getDrAcceleration(), nibs[i]->getDrEulerAngles(), nibs[i]->getDrAngularVelocities());
+         }
+      }
+
+      unsigned int errors{};
+      interop::DeadReckoningBatch batch;
+      std::vector<unsigned int> steps(n);
+      for (unsigned int s = 0; s < NUM_STEPS; s++) {
+         batch.clear();
+         for (unsigned int i = 0; i < n; i++) {
+            batch.add(proxies[i], proxies[i]->getNextDrStep(&steps[i]));
+         }
+         batch.compute();
+         for (unsigned int i = 0; i < n; i++) {
+            const bool wrongStep{s % 5 == 3 && i % 2 == 0};
+            if (wrongStep) {
+               // (a bad position for another step)
+               proxies[i]->setDrResult(batch.getTime(i), batch.getPosition(i) + base::Vec3d(1, 1, 1), batch.getAngles(i), steps[i] + 1);
+            } else {
+               proxies[i]->setDrResult(batch.getTime(i), batch.getPosition(i), batch.getAngles(i), steps[i]);
+            }
+         }
+
+         const double dt{s % 5 == 4 ? 0.5 * STEP : STEP};
+         for (unsigned int i = 0; i < n; i++) {
+            base::Vec3d pos, angles, proxyPos, proxyAngles;
+            owns[i]->updateDeadReckoning(dt, &pos, &angles);
+            proxies[i]->updateDeadReckoning(dt, &proxyPos, &proxyAngles);
+            if (!identical(proxyPos, pos) || !identical(proxyAngles, angles)) {
+               if (numErrors + errors < 20) {
+                  std::printf("ERROR: proxy NIB %u, step %u: position (%.17g, %.17g, %.17g), expected (%.17g, %.17g, %.17g)\n",
+                              i, s, proxyPos[0], proxyPos[1], proxyPos[2], pos[0], pos[1], pos[2]);
+               }
+               errors++;
+            }
+         }
+      }
+      std::printf("   proxy NIBs: %u NIBs, %u steps, %u mismatches\n", n, NUM_STEPS, errors);
+      numErrors += errors;
+
+      for (interop::INib* nib : owns) nib->unref();
+      for (interop::INib* nib : proxies) nib->unref();
+   }
+   base::simd::setKernels(base::simd::Kernels::AVX2);
+
+   for (interop::INib* nib : nibs) nib->unref();
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u mismatches\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
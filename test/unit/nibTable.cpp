@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+// Test: the NIB table (interop::NibTable) -- adding, finding and removing
+// NIBs, including clusters of hash slots that wrap around the end of the
+// table (the backward-shift erase must keep the rest of the cluster
+// findable), and random adds and removes against a reference std::map.
+//------------------------------------------------------------------------------
+
+#include "mixr/interop/NibTable.hpp"
+#include "mixr/interop/INib.hpp"
+#include "mixr/interop/INetIO.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int NUM_SLOTS{64};            // Initial hash table size
+const unsigned int NUM_RANDOM_OPS{200000};
+const unsigned short NUM_RANDOM_IDS{3000};
+
+unsigned int numErrors{};
+
+std::vector<interop::INib*> allNibs;
+
+interop::INib* newNib(const unsigned short id, const std::string& fed)
+{
+   const auto nib = new interop::INib(interop::INetIO::INPUT_NIB);
+   nib->setPlayerID(id);
+   nib->setFederateName(fed);
+   allNibs.push_back(nib);
+   return nib;
+}
+
+void check(const bool ok, const char* const what, const unsigned int id)
+{
+   if (!ok) {
+      if (numErrors < 10) std::printf("   error: %s (player %u)\n", what, id);
+      numErrors++;
+   }
+}
+
+// The table's entries match the reference, and each one can be found
+void checkContents(const interop::NibTable& tbl, const std::map<std::pair<std::string, unsigned short>, interop::INib*>& ref)
+{
+   check(tbl.size() == ref.size(), "size", tbl.size());
+   for (const auto& e : ref) {
+      check(tbl.find(e.first.second, e.first.first) == e.second, "find", e.first.second);
+   }
+   for (unsigned int i = 0; i < tbl.size(); i++) {
+      const interop::INib* nib{tbl.get(i)};
+      const auto it = ref.find(std::make_pair(nib->getFederateName(), nib->getPlayerID()));
+      check(it != ref.end() && it->second == nib, "get", nib->getPlayerID());
+   }
+}
+
+}
+
+int main()
+{
+   // ---
+   // Add, find and remove
+   // ---
+   {
+      interop::NibTable tbl;
+      check(tbl.find(1, "fed") == nullptr, "find in empty table", 1);
+      check(!tbl.remove(nullptr), "remove null", 0);
+
+      interop::INib* a{newNib(1, "fed")};
+      interop::INib* b{newNib(2, "fed")};
+      interop::INib* c{newNib(1, "other")};
+      check(tbl.add(a) && tbl.add(b) && tbl.add(c), "add", 1);
+      check(!tbl.add(newNib(2, "fed")), "duplicate add", 2);
+      check(tbl.size() == 3, "size after adds", 3);
+
+      check(tbl.find(1, "fed") == a, "find a", 1);
+      check(tbl.find(2, "fed") == b, "find b", 2);
+      check(tbl.find(1, "other") == c, "find c", 1);
+      check(tbl.find(3, "fed") == nullptr, "find missing player", 3);
+      check(tbl.find(1, "unknown") == nullptr, "find missing federate", 1);
+
+      // Remove the first entry: the last one is moved to its index
+      check(tbl.remove(a), "remove a", 1);
+      check(!tbl.remove(a), "remove a twice", 1);
+      check(tbl.size() == 2 && tbl.get(0) == c && tbl.get(1) == b, "moved last", 1);
+      check(tbl.find(1, "fed") == nullptr && tbl.find(1, "other") == c, "find after remove", 1);
+      check(tbl.get(2) == nullptr, "get past end", 2);
+
+      tbl.removeAt(1);
+      check(tbl.size() == 1 && tbl.find(2, "fed") == nullptr, "removeAt", 2);
+
+      tbl.clear();
+      check(tbl.size() == 0 && tbl.find(1, "other") == nullptr, "clear", 1);
+      check(tbl.add(a) && tbl.find(1, "fed") == a, "add after clear", 1);
+   }
+
+   // ---
+   // Clusters that wrap around the end of the hash table: the first
+   // federate's ID is zero, so the key is the player ID.  Pick players whose
+   // home slots are the last two and the first slot, then remove them in
+   // random orders.
+   // ---
+   {
+      std::vector<unsigned short> ids;
+      for (unsigned int k = 0; k < 3; k++) {
+         const std::uint32_t home{(NUM_SLOTS - 2 + k) % NUM_SLOTS};
+         unsigned int n{};
+         for (unsigned int id = 1; id < 0x10000 && n < 3; id++) {
+            if ((interop::NibTable::hash(id) & (NUM_SLOTS - 1)) == home) {
+               ids.push_back(static_cast<unsigned short>(id));
+               n++;
+            }
+         }
+      }
+
+      std::mt19937_64 rng(1401);
+      for (unsigned int pass = 0; pass < 200; pass++) {
+         interop::NibTable tbl;
+         std::map<std::pair<std::string, unsigned short>, interop::INib*> ref;
+         std::shuffle(ids.begin(), ids.end(), rng);
+         for (const unsigned short id : ids) {
+            interop::INib* nib{newNib(id, "fed")};
+            check(tbl.add(nib), "add to cluster", id);
+            ref[std::make_pair(std::string("fed"), id)] = nib;
+         }
+         checkContents(tbl, ref);
+
+         std::shuffle(ids.begin(), ids.end(), rng);
+         for (const unsigned short id : ids) {
+            const auto it = ref.find(std::make_pair(std::string("fed"), id));
+            check(tbl.remove(it->second), "remove from cluster", id);
+            ref.erase(it);
+            checkContents(tbl, ref);
+         }
+      }
+   }
+
+   // ---
+   // Random adds and removes (with growth) against a reference map
+   // ---
+   {
+      const std::string feds[]{"fed1", "fed2", "fed3"};
+      std::mt19937_64 rng(1402);
+      std::uniform_int_distribution<unsigned int> idDist(1, NUM_RANDOM_IDS);
+      std::uniform_int_distribution<unsigned int> fedDist(0, 2);
+
+      // One NIB per player ID and federate
+      std::map<std::pair<std::string, unsigned short>, interop::INib*> pool;
+      for (const std::string& fed : feds) {
+         for (unsigned short id = 1; id <= NUM_RANDOM_IDS; id++) pool[std::make_pair(fed, id)] = newNib(id, fed);
+      }
+
+      interop::NibTable tbl;
+      std::map<std::pair<std::string, unsigned short>, interop::INib*> ref;
+      for (unsigned int i = 0; i < NUM_RANDOM_OPS; i++) {
+         const auto id = static_cast<unsigned short>(idDist(rng));
+         const std::string& fed{feds[fedDist(rng)]};
+         const auto key = std::make_pair(fed, id);
+         const auto it = ref.find(key);
+         if (it == ref.end()) {
+            interop::INib* nib{pool[key]};
+            check(tbl.find(id, fed) == nullptr, "random find miss", id);
+            check(tbl.add(nib), "random add", id);
+            ref[key] = nib;
+         }
+         else if (i % 3 == 0) {
+            check(tbl.find(id, fed) == it->second, "random find hit", id);
+         }
+         else {
+            check(tbl.remove(it->second), "random remove", id);
+            ref.erase(it);
+         }
+         if (i % 10000 == 0) checkContents(tbl, ref);
+      }
+      checkContents(tbl, ref);
+   }
+
+   for (interop::INib* nib : allNibs) nib->unref();
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u errors\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------
+// Test: converting a legacy data recorder file to an indexed data file, both
+// uncompressed and compressed (recorder::protobuf_v2::FileWriter::convert()).
+// The indexed file must hold the legacy file's records, in order, and
+// FileReader::seekTime() on it must go to the first record at which the sim
+// time has reached the seek time (the legacy file's sim times restart after
+// a reset).
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/protobuf_v2/FileReader.hpp"
+#include "mixr/recorder/protobuf_v2/FileWriter.hpp"
+#include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
+
+#include "mixr/simulation/dataRecorderTokens.hpp"
+
+#include "mixr/base/String.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace mixr;
+using namespace mixr::recorder::protobuf_v2;
+
+namespace {
+
+const unsigned int NUM_RECORDS{6000};
+const unsigned int RESET_RECORD{4000};     // Sim times restart at this record
+const unsigned int NUM_PLAYERS{8};
+const double DT{0.01};                     // Sim time step (seconds)
+
+unsigned int numErrors{};
+
+void check(const bool ok, const char* const what, const double x)
+{
+   if (!ok) {
+      if (numErrors < 10) std::printf("   error: %s (%g)\n", what, x);
+      numErrors++;
+   }
+}
+
+// The test's records: player data and markers, ending with an end of data record
+std::vector<std::string> makeRecords(std::vector<double>* const times)
+{
+   std::vector<std::string> records;
+   for (unsigned int i = 0; i <= NUM_RECORDS; i++) {
+      proto::DataRecord record;
+      const double t{(i < RESET_RECORD ? i : i - RESET_RECORD) * DT};
+      record.mutable_time()->set_sim_time(t);
+      record.mutable_time()->set_exec_time(i * DT);
+      if (i == NUM_RECORDS) {
+         record.set_id(REID_END_OF_DATA);
+      } else if (i % 10 == 0) {
+         record.set_id(REID_MARKER);
+         record.mutable_marker_msg()->set_id(i);
+         record.mutable_marker_msg()->set_source_id(1);
+      } else {
+         record.set_id(REID_PLAYER_DATA);
+         proto::PlayerDataMsg* const msg{record.mutable_player_data_msg()};
+         msg->mutable_id()->set_id(1 + i % NUM_PLAYERS);
+         msg->mutable_id()->set_name("player" + std::to_string(1 + i % NUM_PLAYERS));
+         proto::PlayerState* const state{msg->mutable_state()};
+         state->mutable_pos()->set_x(6378137.0 + i);
+         state->mutable_pos()->set_y(100.0 * t);
+         state->mutable_pos()->set_z(-50.0 * t);
+         state->mutable_angles()->set_x(0.001 * i);
+         state->mutable_angles()->set_y(0.0);
+         state->mutable_angles()->set_z(1.5);
+         msg->set_cas(250.0 + 0.01 * i);
+      }
+      records.push_back(record.SerializeAsString());
+      times->push_back(t);
+   }
+   return records;
+}
+
+// Writes the records to a legacy data file
+bool writeLegacy(const std::string& filename, const std::vector<std::string>& records)
+{
+   const auto writer = new FileWriter();
+   const auto name = new base::String(filename.c_str());
+   writer->setFilename(name);
+   name->unref();
+   writer->setFormat(FileWriter::Format::LEGACY);
+
+   bool ok{writer->openFile()};
+   for (unsigned int i = 0; ok && i < records.size(); i++) {
+      const auto record = new proto::DataRecord();
+      record->ParseFromString(records[i]);
+      const auto handle = new DataRecordHandle(record);
+      writer->processRecord(handle);
+      handle->unref();
+   }
+   ok = ok && !writer->isFailed();
+   writer->unref();
+   return ok;
+}
+
+FileReader* openReader(const std::string& filename)
+{
+   const auto reader = new FileReader();
+   const auto name = new base::String(filename.c_str());
+   reader->setFilename(name);
+   name->unref();
+   reader->openFile();
+   return reader;
+}
+
+// Checks the next records of the reader against the records from 'first'
+void checkRecords(FileReader* const reader, const std::vector<std::string>& records, const std::size_t first, const std::size_t num)
+{
+   for (std::size_t i = first; i < first + num; i++) {
+      const DataRecordHandle* const handle{reader->readRecord()};
+      if (i < records.size()) {
+         check(handle != nullptr && handle->getRecord()->SerializeAsString() == records[i], "record", static_cast<double>(i));
+      } else {
+         check(handle == nullptr, "record after the end", static_cast<double>(i));
+      }
+      if (handle != nullptr) handle->unref();
+   }
+}
+
+}
+
+int main()
+{
+   char dir[]{"/tmp/recorderConvertXXXXXX"};
+   if (mkdtemp(dir) == nullptr) {
+      std::printf("FAILED: can't create a temporary directory\n");
+      return 1;
+   }
+   const std::string legacy{std::string(dir) + "/legacy.dat"};
+
+   std::vector<double> times;
+   const std::vector<std::string> records{makeRecords(&times)};
+   check(writeLegacy(legacy, records), "write the legacy file", 0);
+
+   // The legacy file can't seek
+   {
+      FileReader* const reader{openReader(legacy)};
+      check(reader->isOpen() && !reader->isIndexed(), "legacy file", 0);
+      check(!reader->seekTime(1.0), "legacy seekTime()", 1.0);
+      checkRecords(reader, records, 0, records.size());
+      reader->unref();
+   }
+
+   // Seek times: first, in the first segment, after the reset, the last and past the end
+   const double last{(NUM_RECORDS - RESET_RECORD) * DT};
+   const double seekTimes[]{-1.0, 0.0, 0.005, 12.34, 25.0, RESET_RECORD * DT - DT, RESET_RECORD * DT, last, 1000.0};
+
+   for (const bool compress : {false, true}) {
+      const std::string indexed{std::string(dir) + (compress ? "/compressed.dat" : "/indexed.dat")};
+      check(FileWriter::convert(legacy.c_str(), indexed.c_str(), compress), "convert", compress);
+
+      FileReader* const reader{openReader(indexed)};
+      check(reader->isOpen() && reader->isIndexed() && reader->isCompressed() == compress, "indexed file", compress);
+      check(reader->getNumIndexedRecords() == records.size(), "indexed records", static_cast<double>(reader->getNumIndexedRecords()));
+
+      // All of the records, in order
+      checkRecords(reader, records, 0, records.size() + 1);
+
+      // Seek: the first record at which the sim time has reached the seek time
+      for (const double t : seekTimes) {
+         double maxTime{-1.0e30};
+         std::size_t expected{records.size()};
+         for (std::size_t i = 0; i < times.size(); i++) {
+            maxTime = std::max(maxTime, times[i]);
+            if (maxTime >= t) {
+               expected = i;
+               break;
+            }
+         }
+         check(reader->seekTime(t), "seekTime()", t);
+         checkRecords(reader, records, expected, 25);
+      }
+
+      // Seek backwards after reading to the end
+      checkRecords(reader, records, records.size(), 1);
+      check(reader->seekTime(0.5), "seekTime() after the end", 0.5);
+      checkRecords(reader, records, 50, 10);
+
+      reader->unref();
+      std::remove(indexed.c_str());
+   }
+
+   std::remove(legacy.c_str());
+   rmdir(dir);
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u errors\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
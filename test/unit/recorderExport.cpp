@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+// Test: exporting a small indexed data recorder file, uncompressed and
+// compressed, as tables (recorder::protobuf_v2::RecordExporter) with several
+// decoder threads.  Each table's rows must be the file's records, in the
+// file's order, in both the CSV and the columns formats, and with a player
+// filter, only that player's records.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/protobuf_v2/RecordExporter.hpp"
+#include "mixr/recorder/protobuf_v2/FileWriter.hpp"
+#include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
+
+#include "mixr/simulation/dataRecorderTokens.hpp"
+
+#include "mixr/base/String.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace mixr;
+using namespace mixr::recorder::protobuf_v2;
+
+namespace {
+
+const unsigned int NUM_RECORDS{20000};     // (several index blocks and compressed blocks)
+const unsigned int NUM_PLAYERS{5};
+const unsigned int FILTER_PLAYER{3};
+const unsigned int NUM_THREADS{4};
+const double DT{0.01};                     // Sim time step (seconds)
+
+unsigned int numErrors{};
+
+void check(const bool ok, const char* const what, const double x)
+{
+   if (!ok) {
+      if (numErrors < 10) std::printf("   error: %s (%g)\n", what, x);
+      numErrors++;
+   }
+}
+
+// An expected table row: its record's exec time (unique) and player
+struct Row {
+   double time{};
+   unsigned int player{};
+};
+
+// Writes the test's indexed data file: player data, with markers (which aren't
+// exported) and weapon detonations in between; returns the expected rows of
+// the players and detonations tables
+bool writeFile(const std::string& filename, const bool compress, std::vector<Row>* const players, std::vector<Row>* const detonations)
+{
+   const auto writer = new FileWriter();
+   const auto name = new base::String(filename.c_str());
+   writer->setFilename(name);
+   name->unref();
+   writer->setFormat(FileWriter::Format::INDEXED);
+   writer->setCompress(compress);
+
+   bool ok{writer->openFile()};
+   for (unsigned int i = 0; ok && i <= NUM_RECORDS; i++) {
+      const auto record = new proto::DataRecord();
+      const double t{i * DT};
+      record->mutable_time()->set_sim_time(t);
+      record->mutable_time()->set_exec_time(t);
+      const unsigned int player{1 + i % NUM_PLAYERS};
+      if (i == NUM_RECORDS) {
+         record->set_id(REID_END_OF_DATA);
+      } else if (i % 50 == 0) {
+         record->set_id(REID_MARKER);
+         record->mutable_marker_msg()->set_id(i);
+         record->mutable_marker_msg()->set_source_id(1);
+      } else if (i % 101 == 0) {
+         record->set_id(REID_WEAPON_DETONATION);
+         proto::WeaponDetonationEventMsg* const msg{record->mutable_weapon_detonation_event_msg()};
+         msg->mutable_wpn_id()->set_id(player);     // (the player filter uses the weapon's ID)
+         msg->mutable_wpn_id()->set_name("missile");
+         msg->mutable_shooter_id()->set_id(1 + (i + 1) % NUM_PLAYERS);
+         msg->mutable_tgt_id()->set_id(1 + (i + 2) % NUM_PLAYERS);
+         msg->set_det_type(proto::WeaponDetonationEventMsg::DETONATE_ENTITY_IMPACT);
+         msg->set_miss_dist(2.5);
+         detonations->push_back(Row{t, player});
+      } else {
+         record->set_id(REID_PLAYER_DATA);
+         proto::PlayerDataMsg* const msg{record->mutable_player_data_msg()};
+         msg->mutable_id()->set_id(player);
+         msg->mutable_id()->set_name("player" + std::to_string(player));
+         proto::PlayerState* const state{msg->mutable_state()};
+         state->mutable_pos()->set_x(6378137.0 + i);
+         state->mutable_pos()->set_y(100.0 * t);
+         state->mutable_pos()->set_z(-50.0 * t);
+         state->mutable_angles()->set_x(0.001 * i);
+         state->mutable_angles()->set_y(0.0);
+         state->mutable_angles()->set_z(1.5);
+         msg->set_cas(250.0 + 0.01 * i);
+         players->push_back(Row{t, player});
+      }
+      const auto handle = new DataRecordHandle(record);
+      writer->processRecord(handle);
+      handle->unref();
+   }
+   ok = ok && !writer->isFailed();
+   writer->unref();
+   return ok;
+}
+
+bool exportFile(const std::string& filename, const std::string& output, const RecordExporter::Format format, const bool filter)
+{
+   const auto exporter = new RecordExporter();
+   const auto name = new base::String(filename.c_str());
+   const auto out = new base::String(output.c_str());
+   exporter->setFilename(name);
+   exporter->setOutput(out);
+   name->unref();
+   out->unref();
+   exporter->setFormat(format);
+   exporter->setNumThreads(NUM_THREADS);
+   if (filter) exporter->setPlayerFilter(FILTER_PLAYER);
+
+   const bool ok{exporter->exportFile() && exporter->getNumErrors() == 0};
+   exporter->unref();
+   return ok;
+}
+
+// The expected rows, or only the filter player's
+std::vector<Row> expectedRows(const std::vector<Row>& rows, const bool filter)
+{
+   std::vector<Row> r;
+   for (const Row& row : rows) {
+      if (!filter || row.player == FILTER_PLAYER) r.push_back(row);
+   }
+   return r;
+}
+
+// Checks a CSV table's rows: their exec time and player ID columns
+void checkCsv(const std::string& filename, const std::vector<Row>& rows, const unsigned int playerColumn)
+{
+   std::ifstream in(filename);
+   std::string line;
+   check(std::getline(in, line) && line.compare(0, 18, "sim_time,exec_time") == 0, "CSV header", 0);
+
+   std::size_t n{};
+   while (std::getline(in, line)) {
+      std::vector<std::string> fields;
+      std::istringstream ss(line);
+      for (std::string f; std::getline(ss, f, ',');) fields.push_back(f);
+      const bool ok{n < rows.size() && fields.size() > playerColumn &&
+                    std::strtod(fields[1].c_str(), nullptr) == rows[n].time &&
+                    std::strtoul(fields[playerColumn].c_str(), nullptr, 10) == rows[n].player};
+      check(ok, "CSV row", static_cast<double>(n));
+      n++;
+   }
+   check(n == rows.size(), "CSV rows", static_cast<double>(n));
+}
+
+// Checks a table's exec time column file (little-endian float64 values)
+void checkColumn(const std::string& filename, const std::vector<Row>& rows)
+{
+   std::ifstream in(filename, std::ios_base::binary);
+   const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+   check(data.size() == rows.size() * sizeof(double), "column size", static_cast<double>(data.size()));
+   for (std::size_t i = 0; i < rows.size() && (i + 1) * sizeof(double) <= data.size(); i++) {
+      std::uint64_t bits{};
+      for (unsigned int k = 0; k < 8; k++) bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i * 8 + k])) << (8 * k);
+      double v{};
+      std::memcpy(&v, &bits, sizeof(v));
+      check(v == rows[i].time, "column row", static_cast<double>(i));
+   }
+}
+
+}
+
+int main()
+{
+   char dir[]{"/tmp/recorderExportXXXXXX"};
+   if (mkdtemp(dir) == nullptr) {
+      std::printf("FAILED: can't create a temporary directory\n");
+      return 1;
+   }
+
+   // (player_id is column 4 of the players table; wpn_id is column 3 of the detonations table)
+   const unsigned int playerColumn{4};
+   const unsigned int weaponColumn{3};
+   const std::vector<const char*> tables{"players", "tracks", "detonations"};
+
+   for (const bool compress : {false, true}) {
+      const std::string filename{std::string(dir) + (compress ? "/compressed.dat" : "/indexed.dat")};
+      std::vector<Row> players;
+      std::vector<Row> detonations;
+      check(writeFile(filename, compress, &players, &detonations), "write the data file", compress);
+
+      for (const bool filter : {false, true}) {
+         const std::vector<Row> p{expectedRows(players, filter)};
+         const std::vector<Row> d{expectedRows(detonations, filter)};
+         const std::string output{std::string(dir) + "/out"};
+
+         // CSV
+         check(exportFile(filename, output, RecordExporter::Format::CSV, filter), "CSV export", filter);
+         checkCsv(output + "_players.csv", p, playerColumn);
+         checkCsv(output + "_detonations.csv", d, weaponColumn);
+         for (const char* t : tables) std::remove((output + "_" + t + ".csv").c_str());
+
+         // Columns
+         check(exportFile(filename, output, RecordExporter::Format::COLUMNS, filter), "columns export", filter);
+         checkColumn(output + "_players.exec_time", p);
+         checkColumn(output + "_detonations.exec_time", d);
+         for (unsigned int t = 0; t < RecordExporter::NUM_TABLES; t++) {
+            const RecordExporter::Table& table{RecordExporter::getTable(t)};
+            const std::string prefix{output + "_" + table.name};
+            std::remove((prefix + ".schema").c_str());
+            for (std::size_t c = 0; c < table.numColumns; c++) {
+               std::remove((prefix + "." + table.columns[c].name).c_str());
+               std::remove((prefix + "." + table.columns[c].name + ".offsets").c_str());
+            }
+         }
+      }
+      std::remove(filename.c_str());
+   }
+
+   rmdir(dir);
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u errors\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+// Test: the vectorized (AVX2) array kernels of simd_utils against the scalar
+// kernels -- the matrix, square root and multiply kernels must be identical,
+// and the arc-cosine, arc-tangent and power of 10 kernels within MAX_ULPS.
+// Array sizes that aren't a multiple of four check the scalar tails.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/util/simd_utils.hpp"
+#include "mixr/base/osg/Vec3d"
+#include "mixr/base/osg/Matrixd"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const double MAX_ULPS{2.0};          // Max difference of the approximations (units in the last place)
+const unsigned int NUM_RANDOM{20001};
+
+unsigned int numErrors{};
+
+// Difference of 'a' and 'b' in units in the last place of the larger
+double ulps(const double a, const double b)
+{
+   if (std::isnan(a) || std::isnan(b)) return (std::isnan(a) && std::isnan(b)) ? 0.0 : std::numeric_limits<double>::infinity();
+   if (a == b) return 0.0;
+   const double m{std::max(std::fabs(a), std::fabs(b))};
+   const double ulp{std::nextafter(m, std::numeric_limits<double>::infinity()) - m};
+   return std::fabs(a - b) / ulp;
+}
+
+bool identical(const double a, const double b)
+{
+   return (std::memcmp(&a, &b, sizeof(double)) == 0) || (std::isnan(a) && std::isnan(b));
+}
+
+void check(const char* const name, const std::vector<double>& s, const std::vector<double>& v, const double maxUlps,
+           const std::vector<double>* const in1, const std::vector<double>* const in2 = nullptr)
+{
+   double worst{};
+   for (std::size_t i = 0; i < s.size(); i++) {
+      const double d{ulps(s[i], v[i])};
+      const bool ok{maxUlps > 0.0 ? (d <= maxUlps) : identical(s[i], v[i])};
+      if (!ok) {
+         if (numErrors < 20) {
+            std::printf("ERROR: %s[%zu]: scalar %.17g, avx2 %.17g (%g ulps); input %.17g",
+                        name, i, s[i], v[i], d, (in1 != nullptr ? (*in1)[i] : 0.0));
+            if (in2 != nullptr) std::printf(", %.17g", (*in2)[i]);
+            std::printf("\n");
+         }
+         numErrors++;
+      }
+      if (d > worst) worst = d;
+   }
+   std::printf("   %-18s %7zu values, max %g ulps\n", name, s.size(), worst);
+}
+
+// Runs 'func' with the scalar and the AVX2 kernels
+template <class F>
+void both(F func)
+{
+   base::simd::setKernels(base::simd::Kernels::SCALAR);
+   func(false);
+   base::simd::setKernels(base::simd::Kernels::AVX2);
+   func(true);
+}
+
+}
+
+int main()
+{
+   if (!base::simd::isAvx2Supported()) {
+      std::printf("AVX2 kernels aren't supported on this CPU; nothing to compare\n");
+      return 0;
+   }
+
+   std::mt19937_64 rng(12345);
+   std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+   // ---
+   // Line-of-sight unit vectors, including the axes and signed zeros
+   // ---
+   std::vector<base::Vec3d> los;
+   const double axes[][3] = {
+      { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 },
+      { -0.0, -0.0, 1 }, { 1, -0.0, -0.0 }, { -1, -0.0, 0 }, { 0, 0, 0 },
+      { 0.7071067811865476, 0.7071067811865476, 0 }, { -0.7071067811865476, 0.7071067811865476, 0 },
+   };
+   for (const auto& a : axes) los.emplace_back(a[0], a[1], a[2]);
+   while (los.size() < NUM_RANDOM) {
+      base::Vec3d v(unit(rng), unit(rng), unit(rng));
+      if (v.length() > 0.0) {
+         v.normalize();
+         los.push_back(v);
+      }
+   }
+   const auto n = static_cast<unsigned int>(los.size());
+
+   // ---
+   // postMultVec3Array(): a rotation with a translation and a perspective row
+   // ---
+   {
+      base::Matrixd m;
+      m.makeRotate(0.3, base::Vec3d(0, 0, 1), -0.2, base::Vec3d(0, 1, 0), 0.1, base::Vec3d(1, 0, 0));
+      m(0, 3) = 10.0;
+      m(3, 0) = 0.001;
+      m(3, 3) = 1.5;
+      std::vector<base::Vec3d> rs(n), rv(n);
+      both([&](const bool v) { base::simd::postMultVec3Array(los.data(), m, (v ? rv : rs).data(), n); });
+      std::vector<double> s(3 * n), v(3 * n);
+      for (unsigned int i = 0; i < n; i++) {
+         for (int k = 0; k < 3; k++) { s[3 * i + k] = rs[i][k]; v[3 * i + k] = rv[i][k]; }
+      }
+      check("postMultVec3Array", s, v, 0.0, nullptr);
+   }
+
+   // ---
+   // boresightArrays()
+   // ---
+   {
+      std::vector<double> out[2][8];
+      for (auto& k : out) for (auto& a : k) a.resize(n);
+      both([&](const bool v) {
+         auto& o = out[v ? 1 : 0];
+         base::simd::boresightArrays(los.data(), o[0].data(), o[1].data(), o[2].data(), o[3].data(),
+                                     o[4].data(), o[5].data(), o[6].data(), o[7].data(), n);
+      });
+      const char* names[8] = { "boresight xa", "boresight ya", "boresight za", "boresight ra2",
+                               "boresight ra", "boresight aar", "boresight aazr", "boresight aelr" };
+      for (int k = 0; k < 8; k++) {
+         check(names[k], out[0][k], out[1][k], (k < 5 ? 0.0 : MAX_ULPS), &out[0][0], &out[0][1]);
+      }
+   }
+
+   // ---
+   // acosArray(), atan2Array(), sqrtArray() and multArrayConst()
+   // ---
+   {
+      std::vector<double> x(n), y(n);
+      for (unsigned int i = 0; i < n; i++) { x[i] = unit(rng); y[i] = unit(rng) * 1000.0; }
+      const double special[] = { 1.0, -1.0, 0.0, -0.0, 0.5, -0.5, 0.66, 1.0e-300, -1.0e-300, 0.9999999999999999 };
+      for (unsigned int i = 0; i < sizeof(special) / sizeof(special[0]); i++) x[i] = special[i];
+      y[0] = 0.0; y[1] = -0.0; y[2] = 0.0; y[3] = -0.0; y[4] = 1.0e300;
+
+      std::vector<double> s(n), v(n);
+      both([&](const bool k) { base::simd::acosArray(x.data(), (k ? v : s).data(), n); });
+      check("acosArray", s, v, MAX_ULPS, &x);
+
+      both([&](const bool k) { base::simd::atan2Array(y.data(), x.data(), (k ? v : s).data(), n); });
+      check("atan2Array", s, v, MAX_ULPS, &y, &x);
+
+      std::vector<double> ay(n);
+      for (unsigned int i = 0; i < n; i++) ay[i] = std::fabs(y[i]);
+      both([&](const bool k) { base::simd::sqrtArray(ay.data(), (k ? v : s).data(), n); });
+      check("sqrtArray", s, v, 0.0, &ay);
+
+      both([&](const bool k) { base::simd::multArrayConst(y.data(), 57.29577951308232, (k ? v : s).data(), n); });
+      check("multArrayConst", s, v, 0.0, &y);
+   }
+
+   // ---
+   // pow10Array(): antenna gains (dB/10), the range limits and out of range values
+   // ---
+   {
+      std::vector<double> x(n);
+      for (unsigned int i = 0; i < n; i++) x[i] = unit(rng) * 30.0;
+      const double special[] = { 0.0, -0.0, 1.0, -1.0, 300.0, -300.0, 300.5, -300.5, 400.0, -400.0,
+                                 std::numeric_limits<double>::quiet_NaN(), 2.5, -2.5, 1.0e-17 };
+      for (unsigned int i = 0; i < sizeof(special) / sizeof(special[0]); i++) x[i] = special[i];
+
+      std::vector<double> s(n), v(n);
+      both([&](const bool k) { base::simd::pow10Array(x.data(), (k ? v : s).data(), n); });
+      check("pow10Array", s, v, MAX_ULPS, &x);
+   }
+
+   base::simd::setKernels(base::simd::Kernels::AVX2);
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u errors\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+// Test: the table lookups (Table1 .. Table5) -- scalar and batch, with and
+// without search hints (storage), grid indexes and extrapolation -- must give
+// exactly the results of the unhinted lfi_1D() .. lfi_5D() searches, for
+// random points, for points on the breakpoints (approached from both
+// directions) and for points beyond the tables, with increasing and with
+// decreasing breakpoints.
+//------------------------------------------------------------------------------
+
+#include "mixr/base/relations/Table5.hpp"
+#include "mixr/base/relations/IFStorage.hpp"
+#include "mixr/base/util/lfi.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace mixr;
+
+namespace {
+
+const unsigned int MAX_DIMS{5};
+const unsigned int SIZES[MAX_DIMS]{7, 5, 4, 4, 3};    // Breakpoints of each axis
+
+unsigned int numErrors{};
+std::mt19937_64 rng(4242);
+
+// Unhinted reference lookup
+double reference(const unsigned int nd, const double* const p,
+                 const std::vector<double>* const bp, const double* const data, const bool eFlg)
+{
+   switch (nd) {
+      case 1: return base::lfi_1D(p[0], bp[0].data(), SIZES[0], data, eFlg);
+      case 2: return base::lfi_2D(p[0], p[1], bp[0].data(), SIZES[0], bp[1].data(), SIZES[1], data, eFlg);
+      case 3: return base::lfi_3D(p[0], p[1], p[2], bp[0].data(), SIZES[0], bp[1].data(), SIZES[1],
+                                  bp[2].data(), SIZES[2], data, eFlg);
+      case 4: return base::lfi_4D(p[0], p[1], p[2], p[3], bp[0].data(), SIZES[0], bp[1].data(), SIZES[1],
+                                  bp[2].data(), SIZES[2], bp[3].data(), SIZES[3], data, eFlg);
+      default: return base::lfi_5D(p[0], p[1], p[2], p[3], p[4], bp[0].data(), SIZES[0], bp[1].data(), SIZES[1],
+                                   bp[2].data(), SIZES[2], bp[3].data(), SIZES[3], bp[4].data(), SIZES[4], data, eFlg);
+   }
+}
+
+// Table's scalar lookup
+double scalar(const unsigned int nd, const base::ITable* const t, const double* const p, base::IFStorage* const s)
+{
+   switch (nd) {
+      case 1: return static_cast<const base::Table1*>(t)->lfi(p[0], s);
+      case 2: return static_cast<const base::Table2*>(t)->lfi(p[0], p[1], s);
+      case 3: return static_cast<const base::Table3*>(t)->lfi(p[0], p[1], p[2], s);
+      case 4: return static_cast<const base::Table4*>(t)->lfi(p[0], p[1], p[2], p[3], s);
+      default: return static_cast<const base::Table5*>(t)->lfi(p[0], p[1], p[2], p[3], p[4], s);
+   }
+}
+
+// Table's batch lookup
+void batch(const unsigned int nd, const base::ITable* const t, const std::vector<double>* const iv,
+           double* const out, const unsigned int n, base::IFStorage* const s)
+{
+   switch (nd) {
+      case 1: static_cast<const base::Table1*>(t)->lfi(iv[0].data(), out, n, s); break;
+      case 2: static_cast<const base::Table2*>(t)->lfi(iv[0].data(), iv[1].data(), out, n, s); break;
+      case 3: static_cast<const base::Table3*>(t)->lfi(iv[0].data(), iv[1].data(), iv[2].data(), out, n, s); break;
+      case 4: static_cast<const base::Table4*>(t)->lfi(iv[0].data(), iv[1].data(), iv[2].data(), iv[3].data(), out, n, s); break;
+      default: static_cast<const base::Table5*>(t)->lfi(iv[0].data(), iv[1].data(), iv[2].data(), iv[3].data(), iv[4].data(), out, n, s); break;
+   }
+}
+
+base::ITable* makeTable(const unsigned int nd, const std::vector<double>* const bp, const std::vector<double>& data)
+{
+   const auto n = static_cast<unsigned int>(data.size());
+   switch (nd) {
+      case 1: return new base::Table1(data.data(), n, bp[0].data(), SIZES[0]);
+      case 2: return new base::Table2(data.data(), n, bp[0].data(), SIZES[0], bp[1].data(), SIZES[1]);
+      case 3: return new base::Table3(data.data(), n, bp[0].data(), SIZES[0], bp[1].data(), SIZES[1], bp[2].data(), SIZES[2]);
+      case 4: return new base::Table4(data.data(), n, bp[0].data(), SIZES[0], bp[1].data(), SIZES[1], bp[2].data(), SIZES[2],
+                                      bp[3].data(), SIZES[3]);
+      default: return new base::Table5(data.data(), n, bp[0].data(), SIZES[0], bp[1].data(), SIZES[1], bp[2].data(), SIZES[2],
+                                       bp[3].data(), SIZES[3], bp[4].data(), SIZES[4]);
+   }
+}
+
+bool identical(const double a, const double b)
+{
+   return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+void testTable(const unsigned int nd, const bool decreasing)
+{
+   std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+   // Non-uniform breakpoints and data values that don't interpolate exactly
+   std::vector<double> bp[MAX_DIMS];
+   for (unsigned int d = 0; d < nd; d++) {
+      double x{-3.7 * (d + 1)};
+      for (unsigned int i = 0; i < SIZES[d]; i++) {
+         bp[d].push_back(x);
+         x += 0.1 + 2.9 * unit(rng);
+      }
+      if (decreasing) std::reverse(bp[d].begin(), bp[d].end());
+   }
+   unsigned int size{1};
+   for (unsigned int d = 0; d < nd; d++) size *= SIZES[d];
+   std::vector<double> data(size);
+   for (double& v : data) v = (unit(rng) - 0.5) * 1000.0 / 3.0;
+
+   // ---
+   // Points: on the breakpoints, ascending then descending (so the hints come
+   // from both sides), midpoints, beyond the ends, and random
+   // ---
+   std::vector<double> iv[MAX_DIMS];
+   const auto addPoint = [&](const double* const p) { for (unsigned int d = 0; d < MAX_DIMS; d++) iv[d].push_back(d < nd ? p[d] : 0.0); };
+   for (int pass = 0; pass < 2; pass++) {
+      for (unsigned int k = 0; k < 2 * SIZES[0] * SIZES[1]; k++) {
+         const unsigned int j{pass == 0 ? k : (2 * SIZES[0] * SIZES[1] - 1 - k)};
+         double p[MAX_DIMS];
+         for (unsigned int d = 0; d < nd; d++) {
+            const unsigned int i{(j / (d + 1)) % SIZES[d]};
+            p[d] = bp[d][i];
+            if ((j + d) % 3 == 1 && i + 1 < SIZES[d]) p[d] = 0.5 * (bp[d][i] + bp[d][i + 1]);
+         }
+         addPoint(p);
+      }
+   }
+   for (unsigned int k = 0; k < 4000; k++) {
+      double p[MAX_DIMS];
+      for (unsigned int d = 0; d < nd; d++) {
+         const double lo{std::min(bp[d].front(), bp[d].back())};
+         const double hi{std::max(bp[d].front(), bp[d].back())};
+         const double r{unit(rng)};
+         if (r < 0.2) {
+            p[d] = bp[d][static_cast<unsigned int>(unit(rng) * SIZES[d]) % SIZES[d]];   // on a breakpoint
+         } else {
+            p[d] = lo + (hi - lo) * (1.4 * unit(rng) - 0.2);                            // in or beyond the table
+         }
+      }
+      addPoint(p);
+   }
+   const auto n = static_cast<unsigned int>(iv[0].size());
+
+   // ---
+   // Compare
+   // ---
+   base::ITable* const table{makeTable(nd, bp, data)};
+   std::vector<double> out(n);
+   unsigned int errors{};
+   for (int e = 0; e < 2; e++) {
+      for (int g = 0; g < 2; g++) {
+         table->setExtrapolationEnabled(e > 0);
+         table->setGridIndexEnabled(g > 0);
+
+         std::vector<double> ref(n);
+         for (unsigned int i = 0; i < n; i++) {
+            double p[MAX_DIMS];
+            for (unsigned int d = 0; d < MAX_DIMS; d++) p[d] = iv[d][i];
+            ref[i] = reference(nd, p, bp, data.data(), e > 0);
+         }
+
+         for (int mode = 0; mode < 4; mode++) {
+            const bool useStorage{(mode & 1) != 0};
+            const bool useBatch{(mode & 2) != 0};
+            base::IFStorage* const s{useStorage ? table->storageFactory() : nullptr};
+            if (useBatch) {
+               batch(nd, table, iv, out.data(), n, s);
+            } else {
+               for (unsigned int i = 0; i < n; i++) {
+                  double p[MAX_DIMS];
+                  for (unsigned int d = 0; d < MAX_DIMS; d++) p[d] = iv[d][i];
+                  out[i] = scalar(nd, table, p, s);
+               }
+            }
+            if (s != nullptr) s->unref();
+
+            for (unsigned int i = 0; i < n; i++) {
+               if (!identical(out[i], ref[i])) {
+                  if (numErrors + errors < 20) {
+                     std::printf("ERROR: Table%u (%s, extrapolate %d, grid %d, %s, storage %d) point %u (",
+                                 nd, (decreasing ? "decreasing" : "increasing"), e, g,
+                                 (useBatch ? "batch" : "scalar"), useStorage, i);
+                     for (unsigned int d = 0; d < nd; d++) std::printf("%s%.17g", (d > 0 ? ", " : ""), iv[d][i]);
+                     std::printf("): %.17g, expected %.17g\n", out[i], ref[i]);
+                  }
+                  errors++;
+               }
+            }
+         }
+      }
+   }
+   table->unref();
+
+   std::printf("   Table%u %-10s %5u points x 16 lookups, %u mismatches\n",
+               nd, (decreasing ? "decreasing" : "increasing"), n, errors);
+   numErrors += errors;
+}
+
+}
+
+int main()
+{
+   for (unsigned int nd = 1; nd <= MAX_DIMS; nd++) {
+      testTable(nd, false);
+      testTable(nd, true);
+   }
+
+   if (numErrors > 0) {
+      std::printf("FAILED: %u mismatches\n", numErrors);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+// Tool: recorderConvert -- converts a data recorder file (e.g., a legacy file)
+// to an indexed, and optionally compressed, data file, which FileReader can
+// seek by sim time and filter by player (see recorder::protobuf_v2::FileWriter
+// and FileReader).
+//
+// Usage:
+//
+//    recorderConvert [-c] <data file> <indexed data file>
+//
+//       -c    compress the records in blocks
+//
+// The indexed data file must not exist (FileWriter would append a version
+// number to its name).  After the conversion, both files are read up to their
+// end of data records, and their numbers of records must match.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/protobuf_v2/FileReader.hpp"
+#include "mixr/recorder/protobuf_v2/FileWriter.hpp"
+#include "mixr/recorder/protobuf_v2/DataRecordHandle.hpp"
+#include "mixr/recorder/protobuf_v2/proto/DataRecord.pb.h"
+
+#include "mixr/simulation/dataRecorderTokens.hpp"
+
+#include "mixr/base/String.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace mixr;
+using namespace mixr::recorder::protobuf_v2;
+
+namespace {
+
+void usage()
+{
+   std::fprintf(stderr, "usage: recorderConvert [-c] <data file> <indexed data file>\n");
+}
+
+// Opens a data file; returns zero if it can't be opened
+FileReader* openReader(const char* const filename)
+{
+   auto reader = new FileReader();
+   const auto name = new base::String(filename);
+   reader->setFilename(name);
+   name->unref();
+   if (!reader->openFile()) {
+      reader->unref();
+      reader = nullptr;
+   }
+   return reader;
+}
+
+// Reads the records of the data file up to the end of data record, which
+// is the last record that's converted; returns the number of records
+unsigned long countRecords(FileReader* const reader)
+{
+   unsigned long n{};
+   bool eod{};
+   const DataRecordHandle* handle{reader->readRecord()};
+   while (handle != nullptr && !eod) {
+      n++;
+      eod = (handle->getRecord()->id() == REID_END_OF_DATA);
+      handle->unref();
+      if (!eod) handle = reader->readRecord();
+   }
+   return n;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+   bool compress{};
+   int arg{1};
+   if (arg < argc && std::strcmp(argv[arg], "-c") == 0) {
+      compress = true;
+      arg++;
+   }
+   if (argc - arg != 2) {
+      usage();
+      return 2;
+   }
+   const char* const inFilename{argv[arg]};
+   const char* const outFilename{argv[arg + 1]};
+
+   if (std::ifstream(outFilename).good()) {
+      std::fprintf(stderr, "recorderConvert: %s already exists\n", outFilename);
+      return 1;
+   }
+
+   if (!FileWriter::convert(inFilename, outFilename, compress)) {
+      std::fprintf(stderr, "recorderConvert: could not convert %s\n", inFilename);
+      return 1;
+   }
+
+   // Check the indexed data file against the data file
+   FileReader* const in{openReader(inFilename)};
+   FileReader* const out{openReader(outFilename)};
+   bool ok{in != nullptr && out != nullptr && out->isIndexed()};
+   if (ok) {
+      const unsigned long numIn{countRecords(in)};
+      const unsigned long numOut{countRecords(out)};
+      std::printf("%s: %lu records, %lu indexed in %lu index blocks%s\n",
+                  outFilename, numOut, static_cast<unsigned long>(out->getNumIndexedRecords()),
+                  static_cast<unsigned long>(out->getNumIndexBlocks()), (out->isCompressed() ? ", compressed" : ""));
+      if (numIn != numOut || in->isFailed() || out->isFailed()) {
+         std::fprintf(stderr, "recorderConvert: %s has %lu records, but %s has %lu\n", inFilename, numIn, outFilename, numOut);
+         ok = false;
+      }
+   } else {
+      std::fprintf(stderr, "recorderConvert: could not read %s\n", outFilename);
+   }
+
+   if (in != nullptr) in->unref();
+   if (out != nullptr) out->unref();
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+// Tool: recorderExport -- exports the player state, track and weapon
+// detonation records of an indexed data recorder file as tables, for offline
+// replay and analysis, using several decoder threads (see
+// recorder::protobuf_v2::RecordExporter).
+//
+// Usage:
+//
+//    recorderExport [-f csv|columns] [-j threads] [-p player] <data file> <output prefix>
+//
+//       -f    output format: CSV files, <output prefix>_<table>.csv, or one
+//             binary file per column, <output prefix>_<table>.<column>, and
+//             a schema file for each table (default: csv)
+//       -j    number of decoder threads (default: one per processor)
+//       -p    only export the records of this player ID
+//
+// Legacy (unindexed) data files need to be converted first (see
+// recorderConvert).  The number of rows of each table is printed.
+//------------------------------------------------------------------------------
+
+#include "mixr/recorder/protobuf_v2/RecordExporter.hpp"
+
+#include "mixr/base/String.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace mixr;
+using namespace mixr::recorder::protobuf_v2;
+
+namespace {
+
+void usage()
+{
+   std::fprintf(stderr, "usage: recorderExport [-f csv|columns] [-j threads] [-p player] <data file> <output prefix>\n");
+}
+
+// Parses an unsigned integer argument; returns false if it's not one
+bool getNumber(const char* const arg, unsigned int* const v)
+{
+   char* end{};
+   const unsigned long n{std::strtoul(arg, &end, 10)};
+   const bool ok{*arg >= '0' && *arg <= '9' && *end == '\0' && n <= 0xffffffffUL};
+   if (ok) *v = static_cast<unsigned int>(n);
+   return ok;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+   const auto exporter = new RecordExporter();
+
+   bool ok{true};
+   int arg{1};
+   while (ok && arg + 1 < argc && argv[arg][0] == '-') {
+      const char* const opt{argv[arg]};
+      const char* const value{argv[arg + 1]};
+      unsigned int n{};
+      if (std::strcmp(opt, "-f") == 0 && std::strcmp(value, "csv") == 0) ok = exporter->setFormat(RecordExporter::Format::CSV);
+      else if (std::strcmp(opt, "-f") == 0 && std::strcmp(value, "columns") == 0) ok = exporter->setFormat(RecordExporter::Format::COLUMNS);
+      else if (std::strcmp(opt, "-j") == 0 && getNumber(value, &n)) ok = exporter->setNumThreads(n);
+      else if (std::strcmp(opt, "-p") == 0 && getNumber(value, &n)) ok = exporter->setPlayerFilter(n);
+      else ok = false;
+      arg += 2;
+   }
+   if (!ok || argc - arg != 2) {
+      usage();
+      exporter->unref();
+      return 2;
+   }
+
+   const auto filename = new base::String(argv[arg]);
+   const auto output = new base::String(argv[arg + 1]);
+   exporter->setFilename(filename);
+   exporter->setOutput(output);
+   filename->unref();
+   output->unref();
+
+   ok = exporter->exportFile();
+   if (ok) {
+      for (unsigned int t = 0; t < RecordExporter::NUM_TABLES; t++) {
+         std::printf("%s: %lu rows\n", RecordExporter::getTable(t).name, static_cast<unsigned long>(exporter->getNumRows(t)));
+      }
+      if (exporter->getNumErrors() > 0) {
+         std::fprintf(stderr, "recorderExport: %s has %lu bad chunks or records\n", argv[arg], static_cast<unsigned long>(exporter->getNumErrors()));
+         ok = false;
+      }
+   } else {
+      std::fprintf(stderr, "recorderExport: could not export %s\n", argv[arg]);
+   }
+
+   exporter->unref();
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// Tool: terrainCacheConvert -- converts DTED (.dt0, .dt1 or .dt2), SRTM (.hgt)
+// or DED (.ded) cell files to terrain cache files (.mtc), which are then
+// loaded by TerrainCacheFile, PagedTerrain and GlobalTerrain without any
+// parsing (see terrain::TerrainCacheFile).
+//
+// Usage:
+//
+//    terrainCacheConvert <cell file> <cache file>
+//    terrainCacheConvert -d <cache directory> <cell file> ...
+//
+// The second form names each cache file after its cell's southwest corner
+// (e.g., "n34w118.mtc"), since DTED cells are usually named by their latitude
+// only (e.g., "w118/n34.dt1").  Each cache file is loaded after it's written,
+// to check it, and its size, corners and elevations are printed.
+//------------------------------------------------------------------------------
+
+#include "mixr/terrain/cache/TerrainCacheFile.hpp"
+
+#include "mixr/base/String.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace mixr;
+
+namespace {
+
+void usage()
+{
+   std::fprintf(stderr, "usage: terrainCacheConvert <cell file> <cache file>\n");
+   std::fprintf(stderr, "       terrainCacheConvert -d <cache directory> <cell file> ...\n");
+}
+
+// Loads a terrain cache file and prints it; returns true if it's valid
+bool check(const std::string& filename)
+{
+   const auto cache = new terrain::TerrainCacheFile();
+   const auto fn = new base::String(filename.c_str());
+   cache->setFilename(fn);
+   fn->unref();
+   cache->reset();
+
+   const bool ok{cache->isDataLoaded()};
+   if (ok) {
+      const terrain::ITerrain* const db{cache};    // (DataFile hides the database's elevation getters)
+      std::printf("%s: %u x %u posts, SW (%g, %g), NE (%g, %g), elevations %g to %g m\n",
+                  filename.c_str(), cache->getNumLatPoints(), cache->getNumLonPoints(),
+                  db->getLatitudeSW(), db->getLongitudeSW(), db->getLatitudeNE(), db->getLongitudeNE(),
+                  db->getMinElevation(), db->getMaxElevation());
+   } else {
+      std::fprintf(stderr, "terrainCacheConvert: could not load %s\n", filename.c_str());
+   }
+   cache->unref();
+   return ok;
+}
+
+// Converts a cell to a cache file in 'dir', which is named by the cell's
+// southwest corner (e.g., "n34w118.mtc"); returns true if successful
+bool convertToDir(const std::string& cell, const std::string& dir, std::string* const name)
+{
+   // Convert to a temporary file, and then load it to find the cell's corner
+   const std::string tmp{dir + "/.terrainCacheConvert.tmp"};
+   if (!terrain::TerrainCacheFile::convert(cell.c_str(), tmp.c_str())) return false;
+
+   const auto cache = new terrain::TerrainCacheFile();
+   const auto fn = new base::String(tmp.c_str());
+   cache->setFilename(fn);
+   fn->unref();
+   cache->reset();
+   bool ok{cache->isDataLoaded()};
+   if (ok) {
+      const auto lat = static_cast<int>(std::lround(cache->getLatitudeSW()));
+      const auto lon = static_cast<int>(std::lround(cache->getLongitudeSW()));
+      char buff[32]{};
+      std::snprintf(buff, sizeof(buff), "%c%02d%c%03d.mtc", (lat < 0 ? 's' : 'n'), std::abs(lat), (lon < 0 ? 'w' : 'e'), std::abs(lon));
+      *name = dir + "/" + buff;
+   }
+   cache->unref();
+
+   if (ok) ok = (std::rename(tmp.c_str(), name->c_str()) == 0);
+   if (!ok) std::remove(tmp.c_str());
+   return ok;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+   // Single cell to a named cache file
+   if (argc == 3 && std::strcmp(argv[1], "-d") != 0) {
+      if (!terrain::TerrainCacheFile::convert(argv[1], argv[2]) || !check(argv[2])) {
+         std::fprintf(stderr, "terrainCacheConvert: could not convert %s\n", argv[1]);
+         return 1;
+      }
+      return 0;
+   }
+
+   // Cells to a cache directory
+   if (argc >= 4 && std::strcmp(argv[1], "-d") == 0) {
+      const std::string dir{argv[2]};
+      unsigned int numErrors{};
+      for (int i = 3; i < argc; i++) {
+         std::string name;
+         if (!convertToDir(argv[i], dir, &name) || !check(name)) {
+            std::fprintf(stderr, "terrainCacheConvert: could not convert %s\n", argv[i]);
+            numErrors++;
+         }
+      }
+      return (numErrors > 0) ? 1 : 0;
+   }
+
+   usage();
+   return 2;
+}